@@ -13,6 +13,8 @@
 #include "Misc/PackageName.h"
 #include "Policies/CondensedJsonPrintPolicy.h"
 #include "JsonObjectWrapper.h"
+#include "CustomJsonTokenReader.h"
+#include "CustomStructDescriptor.h"
 
 FString CustomJsonConverter::StandardizeCase(const FString& StringIn)
 {
@@ -27,6 +29,71 @@ namespace
 {
 	const FString ObjectClassNameKey = "_ClassName";
 
+	struct FCultureChain
+	{
+		FCulturePtr Culture;
+		TSharedPtr<const TArray<FString>> Names;
+	};
+
+	FCriticalSection CultureChainLock;
+	FCultureChain CultureChain;
+
+	/** The current culture's prioritized parent culture names, only worked out again when the culture changes */
+	TSharedRef<const TArray<FString>> GetCultureChain()
+	{
+		FCultureRef CurrentCulture = FInternationalization::Get().GetCurrentCulture();
+
+		FScopeLock Lock(&CultureChainLock);
+
+		if (CultureChain.Culture.Get() != &CurrentCulture.Get() || !CultureChain.Names.IsValid())
+		{
+			CultureChain.Culture = CurrentCulture;
+			CultureChain.Names = MakeShared<const TArray<FString>>(CurrentCulture->GetPrioritizedParentCultureNames());
+		}
+
+		return CultureChain.Names.ToSharedRef();
+	}
+
+	/** Picks the text for the current culture out of culture code and string pairs, see GetTextFromObject */
+	bool GetTextFromCultureStrings(const TMap<FString, FString>& CultureStrings, FText& TextOut)
+	{
+		// get the prioritized culture name list
+		const TSharedRef<const TArray<FString>> CultureChainNames = GetCultureChain();
+		const TArray<FString>& CultureList = *CultureChainNames;
+
+		// try to follow the fall back chain that the engine uses
+		for (const FString& CultureCode : CultureList)
+		{
+			if (const FString* TextString = CultureStrings.Find(CultureCode))
+			{
+				TextOut = FText::FromString(*TextString);
+				return true;
+			}
+		}
+
+		// try again but only search on the locale region (in the localized data). This is a common omission (i.e. en-US source text should be used if no en is defined)
+		for (const FString& LocaleToMatch : CultureList)
+		{
+			int32 SeparatorPos;
+			// only consider base language entries in culture chain (i.e. "en")
+			if (!LocaleToMatch.FindChar('-', SeparatorPos))
+			{
+				for (const TPair<FString, FString>& Pair : CultureStrings)
+				{
+					// only consider coupled entries now (base ones would have been matched on first path) (i.e. "en-US")
+					if (Pair.Key.FindChar('-', SeparatorPos) && Pair.Key.StartsWith(LocaleToMatch))
+					{
+						TextOut = FText::FromString(Pair.Value);
+						return true;
+					}
+				}
+			}
+		}
+
+		// no luck, is this possibly an unrelated json object?
+		return false;
+	}
+
 	/** Convert property to JSON, assuming either the property is not an array or the value is an individual array element */
 	TSharedPtr<FJsonValue> ConvertScalarFPropertyToJsonValue(FProperty* Property, const void* Value, int64 CheckFlags, int64 SkipFlags, const CustomJsonConverter::CustomExportCallback* ExportCb, FProperty* OuterProperty)
 	{
@@ -247,137 +314,745 @@ bool CustomJsonConverter::UStructToJsonAttributes(const UStruct* StructDefinitio
 		return true;
 	}
 
-	for (TFieldIterator<FProperty> It(StructDefinition); It; ++It)
+	const TSharedRef<const FCustomStructDescriptor> Descriptor = CustomStructDescriptorCache::Get(StructDefinition);
+	for (const FCustomStructDescriptor::FField& Field : Descriptor->Fields)
 	{
-		FProperty* Property = *It;
+		FProperty* Property = Field.Property;
 
 		// Check to see if we should ignore this property
 		if (CheckFlags != 0 && !Property->HasAnyPropertyFlags(CheckFlags))
 		{
-			continue;
+			continue;
+		}
+		if (Property->HasAnyPropertyFlags(SkipFlags))
+		{
+			continue;
+		}
+
+		const FString& VariableName = Field.JsonName;
+		const void* Value = Field.GetValuePtr(Struct);
+
+		// convert the property to a FJsonValue
+		TSharedPtr<FJsonValue> JsonValue = UPropertyToJsonValue(Property, Value, CheckFlags, SkipFlags, ExportCb);
+		if (!JsonValue.IsValid())
+		{
+			FFieldClass* PropClass = Property->GetClass();
+			UE_LOG(LogJson, Error, TEXT("UStructToJsonObject - Unhandled property type '%s': %s"), *PropClass->GetName(), *Property->GetPathName());
+			return false;
+		}
+
+		// set the value on the output object
+		OutJsonAttributes.Add(VariableName, JsonValue);
+	}
+
+	return true;
+}
+
+namespace
+{
+	template<class CharType, class PrintPolicy, typename ValueType>
+	void WriteJsonValueWithOptionalIdentifier(TJsonWriter<CharType, PrintPolicy>& JsonWriter, const FString* Identifier, const ValueType& Value)
+	{
+		if (Identifier)
+		{
+			JsonWriter.WriteValue(*Identifier, Value);
+		}
+		else
+		{
+			JsonWriter.WriteValue(Value);
+		}
+	}
+
+	template<class CharType, class PrintPolicy>
+	void WriteJsonObjectStartWithOptionalIdentifier(TJsonWriter<CharType, PrintPolicy>& JsonWriter, const FString* Identifier)
+	{
+		if (Identifier)
+		{
+			JsonWriter.WriteObjectStart(*Identifier);
+		}
+		else
+		{
+			JsonWriter.WriteObjectStart();
+		}
+	}
+
+	template<class CharType, class PrintPolicy>
+	void WriteJsonArrayStartWithOptionalIdentifier(TJsonWriter<CharType, PrintPolicy>& JsonWriter, const FString* Identifier)
+	{
+		if (Identifier)
+		{
+			JsonWriter.WriteArrayStart(*Identifier);
+		}
+		else
+		{
+			JsonWriter.WriteArrayStart();
+		}
+	}
+
+	template<class CharType, class PrintPolicy>
+	bool WriteFPropertyToJson(const TSharedRef<TJsonWriter<CharType, PrintPolicy>>& JsonWriter, const FString* Identifier, FProperty* Property, const void* Value, int64 CheckFlags, int64 SkipFlags, const CustomJsonConverter::CustomExportCallback* ExportCb, FProperty* OuterProperty = nullptr);
+
+	template<class CharType, class PrintPolicy>
+	bool WriteUStructMembersToJson(const TSharedRef<TJsonWriter<CharType, PrintPolicy>>& JsonWriter, const UStruct* StructDefinition, const void* Struct, int64 CheckFlags, int64 SkipFlags, const CustomJsonConverter::CustomExportCallback* ExportCb);
+
+	/**
+	 * ConvertScalarFPropertyToJsonValue, written straight to the writer rather than into an FJsonValue.
+	 * Returns false where that would have returned an invalid value, by which point part of the value may have been written.
+	 */
+	template<class CharType, class PrintPolicy>
+	bool WriteScalarFPropertyToJson(const TSharedRef<TJsonWriter<CharType, PrintPolicy>>& JsonWriter, const FString* Identifier, FProperty* Property, const void* Value, int64 CheckFlags, int64 SkipFlags, const CustomJsonConverter::CustomExportCallback* ExportCb, FProperty* OuterProperty)
+	{
+		// See if there's a custom export callback first, so it can override default behavior
+		if (ExportCb && ExportCb->IsBound())
+		{
+			TSharedPtr<FJsonValue> CustomValue = ExportCb->Execute(Property, Value);
+			if (CustomValue.IsValid())
+			{
+				return FJsonSerializer::Serialize(CustomValue.ToSharedRef(), Identifier ? *Identifier : FString(), JsonWriter, false);
+			}
+			// fall through to default cases
+		}
+
+		if (FEnumProperty* EnumProperty = CastField<FEnumProperty>(Property))
+		{
+			// export enums as strings
+			UEnum* EnumDef = EnumProperty->GetEnum();
+			FString StringValue = EnumDef->GetNameStringByValue(EnumProperty->GetUnderlyingProperty()->GetSignedIntPropertyValue(Value));
+
+			WriteJsonValueWithOptionalIdentifier(*JsonWriter, Identifier, StringValue);
+			return true;
+		}
+		else if (FNumericProperty* NumericProperty = CastField<FNumericProperty>(Property))
+		{
+			// see if it's an enum
+			UEnum* EnumDef = NumericProperty->GetIntPropertyEnum();
+			if (EnumDef != NULL)
+			{
+				// export enums as strings
+				FString StringValue = EnumDef->GetAuthoredNameStringByIndex(NumericProperty->GetSignedIntPropertyValue(Value));
+
+				WriteJsonValueWithOptionalIdentifier(*JsonWriter, Identifier, StringValue);
+				return true;
+			}
+
+			// We want to export numbers as numbers, as doubles like FJsonValueNumber holds them
+			if (NumericProperty->IsFloatingPoint())
+			{
+				WriteJsonValueWithOptionalIdentifier(*JsonWriter, Identifier, NumericProperty->GetFloatingPointPropertyValue(Value));
+				return true;
+			}
+			else if (NumericProperty->IsInteger())
+			{
+				WriteJsonValueWithOptionalIdentifier(*JsonWriter, Identifier, (double)NumericProperty->GetSignedIntPropertyValue(Value));
+				return true;
+			}
+
+			// fall through to default
+		}
+		else if (FBoolProperty* BoolProperty = CastField<FBoolProperty>(Property))
+		{
+			// Export bools as bools
+			WriteJsonValueWithOptionalIdentifier(*JsonWriter, Identifier, BoolProperty->GetPropertyValue(Value));
+			return true;
+		}
+		else if (FStrProperty* StringProperty = CastField<FStrProperty>(Property))
+		{
+			WriteJsonValueWithOptionalIdentifier(*JsonWriter, Identifier, StringProperty->GetPropertyValue(Value));
+			return true;
+		}
+		else if (FTextProperty* TextProperty = CastField<FTextProperty>(Property))
+		{
+			WriteJsonValueWithOptionalIdentifier(*JsonWriter, Identifier, TextProperty->GetPropertyValue(Value).ToString());
+			return true;
+		}
+		else if (FArrayProperty* ArrayProperty = CastField<FArrayProperty>(Property))
+		{
+			WriteJsonArrayStartWithOptionalIdentifier(*JsonWriter, Identifier);
+			FScriptArrayHelper Helper(ArrayProperty, Value);
+			for (int32 i = 0, n = Helper.Num(); i < n; ++i)
+			{
+				if (!WriteFPropertyToJson(JsonWriter, nullptr, ArrayProperty->Inner, Helper.GetRawPtr(i), CheckFlags & (~CPF_ParmFlags), SkipFlags, ExportCb, ArrayProperty))
+				{
+					return false;
+				}
+			}
+			JsonWriter->WriteArrayEnd();
+			return true;
+		}
+		else if (FSetProperty* SetProperty = CastField<FSetProperty>(Property))
+		{
+			WriteJsonArrayStartWithOptionalIdentifier(*JsonWriter, Identifier);
+			FScriptSetHelper Helper(SetProperty, Value);
+			for (int32 i = 0, n = Helper.Num(); n; ++i)
+			{
+				if (Helper.IsValidIndex(i))
+				{
+					if (!WriteFPropertyToJson(JsonWriter, nullptr, SetProperty->ElementProp, Helper.GetElementPtr(i), CheckFlags & (~CPF_ParmFlags), SkipFlags, ExportCb, SetProperty))
+					{
+						return false;
+					}
+
+					--n;
+				}
+			}
+			JsonWriter->WriteArrayEnd();
+			return true;
+		}
+		else if (FMapProperty* MapProperty = CastField<FMapProperty>(Property))
+		{
+			WriteJsonObjectStartWithOptionalIdentifier(*JsonWriter, Identifier);
+
+			FScriptMapHelper Helper(MapProperty, Value);
+			for (int32 i = 0, n = Helper.Num(); n; ++i)
+			{
+				if (Helper.IsValidIndex(i))
+				{
+					// Keys still go through an FJsonValue, as their string form is whatever TryGetString makes of it
+					TSharedPtr<FJsonValue> KeyElement = CustomJsonConverter::UPropertyToJsonValue(MapProperty->KeyProp, Helper.GetKeyPtr(i), CheckFlags & (~CPF_ParmFlags), SkipFlags, ExportCb, MapProperty);
+					if (!KeyElement.IsValid())
+					{
+						return false;
+					}
+
+					FString KeyString;
+					if (!KeyElement->TryGetString(KeyString))
+					{
+						MapProperty->KeyProp->ExportTextItem_Direct(KeyString, Helper.GetKeyPtr(i), nullptr, nullptr, 0);
+						if (KeyString.IsEmpty())
+						{
+							UE_LOG(LogJson, Error, TEXT("Unable to convert key to string for property %s."), *MapProperty->GetName())
+								KeyString = FString::Printf(TEXT("Unparsed Key %d"), i);
+						}
+					}
+
+					if (!WriteFPropertyToJson(JsonWriter, &KeyString, MapProperty->ValueProp, Helper.GetValuePtr(i), CheckFlags & (~CPF_ParmFlags), SkipFlags, ExportCb, MapProperty))
+					{
+						return false;
+					}
+
+					--n;
+				}
+			}
+
+			JsonWriter->WriteObjectEnd();
+			return true;
+		}
+		else if (FStructProperty* StructProperty = CastField<FStructProperty>(Property))
+		{
+			UScriptStruct::ICppStructOps* TheCppStructOps = StructProperty->Struct->GetCppStructOps();
+			// Intentionally exclude the JSON Object wrapper, which specifically needs to export JSON in an object representation instead of a string
+			if (StructProperty->Struct != FJsonObjectWrapper::StaticStruct() && TheCppStructOps && TheCppStructOps->HasExportTextItem())
+			{
+				FString OutValueStr;
+				TheCppStructOps->ExportTextItem(OutValueStr, Value, nullptr, nullptr, PPF_None, nullptr);
+				WriteJsonValueWithOptionalIdentifier(*JsonWriter, Identifier, OutValueStr);
+				return true;
+			}
+
+			WriteJsonObjectStartWithOptionalIdentifier(*JsonWriter, Identifier);
+			if (WriteUStructMembersToJson(JsonWriter, StructProperty->Struct, Value, CheckFlags & (~CPF_ParmFlags), SkipFlags, ExportCb))
+			{
+				JsonWriter->WriteObjectEnd();
+				return true;
+			}
+		}
+		else if (FObjectProperty* ObjectProperty = CastField<FObjectProperty>(Property))
+		{
+			// Instanced properties should be copied by value, while normal UObject* properties should output as asset references
+			UObject* Object = ObjectProperty->GetObjectPropertyValue(Value);
+			if (Object && (ObjectProperty->HasAnyPropertyFlags(CPF_PersistentInstance) || (OuterProperty && OuterProperty->HasAnyPropertyFlags(CPF_PersistentInstance))))
+			{
+				// The class goes first so that the importer knows what to create before it reads anything else
+				WriteJsonObjectStartWithOptionalIdentifier(*JsonWriter, Identifier);
+				JsonWriter->WriteValue(ObjectClassNameKey, Object->GetClass()->GetFName().ToString());
+				if (WriteUStructMembersToJson(JsonWriter, Object->GetClass(), Object, CheckFlags, SkipFlags, ExportCb))
+				{
+					JsonWriter->WriteObjectEnd();
+					return true;
+				}
+			}
+			else
+			{
+				FString StringValue;
+				Property->ExportTextItem_Direct(StringValue, Value, nullptr, nullptr, PPF_None);
+				WriteJsonValueWithOptionalIdentifier(*JsonWriter, Identifier, StringValue);
+				return true;
+			}
+		}
+		else
+		{
+			// Default to export as string for everything else
+			FString StringValue;
+			Property->ExportTextItem_Direct(StringValue, Value, NULL, NULL, PPF_None);
+			WriteJsonValueWithOptionalIdentifier(*JsonWriter, Identifier, StringValue);
+			return true;
+		}
+
+		// invalid
+		return false;
+	}
+
+	/** UPropertyToJsonValue, written straight to the writer */
+	template<class CharType, class PrintPolicy>
+	bool WriteFPropertyToJson(const TSharedRef<TJsonWriter<CharType, PrintPolicy>>& JsonWriter, const FString* Identifier, FProperty* Property, const void* Value, int64 CheckFlags, int64 SkipFlags, const CustomJsonConverter::CustomExportCallback* ExportCb, FProperty* OuterProperty)
+	{
+		if (Property->ArrayDim == 1)
+		{
+			return WriteScalarFPropertyToJson(JsonWriter, Identifier, Property, Value, CheckFlags, SkipFlags, ExportCb, OuterProperty);
+		}
+
+		WriteJsonArrayStartWithOptionalIdentifier(*JsonWriter, Identifier);
+		for (int Index = 0; Index != Property->ArrayDim; ++Index)
+		{
+			if (!WriteScalarFPropertyToJson(JsonWriter, nullptr, Property, (char*)Value + Index * Property->ElementSize, CheckFlags, SkipFlags, ExportCb, OuterProperty))
+			{
+				return false;
+			}
+		}
+		JsonWriter->WriteArrayEnd();
+		return true;
+	}
+
+	/** UStructToJsonAttributes, written straight to the writer as the members of an object that has already been started */
+	template<class CharType, class PrintPolicy>
+	bool WriteUStructMembersToJson(const TSharedRef<TJsonWriter<CharType, PrintPolicy>>& JsonWriter, const UStruct* StructDefinition, const void* Struct, int64 CheckFlags, int64 SkipFlags, const CustomJsonConverter::CustomExportCallback* ExportCb)
+	{
+		if (SkipFlags == 0)
+		{
+			// If we have no specified skip flags, skip deprecated, transient and skip serialization by default when writing
+			SkipFlags |= CPF_Deprecated | CPF_Transient;
+		}
+
+		if (StructDefinition == FJsonObjectWrapper::StaticStruct())
+		{
+			// Just copy it into the object
+			const FJsonObjectWrapper* ProxyObject = (const FJsonObjectWrapper*)Struct;
+
+			if (ProxyObject->JsonObject.IsValid())
+			{
+				for (const auto& Pair : ProxyObject->JsonObject->Values)
+				{
+					if (Pair.Value.IsValid() && !FJsonSerializer::Serialize(Pair.Value.ToSharedRef(), Pair.Key, JsonWriter, false))
+					{
+						return false;
+					}
+				}
+			}
+			return true;
+		}
+
+		const TSharedRef<const FCustomStructDescriptor> Descriptor = CustomStructDescriptorCache::Get(StructDefinition);
+		for (const FCustomStructDescriptor::FField& Field : Descriptor->Fields)
+		{
+			FProperty* Property = Field.Property;
+
+			// Check to see if we should ignore this property
+			if (CheckFlags != 0 && !Property->HasAnyPropertyFlags(CheckFlags))
+			{
+				continue;
+			}
+			if (Property->HasAnyPropertyFlags(SkipFlags))
+			{
+				continue;
+			}
+
+			if (!WriteFPropertyToJson(JsonWriter, &Field.JsonName, Property, Field.GetValuePtr(Struct), CheckFlags, SkipFlags, ExportCb))
+			{
+				FFieldClass* PropClass = Property->GetClass();
+				UE_LOG(LogJson, Error, TEXT("UStructToJsonObject - Unhandled property type '%s': %s"), *PropClass->GetName(), *Property->GetPathName());
+				return false;
+			}
+		}
+
+		return true;
+	}
+}
+
+template<class CharType, class PrintPolicy>
+bool UStructToJsonObjectStringInternal(const UStruct* StructDefinition, const void* Struct, FString& OutJsonString, int64 CheckFlags, int64 SkipFlags, int32 Indent, const CustomJsonConverter::CustomExportCallback* ExportCb)
+{
+	// The writer is only closed, which is what hands the text over, once the whole struct has been written
+	TSharedRef<TJsonWriter<CharType, PrintPolicy> > JsonWriter = TJsonWriterFactory<CharType, PrintPolicy>::Create(&OutJsonString, Indent);
+	JsonWriter->WriteObjectStart();
+	if (!WriteUStructMembersToJson(JsonWriter, StructDefinition, Struct, CheckFlags, SkipFlags, ExportCb))
+	{
+		return false;
+	}
+	JsonWriter->WriteObjectEnd();
+
+	if (!JsonWriter->Close())
+	{
+		UE_LOG(LogJson, Warning, TEXT("UStructToJsonObjectString - Unable to write out json"));
+		return false;
+	}
+	return true;
+}
+
+bool CustomJsonConverter::UStructToJsonObjectString(const UStruct* StructDefinition, const void* Struct, FString& OutJsonString, int64 CheckFlags, int64 SkipFlags, int32 Indent, const CustomExportCallback* ExportCb, bool bPrettyPrint)
+{
+	if (bPrettyPrint)
+	{
+		return UStructToJsonObjectStringInternal<TCHAR, TPrettyJsonPrintPolicy<TCHAR> >(StructDefinition, Struct, OutJsonString, CheckFlags, SkipFlags, Indent, ExportCb);
+	}
+	return UStructToJsonObjectStringInternal<TCHAR, TCondensedJsonPrintPolicy<TCHAR> >(StructDefinition, Struct, OutJsonString, CheckFlags, SkipFlags, Indent, ExportCb);
+}
+
+//static
+void CustomJsonConverter::ResetStructCache()
+{
+	CustomStructDescriptorCache::Reset();
+
+	FScopeLock Lock(&CultureChainLock);
+	CultureChain = FCultureChain();
+}
+
+//static
+bool CustomJsonConverter::GetTextFromObject(const TSharedRef<FJsonObject>& Obj, FText& TextOut)
+{
+	TMap<FString, FString> CultureStrings;
+	CultureStrings.Reserve(Obj->Values.Num());
+	for (const TPair<FString, TSharedPtr<FJsonValue>>& Pair : Obj->Values)
+	{
+		FString TextString;
+		if (Pair.Value.IsValid() && Pair.Value->TryGetString(TextString))
+		{
+			CultureStrings.Add(Pair.Key, MoveTemp(TextString));
+		}
+	}
+
+	return GetTextFromCultureStrings(CultureStrings, TextOut);
+}
+
+
+namespace
+{
+	/**
+	 * The value being converted by JsonValueToFPropertyWithContainer below, read from an FJsonValue (or the attributes of an
+	 * object) that has already been parsed. Every rule for turning JSON into a property lives in the conversion, so the
+	 * only thing that differs between this and FJsonTokenValueSource is where the JSON comes from.
+	 */
+	class FJsonDomValueSource
+	{
+	public:
+		explicit FJsonDomValueSource(const FJsonValue* InValue)
+			: Value(InValue)
+			, Attributes(InValue && InValue->Type == EJson::Object && InValue->AsObject().IsValid() ? &InValue->AsObject()->Values : nullptr)
+		{
+		}
+
+		explicit FJsonDomValueSource(const TMap<FString, TSharedPtr<FJsonValue>>& InAttributes)
+			: Value(nullptr)
+			, Attributes(&InAttributes)
+		{
+		}
+
+		EJson GetType() const
+		{
+			// An object value without an object behind it has nothing to read, so it's passed over like a null
+			return Attributes ? EJson::Object : Value && Value->Type != EJson::Object ? Value->Type : EJson::Null;
+		}
+
+		bool IsNull() const
+		{
+			return GetType() == EJson::Null;
+		}
+
+		// The As functions log an error for completely inappropriate types, then give a default
+		FString AsString() const
+		{
+			return Value ? Value->AsString() : FString();
+		}
+
+		double AsNumber() const
+		{
+			return Value ? Value->AsNumber() : 0.0;
+		}
+
+		bool AsBool() const
+		{
+			return Value ? Value->AsBool() : false;
+		}
+
+		int64 AsInt64() const
+		{
+			// parse string -> int64 ourselves so we don't lose any precision going through AsNumber (aka double)
+			return GetType() == EJson::String ? FCString::Atoi64(*Value->AsString()) : (int64)AsNumber();
+		}
+
+		bool TryGetString(FString& OutString) const
+		{
+			return Value && Value->TryGetString(OutString);
+		}
+
+		bool ForEachElement(TFunctionRef<bool(FJsonDomValueSource&)> Visit)
+		{
+			for (const TSharedPtr<FJsonValue>& Element : Value->AsArray())
+			{
+				FJsonDomValueSource ElementSource(Element.Get());
+				if (!Visit(ElementSource))
+				{
+					return false;
+				}
+			}
+			return true;
+		}
+
+		bool ForEachMember(TFunctionRef<bool(const FString&, FJsonDomValueSource&)> Visit)
+		{
+			for (const TPair<FString, TSharedPtr<FJsonValue>>& Member : *Attributes)
+			{
+				FJsonDomValueSource MemberSource(Member.Value.Get());
+				if (!Visit(Member.Key, MemberSource))
+				{
+					return false;
+				}
+			}
+			return true;
+		}
+
+		/** The class an instanced object was exported as, wherever it is in the object. Its member is then ignored like any unknown key. */
+		bool ReadObjectClassName(FString& OutClassName)
+		{
+			if (const TSharedPtr<FJsonValue>* ClassName = Attributes->Find(ObjectClassNameKey))
+			{
+				if (ClassName->IsValid())
+				{
+					(*ClassName)->TryGetString(OutClassName);
+				}
+			}
+			return true;
+		}
+
+		bool CopyMembersTo(FJsonObject& OutObject)
+		{
+			OutObject.Values = *Attributes;
+			return true;
+		}
+
+	private:
+		const FJsonValue* Value;
+		const TMap<FString, TSharedPtr<FJsonValue>>* Attributes;
+	};
+
+	/**
+	 * The same as FJsonDomValueSource, but for the value that starts with Notation on a reader, so that nothing is built
+	 * for it. Whatever a conversion doesn't read of an array or object is skipped by Finish, which the parent calls.
+	 */
+	class FJsonTokenValueSource
+	{
+	public:
+		FJsonTokenValueSource(CustomJsonToken::FReader& InReader, const EJsonNotation InNotation)
+			: Reader(InReader)
+			, Notation(InNotation)
+		{
 		}
-		if (Property->HasAnyPropertyFlags(SkipFlags))
+
+		EJson GetType() const
 		{
-			continue;
+			switch (Notation)
+			{
+			case EJsonNotation::String:
+				return EJson::String;
+			case EJsonNotation::Number:
+				return EJson::Number;
+			case EJsonNotation::Boolean:
+				return EJson::Boolean;
+			case EJsonNotation::Null:
+				return EJson::Null;
+			case EJsonNotation::ArrayStart:
+				return EJson::Array;
+			case EJsonNotation::ObjectStart:
+				return EJson::Object;
+			default:
+				return EJson::None;
+			}
 		}
 
-		//FString VariableName = StandardizeCase(Property->GetName());
-		FString VariableName = StandardizeCase(Property->GetAuthoredName());
-		const void* Value = Property->ContainerPtrToValuePtr<uint8>(Struct);
+		bool IsNull() const
+		{
+			return Notation == EJsonNotation::Null;
+		}
 
-		// convert the property to a FJsonValue
-		TSharedPtr<FJsonValue> JsonValue = UPropertyToJsonValue(Property, Value, CheckFlags, SkipFlags, ExportCb);
-		if (!JsonValue.IsValid())
+		// The As functions log the same errors as FJsonValue's, then give a default
+		FString AsString() const
 		{
-			FFieldClass* PropClass = Property->GetClass();
-			UE_LOG(LogJson, Error, TEXT("UStructToJsonObject - Unhandled property type '%s': %s"), *PropClass->GetName(), *Property->GetPathName());
-			return false;
+			FString Value;
+			if (!CustomJsonToken::TryGetString(Reader, Notation, Value))
+			{
+				LogTypeMismatch(TEXT("String"));
+			}
+			return Value;
 		}
 
-		// set the value on the output object
-		OutJsonAttributes.Add(VariableName, JsonValue);
-	}
+		double AsNumber() const
+		{
+			double Number = 0.0;
+			if (!CustomJsonToken::TryGetNumber(Reader, Notation, Number))
+			{
+				LogTypeMismatch(TEXT("Number"));
+			}
+			return Number;
+		}
 
-	return true;
-}
+		bool AsBool() const
+		{
+			bool bValue = false;
+			if (!CustomJsonToken::TryGetBool(Reader, Notation, bValue))
+			{
+				LogTypeMismatch(TEXT("Boolean"));
+			}
+			return bValue;
+		}
 
-template<class CharType, class PrintPolicy>
-bool UStructToJsonObjectStringInternal(const TSharedRef<FJsonObject>& JsonObject, FString& OutJsonString, int32 Indent)
-{
-	TSharedRef<TJsonWriter<CharType, PrintPolicy> > JsonWriter = TJsonWriterFactory<CharType, PrintPolicy>::Create(&OutJsonString, Indent);
-	bool bSuccess = FJsonSerializer::Serialize(JsonObject, JsonWriter);
-	JsonWriter->Close();
-	return bSuccess;
-}
+		int64 AsInt64() const
+		{
+			// Whole numbers are read from their text, so large ones keep the precision a double would lose
+			int64 IntValue = 0;
+			return CustomJsonToken::TryGetNumber(Reader, Notation, IntValue) ? IntValue : (int64)AsNumber();
+		}
 
-bool CustomJsonConverter::UStructToJsonObjectString(const UStruct* StructDefinition, const void* Struct, FString& OutJsonString, int64 CheckFlags, int64 SkipFlags, int32 Indent, const CustomExportCallback* ExportCb, bool bPrettyPrint)
-{
-	TSharedRef<FJsonObject> JsonObject = MakeShared<FJsonObject>();
-	if (UStructToJsonObject(StructDefinition, Struct, JsonObject, CheckFlags, SkipFlags, ExportCb))
-	{
-		bool bSuccess = false;
-		if (bPrettyPrint)
+		bool TryGetString(FString& OutString) const
 		{
-			bSuccess = UStructToJsonObjectStringInternal<TCHAR, TPrettyJsonPrintPolicy<TCHAR> >(JsonObject, OutJsonString, Indent);
+			return CustomJsonToken::TryGetString(Reader, Notation, OutString);
 		}
-		else
+
+		bool ForEachElement(TFunctionRef<bool(FJsonTokenValueSource&)> Visit)
 		{
-			bSuccess = UStructToJsonObjectStringInternal<TCHAR, TCondensedJsonPrintPolicy<TCHAR> >(JsonObject, OutJsonString, Indent);
+			// Whatever happens from here the array can't be skipped any more
+			bConsumed = true;
+
+			EJsonNotation ElementNotation = EJsonNotation::Error;
+			while (Reader.ReadNext(ElementNotation) && ElementNotation != EJsonNotation::ArrayEnd)
+			{
+				FJsonTokenValueSource Element(Reader, ElementNotation);
+				if (!Visit(Element) || !Element.Finish())
+				{
+					return false;
+				}
+			}
+			return ElementNotation == EJsonNotation::ArrayEnd;
 		}
-		if (bSuccess)
+
+		/** The key handed to Visit is only good until the member's value has been read */
+		bool ForEachMember(TFunctionRef<bool(const FString&, FJsonTokenValueSource&)> Visit)
 		{
+			if (!StartMembers())
+			{
+				return false;
+			}
+			bConsumed = true;
+
+			while (MemberNotation != EJsonNotation::ObjectEnd)
+			{
+				FJsonTokenValueSource Member(Reader, MemberNotation);
+				if (!Visit(Reader.GetIdentifier(), Member) || !Member.Finish() || !Reader.ReadNext(MemberNotation))
+				{
+					return false;
+				}
+			}
 			return true;
 		}
-		else
+
+		/**
+		 * The class an instanced object was exported as. It has to be known before the object is made, so it's only looked
+		 * for where the exporter writes it, first, and is then passed over.
+		 */
+		bool ReadObjectClassName(FString& OutClassName)
 		{
-			UE_LOG(LogJson, Warning, TEXT("UStructToJsonObjectString - Unable to write out json"));
+			if (!StartMembers())
+			{
+				return false;
+			}
+
+			if (MemberNotation == EJsonNotation::String && Reader.GetIdentifier() == ObjectClassNameKey)
+			{
+				OutClassName = Reader.GetValueAsString();
+				return Reader.ReadNext(MemberNotation);
+			}
+			return true;
 		}
-	}
 
-	return false;
-}
+		/** For FJsonObjectWrapper, which holds the JSON itself, so this is the one place an FJsonObject is still built */
+		bool CopyMembersTo(FJsonObject& OutObject)
+		{
+			if (!StartMembers())
+			{
+				return false;
+			}
+			bConsumed = true;
 
-//static
-bool CustomJsonConverter::GetTextFromObject(const TSharedRef<FJsonObject>& Obj, FText& TextOut)
-{
-	// get the prioritized culture name list
-	FCultureRef CurrentCulture = FInternationalization::Get().GetCurrentCulture();
-	TArray<FString> CultureList = CurrentCulture->GetPrioritizedParentCultureNames();
+			return CustomJsonToken::ReadObjectMembers(Reader, MemberNotation, OutObject);
+		}
 
-	// try to follow the fall back chain that the engine uses
-	FString TextString;
-	for (const FString& CultureCode : CultureList)
-	{
-		if (Obj->TryGetStringField(CultureCode, TextString))
+		/** Skips whatever hasn't been read, leaving the reader on the value's last token. False on a syntax error. */
+		bool Finish()
 		{
-			TextOut = FText::FromString(TextString);
+			if (bConsumed)
+			{
+				return true;
+			}
+			bConsumed = true;
+
+			if (!bMembersStarted)
+			{
+				return CustomJsonToken::SkipValue(Reader, Notation);
+			}
+
+			while (MemberNotation != EJsonNotation::ObjectEnd)
+			{
+				if (!CustomJsonToken::SkipValue(Reader, MemberNotation) || !Reader.ReadNext(MemberNotation))
+				{
+					return false;
+				}
+			}
 			return true;
 		}
-	}
 
-	// try again but only search on the locale region (in the localized data). This is a common omission (i.e. en-US source text should be used if no en is defined)
-	for (const FString& LocaleToMatch : CultureList)
-	{
-		int32 SeparatorPos;
-		// only consider base language entries in culture chain (i.e. "en")
-		if (!LocaleToMatch.FindChar('-', SeparatorPos))
+	private:
+		bool StartMembers()
 		{
-			for (const auto& Pair : Obj->Values)
+			if (!bMembersStarted)
 			{
-				// only consider coupled entries now (base ones would have been matched on first path) (i.e. "en-US")
-				if (Pair.Key.FindChar('-', SeparatorPos))
-				{
-					if (Pair.Key.StartsWith(LocaleToMatch))
-					{
-						TextOut = FText::FromString(Pair.Value->AsString());
-						return true;
-					}
-				}
+				bMembersStarted = true;
+				return Reader.ReadNext(MemberNotation);
 			}
+			return true;
 		}
-	}
 
-	// no luck, is this possibly an unrelated json object?
-	return false;
-}
+		void LogTypeMismatch(const TCHAR* InTypeName) const
+		{
+			UE_LOG(LogJson, Error, TEXT("Json Value of type '%s' used as a '%s'."), CustomJsonToken::NotationToString(Notation), InTypeName);
+		}
 
+		CustomJsonToken::FReader& Reader;
+		const EJsonNotation Notation;
 
-namespace
-{
-	bool JsonValueToFPropertyWithContainer(const TSharedPtr<FJsonValue>& JsonValue, FProperty* Property, void* OutValue, const UStruct* ContainerStruct, void* Container, int64 CheckFlags, int64 SkipFlags);
-	bool JsonAttributesToUStructWithContainer(const TMap< FString, TSharedPtr<FJsonValue> >& JsonAttributes, const UStruct* StructDefinition, void* OutStruct, const UStruct* ContainerStruct, void* Container, int64 CheckFlags, int64 SkipFlags);
+		// The token of the object member being read, once the object has been started
+		EJsonNotation MemberNotation = EJsonNotation::Error;
+		bool bMembersStarted = false;
+		bool bConsumed = false;
+	};
+
+	template<typename ValueSourceType>
+	bool JsonValueToFPropertyWithContainer(ValueSourceType& JsonValue, FProperty* Property, void* OutValue, const UStruct* ContainerStruct, void* Container, int64 CheckFlags, int64 SkipFlags);
+
+	template<typename ValueSourceType>
+	bool JsonMembersToUStructWithContainer(ValueSourceType& JsonObject, const UStruct* StructDefinition, void* OutStruct, const UStruct* ContainerStruct, void* Container, int64 CheckFlags, int64 SkipFlags);
 
 	/** Convert JSON to property, assuming either the property is not an array or the value is an individual array element */
-	bool ConvertScalarJsonValueToFPropertyWithContainer(const TSharedPtr<FJsonValue>& JsonValue, FProperty* Property, void* OutValue, const UStruct* ContainerStruct, void* Container, int64 CheckFlags, int64 SkipFlags)
+	template<typename ValueSourceType>
+	bool ConvertScalarJsonValueToFPropertyWithContainer(ValueSourceType& JsonValue, FProperty* Property, void* OutValue, const UStruct* ContainerStruct, void* Container, int64 CheckFlags, int64 SkipFlags)
 	{
+		const EJson JsonType = JsonValue.GetType();
+
 		if (FEnumProperty* EnumProperty = CastField<FEnumProperty>(Property))
 		{
-			if (JsonValue->Type == EJson::String)
+			if (JsonType == EJson::String)
 			{
 				// see if we were passed a string for the enum
 				const UEnum* Enum = EnumProperty->GetEnum();
 				check(Enum);
-				FString StrValue = JsonValue->AsString();
+				FString StrValue = JsonValue.AsString();
 				int64 IntValue = Enum->GetValueByName(FName(*StrValue));
 				if (IntValue == INDEX_NONE)
 				{
@@ -389,17 +1064,17 @@ namespace
 			else
 			{
 				// AsNumber will log an error for completely inappropriate types (then give us a default)
-				EnumProperty->GetUnderlyingProperty()->SetIntPropertyValue(OutValue, (int64)JsonValue->AsNumber());
+				EnumProperty->GetUnderlyingProperty()->SetIntPropertyValue(OutValue, (int64)JsonValue.AsNumber());
 			}
 		}
 		else if (FNumericProperty* NumericProperty = CastField<FNumericProperty>(Property))
 		{
-			if (NumericProperty->IsEnum() && JsonValue->Type == EJson::String)
+			if (NumericProperty->IsEnum() && JsonType == EJson::String)
 			{
 				// see if we were passed a string for the enum
 				const UEnum* Enum = NumericProperty->GetIntPropertyEnum();
 				check(Enum); // should be assured by IsEnum()
-				FString StrValue = JsonValue->AsString();
+				FString StrValue = JsonValue.AsString();
 				int64 IntValue = Enum->GetValueByName(FName(*StrValue),EGetByNameFlags::CheckAuthoredName);
 
 				if (IntValue == INDEX_NONE)
@@ -412,20 +1087,11 @@ namespace
 			else if (NumericProperty->IsFloatingPoint())
 			{
 				// AsNumber will log an error for completely inappropriate types (then give us a default)
-				NumericProperty->SetFloatingPointPropertyValue(OutValue, JsonValue->AsNumber());
+				NumericProperty->SetFloatingPointPropertyValue(OutValue, JsonValue.AsNumber());
 			}
 			else if (NumericProperty->IsInteger())
 			{
-				if (JsonValue->Type == EJson::String)
-				{
-					// parse string -> int64 ourselves so we don't lose any precision going through AsNumber (aka double)
-					NumericProperty->SetIntPropertyValue(OutValue, FCString::Atoi64(*JsonValue->AsString()));
-				}
-				else
-				{
-					// AsNumber will log an error for completely inappropriate types (then give us a default)
-					NumericProperty->SetIntPropertyValue(OutValue, (int64)JsonValue->AsNumber());
-				}
+				NumericProperty->SetIntPropertyValue(OutValue, JsonValue.AsInt64());
 			}
 			else
 			{
@@ -436,132 +1102,147 @@ namespace
 		else if (FBoolProperty* BoolProperty = CastField<FBoolProperty>(Property))
 		{
 			// AsBool will log an error for completely inappropriate types (then give us a default)
-			BoolProperty->SetPropertyValue(OutValue, JsonValue->AsBool());
+			BoolProperty->SetPropertyValue(OutValue, JsonValue.AsBool());
 		}
 		else if (FStrProperty* StringProperty = CastField<FStrProperty>(Property))
 		{
 			// AsString will log an error for completely inappropriate types (then give us a default)
-			StringProperty->SetPropertyValue(OutValue, JsonValue->AsString());
+			StringProperty->SetPropertyValue(OutValue, JsonValue.AsString());
 		}
 		else if (FArrayProperty* ArrayProperty = CastField<FArrayProperty>(Property))
 		{
-			if (JsonValue->Type == EJson::Array)
+			if (JsonType != EJson::Array)
 			{
-				TArray< TSharedPtr<FJsonValue> > ArrayValue = JsonValue->AsArray();
-				int32 ArrLen = ArrayValue.Num();
+				UE_LOG(LogJson, Error, TEXT("JsonValueToUProperty - Attempted to import TArray from non-array JSON key for property %s"), *Property->GetNameCPP());
+				return false;
+			}
 
-				// make the output array size match
-				FScriptArrayHelper Helper(ArrayProperty, OutValue);
-				Helper.Resize(ArrLen);
+			// Elements that are already there are read over, as they would be after a Resize
+			FScriptArrayHelper Helper(ArrayProperty, OutValue);
+			int32 ArrLen = 0;
+			const bool bReadAll = JsonValue.ForEachElement([&](ValueSourceType& ArrayValueItem)
+			{
+				if (ArrLen >= Helper.Num())
+				{
+					Helper.AddValue();
+				}
 
-				// set the property values
-				for (int32 i = 0; i < ArrLen; ++i)
+				if (!ArrayValueItem.IsNull() && !JsonValueToFPropertyWithContainer(ArrayValueItem, ArrayProperty->Inner, Helper.GetRawPtr(ArrLen), ContainerStruct, Container, CheckFlags & (~CPF_ParmFlags), SkipFlags))
 				{
-					const TSharedPtr<FJsonValue>& ArrayValueItem = ArrayValue[i];
-					if (ArrayValueItem.IsValid() && !ArrayValueItem->IsNull())
-					{
-						if (!JsonValueToFPropertyWithContainer(ArrayValueItem, ArrayProperty->Inner, Helper.GetRawPtr(i), ContainerStruct, Container, CheckFlags & (~CPF_ParmFlags), SkipFlags))
-						{
-							UE_LOG(LogJson, Error, TEXT("JsonValueToUProperty - Unable to deserialize array element [%d] for property %s"), i, *Property->GetNameCPP());
-							return false;
-						}
-					}
+					UE_LOG(LogJson, Error, TEXT("JsonValueToUProperty - Unable to deserialize array element [%d] for property %s"), ArrLen, *Property->GetNameCPP());
+					return false;
 				}
-			}
-			else
+
+				++ArrLen;
+				return true;
+			});
+
+			if (!bReadAll)
 			{
-				UE_LOG(LogJson, Error, TEXT("JsonValueToUProperty - Attempted to import TArray from non-array JSON key for property %s"), *Property->GetNameCPP());
 				return false;
 			}
+			Helper.Resize(ArrLen);
 		}
 		else if (FMapProperty* MapProperty = CastField<FMapProperty>(Property))
 		{
-			if (JsonValue->Type == EJson::Object)
+			if (JsonType != EJson::Object)
 			{
-				TSharedPtr<FJsonObject> ObjectValue = JsonValue->AsObject();
-
-				FScriptMapHelper Helper(MapProperty, OutValue);
-
-				check(ObjectValue);
+				UE_LOG(LogJson, Error, TEXT("JsonValueToUProperty - Attempted to import TMap from non-object JSON key for property %s"), *Property->GetNameCPP());
+				return false;
+			}
 
-				int32 MapSize = ObjectValue->Values.Num();
-				Helper.EmptyValues(MapSize);
+			FScriptMapHelper Helper(MapProperty, OutValue);
+			Helper.EmptyValues();
 
-				// set the property values
-				for (const auto& Entry : ObjectValue->Values)
+			// set the property values
+			const bool bReadAll = JsonValue.ForEachMember([&](const FString& InKey, ValueSourceType& EntryValue)
+			{
+				if (EntryValue.IsNull())
 				{
-					if (Entry.Value.IsValid() && !Entry.Value->IsNull())
-					{
-						int32 NewIndex = Helper.AddDefaultValue_Invalid_NeedsRehash();
+					return true;
+				}
 
-						TSharedPtr<FJsonValueString> TempKeyValue = MakeShared<FJsonValueString>(Entry.Key);
+				int32 NewIndex = Helper.AddDefaultValue_Invalid_NeedsRehash();
 
-						const bool bKeySuccess = JsonValueToFPropertyWithContainer(TempKeyValue, MapProperty->KeyProp, Helper.GetKeyPtr(NewIndex), ContainerStruct, Container, CheckFlags & (~CPF_ParmFlags), SkipFlags);
-						const bool bValueSuccess = JsonValueToFPropertyWithContainer(Entry.Value, MapProperty->ValueProp, Helper.GetValuePtr(NewIndex), ContainerStruct, Container, CheckFlags & (~CPF_ParmFlags), SkipFlags);
+				// Keys are always strings, so they go through the same conversion as a string value would
+				const FString Key = InKey;
+				const FJsonValueString KeyValue(Key);
+				FJsonDomValueSource KeySource(&KeyValue);
 
-						if (!(bKeySuccess && bValueSuccess))
-						{
-							UE_LOG(LogJson, Error, TEXT("JsonValueToUProperty - Unable to deserialize map element [key: %s] for property %s"), *Entry.Key, *Property->GetNameCPP());
-							return false;
-						}
-					}
+				const bool bKeySuccess = JsonValueToFPropertyWithContainer(KeySource, MapProperty->KeyProp, Helper.GetKeyPtr(NewIndex), ContainerStruct, Container, CheckFlags & (~CPF_ParmFlags), SkipFlags);
+				const bool bValueSuccess = bKeySuccess && JsonValueToFPropertyWithContainer(EntryValue, MapProperty->ValueProp, Helper.GetValuePtr(NewIndex), ContainerStruct, Container, CheckFlags & (~CPF_ParmFlags), SkipFlags);
+
+				if (!(bKeySuccess && bValueSuccess))
+				{
+					UE_LOG(LogJson, Error, TEXT("JsonValueToUProperty - Unable to deserialize map element [key: %s] for property %s"), *Key, *Property->GetNameCPP());
+					return false;
 				}
+				return true;
+			});
 
-				Helper.Rehash();
-			}
-			else
+			if (!bReadAll)
 			{
-				UE_LOG(LogJson, Error, TEXT("JsonValueToUProperty - Attempted to import TMap from non-object JSON key for property %s"), *Property->GetNameCPP());
 				return false;
 			}
+			Helper.Rehash();
 		}
 		else if (FSetProperty* SetProperty = CastField<FSetProperty>(Property))
 		{
-			if (JsonValue->Type == EJson::Array)
+			if (JsonType != EJson::Array)
 			{
-				TArray< TSharedPtr<FJsonValue> > ArrayValue = JsonValue->AsArray();
-				int32 ArrLen = ArrayValue.Num();
+				UE_LOG(LogJson, Error, TEXT("JsonValueToUProperty - Attempted to import TSet from non-array JSON key for property %s"), *Property->GetNameCPP());
+				return false;
+			}
 
-				FScriptSetHelper Helper(SetProperty, OutValue);
+			FScriptSetHelper Helper(SetProperty, OutValue);
 
-				// set the property values
-				for (int32 i = 0; i < ArrLen; ++i)
+			// set the property values
+			int32 ElementIndex = 0;
+			const bool bReadAll = JsonValue.ForEachElement([&](ValueSourceType& ArrayValueItem)
+			{
+				if (!ArrayValueItem.IsNull())
 				{
-					const TSharedPtr<FJsonValue>& ArrayValueItem = ArrayValue[i];
-					if (ArrayValueItem.IsValid() && !ArrayValueItem->IsNull())
+					int32 NewIndex = Helper.AddDefaultValue_Invalid_NeedsRehash();
+					if (!JsonValueToFPropertyWithContainer(ArrayValueItem, SetProperty->ElementProp, Helper.GetElementPtr(NewIndex), ContainerStruct, Container, CheckFlags & (~CPF_ParmFlags), SkipFlags))
 					{
-						int32 NewIndex = Helper.AddDefaultValue_Invalid_NeedsRehash();
-						if (!JsonValueToFPropertyWithContainer(ArrayValueItem, SetProperty->ElementProp, Helper.GetElementPtr(NewIndex), ContainerStruct, Container, CheckFlags & (~CPF_ParmFlags), SkipFlags))
-						{
-							UE_LOG(LogJson, Error, TEXT("JsonValueToUProperty - Unable to deserialize set element [%d] for property %s"), i, *Property->GetNameCPP());
-							return false;
-						}
+						UE_LOG(LogJson, Error, TEXT("JsonValueToUProperty - Unable to deserialize set element [%d] for property %s"), ElementIndex, *Property->GetNameCPP());
+						return false;
 					}
 				}
 
-				Helper.Rehash();
-			}
-			else
+				++ElementIndex;
+				return true;
+			});
+
+			if (!bReadAll)
 			{
-				UE_LOG(LogJson, Error, TEXT("JsonValueToUProperty - Attempted to import TSet from non-array JSON key for property %s"), *Property->GetNameCPP());
 				return false;
 			}
+			Helper.Rehash();
 		}
 		else if (FTextProperty* TextProperty = CastField<FTextProperty>(Property))
 		{
-			if (JsonValue->Type == EJson::String)
+			if (JsonType == EJson::String)
 			{
 				// assume this string is already localized, so import as invariant
-				TextProperty->SetPropertyValue(OutValue, FText::FromString(JsonValue->AsString()));
+				TextProperty->SetPropertyValue(OutValue, FText::FromString(JsonValue.AsString()));
 			}
-			else if (JsonValue->Type == EJson::Object)
+			else if (JsonType == EJson::Object)
 			{
-				TSharedPtr<FJsonObject> Obj = JsonValue->AsObject();
-				check(Obj.IsValid()); // should not fail if Type == EJson::Object
-
 				// import the subvalue as a culture invariant string
+				TMap<FString, FString> CultureStrings;
+				const bool bReadAll = JsonValue.ForEachMember([&CultureStrings](const FString& CultureCode, ValueSourceType& TextValue)
+				{
+					FString TextString;
+					if (TextValue.TryGetString(TextString))
+					{
+						CultureStrings.Add(CultureCode, MoveTemp(TextString));
+					}
+					return true;
+				});
+
 				FText Text;
-				if (!CustomJsonConverter::GetTextFromObject(Obj.ToSharedRef(), Text))
+				if (!bReadAll || !GetTextFromCultureStrings(CultureStrings, Text))
 				{
 					UE_LOG(LogJson, Error, TEXT("JsonValueToUProperty - Attempted to import FText from JSON object with invalid keys for property %s"), *Property->GetNameCPP());
 					return false;
@@ -576,39 +1257,38 @@ namespace
 		}
 		else if (FStructProperty* StructProperty = CastField<FStructProperty>(Property))
 		{
-		static const FName NAME_DateTimeY(TEXT("DateTime"));
-		static const FName NAME_ColorY(TEXT("Color"));
-		static const FName NAME_LinearColorY(TEXT("LinearColor"));
-			if (JsonValue->Type == EJson::Object)
+			static const FName NAME_DateTimeY(TEXT("DateTime"));
+			static const FName NAME_ColorY(TEXT("Color"));
+			static const FName NAME_LinearColorY(TEXT("LinearColor"));
+
+			if (JsonType == EJson::Object)
 			{
-				TSharedPtr<FJsonObject> Obj = JsonValue->AsObject();
-				check(Obj.IsValid()); // should not fail if Type == EJson::Object
-				if (!JsonAttributesToUStructWithContainer(Obj->Values, StructProperty->Struct, OutValue, ContainerStruct, Container, CheckFlags & (~CPF_ParmFlags), SkipFlags))
+				if (!JsonMembersToUStructWithContainer(JsonValue, StructProperty->Struct, OutValue, ContainerStruct, Container, CheckFlags & (~CPF_ParmFlags), SkipFlags))
 				{
 					UE_LOG(LogJson, Error, TEXT("JsonValueToUProperty - TestJsonConverter::JsonObjectToUStruct failed for property %s"), *Property->GetNameCPP());
 					return false;
 				}
 			}
-			else if (JsonValue->Type == EJson::String && StructProperty->Struct->GetFName() == NAME_LinearColorY)
+			else if (JsonType == EJson::String && StructProperty->Struct->GetFName() == NAME_LinearColorY)
 			{
 				FLinearColor& ColorOut = *(FLinearColor*)OutValue;
-				FString ColorString = JsonValue->AsString();
+				FString ColorString = JsonValue.AsString();
 
 				FColor IntermediateColor;
 				IntermediateColor = FColor::FromHex(ColorString);
 
 				ColorOut = IntermediateColor;
 			}
-			else if (JsonValue->Type == EJson::String && StructProperty->Struct->GetFName() == NAME_ColorY)
+			else if (JsonType == EJson::String && StructProperty->Struct->GetFName() == NAME_ColorY)
 			{
 				FColor& ColorOut = *(FColor*)OutValue;
-				FString ColorString = JsonValue->AsString();
+				FString ColorString = JsonValue.AsString();
 
 				ColorOut = FColor::FromHex(ColorString);
 			}
-			else if (JsonValue->Type == EJson::String && StructProperty->Struct->GetFName() == NAME_DateTimeY)
+			else if (JsonType == EJson::String && StructProperty->Struct->GetFName() == NAME_DateTimeY)
 			{
-				FString DateString = JsonValue->AsString();
+				FString DateString = JsonValue.AsString();
 				FDateTime& DateTimeOut = *(FDateTime*)OutValue;
 				if (DateString == TEXT("min"))
 				{
@@ -639,11 +1319,11 @@ namespace
 					return false;
 				}
 			}
-			else if (JsonValue->Type == EJson::String && StructProperty->Struct->GetCppStructOps() && StructProperty->Struct->GetCppStructOps()->HasImportTextItem())
+			else if (JsonType == EJson::String && StructProperty->Struct->GetCppStructOps() && StructProperty->Struct->GetCppStructOps()->HasImportTextItem())
 			{
 				UScriptStruct::ICppStructOps* TheCppStructOps = StructProperty->Struct->GetCppStructOps();
 
-				FString ImportTextString = JsonValue->AsString();
+				FString ImportTextString = JsonValue.AsString();
 				const TCHAR* ImportTextPtr = *ImportTextString;
 				if (!TheCppStructOps->ImportTextItem(ImportTextPtr, OutValue, PPF_None, nullptr, (FOutputDevice*)GWarn))
 				{
@@ -651,9 +1331,9 @@ namespace
 					Property->ImportText_Direct(ImportTextPtr, OutValue, nullptr, PPF_None);
 				}
 			}
-			else if (JsonValue->Type == EJson::String)
+			else if (JsonType == EJson::String)
 			{
-				FString ImportTextString = JsonValue->AsString();
+				FString ImportTextString = JsonValue.AsString();
 				const TCHAR* ImportTextPtr = *ImportTextString;
 				Property->ImportText_Direct(ImportTextPtr, OutValue, nullptr, PPF_None);
 			}
@@ -665,20 +1345,22 @@ namespace
 		}
 		else if (FObjectProperty* ObjectProperty = CastField<FObjectProperty>(Property))
 		{
-			if (JsonValue->Type == EJson::Object)
+			if (JsonType == EJson::Object)
 			{
 				UObject* Outer = GetTransientPackage();
-				if (ContainerStruct->IsChildOf(UObject::StaticClass()))
+				if (ContainerStruct && ContainerStruct->IsChildOf(UObject::StaticClass()))
 				{
 					Outer = (UObject*)Container;
 				}
 
-				TSharedPtr<FJsonObject> Obj = JsonValue->AsObject();
 				UClass* PropertyClass = ObjectProperty->PropertyClass;
 
 				// If a specific subclass was stored in the Json, use that instead of the PropertyClass
-				FString ClassString = Obj->GetStringField(ObjectClassNameKey);
-				Obj->RemoveField(ObjectClassNameKey);
+				FString ClassString;
+				if (!JsonValue.ReadObjectClassName(ClassString))
+				{
+					return false;
+				}
 				if (!ClassString.IsEmpty())
 				{
 					UClass* FoundClass = FPackageName::IsShortPackageName(ClassString) ? FindFirstObject<UClass>(*ClassString) : UClass::TryFindTypeSlow<UClass>(ClassString);
@@ -690,20 +1372,19 @@ namespace
 
 				UObject* createdObj = StaticAllocateObject(PropertyClass, Outer, NAME_None, EObjectFlags::RF_NoFlags, EInternalObjectFlags::None, false);
 				(*PropertyClass->ClassConstructor)(FObjectInitializer(createdObj, PropertyClass->ClassDefaultObject, EObjectInitializerOptions::None));
-				
+
 				ObjectProperty->SetObjectPropertyValue(OutValue, createdObj);
 
-				check(Obj.IsValid()); // should not fail if Type == EJson::Object
-				if (!JsonAttributesToUStructWithContainer(Obj->Values, PropertyClass, createdObj, PropertyClass, createdObj, CheckFlags & (~CPF_ParmFlags), SkipFlags))
+				if (!JsonMembersToUStructWithContainer(JsonValue, PropertyClass, createdObj, PropertyClass, createdObj, CheckFlags & (~CPF_ParmFlags), SkipFlags))
 				{
 					UE_LOG(LogJson, Error, TEXT("JsonValueToUProperty - TestJsonConverter::JsonObjectToUStruct failed for property %s"), *Property->GetNameCPP());
 					return false;
 				}
 			}
-			else if (JsonValue->Type == EJson::String)
+			else if (JsonType == EJson::String)
 			{
 				// Default to expect a string for everything else
-				if (Property->ImportText_Direct(*JsonValue->AsString(), OutValue, nullptr, EPropertyPortFlags::PPF_None) == NULL)
+				if (Property->ImportText_Direct(*JsonValue.AsString(), OutValue, nullptr, EPropertyPortFlags::PPF_None) == NULL)
 				{
 					UE_LOG(LogJson, Error, TEXT("JsonValueToUProperty - Unable import property type %s from string value for property %s"), *Property->GetClass()->GetName(), *Property->GetNameCPP());
 					return false;
@@ -713,7 +1394,7 @@ namespace
 		else
 		{
 			// Default to expect a string for everything else
-			if (Property->ImportText_Direct(*JsonValue->AsString(), OutValue, nullptr, EPropertyPortFlags::PPF_None) == NULL)
+			if (Property->ImportText_Direct(*JsonValue.AsString(), OutValue, nullptr, EPropertyPortFlags::PPF_None) == NULL)
 			{
 				UE_LOG(LogJson, Error, TEXT("JsonValueToUProperty - Unable import property type %s from string value for property %s"), *Property->GetClass()->GetName(), *Property->GetNameCPP());
 				return false;
@@ -723,17 +1404,11 @@ namespace
 		return true;
 	}
 
-
-	bool JsonValueToFPropertyWithContainer(const TSharedPtr<FJsonValue>& JsonValue, FProperty* Property, void* OutValue, const UStruct* ContainerStruct, void* Container, int64 CheckFlags, int64 SkipFlags)
+	template<typename ValueSourceType>
+	bool JsonValueToFPropertyWithContainer(ValueSourceType& JsonValue, FProperty* Property, void* OutValue, const UStruct* ContainerStruct, void* Container, int64 CheckFlags, int64 SkipFlags)
 	{
-		if (!JsonValue.IsValid())
-		{
-			UE_LOG(LogJson, Error, TEXT("JsonValueToUProperty - Invalid value JSON key"));
-			return false;
-		}
-
 		bool bArrayOrSetProperty = Property->IsA<FArrayProperty>() || Property->IsA<FSetProperty>();
-		bool bJsonArray = JsonValue->Type == EJson::Array;
+		bool bJsonArray = JsonValue.GetType() == EJson::Array;
 
 		if (!bJsonArray)
 		{
@@ -758,90 +1433,74 @@ namespace
 			return ConvertScalarJsonValueToFPropertyWithContainer(JsonValue, Property, OutValue, ContainerStruct, Container, CheckFlags, SkipFlags);
 		}
 
-		// We're deserializing a JSON array
-		const auto& ArrayValue = JsonValue->AsArray();
-		if (Property->ArrayDim < ArrayValue.Num())
-		{
-			UE_LOG(LogJson, Warning, TEXT("Ignoring excess properties when deserializing %s"), *Property->GetName());
-		}
-
 		// Read into native array
-		int ItemsToRead = FMath::Clamp(ArrayValue.Num(), 0, Property->ArrayDim);
-		for (int Index = 0; Index != ItemsToRead; ++Index)
+		int32 Index = 0;
+		return JsonValue.ForEachElement([&](ValueSourceType& ArrayValueItem)
 		{
-			if (!ConvertScalarJsonValueToFPropertyWithContainer(ArrayValue[Index], Property, (char*)OutValue + Index * Property->ElementSize, ContainerStruct, Container, CheckFlags, SkipFlags))
+			if (Index < Property->ArrayDim)
 			{
-				return false;
+				if (!ConvertScalarJsonValueToFPropertyWithContainer(ArrayValueItem, Property, (char*)OutValue + Index * Property->ElementSize, ContainerStruct, Container, CheckFlags, SkipFlags))
+				{
+					return false;
+				}
 			}
-		}
-		return true;
+			else if (Index == Property->ArrayDim)
+			{
+				UE_LOG(LogJson, Warning, TEXT("Ignoring excess properties when deserializing %s"), *Property->GetName());
+			}
+
+			++Index;
+			return true;
+		});
 	}
 
-	bool JsonAttributesToUStructWithContainer(const TMap< FString, TSharedPtr<FJsonValue> >& JsonAttributes, const UStruct* StructDefinition, void* OutStruct, const UStruct* ContainerStruct, void* Container, int64 CheckFlags, int64 SkipFlags)
+	template<typename ValueSourceType>
+	bool JsonMembersToUStructWithContainer(ValueSourceType& JsonObject, const UStruct* StructDefinition, void* OutStruct, const UStruct* ContainerStruct, void* Container, int64 CheckFlags, int64 SkipFlags)
 	{
 		if (StructDefinition == FJsonObjectWrapper::StaticStruct())
 		{
 			// Just copy it into the object
 			FJsonObjectWrapper* ProxyObject = (FJsonObjectWrapper*)OutStruct;
 			ProxyObject->JsonObject = MakeShared<FJsonObject>();
-			ProxyObject->JsonObject->Values = JsonAttributes;
-			return true;
+			return JsonObject.CopyMembersTo(*ProxyObject->JsonObject);
 		}
 
-		int32 NumUnclaimedProperties = JsonAttributes.Num();
-		if (NumUnclaimedProperties <= 0)
-		{
-			return true;
-		}
+		const TSharedRef<const FCustomStructDescriptor> Descriptor = CustomStructDescriptorCache::Get(StructDefinition);
 
-		// iterate over the struct properties
-		for (TFieldIterator<FProperty> PropIt(StructDefinition); PropIt; ++PropIt)
+		return JsonObject.ForEachMember([&](const FString& Key, ValueSourceType& JsonValue)
 		{
-			FProperty* Property = *PropIt;
-
-			// Check to see if we should ignore this property
-			if (CheckFlags != 0 && !Property->HasAnyPropertyFlags(CheckFlags))
-			{
-				continue;
-			}
-			if (Property->HasAnyPropertyFlags(SkipFlags))
-			{
-				continue;
-			}
-
-			// find a json value matching this property name
-			//const TSharedPtr<FJsonValue>* JsonValue = JsonAttributes.Find(Property->GetName());
-			const TSharedPtr<FJsonValue>* JsonValue = JsonAttributes.Find(Property->GetAuthoredName());
-			if (!JsonValue)
-			{
-				// we allow values to not be found since this mirrors the typical UObject mantra that all the fields are optional when deserializing
-				continue;
-			}
-
-			if (JsonValue->IsValid() && !(*JsonValue)->IsNull())
+			// find the property this json value is named for
+			const int32* FieldIdx = Descriptor->FieldsByName.Find(Key);
+			const FCustomStructDescriptor::FField* Field = FieldIdx ? &Descriptor->Fields[*FieldIdx] : nullptr;
+			FProperty* Property = Field ? Field->Property : nullptr;
+
+			// Unknown keys, ignored properties and nulls are passed over. We allow values to not be found since this mirrors
+			// the typical UObject mantra that all the fields are optional when deserializing.
+			if (!Property || (CheckFlags != 0 && !Property->HasAnyPropertyFlags(CheckFlags)) || Property->HasAnyPropertyFlags(SkipFlags) || JsonValue.IsNull())
 			{
-				void* Value = Property->ContainerPtrToValuePtr<uint8>(OutStruct);
-				if (!JsonValueToFPropertyWithContainer(*JsonValue, Property, Value, ContainerStruct, Container, CheckFlags, SkipFlags))
-				{
-					UE_LOG(LogJson, Error, TEXT("JsonObjectToUStruct - Unable to parse %s.%s from JSON"), *StructDefinition->GetName(), *Property->GetName());
-					return false;
-				}
+				return true;
 			}
 
-			if (--NumUnclaimedProperties <= 0)
+			if (!JsonValueToFPropertyWithContainer(JsonValue, Property, Field->GetValuePtr(OutStruct), ContainerStruct, Container, CheckFlags, SkipFlags))
 			{
-				// If we found all properties that were in the JsonAttributes map, there is no reason to keep looking for more.
-				break;
+				UE_LOG(LogJson, Error, TEXT("JsonObjectToUStruct - Unable to parse %s.%s from JSON"), *StructDefinition->GetName(), *Property->GetName());
+				return false;
 			}
-		}
-
-		return true;
+			return true;
+		});
 	}
 }
 
 bool CustomJsonConverter::JsonValueToUProperty(const TSharedPtr<FJsonValue>& JsonValue, FProperty* Property, void* OutValue, int64 CheckFlags, int64 SkipFlags)
 {
-	return JsonValueToFPropertyWithContainer(JsonValue, Property, OutValue, nullptr, nullptr, CheckFlags, SkipFlags);
+	if (!JsonValue.IsValid())
+	{
+		UE_LOG(LogJson, Error, TEXT("JsonValueToUProperty - Invalid value JSON key"));
+		return false;
+	}
+
+	FJsonDomValueSource Source(JsonValue.Get());
+	return JsonValueToFPropertyWithContainer(Source, Property, OutValue, nullptr, nullptr, CheckFlags, SkipFlags);
 }
 
 bool CustomJsonConverter::JsonObjectToUStruct(const TSharedRef<FJsonObject>& JsonObject, const UStruct* StructDefinition, void* OutStruct, int64 CheckFlags, int64 SkipFlags)
@@ -851,7 +1510,73 @@ bool CustomJsonConverter::JsonObjectToUStruct(const TSharedRef<FJsonObject>& Jso
 
 bool CustomJsonConverter::JsonAttributesToUStruct(const TMap< FString, TSharedPtr<FJsonValue> >& JsonAttributes, const UStruct* StructDefinition, void* OutStruct, int64 CheckFlags, int64 SkipFlags)
 {
-	return JsonAttributesToUStructWithContainer(JsonAttributes, StructDefinition, OutStruct, StructDefinition, OutStruct, CheckFlags, SkipFlags);
+	FJsonDomValueSource Source(JsonAttributes);
+	return JsonMembersToUStructWithContainer(Source, StructDefinition, OutStruct, StructDefinition, OutStruct, CheckFlags, SkipFlags);
+}
+
+bool CustomJsonConverter::JsonObjectStringToUStruct(const FString& JsonString, const UStruct* StructDefinition, void* OutStruct, int64 CheckFlags, int64 SkipFlags)
+{
+	TSharedRef<TJsonReader<> > JsonReader = TJsonReaderFactory<>::Create(JsonString);
+
+	EJsonNotation Notation = EJsonNotation::Error;
+	if (!JsonReader->ReadNext(Notation) || Notation != EJsonNotation::ObjectStart)
+	{
+		UE_LOG(LogJson, Warning, TEXT("JsonObjectStringToUStruct - Unable to parse json=[%s]"), *JsonString);
+		return false;
+	}
+
+	FJsonTokenValueSource Source(*JsonReader, Notation);
+	if (!JsonMembersToUStructWithContainer(Source, StructDefinition, OutStruct, StructDefinition, OutStruct, CheckFlags, SkipFlags))
+	{
+		if (!JsonReader->GetErrorMessage().IsEmpty())
+		{
+			UE_LOG(LogJson, Warning, TEXT("JsonObjectStringToUStruct - Unable to parse json=[%s]"), *JsonString);
+		}
+		else
+		{
+			UE_LOG(LogJson, Warning, TEXT("JsonObjectStringToUStruct - Unable to deserialize. json=[%s]"), *JsonString);
+		}
+		return false;
+	}
+	return true;
+}
+
+bool CustomJsonConverter::JsonArrayStringToUStruct(const FString& JsonString, const UStruct* ElementDefinition, TFunctionRef<void*()> AddElement, int64 CheckFlags, int64 SkipFlags)
+{
+	TSharedRef<TJsonReader<> > JsonReader = TJsonReaderFactory<>::Create(JsonString);
+
+	EJsonNotation Notation = EJsonNotation::Error;
+	if (!JsonReader->ReadNext(Notation) || Notation != EJsonNotation::ArrayStart)
+	{
+		UE_LOG(LogJson, Warning, TEXT("JsonArrayStringToUStruct - Unable to parse. json=[%s]"), *JsonString);
+		return false;
+	}
+
+	int32 i = 0;
+	while (JsonReader->ReadNext(Notation) && Notation != EJsonNotation::ArrayEnd)
+	{
+		if (Notation != EJsonNotation::ObjectStart)
+		{
+			UE_LOG(LogJson, Warning, TEXT("JsonArrayToUStruct - Array element [%i] was not an object."), i);
+			return false;
+		}
+
+		void* OutElement = AddElement();
+		FJsonTokenValueSource Source(*JsonReader, Notation);
+		if (!JsonMembersToUStructWithContainer(Source, ElementDefinition, OutElement, ElementDefinition, OutElement, CheckFlags, SkipFlags) || !Source.Finish())
+		{
+			UE_LOG(LogJson, Warning, TEXT("JsonArrayToUStruct - Unable to convert element [%i]."), i);
+			return false;
+		}
+		++i;
+	}
+
+	if (Notation != EJsonNotation::ArrayEnd)
+	{
+		UE_LOG(LogJson, Warning, TEXT("JsonArrayStringToUStruct - Unable to parse. json=[%s]"), *JsonString);
+		return false;
+	}
+	return true;
 }
 
 //static 
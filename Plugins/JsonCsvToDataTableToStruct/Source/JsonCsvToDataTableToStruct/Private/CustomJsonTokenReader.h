@@ -0,0 +1,217 @@
+/************************************************************************/
+/* Author: YWT20                                                        */
+/* Expected release year : 2021                                         */
+/************************************************************************/
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonObject.h"
+#include "Dom/JsonValue.h"
+#include "Serialization/JsonReader.h"
+
+/**
+ * Helpers for reading values straight off TJsonReader tokens, so that importers can write into UStructs without building
+ * FJsonObject/FJsonValue trees first. A value is identified by the notation of its first token; anything that takes that
+ * notation and returns is expected to have consumed the whole value.
+ * The TryGet functions convert between scalar types the way the matching FJsonValue::TryGet functions do.
+ */
+namespace CustomJsonToken
+{
+	typedef TJsonReader<TCHAR> FReader;
+
+	inline const TCHAR* NotationToString(const EJsonNotation Notation)
+	{
+		switch (Notation)
+		{
+		case EJsonNotation::Null:
+			return TEXT("Null");
+		case EJsonNotation::String:
+			return TEXT("String");
+		case EJsonNotation::Number:
+			return TEXT("Number");
+		case EJsonNotation::Boolean:
+			return TEXT("Boolean");
+		case EJsonNotation::ArrayStart:
+			return TEXT("Array");
+		case EJsonNotation::ObjectStart:
+			return TEXT("Object");
+		default:
+			return TEXT("Unknown");
+		}
+	}
+
+	/** Consumes the rest of the value that started with Notation. False on a syntax error. */
+	inline bool SkipValue(FReader& Reader, const EJsonNotation Notation)
+	{
+		switch (Notation)
+		{
+		case EJsonNotation::ObjectStart:
+			return Reader.SkipObject();
+		case EJsonNotation::ArrayStart:
+			return Reader.SkipArray();
+		case EJsonNotation::Error:
+		case EJsonNotation::ObjectEnd:
+		case EJsonNotation::ArrayEnd:
+			return false;
+		default:
+			return true;
+		}
+	}
+
+	inline bool TryGetString(const FReader& Reader, const EJsonNotation Notation, FString& OutString)
+	{
+		switch (Notation)
+		{
+		case EJsonNotation::String:
+			OutString = Reader.GetValueAsString();
+			return true;
+		case EJsonNotation::Number:
+			// As written, rather than going through a double
+			OutString = Reader.GetValueAsNumberString();
+			return true;
+		case EJsonNotation::Boolean:
+			OutString = Reader.GetValueAsBoolean() ? TEXT("true") : TEXT("false");
+			return true;
+		default:
+			return false;
+		}
+	}
+
+	inline bool TryGetNumber(const FReader& Reader, const EJsonNotation Notation, double& OutNumber)
+	{
+		switch (Notation)
+		{
+		case EJsonNotation::Number:
+			OutNumber = Reader.GetValueAsNumber();
+			return true;
+		case EJsonNotation::String:
+			if (Reader.GetValueAsString().IsNumeric())
+			{
+				OutNumber = FCString::Atod(*Reader.GetValueAsString());
+				return true;
+			}
+			return false;
+		case EJsonNotation::Boolean:
+			OutNumber = Reader.GetValueAsBoolean() ? 1.0 : 0.0;
+			return true;
+		default:
+			return false;
+		}
+	}
+
+	inline bool TryGetNumber(const FReader& Reader, const EJsonNotation Notation, int64& OutNumber)
+	{
+		// Whole numbers are parsed from their text so that large values keep their precision
+		if (Notation == EJsonNotation::Number || Notation == EJsonNotation::String)
+		{
+			const FString& NumberString = Notation == EJsonNotation::Number ? Reader.GetValueAsNumberString() : Reader.GetValueAsString();
+			int32 Index = INDEX_NONE;
+			if (NumberString.IsNumeric() && !NumberString.FindChar(TEXT('.'), Index) && !NumberString.FindChar(TEXT('e'), Index) && !NumberString.FindChar(TEXT('E'), Index))
+			{
+				OutNumber = FCString::Atoi64(*NumberString);
+				return true;
+			}
+		}
+
+		double Number = 0.0;
+		if (!TryGetNumber(Reader, Notation, Number) || Number < (double)MIN_int64 || Number > (double)MAX_int64)
+		{
+			return false;
+		}
+
+		OutNumber = (int64)Number;
+		return true;
+	}
+
+	inline bool TryGetBool(const FReader& Reader, const EJsonNotation Notation, bool& OutBool)
+	{
+		switch (Notation)
+		{
+		case EJsonNotation::Boolean:
+			OutBool = Reader.GetValueAsBoolean();
+			return true;
+		case EJsonNotation::Number:
+			OutBool = Reader.GetValueAsNumber() != 0.0;
+			return true;
+		case EJsonNotation::String:
+			OutBool = Reader.GetValueAsString().ToBool();
+			return true;
+		default:
+			return false;
+		}
+	}
+
+	inline TSharedPtr<FJsonValue> ReadValue(FReader& Reader, const EJsonNotation Notation);
+
+	/**
+	 * Reads the members of an object into OutObject, for values that really are kept as JSON.
+	 * Notation is the token after the object's ObjectStart.
+	 */
+	inline bool ReadObjectMembers(FReader& Reader, EJsonNotation Notation, FJsonObject& OutObject)
+	{
+		while (Notation != EJsonNotation::ObjectEnd)
+		{
+			const FString Identifier = Reader.GetIdentifier();
+			TSharedPtr<FJsonValue> Value = ReadValue(Reader, Notation);
+			if (!Value.IsValid())
+			{
+				return false;
+			}
+			OutObject.SetField(Identifier, Value);
+
+			if (!Reader.ReadNext(Notation))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	/** Builds an FJsonValue for the value that started with Notation */
+	inline TSharedPtr<FJsonValue> ReadValue(FReader& Reader, const EJsonNotation Notation)
+	{
+		switch (Notation)
+		{
+		case EJsonNotation::Null:
+			return MakeShared<FJsonValueNull>();
+		case EJsonNotation::String:
+			return MakeShared<FJsonValueString>(Reader.GetValueAsString());
+		case EJsonNotation::Number:
+			return MakeShared<FJsonValueNumber>(Reader.GetValueAsNumber());
+		case EJsonNotation::Boolean:
+			return MakeShared<FJsonValueBoolean>(Reader.GetValueAsBoolean());
+		case EJsonNotation::ObjectStart:
+		{
+			TSharedRef<FJsonObject> Object = MakeShared<FJsonObject>();
+			EJsonNotation MemberNotation;
+			if (!Reader.ReadNext(MemberNotation) || !ReadObjectMembers(Reader, MemberNotation, *Object))
+			{
+				return TSharedPtr<FJsonValue>();
+			}
+			return MakeShared<FJsonValueObject>(Object);
+		}
+		case EJsonNotation::ArrayStart:
+		{
+			TArray<TSharedPtr<FJsonValue>> Array;
+			EJsonNotation ElementNotation;
+			while (Reader.ReadNext(ElementNotation))
+			{
+				if (ElementNotation == EJsonNotation::ArrayEnd)
+				{
+					return MakeShared<FJsonValueArray>(Array);
+				}
+
+				TSharedPtr<FJsonValue> Element = ReadValue(Reader, ElementNotation);
+				if (!Element.IsValid())
+				{
+					return TSharedPtr<FJsonValue>();
+				}
+				Array.Add(Element);
+			}
+			return TSharedPtr<FJsonValue>();
+		}
+		default:
+			return TSharedPtr<FJsonValue>();
+		}
+	}
+}
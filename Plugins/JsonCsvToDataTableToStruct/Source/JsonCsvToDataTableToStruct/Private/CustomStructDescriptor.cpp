@@ -0,0 +1,118 @@
+/************************************************************************/
+/* Author: YWT20                                                        */
+/* Expected release year : 2021                                         */
+/************************************************************************/
+
+#include "CustomStructDescriptor.h"
+#include "CustomJsonConverter.h"
+#include "DataTableUtils.h"
+#include "Engine/UserDefinedStruct.h"
+
+namespace
+{
+	// Structs are only looked up by a handful of tables and converters at a time, so this only guards against unbounded growth
+	constexpr int32 MaxCachedDescriptors = 64;
+
+	FCriticalSection DescriptorsLock;
+	TMap<const UStruct*, TSharedPtr<const FCustomStructDescriptor>> Descriptors;
+
+	TSharedRef<FCustomStructDescriptor> MakeDescriptor(const UStruct* InStruct)
+	{
+		TSharedRef<FCustomStructDescriptor> Descriptor = MakeShared<FCustomStructDescriptor>();
+		Descriptor->Struct = InStruct;
+
+		// The first property to claim a name keeps it
+		for (TFieldIterator<FProperty> PropIt(InStruct); PropIt; ++PropIt)
+		{
+			FProperty* Property = *PropIt;
+			const FString AuthoredName = Property->GetAuthoredName();
+			const TArray<FString> ImportNames = DataTableUtils::GetPropertyImportNames(Property);
+
+			const int32 FieldIdx = Descriptor->Fields.Add({ Property, AuthoredName, CustomJsonConverter::StandardizeCase(AuthoredName), DataTableUtils::GetPropertyExportName(Property), Property->GetOffset_ForInternal() });
+
+			if (!Descriptor->FieldsByName.Contains(AuthoredName))
+			{
+				Descriptor->FieldsByName.Add(AuthoredName, FieldIdx);
+			}
+
+			if (!Descriptor->ColumnProperties.Contains(Property->GetFName()))
+			{
+				Descriptor->ColumnProperties.Add(Property->GetFName(), Property);
+			}
+
+			for (const FString& ImportName : ImportNames)
+			{
+				if (!Descriptor->FieldsByImportName.Contains(ImportName))
+				{
+					Descriptor->FieldsByImportName.Add(ImportName, FieldIdx);
+				}
+
+				const FName ColumnName(*ImportName);
+				if (!Descriptor->ColumnProperties.Contains(ColumnName))
+				{
+					Descriptor->ColumnProperties.Add(ColumnName, Property);
+				}
+			}
+
+			const FName AuthoredColumnName(*AuthoredName);
+			if (!Descriptor->ColumnProperties.Contains(AuthoredColumnName))
+			{
+				Descriptor->ColumnProperties.Add(AuthoredColumnName, Property);
+			}
+		}
+
+		return Descriptor;
+	}
+
+	bool CanCacheDescriptor(const UStruct* InStruct)
+	{
+#if WITH_EDITOR
+		const UClass* AsClass = Cast<UClass>(InStruct);
+		return !InStruct->IsA<UUserDefinedStruct>() && !(AsClass && !AsClass->HasAnyClassFlags(CLASS_Native));
+#else
+		return true;
+#endif
+	}
+}
+
+TSharedRef<const FCustomStructDescriptor> CustomStructDescriptorCache::Get(const UStruct* InStruct)
+{
+	check(InStruct);
+
+	if (!CanCacheDescriptor(InStruct))
+	{
+		return MakeDescriptor(InStruct);
+	}
+
+	{
+		FScopeLock Lock(&DescriptorsLock);
+
+		// A struct that was destroyed can leave its address to a new one
+		if (const TSharedPtr<const FCustomStructDescriptor>* Cached = Descriptors.Find(InStruct))
+		{
+			if ((*Cached)->Struct.Get() == InStruct)
+			{
+				return Cached->ToSharedRef();
+			}
+		}
+	}
+
+	// Made outside the lock, if two threads race for the same struct the second one's is kept, which is just as good
+	TSharedRef<const FCustomStructDescriptor> Descriptor = MakeDescriptor(InStruct);
+
+	FScopeLock Lock(&DescriptorsLock);
+
+	if (Descriptors.Num() >= MaxCachedDescriptors)
+	{
+		Descriptors.Reset();
+	}
+	Descriptors.Add(InStruct, Descriptor);
+
+	return Descriptor;
+}
+
+void CustomStructDescriptorCache::Reset()
+{
+	FScopeLock Lock(&DescriptorsLock);
+	Descriptors.Reset();
+}
@@ -0,0 +1,70 @@
+/************************************************************************/
+/* Author: YWT20                                                        */
+/* Expected release year : 2021                                         */
+/************************************************************************/
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Class.h"
+#include "UObject/UnrealType.h"
+
+/**
+ * Everything the JSON converter and the DataTable importers look up about a struct's properties, worked out once per
+ * struct and shared between them. Descriptors are immutable once made, so they can be used from any thread.
+ */
+struct FCustomStructDescriptor
+{
+	/** One property of the struct */
+	struct FField
+	{
+		FProperty* Property;
+
+		// The name the converter reads it from
+		FString AuthoredName;
+
+		// StandardizeCase of AuthoredName, the name the converter writes it as
+		FString JsonName;
+
+		// The name a DataTable exports it as, used for the importers' problems
+		FString ColumnName;
+
+		// From the start of the struct, as ContainerPtrToValuePtr would find it
+		int32 Offset;
+
+		const void* GetValuePtr(const void* Struct) const
+		{
+			return (const uint8*)Struct + Offset;
+		}
+
+		void* GetValuePtr(void* Struct) const
+		{
+			return (uint8*)Struct + Offset;
+		}
+	};
+
+	TWeakObjectPtr<const UStruct> Struct;
+
+	// In field order
+	TArray<FField> Fields;
+
+	// Index into Fields by authored name. FString keys hash and compare ignoring case, as FJsonObject keys do.
+	TMap<FString, int32> FieldsByName;
+
+	// Index into Fields by every name a DataTable may import the property under
+	TMap<FString, int32> FieldsByImportName;
+
+	// CSV column titles to properties: the property's name, authored name or any import name. FName ignores case, as the engine's CSV import does.
+	TMap<FName, FProperty*> ColumnProperties;
+};
+
+namespace CustomStructDescriptorCache
+{
+	/**
+	 * InStruct's descriptor, made the first time it's asked for. Safe to call from any thread.
+	 * In the editor Blueprint structs and classes are recompiled in place, so theirs are made fresh every time.
+	 */
+	TSharedRef<const FCustomStructDescriptor> Get(const UStruct* InStruct);
+
+	/** Forgets every descriptor, for when a reload may have changed struct layouts without recreating the structs */
+	void Reset();
+}
@@ -4,20 +4,28 @@
 /************************************************************************/
 
 #include "JsonCsvToDataTableToStruct.h"
+#include "CustomJsonConverter.h"
+#include "UObject/UObjectGlobals.h"
 
 #define LOCTEXT_NAMESPACE "FJsonCsvToDataTableToStructModule"
 
 void FJsonCsvToDataTableToStructModule::StartupModule()
 {
 	// This code will execute after your module is loaded into memory; the exact timing is specified in the .uplugin file per-module
-	
+
+	// Reloaded structs can change layout in place, so what the converter knows about them has to go
+	ReloadCompleteHandle = FCoreUObjectDelegates::ReloadCompleteDelegate.AddLambda([](EReloadCompleteReason)
+	{
+		CustomJsonConverter::ResetStructCache();
+	});
 }
 
 void FJsonCsvToDataTableToStructModule::ShutdownModule()
 {
 	// This function may be called during shutdown to clean up your module.  For modules that support dynamic reloading,
 	// we call this function before unloading the module.
-	
+
+	FCoreUObjectDelegates::ReloadCompleteDelegate.Remove(ReloadCompleteHandle);
 }
 
 #undef LOCTEXT_NAMESPACE
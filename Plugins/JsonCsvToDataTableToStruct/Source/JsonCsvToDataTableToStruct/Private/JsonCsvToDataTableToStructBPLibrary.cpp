@@ -10,12 +10,15 @@
 #include "Engine/Engine.h"
 #include "UObject/UnrealType.h"
 #include "UObject/EnumProperty.h"
+#include "UObject/TextProperty.h"
 #include "Misc/FileHelper.h"
 #include "DataTableUtils.h"
 #include "Engine/DataTable.h"
 #include "Serialization/JsonReader.h"
 #include "Serialization/JsonSerializer.h"
 #include "Engine/UserDefinedStruct.h"
+#include "CustomJsonTokenReader.h"
+#include "CustomStructDescriptor.h"
 
 #if PLATFORM_MAC
 #include "Mac/MacPlatformApplicationMisc.h"
@@ -29,6 +32,7 @@
 #include "IOS/IOSPlatformApplicationMisc.h"
 #endif 
 #include "Kismet/KismetArrayLibrary.h"
+#include "Async/ParallelFor.h"
 
 
 
@@ -70,10 +74,12 @@ bool UJsonCsvToDataTableToStructBPLibrary::Generic_StructArrayToJsonObjectString
 
 	FScriptArrayHelper ArrayHelper(StructDefinition, Struct);
 
+	// Each element is written into the same scratch string, which keeps its allocation between them
 	FString tempString = "";
 	OutJsonString = "[\n\r";
 	for (int32 i = 0; i < ArrayHelper.Num(); i++)
 	{
+		tempString.Reset();
 		CustomJsonConverter::UStructToJsonObjectString(StructType, ArrayHelper.GetRawPtr(i), tempString);
 		OutJsonString += tempString;
 
@@ -94,19 +100,7 @@ bool UJsonCsvToDataTableToStructBPLibrary::Generic_JsonStringToStructV2(FString
 {
 	if (InJsonString.IsEmpty()) return false;
 
-	TSharedPtr<FJsonObject> JsonObject;
-	TSharedRef<TJsonReader<> > JsonReader = TJsonReaderFactory<>::Create(InJsonString);
-	if (!FJsonSerializer::Deserialize(JsonReader, JsonObject) || !JsonObject.IsValid())
-	{
-		UE_LOG(LogJson, Warning, TEXT("JsonStringToStructV2 - Unable to parse json=[%s]"), *InJsonString);
-		return false;
-	}
-	if (!CustomJsonConverter::JsonObjectToUStruct(JsonObject.ToSharedRef(), StructDefinition, OutPtr))
-	{
-		UE_LOG(LogJson, Warning, TEXT("JsonStringToStructV2 - Unable to deserialize. json=[%s]"), *InJsonString);
-		return false;
-	}
-	return true;
+	return CustomJsonConverter::JsonObjectStringToUStruct(InJsonString, StructDefinition, OutPtr);
 }
 
 bool UJsonCsvToDataTableToStructBPLibrary::JsonStringToStructArrayV2(FString InJsonString, TArray<UScriptStruct*>& StructArray)
@@ -124,33 +118,10 @@ bool UJsonCsvToDataTableToStructBPLibrary::Generic_JsonStringToStructArrayV2(FSt
 	if (!StructType) return false;
 
 	FScriptArrayHelper ArrayHelper(StructDefinition, Struct);
+	ArrayHelper.EmptyValues();
 
-
-	TArray<TSharedPtr<FJsonValue> > JsonArray;
-	TSharedRef<TJsonReader<> > JsonReader = TJsonReaderFactory<>::Create(InJsonString);
-	if (!FJsonSerializer::Deserialize(JsonReader, JsonArray))
-	{
-		UE_LOG(LogJson, Warning, TEXT("JsonStringToStructArrayV2 - Unable to parse. json=[%s]"), *InJsonString);
-		return false;
-	}
-	ArrayHelper.EmptyAndAddValues(JsonArray.Num());
-	for (int32 i = 0; i < JsonArray.Num(); ++i)
-	{
-		//void* OutPtr = nullptr;
-		const auto& Value = JsonArray[i];
-		if (Value->Type != EJson::Object)
-		{
-			UE_LOG(LogJson, Warning, TEXT("JsonStringToStructArrayV2 - Array element [%i] was not an object."), i);
-			return false;
-		}
-		if (!CustomJsonConverter::JsonObjectToUStruct(Value->AsObject().ToSharedRef(), StructType, &(*ArrayHelper.GetRawPtr(i))))
-		{
-			UE_LOG(LogJson, Warning, TEXT("JsonStringToStructArrayV2 - Unable to deserialize. json=[%s]"), *InJsonString);
-			return false;
-		}
-	}
-
-	return true;
+	// Elements are added as the array's objects are read
+	return CustomJsonConverter::JsonArrayStringToUStruct(InJsonString, StructType, [&ArrayHelper]() -> void* { return ArrayHelper.GetRawPtr(ArrayHelper.AddValue()); });
 }
 
 
@@ -170,25 +141,25 @@ UDataTable* UJsonCsvToDataTableToStructBPLibrary::ReadJsonToDataTable(const FStr
 {
 	if (InData.IsEmpty() || !TableType) return nullptr;
 
-	FString newInData = InData;
-
 	UDataTable* OutDataTable = NewObject<UDataTable>(GWorld, FName(FGuid::NewGuid().ToString()));
 
 	if (!OutDataTable) return nullptr;
 
 	OutDataTable->RowStruct = TableType;
 
-	TArray<FString> OutError = OutDataTable->CreateTableFromJSONString(newInData);
+	// A single object is read as a row named _MyTempName
+	TArray<FString> OutError;
+	FYDataTableImporterJSON(*OutDataTable, InData, OutError).YReadTable();
 
 	if (OutError.Num() != 0)
 	{
-		newInData.InsertAt(newInData.Find("{") + 1, "\r\n\t\t\"Name\": \"_MyTempName\",");
-		newInData = "[" + newInData + "]";
-		OutError = OutDataTable->CreateTableFromJSONString(newInData);
+		for (const FString& Error : OutError)
+		{
+			UE_LOG(LogJson, Warning, TEXT("ReadJsonToDataTable - %s"), *Error);
+		}
+		return nullptr;
 	}
 
-	if (OutError.Num() != 0) return nullptr;
-
 	return OutDataTable;
 }
 
@@ -225,43 +196,23 @@ UDataTable* UJsonCsvToDataTableToStructBPLibrary::ReadCsvToDataTable(const FStri
 {
 	if (InData.IsEmpty() || !TableType) return nullptr;
 
-	FString newInData = InData;
-
-#if !WITH_EDITOR
-	TObjectPtr<UField> ptr = TableType->Children;
-	FString LName, DisplayName, TFrom, TTo, Lstr, Rstr;
-	InData.Split("\n", &Lstr, &Rstr);
-
-	while (ptr)
-	{
-		LName = ptr->GetName();
-		DisplayName = ptr->GetAuthoredName();
-
-		TFrom = ("," + DisplayName + ",");
-		TTo = ("," + LName + ",");
-
-		if (!Lstr.Contains(TFrom))
-		{
-			TFrom = ("," + DisplayName + '\n');
-			TTo = ("," + LName + '\n');
-		}
-
-		Lstr = Lstr.Replace(*TFrom, *TTo);
-		ptr = ptr->Next;
-	}
-	Lstr.AppendChar('\n');
-	newInData = Lstr.Append(Rstr);
-#endif //WITH_EDITOR
-
 	UDataTable* OutDataTable = NewObject<UDataTable>(GWorld, FName(FGuid::NewGuid().ToString()));
 
 	if (!OutDataTable) return nullptr;
 
 	OutDataTable->RowStruct = TableType;
 
-	TArray<FString> OutError = OutDataTable->CreateTableFromCSVString(newInData);
+	TArray<FString> OutError;
+	FYDataTableImporterCSV(*OutDataTable, InData, OutError).YReadTable();
 
-	if (OutError.Num() != 0) return nullptr;
+	if (OutError.Num() != 0)
+	{
+		for (const FString& Error : OutError)
+		{
+			UE_LOG(LogJson, Warning, TEXT("ReadCsvToDataTable - %s"), *Error);
+		}
+		return nullptr;
+	}
 
 	return OutDataTable;
 }
@@ -395,16 +346,8 @@ bool UJsonCsvToDataTableToStructBPLibrary::Generic_JsonStringToStruct(FString In
 
 	InDataTable->RowStruct = TableType;
 
-	TArray<FString> OutError = InDataTable->CreateTableFromJSONString(InJsonString);
-	if (OutError.Num() != 0) {
-		InJsonString.InsertAt(InJsonString.Find("{") + 1, "\r\n\t\t\"Name\": \"_MyTempName\",");
-		InJsonString = "[" + InJsonString + "]";
-		OutError = InDataTable->CreateTableFromJSONString(InJsonString);
-	}
-	if (OutError.Num() != 0) {
-		InJsonString = InJsonString.Replace(TEXT("\":null"), TEXT("\":\"\""));
-		OutError = InDataTable->CreateTableFromJSONString(InJsonString);
-	}
+	TArray<FString> OutError;
+	FYDataTableImporterJSON(*InDataTable, InJsonString, OutError).YReadTable();
 	if (OutError.Num() != 0) return false;
 
 	void* RowPtr = InDataTable->FindRowUnchecked(InDataTable->GetRowNames()[0]);
@@ -440,16 +383,8 @@ bool UJsonCsvToDataTableToStructBPLibrary::Generic_JsonStringToStructArray(FStri
 	if (!InDataTable) return false;
 	InDataTable->RowStruct = StructType;
 
-	TArray<FString> OutError = InDataTable->CreateTableFromJSONString(InJsonString);
-	if (OutError.Num() != 0) {
-		InJsonString.InsertAt(InJsonString.Find("{") + 1, "\r\n\t\t\"Name\": \"_MyTempName\",");
-		InJsonString = "[" + InJsonString + "]";
-		OutError = InDataTable->CreateTableFromJSONString(InJsonString);
-	}
-	if (OutError.Num() != 0) {
-		InJsonString = InJsonString.Replace(TEXT("\":null"), TEXT("\":\"\""));
-		OutError = InDataTable->CreateTableFromJSONString(InJsonString);
-	}
+	TArray<FString> OutError;
+	FYDataTableImporterJSON(*InDataTable, InJsonString, OutError).YReadTable();
 	if (OutError.Num() != 0) return false;
 
 
@@ -470,6 +405,110 @@ bool UJsonCsvToDataTableToStructBPLibrary::Generic_JsonStringToStructArray(FStri
 	return true;
 }
 
+namespace
+{
+	// Rows are exported this many at a time, one task per chunk
+	constexpr int32 ExportRowsPerChunk = 256;
+
+	/** The table's rows in row map order, so that they can be handed out by index */
+	TArray<TPair<FName, const uint8*>> GetRowsInOrder(const UDataTable& InDataTable)
+	{
+		TArray<TPair<FName, const uint8*>> Rows;
+		Rows.Reserve(InDataTable.GetRowMap().Num());
+		for (auto RowIt = InDataTable.GetRowMap().CreateConstIterator(); RowIt; ++RowIt)
+		{
+			Rows.Emplace(RowIt.Key(), RowIt.Value());
+		}
+		return Rows;
+	}
+
+	/**
+	 * Whether every value in InStruct can be exported off the game thread. Numbers, strings, names, enums and plain structs
+	 * and containers of them only read their own memory. Text goes through the localization system, and object, class,
+	 * interface, soft and delegate properties look up and name UObjects, none of which are safe to do from task threads.
+	 */
+	bool CanExportInParallel(const UStruct* InStruct, TSet<const UStruct*>& VisitedStructs);
+
+	bool CanExportPropertyInParallel(const FProperty* InProperty, TSet<const UStruct*>& VisitedStructs)
+	{
+		if (InProperty->IsA<FTextProperty>() || InProperty->IsA<FObjectPropertyBase>() || InProperty->IsA<FInterfaceProperty>() ||
+			InProperty->IsA<FDelegateProperty>() || InProperty->IsA<FMulticastDelegateProperty>())
+		{
+			return false;
+		}
+
+		if (const FStructProperty* StructProp = CastField<FStructProperty>(InProperty))
+		{
+			return CanExportInParallel(StructProp->Struct, VisitedStructs);
+		}
+		if (const FArrayProperty* ArrayProp = CastField<FArrayProperty>(InProperty))
+		{
+			return CanExportPropertyInParallel(ArrayProp->Inner, VisitedStructs);
+		}
+		if (const FSetProperty* SetProp = CastField<FSetProperty>(InProperty))
+		{
+			return CanExportPropertyInParallel(SetProp->ElementProp, VisitedStructs);
+		}
+		if (const FMapProperty* MapProp = CastField<FMapProperty>(InProperty))
+		{
+			return CanExportPropertyInParallel(MapProp->KeyProp, VisitedStructs) && CanExportPropertyInParallel(MapProp->ValueProp, VisitedStructs);
+		}
+		return true;
+	}
+
+	bool CanExportInParallel(const UStruct* InStruct, TSet<const UStruct*>& VisitedStructs)
+	{
+		// A struct can hold containers of itself, it only needs checking once
+		bool bAlreadyVisited = false;
+		VisitedStructs.Add(InStruct, &bAlreadyVisited);
+		if (bAlreadyVisited)
+		{
+			return true;
+		}
+
+		for (TFieldIterator<FProperty> It(InStruct); It; ++It)
+		{
+			if (!CanExportPropertyInParallel(*It, VisitedStructs))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	/**
+	 * Splits NumRows rows of InRowStruct into chunks and has ExportChunk write each one into a string of its own, on as many task
+	 * threads as are free. Row structs that CanExportInParallel turns down have their chunks written one after another on the
+	 * calling thread instead. The chunks are appended to ExportedText in row order once they are all done.
+	 */
+	void ExportRowChunks(const UStruct* InRowStruct, const int32 NumRows, FString& ExportedText, TFunctionRef<void(int32 FirstRow, int32 NumChunkRows, FString& OutChunk)> ExportChunk)
+	{
+		TArray<FString> Chunks;
+		Chunks.SetNum(FMath::DivideAndRoundUp(NumRows, ExportRowsPerChunk));
+
+		TSet<const UStruct*> VisitedStructs;
+		const EParallelForFlags Flags = CanExportInParallel(InRowStruct, VisitedStructs) ? EParallelForFlags::None : EParallelForFlags::ForceSingleThread;
+
+		ParallelFor(Chunks.Num(), [NumRows, &Chunks, &ExportChunk](const int32 ChunkIdx)
+		{
+			const int32 FirstRow = ChunkIdx * ExportRowsPerChunk;
+			ExportChunk(FirstRow, FMath::Min(ExportRowsPerChunk, NumRows - FirstRow), Chunks[ChunkIdx]);
+		}, Flags);
+
+		int32 TotalLen = ExportedText.Len();
+		for (const FString& Chunk : Chunks)
+		{
+			TotalLen += Chunk.Len();
+		}
+		ExportedText.Reserve(TotalLen);
+
+		for (const FString& Chunk : Chunks)
+		{
+			ExportedText += Chunk;
+		}
+	}
+}
+
 bool UJsonCsvToDataTableToStructBPLibrary::WriteDataTableToCsv(UDataTable* InDataTable, FString& ExportedText)
 {
 	if (!InDataTable->RowStruct)
@@ -492,7 +531,8 @@ bool UJsonCsvToDataTableToStructBPLibrary::WriteDataTableToCsv(UDataTable* InDat
 		ExportedText += TEXT("---");
 	}
 
-	FProperty* SkipProperty = nullptr;
+	// The properties that get a column, in column order
+	TArray<const FProperty*> Columns;
 	for (TFieldIterator<FProperty> It(InDataTable->RowStruct); It; ++It)
 	{
 		FProperty* BaseProp = *It;
@@ -502,67 +542,88 @@ bool UJsonCsvToDataTableToStructBPLibrary::WriteDataTableToCsv(UDataTable* InDat
 
 		if (ColumnHeader == ImportKeyField)
 		{
-			// Don't write header again if this is the name field, and save for skipping later
-			SkipProperty = BaseProp;
+			// Don't write header again if this is the name field, the row name is written in its place
 			continue;
 		}
 
+		Columns.Add(BaseProp);
 		ExportedText += TEXT(",");
 		ExportedText += ColumnHeader;
 	}
 	ExportedText += TEXT("\n");
 
 	// Write each row
-	for (auto RowIt = InDataTable->GetRowMap().CreateConstIterator(); RowIt; ++RowIt)
+	const TArray<TPair<FName, const uint8*>> Rows = GetRowsInOrder(*InDataTable);
+	ExportRowChunks(InDataTable->RowStruct, Rows.Num(), ExportedText, [&Rows, &Columns](const int32 FirstRow, const int32 NumChunkRows, FString& OutChunk)
 	{
-		FName RowName = RowIt.Key();
-		ExportedText += RowName.ToString();
-
-		uint8* RowData = RowIt.Value();
-
-		//WriteRow(InDataTable.RowStruct, RowData);
+		for (int32 RowIdx = FirstRow; RowIdx < FirstRow + NumChunkRows; ++RowIdx)
 		{
-			if (!InDataTable->RowStruct)
-			{
-				return false;
-			}
+			Rows[RowIdx].Key.AppendString(OutChunk);
 
-			for (TFieldIterator<FProperty> It(InDataTable->RowStruct); It; ++It)
+			for (const FProperty* Column : Columns)
 			{
-				FProperty* BaseProp = *It;
-				check(BaseProp);
+				const FString PropertyValue = DataTableUtils::GetPropertyValueAsString(Column, Rows[RowIdx].Value, EDataTableExportFlags::None);
+				OutChunk += TEXT(",\"");
 
-				if (BaseProp == SkipProperty)
+				int32 QuoteIdx = INDEX_NONE;
+				if (PropertyValue.FindChar(TEXT('"'), QuoteIdx))
 				{
-					continue;
+					OutChunk += PropertyValue.Replace(TEXT("\""), TEXT("\"\""));
 				}
-
-				const void* Data = BaseProp->ContainerPtrToValuePtr<void>(RowData, 0);
-
-				//WriteStructEntry(InRowData, BaseProp, Data);
+				else
 				{
-					ExportedText += TEXT(",");
-					const FString PropertyValue = DataTableUtils::GetPropertyValueAsString(BaseProp, (uint8*)RowData, EDataTableExportFlags::None);
-					ExportedText += TEXT("\"");
-					ExportedText += PropertyValue.Replace(TEXT("\""), TEXT("\"\""));
-					ExportedText += TEXT("\"");
+					OutChunk += PropertyValue;
 				}
+
+				OutChunk += TEXT("\"");
 			}
-		}
 
-		ExportedText += TEXT("\n");
-	}
+			OutChunk += TEXT("\n");
+		}
+	});
 
 	return true;
 }
 
 bool UJsonCsvToDataTableToStructBPLibrary::WriteDataTableToJson(UDataTable* InDataTable, FString& ExportedText)
 {
-	if (!FYDataTableExporterJSON(EDataTableExportFlags::UseJsonObjectsForStructs, ExportedText).WriteTable(*InDataTable))
+	const EDataTableExportFlags DTExportFlags = EDataTableExportFlags::UseJsonObjectsForStructs;
+
+	if (!InDataTable->RowStruct || InDataTable->GetRowMap().Num() == 0)
 	{
-		ExportedText = TEXT("Missing RowStruct!\n");
-		return false;
+		// Nothing to split up
+		if (!FYDataTableExporterJSON(DTExportFlags, ExportedText).WriteTable(*InDataTable))
+		{
+			ExportedText = TEXT("Missing RowStruct!\n");
+			return false;
+		}
+		return true;
 	}
+
+	ExportedText.Empty();
+
+	// Each chunk is written as a table of its own, then trimmed to fit into the whole one. Only the first row's text depends on where
+	// it sits: rows after the first in the table are preceded by a comma, so the chunk's "[" becomes one, and only the last chunk
+	// keeps the text that closes the array.
+	const TArray<TPair<FName, const uint8*>> Rows = GetRowsInOrder(*InDataTable);
+	ExportRowChunks(InDataTable->RowStruct, Rows.Num(), ExportedText, [InDataTable, DTExportFlags, &Rows](const int32 FirstRow, const int32 NumChunkRows, FString& OutChunk)
+	{
+		FYDataTableExporterJSON(DTExportFlags, OutChunk).WriteTableRows(*InDataTable, MakeArrayView(Rows).Slice(FirstRow, NumChunkRows));
+
+		if (FirstRow > 0)
+		{
+			OutChunk[0] = TEXT(',');
+		}
+
+		if (FirstRow + NumChunkRows < Rows.Num())
+		{
+			// Every row is an object, so the chunk's rows end at its last '}'
+			int32 RowsEnd = INDEX_NONE;
+			OutChunk.FindLastChar(TEXT('}'), RowsEnd);
+			OutChunk.LeftInline(RowsEnd + 1, false);
+		}
+	});
+
 	return true;
 }
 
@@ -583,29 +644,6 @@ FString UJsonCsvToDataTableToStructBPLibrary::PasteMessageFromClipboard()
 
 namespace
 {
-	const TCHAR* JSONTypeToString(const EJson InType)
-	{
-		switch (InType)
-		{
-		case EJson::None:
-			return TEXT("None");
-		case EJson::Null:
-			return TEXT("Null");
-		case EJson::String:
-			return TEXT("String");
-		case EJson::Number:
-			return TEXT("Number");
-		case EJson::Boolean:
-			return TEXT("Boolean");
-		case EJson::Array:
-			return TEXT("Array");
-		case EJson::Object:
-			return TEXT("Object");
-		default:
-			return TEXT("Unknown");
-		}
-	}
-
 	template <typename CharType>
 	void WriteJSONObjectStartWithOptionalIdentifier(typename TYDataTableExporterJSON<CharType>::FDataTableJsonWriter& InJsonWriter, const FString* InIdentifier)
 	{
@@ -686,17 +724,28 @@ bool TYDataTableExporterJSON<CharType>::WriteTable(const UDataTable& InDataTable
 	// Iterate over rows
 	for (auto RowIt = InDataTable.GetRowMap().CreateConstIterator(); RowIt; ++RowIt)
 	{
-		JsonWriter->WriteObjectStart();
-		{
-			// RowName
-			const FName RowName = RowIt.Key();
-			JsonWriter->WriteValue(KeyField, RowName.ToString());
+		WriteTableRow(InDataTable, KeyField, RowIt.Key(), RowIt.Value());
+	}
 
-			// Now the values
-			uint8* RowData = RowIt.Value();
-			WriteRow(InDataTable.RowStruct, RowData, &KeyField);
-		}
-		JsonWriter->WriteObjectEnd();
+	JsonWriter->WriteArrayEnd();
+
+	return true;
+}
+
+template<typename CharType>
+bool TYDataTableExporterJSON<CharType>::WriteTableRows(const UDataTable& InDataTable, TArrayView<const TPair<FName, const uint8*>> InRows)
+{
+	if (!InDataTable.RowStruct)
+	{
+		return false;
+	}
+
+	FString KeyField = DataTableJSONUtils::YGetKeyFieldName(InDataTable);
+	JsonWriter->WriteArrayStart();
+
+	for (const TPair<FName, const uint8*>& Row : InRows)
+	{
+		WriteTableRow(InDataTable, KeyField, Row.Key, Row.Value);
 	}
 
 	JsonWriter->WriteArrayEnd();
@@ -704,6 +753,20 @@ bool TYDataTableExporterJSON<CharType>::WriteTable(const UDataTable& InDataTable
 	return true;
 }
 
+template<typename CharType>
+void TYDataTableExporterJSON<CharType>::WriteTableRow(const UDataTable& InDataTable, const FString& InKeyField, const FName InRowName, const uint8* InRowData)
+{
+	JsonWriter->WriteObjectStart();
+	{
+		// RowName
+		JsonWriter->WriteValue(InKeyField, InRowName.ToString());
+
+		// Now the values
+		WriteRow(InDataTable.RowStruct, InRowData, &InKeyField);
+	}
+	JsonWriter->WriteObjectEnd();
+}
+
 template<typename CharType>
 bool TYDataTableExporterJSON<CharType>::WriteTableAsObject(const UDataTable& InDataTable)
 {
@@ -744,14 +807,32 @@ bool TYDataTableExporterJSON<CharType>::WriteRow(const UScriptStruct* InRowStruc
 }
 
 template<typename CharType>
-bool TYDataTableExporterJSON<CharType>::WriteStruct(const UScriptStruct* InStruct, const void* InStructData, const FString* FieldToSkip)
+const typename TYDataTableExporterJSON<CharType>::FColumnPlan& TYDataTableExporterJSON<CharType>::GetColumnPlan(const UScriptStruct* InStruct)
 {
+	if (const TUniquePtr<FColumnPlan>* ExistingPlan = ColumnPlans.Find(InStruct))
+	{
+		return **ExistingPlan;
+	}
+
+	TUniquePtr<FColumnPlan> Plan = MakeUnique<FColumnPlan>();
 	for (TFieldIterator<const FProperty> It(InStruct); It; ++It)
 	{
 		const FProperty* BaseProp = *It;
 		check(BaseProp);
 
-		const FString Identifier = DataTableUtils::GetPropertyExportName(BaseProp, DTExportFlags);
+		Plan->Emplace(BaseProp, DataTableUtils::GetPropertyExportName(BaseProp, DTExportFlags));
+	}
+
+	return *ColumnPlans.Add(InStruct, MoveTemp(Plan));
+}
+
+template<typename CharType>
+bool TYDataTableExporterJSON<CharType>::WriteStruct(const UScriptStruct* InStruct, const void* InStructData, const FString* FieldToSkip)
+{
+	for (const TPair<const FProperty*, FString>& Column : GetColumnPlan(InStruct))
+	{
+		const FProperty* BaseProp = Column.Key;
+		const FString& Identifier = Column.Value;
 		if (FieldToSkip && *FieldToSkip == Identifier)
 		{
 			// Skip this field
@@ -761,7 +842,7 @@ bool TYDataTableExporterJSON<CharType>::WriteStruct(const UScriptStruct* InStruc
 		if (BaseProp->ArrayDim == 1)
 		{
 			const void* Data = BaseProp->ContainerPtrToValuePtr<void>(InStructData, 0);
-			WriteStructEntry(InStructData, BaseProp, Data);
+			WriteStructEntry(InStructData, BaseProp, Identifier, Data);
 		}
 		else
 		{
@@ -781,41 +862,39 @@ bool TYDataTableExporterJSON<CharType>::WriteStruct(const UScriptStruct* InStruc
 }
 
 template<typename CharType>
-bool TYDataTableExporterJSON<CharType>::WriteStructEntry(const void* InRowData, const FProperty* InProperty, const void* InPropertyData)
+bool TYDataTableExporterJSON<CharType>::WriteStructEntry(const void* InRowData, const FProperty* InProperty, const FString& InIdentifier, const void* InPropertyData)
 {
-	const FString Identifier = DataTableUtils::GetPropertyExportName(InProperty, DTExportFlags);
-
 	if (const FEnumProperty* EnumProp = CastField<const FEnumProperty>(InProperty))
 	{
 		const FString PropertyValue = DataTableUtils::GetPropertyValueAsString(EnumProp, (uint8*)InRowData, DTExportFlags);
-		JsonWriter->WriteValue(Identifier, PropertyValue);
+		JsonWriter->WriteValue(InIdentifier, PropertyValue);
 	}
 	else if (const FNumericProperty* NumProp = CastField<const FNumericProperty>(InProperty))
 	{
 		if (NumProp->IsEnum())
 		{
 			const FString PropertyValue = DataTableUtils::GetPropertyValueAsString(InProperty, (uint8*)InRowData, DTExportFlags);
-			JsonWriter->WriteValue(Identifier, PropertyValue);
+			JsonWriter->WriteValue(InIdentifier, PropertyValue);
 		}
 		else if (NumProp->IsInteger())
 		{
 			const int64 PropertyValue = NumProp->GetSignedIntPropertyValue(InPropertyData);
-			JsonWriter->WriteValue(Identifier, PropertyValue);
+			JsonWriter->WriteValue(InIdentifier, PropertyValue);
 		}
 		else
 		{
 			const double PropertyValue = NumProp->GetFloatingPointPropertyValue(InPropertyData);
-			JsonWriter->WriteValue(Identifier, PropertyValue);
+			JsonWriter->WriteValue(InIdentifier, PropertyValue);
 		}
 	}
 	else if (const FBoolProperty* BoolProp = CastField<const FBoolProperty>(InProperty))
 	{
 		const bool PropertyValue = BoolProp->GetPropertyValue(InPropertyData);
-		JsonWriter->WriteValue(Identifier, PropertyValue);
+		JsonWriter->WriteValue(InIdentifier, PropertyValue);
 	}
 	else if (const FArrayProperty* ArrayProp = CastField<const FArrayProperty>(InProperty))
 	{
-		JsonWriter->WriteArrayStart(Identifier);
+		JsonWriter->WriteArrayStart(InIdentifier);
 
 		FScriptArrayHelper ArrayHelper(ArrayProp, InPropertyData);
 		for (int32 ArrayEntryIndex = 0; ArrayEntryIndex < ArrayHelper.Num(); ++ArrayEntryIndex)
@@ -828,7 +907,7 @@ bool TYDataTableExporterJSON<CharType>::WriteStructEntry(const void* InRowData,
 	}
 	else if (const FSetProperty* SetProp = CastField<const FSetProperty>(InProperty))
 	{
-		JsonWriter->WriteArrayStart(Identifier);
+		JsonWriter->WriteArrayStart(InIdentifier);
 
 		FScriptSetHelper SetHelper(SetProp, InPropertyData);
 		for (int32 SetSparseIndex = 0; SetSparseIndex < SetHelper.GetMaxIndex(); ++SetSparseIndex)
@@ -844,7 +923,7 @@ bool TYDataTableExporterJSON<CharType>::WriteStructEntry(const void* InRowData,
 	}
 	else if (const FMapProperty* MapProp = CastField<const FMapProperty>(InProperty))
 	{
-		JsonWriter->WriteObjectStart(Identifier);
+		JsonWriter->WriteObjectStart(InIdentifier);
 
 		FScriptMapHelper MapHelper(MapProp, InPropertyData);
 		for (int32 MapSparseIndex = 0; MapSparseIndex < MapHelper.GetMaxIndex(); ++MapSparseIndex)
@@ -866,20 +945,20 @@ bool TYDataTableExporterJSON<CharType>::WriteStructEntry(const void* InRowData,
 	{
 		if (!!(DTExportFlags & EDataTableExportFlags::UseJsonObjectsForStructs))
 		{
-			JsonWriter->WriteObjectStart(Identifier);
+			JsonWriter->WriteObjectStart(InIdentifier);
 			WriteStruct(StructProp->Struct, InPropertyData);
 			JsonWriter->WriteObjectEnd();
 		}
 		else
 		{
 			const FString PropertyValue = DataTableUtils::GetPropertyValueAsString(InProperty, (uint8*)InRowData, DTExportFlags);
-			JsonWriter->WriteValue(Identifier, PropertyValue);
+			JsonWriter->WriteValue(InIdentifier, PropertyValue);
 		}
 	}
 	else
 	{
 		const FString PropertyValue = DataTableUtils::GetPropertyValueAsString(InProperty, (uint8*)InRowData, DTExportFlags);
-		JsonWriter->WriteValue(Identifier, PropertyValue);
+		JsonWriter->WriteValue(InIdentifier, PropertyValue);
 	}
 
 	return true;
@@ -958,10 +1037,29 @@ template class TYDataTableExporterJSON<TCHAR>;
 template class TYDataTableExporterJSON<ANSICHAR>;
 
 
+namespace
+{
+	/**
+	 * What CreateTableFromCSVString and CreateTableFromJSONString do once the rows are in: lets each row fix itself up,
+	 * then tells listeners about the whole import at once. UDataTable::OnPostDataImported isn't public, so this is its loop.
+	 */
+	void YFinishImport(UDataTable& InDataTable, TArray<FString>& OutProblems)
+	{
+		for (const TPair<FName, uint8*>& Row : InDataTable.GetRowMap())
+		{
+			reinterpret_cast<FTableRowBase*>(Row.Value)->OnPostDataImport(&InDataTable, Row.Key, OutProblems);
+		}
+
+		InDataTable.Modify(true);
+		InDataTable.HandleDataTableChanged();
+	}
+}
+
 FYDataTableImporterJSON::FYDataTableImporterJSON(UDataTable& InDataTable, const FString& InJSONData, TArray<FString>& OutProblems)
 	: DataTable(&InDataTable)
 	, JSONData(InJSONData)
 	, ImportProblems(OutProblems)
+	, ScratchRowData(nullptr)
 {
 }
 
@@ -978,142 +1076,232 @@ bool FYDataTableImporterJSON::YReadTable()
 	}
 
 	// Check we have a RowStruct specified
-	if (!DataTable->RowStruct)
+	UScriptStruct* RowStruct = DataTable->RowStruct;
+	if (!RowStruct)
 	{
 		ImportProblems.Add(TEXT("No RowStruct specified."));
 		return false;
 	}
 
-	TArray< TSharedPtr<FJsonValue> > ParsedTableRows;
+	JsonReader = TJsonReaderFactory<TCHAR>::Create(JSONData);
+	KeyField = DataTableJSONUtils::YGetKeyFieldName(*DataTable);
+
+	EJsonNotation Notation = EJsonNotation::Error;
+	if (!JsonReader->ReadNext(Notation) || (Notation != EJsonNotation::ArrayStart && Notation != EJsonNotation::ObjectStart))
 	{
-		const TSharedRef< TJsonReader<TCHAR> > JsonReader = TJsonReaderFactory<TCHAR>::Create(JSONData);
-		if (!FJsonSerializer::Deserialize(JsonReader, ParsedTableRows) || ParsedTableRows.Num() == 0)
-		{
-			ImportProblems.Add(FString::Printf(TEXT("Failed to parse the JSON data. Error: %s"), *JsonReader->GetErrorMessage()));
-			return false;
-		}
+		ImportProblems.Add(FString::Printf(TEXT("Failed to parse the JSON data. Error: %s"), *JsonReader->GetErrorMessage()));
+		JsonReader.Reset();
+		return false;
 	}
 
 	// Empty existing data
 	DataTable->EmptyTable();
 
-	// Iterate over rows
-	for (int32 RowIdx = 0; RowIdx < ParsedTableRows.Num(); ++RowIdx)
+	// Rows that don't lead with their key are read here until their name is known
+	ScratchRowData = (uint8*)FMemory::Malloc(RowStruct->GetStructureSize(), RowStruct->GetMinAlignment());
+	RowStruct->InitializeStruct(ScratchRowData);
+
+	bool bReadAll = true;
+	int32 RowIdx = 0;
+	if (Notation == EJsonNotation::ObjectStart)
 	{
-		const TSharedPtr<FJsonValue>& ParsedTableRowValue = ParsedTableRows[RowIdx];
-		TSharedPtr<FJsonObject> ParsedTableRowObject = ParsedTableRowValue->AsObject();
-		if (!ParsedTableRowObject.IsValid())
+		// A lone row, which doesn't need a key field
+		bReadAll = YReadRow(RowIdx++, TEXT("_MyTempName"));
+	}
+	else
+	{
+		while (bReadAll && JsonReader->ReadNext(Notation) && Notation != EJsonNotation::ArrayEnd)
 		{
-			ImportProblems.Add(FString::Printf(TEXT("Row '%d' is not a valid JSON object."), RowIdx));
-			continue;
+			if (Notation == EJsonNotation::ObjectStart)
+			{
+				bReadAll = YReadRow(RowIdx, nullptr);
+			}
+			else
+			{
+				ImportProblems.Add(FString::Printf(TEXT("Row '%d' is not a valid JSON object."), RowIdx));
+				bReadAll = CustomJsonToken::SkipValue(*JsonReader, Notation);
+			}
+			++RowIdx;
 		}
+		bReadAll = bReadAll && Notation == EJsonNotation::ArrayEnd;
+	}
 
-		YReadRow(ParsedTableRowObject.ToSharedRef(), RowIdx);
+	if (!bReadAll || RowIdx == 0)
+	{
+		// Rows before the error have been imported
+		ImportProblems.Add(FString::Printf(TEXT("Failed to parse the JSON data. Error: %s"), *JsonReader->GetErrorMessage()));
 	}
 
-	DataTable->Modify(true);
+	RowStruct->DestroyStruct(ScratchRowData);
+	FMemory::Free(ScratchRowData);
+	ScratchRowData = nullptr;
+	JsonReader.Reset();
 
-	return true;
+	YFinishImport(*DataTable, ImportProblems);
+
+	return bReadAll && RowIdx > 0;
 }
 
-bool FYDataTableImporterJSON::YReadRow(const TSharedRef<FJsonObject>& InParsedTableRowObject, const int32 InRowIdx)
+FName FYDataTableImporterJSON::YGetRowName(const FString& InKeyValue, const int32 InRowIdx, const TCHAR* InDefaultRowName)
 {
-	// Get row name
-	FString RowKey = DataTableJSONUtils::YGetKeyFieldName(*DataTable);
-	FName RowName = DataTableUtils::MakeValidName(InParsedTableRowObject->GetStringField(RowKey));
+	const FName RowName = DataTableUtils::MakeValidName(InKeyValue.IsEmpty() && InDefaultRowName ? FString(InDefaultRowName) : InKeyValue);
 
 	// Check its not 'none'
 	if (RowName.IsNone())
 	{
-		ImportProblems.Add(FString::Printf(TEXT("Row '%d' missing key field '%s'."), InRowIdx, *RowKey));
-		return false;
+		ImportProblems.Add(FString::Printf(TEXT("Row '%d' missing key field '%s'."), InRowIdx, *KeyField));
+		return NAME_None;
 	}
 
 	// Check its not a duplicate
 	if (!DataTable->AllowDuplicateRowsOnImport() && DataTable->GetRowMap().Find(RowName) != nullptr)
 	{
 		ImportProblems.Add(FString::Printf(TEXT("Duplicate row name '%s'."), *RowName.ToString()));
-		return false;
+		return NAME_None;
 	}
 
-	// Allocate data to store information, using UScriptStruct to know its size
-	uint8* RowData = (uint8*)FMemory::Malloc(DataTable->RowStruct->GetStructureSize());
-	DataTable->RowStruct->InitializeStruct(RowData);
-	// And be sure to call DestroyScriptStruct later
-
-	// Add to row map
-	//DataTable->AddRowInternal(RowName, RowData);
-	DataTable->AddRow(RowName, *(FTableRowBase*)RowData);
-	return YReadStruct(InParsedTableRowObject, DataTable->RowStruct, RowName, RowData);
+	return RowName;
 }
 
-bool FYDataTableImporterJSON::YReadStruct(const TSharedRef<FJsonObject>& InParsedObject, UScriptStruct* InStruct, const FName InRowName, void* InStructData)
+bool FYDataTableImporterJSON::YReadRow(const int32 InRowIdx, const TCHAR* InDefaultRowName)
 {
-	// Now read in each property
-	for (TFieldIterator<FProperty> It(InStruct); It; ++It)
-	{
-		FProperty* BaseProp = *It;
-		check(BaseProp);
+	UScriptStruct* RowStruct = DataTable->RowStruct;
 
-		const FString ColumnName = DataTableUtils::GetPropertyExportName(BaseProp);
+	EJsonNotation Notation = EJsonNotation::Error;
+	if (!JsonReader->ReadNext(Notation))
+	{
+		return false;
+	}
 
-		TSharedPtr<FJsonValue> ParsedPropertyValue;
-		for (const FString& PropertyName : DataTableUtils::GetPropertyImportNames(BaseProp))
+	// Rows written by the exporter lead with their key, so a bad name can skip the row without reading it
+	FString KeyValue;
+	FName RowName = NAME_None;
+	if (Notation != EJsonNotation::ObjectEnd && JsonReader->GetIdentifier().Equals(KeyField, ESearchCase::IgnoreCase) && CustomJsonToken::TryGetString(*JsonReader, Notation, KeyValue))
+	{
+		RowName = YGetRowName(KeyValue, InRowIdx, InDefaultRowName);
+		if (RowName.IsNone())
 		{
-			ParsedPropertyValue = InParsedObject->TryGetField(PropertyName);
-			if (ParsedPropertyValue.IsValid())
-			{
-				break;
-			}
+			return JsonReader->SkipObject();
 		}
+	}
 
-		if (!ParsedPropertyValue.IsValid())
-		{
-			// If the structure has specified the property as optional for import (gameplay code likely doing a custom fix-up or parse of that property),
-			// then avoid warning about it
-			static const FName DataTableImportOptionalMetadataKey(TEXT("DataTableImportOptional"));
-			//if (BaseProp->HasMetaData(DataTableImportOptionalMetadataKey))
-			//{
-			//	continue;
-			//}
+	// Problems are reported against the row's index until its name turns up
+	const bool bHasRowName = !RowName.IsNone();
+	if (!YReadStruct(Notation, RowStruct, bHasRowName ? RowName : FName(*FString::FromInt(InRowIdx)), ScratchRowData, bHasRowName ? nullptr : &KeyValue))
+	{
+		return false;
+	}
 
-			if (!DataTable->bIgnoreMissingFields)
-			{
-				ImportProblems.Add(FString::Printf(TEXT("Row '%s' is missing an entry for '%s'."), *InRowName.ToString(), *ColumnName));
-			}
+	if (!bHasRowName)
+	{
+		RowName = YGetRowName(KeyValue, InRowIdx, InDefaultRowName);
+	}
 
-			continue;
+	// Added only once it's filled in, since AddRow tells listeners about it
+	if (!RowName.IsNone())
+	{
+		DataTable->AddRow(RowName, *(FTableRowBase*)ScratchRowData);
+	}
+
+	RowStruct->DestroyStruct(ScratchRowData);
+	RowStruct->InitializeStruct(ScratchRowData);
+
+	return true;
+}
+
+bool FYDataTableImporterJSON::YReadStruct(EJsonNotation InNotation, const UScriptStruct* InStruct, const FName InRowName, void* InStructData, FString* OutKeyValue)
+{
+	const TSharedRef<const FCustomStructDescriptor> StructFields = CustomStructDescriptorCache::Get(InStruct);
+	TBitArray<> FoundFields(false, StructFields->Fields.Num());
+
+	// Now read in each property, in the order the JSON has them
+	while (InNotation != EJsonNotation::ObjectEnd)
+	{
+		const FString& Identifier = JsonReader->GetIdentifier();
+
+		if (OutKeyValue && Identifier.Equals(KeyField, ESearchCase::IgnoreCase))
+		{
+			CustomJsonToken::TryGetString(*JsonReader, InNotation, *OutKeyValue);
 		}
 
-		if (BaseProp->ArrayDim == 1)
+		const int32* FieldIdx = StructFields->FieldsByImportName.Find(Identifier);
+		if (!FieldIdx || FoundFields[*FieldIdx])
 		{
-			void* Data = BaseProp->ContainerPtrToValuePtr<void>(InStructData, 0);
-			YReadStructEntry(ParsedPropertyValue.ToSharedRef(), InRowName, ColumnName, InStructData, BaseProp, Data);
+			// Not a property, or one that has already been read under another of its names
+			if (!CustomJsonToken::SkipValue(*JsonReader, InNotation))
+			{
+				return false;
+			}
 		}
 		else
 		{
-			const TCHAR* const ParsedPropertyType = JSONTypeToString(ParsedPropertyValue->Type);
+			FoundFields[*FieldIdx] = true;
+
+			const FCustomStructDescriptor::FField& Field = StructFields->Fields[*FieldIdx];
+			FProperty* BaseProp = Field.Property;
 
-			const TArray< TSharedPtr<FJsonValue> >* PropertyValuesPtr;
-			if (!ParsedPropertyValue->TryGetArray(PropertyValuesPtr))
+			if (InNotation == EJsonNotation::Null)
 			{
-				ImportProblems.Add(FString::Printf(TEXT("Property '%s' on row '%s' is the incorrect type. Expected Array, got %s."), *ColumnName, *InRowName.ToString(), ParsedPropertyType));
-				return false;
+				// Left as the struct's default
 			}
-
-			if (BaseProp->ArrayDim != PropertyValuesPtr->Num())
+			else if (BaseProp->ArrayDim == 1)
+			{
+				void* Data = BaseProp->ContainerPtrToValuePtr<void>(InStructData, 0);
+				if (!YReadStructEntry(InNotation, InRowName, Field.ColumnName, InStructData, BaseProp, Data))
+				{
+					return false;
+				}
+			}
+			else if (InNotation != EJsonNotation::ArrayStart)
 			{
-				ImportProblems.Add(FString::Printf(TEXT("Property '%s' on row '%s' is a static sized array with %d elements, but we have %d values to import"), *ColumnName, *InRowName.ToString(), BaseProp->ArrayDim, PropertyValuesPtr->Num()));
+				ImportProblems.Add(FString::Printf(TEXT("Property '%s' on row '%s' is the incorrect type. Expected Array, got %s."), *Field.ColumnName, *InRowName.ToString(), CustomJsonToken::NotationToString(InNotation)));
+				if (!CustomJsonToken::SkipValue(*JsonReader, InNotation))
+				{
+					return false;
+				}
 			}
-
-			for (int32 ArrayEntryIndex = 0; ArrayEntryIndex < BaseProp->ArrayDim; ++ArrayEntryIndex)
+			else
 			{
-				if (PropertyValuesPtr->IsValidIndex(ArrayEntryIndex))
+				int32 ArrayEntryIndex = 0;
+				EJsonNotation EntryNotation = EJsonNotation::Error;
+				while (JsonReader->ReadNext(EntryNotation) && EntryNotation != EJsonNotation::ArrayEnd)
 				{
-					void* Data = BaseProp->ContainerPtrToValuePtr<void>(InStructData, ArrayEntryIndex);
-					const TSharedPtr<FJsonValue>& PropertyValueEntry = (*PropertyValuesPtr)[ArrayEntryIndex];
-					YReadContainerEntry(PropertyValueEntry.ToSharedRef(), InRowName, ColumnName, ArrayEntryIndex, BaseProp, Data);
+					const bool bEntryRead = ArrayEntryIndex < BaseProp->ArrayDim
+						? YReadContainerEntry(EntryNotation, InRowName, Field.ColumnName, ArrayEntryIndex, BaseProp, BaseProp->ContainerPtrToValuePtr<void>(InStructData, ArrayEntryIndex))
+						: CustomJsonToken::SkipValue(*JsonReader, EntryNotation);
+
+					if (!bEntryRead)
+					{
+						return false;
+					}
+					++ArrayEntryIndex;
 				}
+
+				if (EntryNotation != EJsonNotation::ArrayEnd)
+				{
+					return false;
+				}
+
+				if (BaseProp->ArrayDim != ArrayEntryIndex)
+				{
+					ImportProblems.Add(FString::Printf(TEXT("Property '%s' on row '%s' is a static sized array with %d elements, but we have %d values to import"), *Field.ColumnName, *InRowName.ToString(), BaseProp->ArrayDim, ArrayEntryIndex));
+				}
+			}
+		}
+
+		if (!JsonReader->ReadNext(InNotation))
+		{
+			return false;
+		}
+	}
+
+	if (!DataTable->bIgnoreMissingFields)
+	{
+		for (int32 FieldIdx = 0; FieldIdx < StructFields->Fields.Num(); ++FieldIdx)
+		{
+			if (!FoundFields[FieldIdx])
+			{
+				ImportProblems.Add(FString::Printf(TEXT("Row '%s' is missing an entry for '%s'."), *InRowName.ToString(), *StructFields->Fields[FieldIdx].ColumnName));
 			}
 		}
 	}
@@ -1121,29 +1309,28 @@ bool FYDataTableImporterJSON::YReadStruct(const TSharedRef<FJsonObject>& InParse
 	return true;
 }
 
-bool FYDataTableImporterJSON::YReadStructEntry(const TSharedRef<FJsonValue>& InParsedPropertyValue, const FName InRowName, const FString& InColumnName, const void* InRowData, FProperty* InProperty, void* InPropertyData)
+bool FYDataTableImporterJSON::YReadStructEntry(const EJsonNotation InNotation, const FName InRowName, const FString& InColumnName, const void* InRowData, FProperty* InProperty, void* InPropertyData)
 {
-	const TCHAR* const ParsedPropertyType = JSONTypeToString(InParsedPropertyValue->Type);
+	const TCHAR* const ParsedPropertyType = CustomJsonToken::NotationToString(InNotation);
 
 	if (FEnumProperty* EnumProp = CastField<FEnumProperty>(InProperty))
 	{
 		FString EnumValue;
-		if (InParsedPropertyValue->TryGetString(EnumValue))
+		if (CustomJsonToken::TryGetString(*JsonReader, InNotation, EnumValue))
 		{
 			FString Error = DataTableUtils::AssignStringToProperty(EnumValue, InProperty, (uint8*)InRowData);
 			if (!Error.IsEmpty())
 			{
 				ImportProblems.Add(FString::Printf(TEXT("Property '%s' on row '%s' has invalid enum value: %s."), *InColumnName, *InRowName.ToString(), *EnumValue));
-				return false;
 			}
 		}
 		else
 		{
 			int64 PropertyValue = 0;
-			if (!InParsedPropertyValue->TryGetNumber(PropertyValue))
+			if (!CustomJsonToken::TryGetNumber(*JsonReader, InNotation, PropertyValue))
 			{
 				ImportProblems.Add(FString::Printf(TEXT("Property '%s' on row '%s' is the incorrect type. Expected Integer, got %s."), *InColumnName, *InRowName.ToString(), ParsedPropertyType));
-				return false;
+				return CustomJsonToken::SkipValue(*JsonReader, InNotation);
 			}
 
 			EnumProp->GetUnderlyingProperty()->SetIntPropertyValue(InPropertyData, PropertyValue);
@@ -1152,22 +1339,21 @@ bool FYDataTableImporterJSON::YReadStructEntry(const TSharedRef<FJsonValue>& InP
 	else if (FNumericProperty* NumProp = CastField<FNumericProperty>(InProperty))
 	{
 		FString EnumValue;
-		if (NumProp->IsEnum() && InParsedPropertyValue->TryGetString(EnumValue))
+		if (NumProp->IsEnum() && CustomJsonToken::TryGetString(*JsonReader, InNotation, EnumValue))
 		{
 			FString Error = DataTableUtils::AssignStringToProperty(EnumValue, InProperty, (uint8*)InRowData);
 			if (!Error.IsEmpty())
 			{
 				ImportProblems.Add(FString::Printf(TEXT("Property '%s' on row '%s' has invalid enum value: %s."), *InColumnName, *InRowName.ToString(), *EnumValue));
-				return false;
 			}
 		}
 		else if (NumProp->IsInteger())
 		{
 			int64 PropertyValue = 0;
-			if (!InParsedPropertyValue->TryGetNumber(PropertyValue))
+			if (!CustomJsonToken::TryGetNumber(*JsonReader, InNotation, PropertyValue))
 			{
 				ImportProblems.Add(FString::Printf(TEXT("Property '%s' on row '%s' is the incorrect type. Expected Integer, got %s."), *InColumnName, *InRowName.ToString(), ParsedPropertyType));
-				return false;
+				return CustomJsonToken::SkipValue(*JsonReader, InNotation);
 			}
 
 			NumProp->SetIntPropertyValue(InPropertyData, PropertyValue);
@@ -1175,10 +1361,10 @@ bool FYDataTableImporterJSON::YReadStructEntry(const TSharedRef<FJsonValue>& InP
 		else
 		{
 			double PropertyValue = 0.0;
-			if (!InParsedPropertyValue->TryGetNumber(PropertyValue))
+			if (!CustomJsonToken::TryGetNumber(*JsonReader, InNotation, PropertyValue))
 			{
 				ImportProblems.Add(FString::Printf(TEXT("Property '%s' on row '%s' is the incorrect type. Expected Double, got %s."), *InColumnName, *InRowName.ToString(), ParsedPropertyType));
-				return false;
+				return CustomJsonToken::SkipValue(*JsonReader, InNotation);
 			}
 
 			NumProp->SetFloatingPointPropertyValue(InPropertyData, PropertyValue);
@@ -1187,155 +1373,169 @@ bool FYDataTableImporterJSON::YReadStructEntry(const TSharedRef<FJsonValue>& InP
 	else if (FBoolProperty* BoolProp = CastField<FBoolProperty>(InProperty))
 	{
 		bool PropertyValue = false;
-		if (!InParsedPropertyValue->TryGetBool(PropertyValue))
+		if (!CustomJsonToken::TryGetBool(*JsonReader, InNotation, PropertyValue))
 		{
 			ImportProblems.Add(FString::Printf(TEXT("Property '%s' on row '%s' is the incorrect type. Expected Boolean, got %s."), *InColumnName, *InRowName.ToString(), ParsedPropertyType));
-			return false;
+			return CustomJsonToken::SkipValue(*JsonReader, InNotation);
 		}
 
 		BoolProp->SetPropertyValue(InPropertyData, PropertyValue);
 	}
 	else if (FArrayProperty* ArrayProp = CastField<FArrayProperty>(InProperty))
 	{
-		const TArray< TSharedPtr<FJsonValue> >* PropertyValuesPtr;
-		if (!InParsedPropertyValue->TryGetArray(PropertyValuesPtr))
+		if (InNotation != EJsonNotation::ArrayStart)
 		{
 			ImportProblems.Add(FString::Printf(TEXT("Property '%s' on row '%s' is the incorrect type. Expected Array, got %s."), *InColumnName, *InRowName.ToString(), ParsedPropertyType));
-			return false;
+			return CustomJsonToken::SkipValue(*JsonReader, InNotation);
 		}
 
 		FScriptArrayHelper ArrayHelper(ArrayProp, InPropertyData);
 		ArrayHelper.EmptyValues();
-		for (const TSharedPtr<FJsonValue>& PropertyValueEntry : *PropertyValuesPtr)
+
+		EJsonNotation EntryNotation = EJsonNotation::Error;
+		while (JsonReader->ReadNext(EntryNotation) && EntryNotation != EJsonNotation::ArrayEnd)
 		{
 			const int32 NewEntryIndex = ArrayHelper.AddValue();
 			uint8* ArrayEntryData = ArrayHelper.GetRawPtr(NewEntryIndex);
-			YReadContainerEntry(PropertyValueEntry.ToSharedRef(), InRowName, InColumnName, NewEntryIndex, ArrayProp->Inner, ArrayEntryData);
+			if (!YReadContainerEntry(EntryNotation, InRowName, InColumnName, NewEntryIndex, ArrayProp->Inner, ArrayEntryData))
+			{
+				return false;
+			}
 		}
+		return EntryNotation == EJsonNotation::ArrayEnd;
 	}
 	else if (FSetProperty* SetProp = CastField<FSetProperty>(InProperty))
 	{
-		const TArray< TSharedPtr<FJsonValue> >* PropertyValuesPtr;
-		if (!InParsedPropertyValue->TryGetArray(PropertyValuesPtr))
+		if (InNotation != EJsonNotation::ArrayStart)
 		{
 			ImportProblems.Add(FString::Printf(TEXT("Property '%s' on row '%s' is the incorrect type. Expected Array, got %s."), *InColumnName, *InRowName.ToString(), ParsedPropertyType));
-			return false;
+			return CustomJsonToken::SkipValue(*JsonReader, InNotation);
 		}
 
 		FScriptSetHelper SetHelper(SetProp, InPropertyData);
 		SetHelper.EmptyElements();
-		for (const TSharedPtr<FJsonValue>& PropertyValueEntry : *PropertyValuesPtr)
+
+		bool bEntriesRead = true;
+		EJsonNotation EntryNotation = EJsonNotation::Error;
+		while (bEntriesRead && JsonReader->ReadNext(EntryNotation) && EntryNotation != EJsonNotation::ArrayEnd)
 		{
 			const int32 NewEntryIndex = SetHelper.AddDefaultValue_Invalid_NeedsRehash();
 			uint8* SetEntryData = SetHelper.GetElementPtr(NewEntryIndex);
-			YReadContainerEntry(PropertyValueEntry.ToSharedRef(), InRowName, InColumnName, NewEntryIndex, SetHelper.GetElementProperty(), SetEntryData);
+			bEntriesRead = YReadContainerEntry(EntryNotation, InRowName, InColumnName, NewEntryIndex, SetHelper.GetElementProperty(), SetEntryData);
 		}
+		// Even when giving up, so the set is never left unhashed
 		SetHelper.Rehash();
+
+		return bEntriesRead && EntryNotation == EJsonNotation::ArrayEnd;
 	}
 	else if (FMapProperty* MapProp = CastField<FMapProperty>(InProperty))
 	{
-		const TSharedPtr<FJsonObject>* PropertyValue;
-		if (!InParsedPropertyValue->TryGetObject(PropertyValue))
+		if (InNotation != EJsonNotation::ObjectStart)
 		{
 			ImportProblems.Add(FString::Printf(TEXT("Property '%s' on row '%s' is the incorrect type. Expected Object, got %s."), *InColumnName, *InRowName.ToString(), ParsedPropertyType));
-			return false;
+			return CustomJsonToken::SkipValue(*JsonReader, InNotation);
 		}
 
 		FScriptMapHelper MapHelper(MapProp, InPropertyData);
 		MapHelper.EmptyValues();
-		for (const auto& PropertyValuePair : (*PropertyValue)->Values)
+
+		bool bEntriesRead = true;
+		EJsonNotation EntryNotation = EJsonNotation::Error;
+		while (bEntriesRead && JsonReader->ReadNext(EntryNotation) && EntryNotation != EJsonNotation::ObjectEnd)
 		{
+			const FString& EntryKey = JsonReader->GetIdentifier();
+
 			const int32 NewEntryIndex = MapHelper.AddDefaultValue_Invalid_NeedsRehash();
 			uint8* MapKeyData = MapHelper.GetKeyPtr(NewEntryIndex);
 			uint8* MapValueData = MapHelper.GetValuePtr(NewEntryIndex);
 
 			// JSON object keys are always strings
-			const FString KeyError = DataTableUtils::AssignStringToPropertyDirect(PropertyValuePair.Key, MapHelper.GetKeyProperty(), MapKeyData);
+			const FString KeyError = DataTableUtils::AssignStringToPropertyDirect(EntryKey, MapHelper.GetKeyProperty(), MapKeyData);
 			if (KeyError.Len() > 0)
 			{
+				ImportProblems.Add(FString::Printf(TEXT("Problem assigning key '%s' to property '%s' on row '%s' : %s"), *EntryKey, *InColumnName, *InRowName.ToString(), *KeyError));
 				MapHelper.RemoveAt(NewEntryIndex);
-				ImportProblems.Add(FString::Printf(TEXT("Problem assigning key '%s' to property '%s' on row '%s' : %s"), *PropertyValuePair.Key, *InColumnName, *InRowName.ToString(), *KeyError));
-				return false;
+				bEntriesRead = CustomJsonToken::SkipValue(*JsonReader, EntryNotation);
+				continue;
 			}
 
-			if (!YReadContainerEntry(PropertyValuePair.Value.ToSharedRef(), InRowName, InColumnName, NewEntryIndex, MapHelper.GetValueProperty(), MapValueData))
+			// Entries whose value couldn't be read are dropped rather than left at defaults
+			const int32 NumProblems = ImportProblems.Num();
+			bEntriesRead = YReadContainerEntry(EntryNotation, InRowName, InColumnName, NewEntryIndex, MapHelper.GetValueProperty(), MapValueData);
+			if (ImportProblems.Num() > NumProblems)
 			{
 				MapHelper.RemoveAt(NewEntryIndex);
-				return false;
 			}
 		}
 		MapHelper.Rehash();
+
+		return bEntriesRead && EntryNotation == EJsonNotation::ObjectEnd;
 	}
 	else if (FStructProperty* StructProp = CastField<FStructProperty>(InProperty))
 	{
-		const TSharedPtr<FJsonObject>* PropertyValue = nullptr;
-		if (InParsedPropertyValue->TryGetObject(PropertyValue))
+		if (InNotation == EJsonNotation::ObjectStart)
 		{
-			return YReadStruct(PropertyValue->ToSharedRef(), StructProp->Struct, InRowName, InPropertyData);
+			EJsonNotation MemberNotation = EJsonNotation::Error;
+			return JsonReader->ReadNext(MemberNotation) && YReadStruct(MemberNotation, StructProp->Struct, InRowName, InPropertyData, nullptr);
 		}
 		else
 		{
 			// If the JSON does not contain a JSON object for this struct, we try to use the backwards-compatible string deserialization, same as the "else" block below
 			FString PropertyValueString;
-			if (!InParsedPropertyValue->TryGetString(PropertyValueString))
+			if (!CustomJsonToken::TryGetString(*JsonReader, InNotation, PropertyValueString))
 			{
 				ImportProblems.Add(FString::Printf(TEXT("Property '%s' on row '%s' is the incorrect type. Expected String, got %s."), *InColumnName, *InRowName.ToString(), ParsedPropertyType));
-				return false;
+				return CustomJsonToken::SkipValue(*JsonReader, InNotation);
 			}
 
 			const FString Error = DataTableUtils::AssignStringToProperty(PropertyValueString, InProperty, (uint8*)InRowData);
 			if (Error.Len() > 0)
 			{
 				ImportProblems.Add(FString::Printf(TEXT("Problem assigning string '%s' to property '%s' on row '%s' : %s"), *PropertyValueString, *InColumnName, *InRowName.ToString(), *Error));
-				return false;
 			}
-
-			return true;
 		}
 	}
 	else
 	{
 		FString PropertyValue;
-		if (!InParsedPropertyValue->TryGetString(PropertyValue))
+		if (!CustomJsonToken::TryGetString(*JsonReader, InNotation, PropertyValue))
 		{
 			ImportProblems.Add(FString::Printf(TEXT("Property '%s' on row '%s' is the incorrect type. Expected String, got %s."), *InColumnName, *InRowName.ToString(), ParsedPropertyType));
-			return false;
+			return CustomJsonToken::SkipValue(*JsonReader, InNotation);
 		}
 
 		const FString Error = DataTableUtils::AssignStringToProperty(PropertyValue, InProperty, (uint8*)InRowData);
 		if (Error.Len() > 0)
 		{
 			ImportProblems.Add(FString::Printf(TEXT("Problem assigning string '%s' to property '%s' on row '%s' : %s"), *PropertyValue, *InColumnName, *InRowName.ToString(), *Error));
-			return false;
 		}
 	}
 
 	return true;
 }
 
-bool FYDataTableImporterJSON::YReadContainerEntry(const TSharedRef<FJsonValue>& InParsedPropertyValue, const FName InRowName, const FString& InColumnName, const int32 InArrayEntryIndex, FProperty* InProperty, void* InPropertyData)
+bool FYDataTableImporterJSON::YReadContainerEntry(const EJsonNotation InNotation, const FName InRowName, const FString& InColumnName, const int32 InArrayEntryIndex, FProperty* InProperty, void* InPropertyData)
 {
-	const TCHAR* const ParsedPropertyType = JSONTypeToString(InParsedPropertyValue->Type);
+	const TCHAR* const ParsedPropertyType = CustomJsonToken::NotationToString(InNotation);
 
 	if (FEnumProperty* EnumProp = CastField<FEnumProperty>(InProperty))
 	{
 		FString EnumValue;
-		if (InParsedPropertyValue->TryGetString(EnumValue))
+		if (CustomJsonToken::TryGetString(*JsonReader, InNotation, EnumValue))
 		{
 			FString Error = DataTableUtils::AssignStringToPropertyDirect(EnumValue, InProperty, (uint8*)InPropertyData);
 			if (!Error.IsEmpty())
 			{
 				ImportProblems.Add(FString::Printf(TEXT("Entry %d on property '%s' on row '%s' has invalid enum value: %s."), InArrayEntryIndex, *InColumnName, *InRowName.ToString(), *EnumValue));
-				return false;
 			}
 		}
 		else
 		{
 			int64 PropertyValue = 0;
-			if (!InParsedPropertyValue->TryGetNumber(PropertyValue))
+			if (!CustomJsonToken::TryGetNumber(*JsonReader, InNotation, PropertyValue))
 			{
 				ImportProblems.Add(FString::Printf(TEXT("Entry %d on property '%s' on row '%s' is the incorrect type. Expected Integer, got %s."), InArrayEntryIndex, *InColumnName, *InRowName.ToString(), ParsedPropertyType));
-				return false;
+				return CustomJsonToken::SkipValue(*JsonReader, InNotation);
 			}
 
 			EnumProp->GetUnderlyingProperty()->SetIntPropertyValue(InPropertyData, PropertyValue);
@@ -1344,22 +1544,21 @@ bool FYDataTableImporterJSON::YReadContainerEntry(const TSharedRef<FJsonValue>&
 	else if (FNumericProperty* NumProp = CastField<FNumericProperty>(InProperty))
 	{
 		FString EnumValue;
-		if (NumProp->IsEnum() && InParsedPropertyValue->TryGetString(EnumValue))
+		if (NumProp->IsEnum() && CustomJsonToken::TryGetString(*JsonReader, InNotation, EnumValue))
 		{
 			FString Error = DataTableUtils::AssignStringToPropertyDirect(EnumValue, InProperty, (uint8*)InPropertyData);
 			if (!Error.IsEmpty())
 			{
 				ImportProblems.Add(FString::Printf(TEXT("Entry %d on property '%s' on row '%s' has invalid enum value: %s."), InArrayEntryIndex, *InColumnName, *InRowName.ToString(), *EnumValue));
-				return false;
 			}
 		}
 		else if (NumProp->IsInteger())
 		{
 			int64 PropertyValue = 0;
-			if (!InParsedPropertyValue->TryGetNumber(PropertyValue))
+			if (!CustomJsonToken::TryGetNumber(*JsonReader, InNotation, PropertyValue))
 			{
 				ImportProblems.Add(FString::Printf(TEXT("Entry %d on property '%s' on row '%s' is the incorrect type. Expected Integer, got %s."), InArrayEntryIndex, *InColumnName, *InRowName.ToString(), ParsedPropertyType));
-				return false;
+				return CustomJsonToken::SkipValue(*JsonReader, InNotation);
 			}
 
 			NumProp->SetIntPropertyValue(InPropertyData, PropertyValue);
@@ -1367,10 +1566,10 @@ bool FYDataTableImporterJSON::YReadContainerEntry(const TSharedRef<FJsonValue>&
 		else
 		{
 			double PropertyValue = 0.0;
-			if (!InParsedPropertyValue->TryGetNumber(PropertyValue))
+			if (!CustomJsonToken::TryGetNumber(*JsonReader, InNotation, PropertyValue))
 			{
 				ImportProblems.Add(FString::Printf(TEXT("Entry %d on property '%s' on row '%s' is the incorrect type. Expected Double, got %s."), InArrayEntryIndex, *InColumnName, *InRowName.ToString(), ParsedPropertyType));
-				return false;
+				return CustomJsonToken::SkipValue(*JsonReader, InNotation);
 			}
 
 			NumProp->SetFloatingPointPropertyValue(InPropertyData, PropertyValue);
@@ -1379,73 +1578,309 @@ bool FYDataTableImporterJSON::YReadContainerEntry(const TSharedRef<FJsonValue>&
 	else if (FBoolProperty* BoolProp = CastField<FBoolProperty>(InProperty))
 	{
 		bool PropertyValue = false;
-		if (!InParsedPropertyValue->TryGetBool(PropertyValue))
+		if (!CustomJsonToken::TryGetBool(*JsonReader, InNotation, PropertyValue))
 		{
 			ImportProblems.Add(FString::Printf(TEXT("Entry %d on property '%s' on row '%s' is the incorrect type. Expected Boolean, got %s."), InArrayEntryIndex, *InColumnName, *InRowName.ToString(), ParsedPropertyType));
-			return false;
+			return CustomJsonToken::SkipValue(*JsonReader, InNotation);
 		}
 
 		BoolProp->SetPropertyValue(InPropertyData, PropertyValue);
 	}
-	else if (FArrayProperty* ArrayProp = CastField<FArrayProperty>(InProperty))
+	else if (InProperty->IsA<FArrayProperty>() || InProperty->IsA<FSetProperty>() || InProperty->IsA<FMapProperty>())
 	{
-		// Cannot nest arrays
-		return false;
-	}
-	else if (FSetProperty* SetProp = CastField<FSetProperty>(InProperty))
-	{
-		// Cannot nest sets
-		return false;
-	}
-	else if (FMapProperty* MapProp = CastField<FMapProperty>(InProperty))
-	{
-		// Cannot nest maps
-		return false;
+		// Cannot nest arrays, sets or maps
+		return CustomJsonToken::SkipValue(*JsonReader, InNotation);
 	}
 	else if (FStructProperty* StructProp = CastField<FStructProperty>(InProperty))
 	{
-		const TSharedPtr<FJsonObject>* PropertyValue = nullptr;
-		if (InParsedPropertyValue->TryGetObject(PropertyValue))
+		if (InNotation == EJsonNotation::ObjectStart)
 		{
-			return YReadStruct(PropertyValue->ToSharedRef(), StructProp->Struct, InRowName, InPropertyData);
+			EJsonNotation MemberNotation = EJsonNotation::Error;
+			return JsonReader->ReadNext(MemberNotation) && YReadStruct(MemberNotation, StructProp->Struct, InRowName, InPropertyData, nullptr);
 		}
 		else
 		{
 			// If the JSON does not contain a JSON object for this struct, we try to use the backwards-compatible string deserialization, same as the "else" block below
 			FString PropertyValueString;
-			if (!InParsedPropertyValue->TryGetString(PropertyValueString))
+			if (!CustomJsonToken::TryGetString(*JsonReader, InNotation, PropertyValueString))
 			{
 				ImportProblems.Add(FString::Printf(TEXT("Property '%s' on row '%s' is the incorrect type. Expected String, got %s."), *InColumnName, *InRowName.ToString(), ParsedPropertyType));
-				return false;
+				return CustomJsonToken::SkipValue(*JsonReader, InNotation);
 			}
 
 			const FString Error = DataTableUtils::AssignStringToPropertyDirect(PropertyValueString, InProperty, (uint8*)InPropertyData);
 			if (Error.Len() > 0)
 			{
-				ImportProblems.Add(FString::Printf(TEXT("Problem assigning string '%s' to entry %d on property '%s' on row '%s' : %s"), InArrayEntryIndex, *PropertyValueString, *InColumnName, *InRowName.ToString(), *Error));
-				return false;
+				ImportProblems.Add(FString::Printf(TEXT("Problem assigning string '%s' to entry %d on property '%s' on row '%s' : %s"), *PropertyValueString, InArrayEntryIndex, *InColumnName, *InRowName.ToString(), *Error));
 			}
-
-			return true;
 		}
 	}
 	else
 	{
 		FString PropertyValue;
-		if (!InParsedPropertyValue->TryGetString(PropertyValue))
+		if (!CustomJsonToken::TryGetString(*JsonReader, InNotation, PropertyValue))
 		{
 			ImportProblems.Add(FString::Printf(TEXT("Entry %d on property '%s' on row '%s' is the incorrect type. Expected String, got %s."), InArrayEntryIndex, *InColumnName, *InRowName.ToString(), ParsedPropertyType));
-			return false;
+			return CustomJsonToken::SkipValue(*JsonReader, InNotation);
 		}
 
 		const FString Error = DataTableUtils::AssignStringToPropertyDirect(PropertyValue, InProperty, (uint8*)InPropertyData);
 		if (Error.Len() > 0)
 		{
-			ImportProblems.Add(FString::Printf(TEXT("Problem assigning string '%s' to entry %d on property '%s' on row '%s' : %s"), InArrayEntryIndex, *PropertyValue, *InColumnName, *InRowName.ToString(), *Error));
-			return false;
+			ImportProblems.Add(FString::Printf(TEXT("Problem assigning string '%s' to entry %d on property '%s' on row '%s' : %s"), *PropertyValue, InArrayEntryIndex, *InColumnName, *InRowName.ToString(), *Error));
 		}
 	}
 
 	return true;
 }
 
+
+
+namespace
+{
+	/** Walks CSV text one cell at a time, with quoted cells and CRLF, LF or CR line ends */
+	class FYCsvTokenizer
+	{
+	public:
+		explicit FYCsvTokenizer(const FString& InData)
+			: Cursor(*InData)
+			, End(*InData + InData.Len())
+		{
+		}
+
+		bool IsAtEnd() const
+		{
+			return Cursor >= End;
+		}
+
+		/** Reads the next cell into OutCell. Returns true if another cell follows on the same row. */
+		bool ReadCell(FString& OutCell)
+		{
+			OutCell.Reset();
+
+			if (Cursor < End && *Cursor == TEXT('"'))
+			{
+				++Cursor;
+				while (Cursor < End)
+				{
+					const TCHAR* Start = Cursor;
+					while (Cursor < End && *Cursor != TEXT('"'))
+					{
+						++Cursor;
+					}
+					OutCell.AppendChars(Start, UE_PTRDIFF_TO_INT32(Cursor - Start));
+
+					if (Cursor >= End)
+					{
+						break;
+					}
+
+					// Either the closing quote or the first of an escaped pair
+					++Cursor;
+					if (Cursor < End && *Cursor == TEXT('"'))
+					{
+						OutCell.AppendChar(TEXT('"'));
+						++Cursor;
+						continue;
+					}
+					break;
+				}
+			}
+
+			// Unquoted cells, and anything after a closing quote, run up to the next separator
+			const TCHAR* Start = Cursor;
+			while (Cursor < End && *Cursor != TEXT(',') && *Cursor != TEXT('\n') && *Cursor != TEXT('\r'))
+			{
+				++Cursor;
+			}
+			OutCell.AppendChars(Start, UE_PTRDIFF_TO_INT32(Cursor - Start));
+
+			if (Cursor >= End)
+			{
+				return false;
+			}
+
+			const TCHAR Separator = *Cursor++;
+			if (Separator == TEXT('\r') && Cursor < End && *Cursor == TEXT('\n'))
+			{
+				++Cursor;
+			}
+			return Separator == TEXT(',');
+		}
+
+		void SkipRow(FString& Scratch)
+		{
+			while (ReadCell(Scratch))
+			{
+			}
+		}
+
+	private:
+		const TCHAR* Cursor;
+		const TCHAR* End;
+	};
+}
+
+FYDataTableImporterCSV::FYDataTableImporterCSV(UDataTable& InDataTable, const FString& InCSVData, TArray<FString>& OutProblems)
+	: DataTable(&InDataTable)
+	, CSVData(InCSVData)
+	, ImportProblems(OutProblems)
+{
+}
+
+FYDataTableImporterCSV::~FYDataTableImporterCSV()
+{
+}
+
+bool FYDataTableImporterCSV::YReadTable()
+{
+	if (CSVData.IsEmpty())
+	{
+		ImportProblems.Add(TEXT("Input data is empty."));
+		return false;
+	}
+
+	// Check we have a RowStruct specified
+	UScriptStruct* RowStruct = DataTable->RowStruct;
+	if (!RowStruct)
+	{
+		ImportProblems.Add(TEXT("No RowStruct specified."));
+		return false;
+	}
+
+	const TSharedRef<const FCustomStructDescriptor> RowDescriptor = CustomStructDescriptorCache::Get(RowStruct);
+
+	FYCsvTokenizer Tokenizer(CSVData);
+	FString Cell;
+
+	// The header. Its first cell names the row name column, which isn't a property.
+	TArray<FProperty*> ColumnProperties;
+	ColumnProperties.Add(nullptr);
+	{
+		bool bMoreCells = Tokenizer.ReadCell(Cell);
+		while (bMoreCells)
+		{
+			bMoreCells = Tokenizer.ReadCell(Cell);
+
+			const int32 ColumnIdx = ColumnProperties.Num();
+			FProperty* ColumnProp = nullptr;
+
+			const FString ColumnName = Cell.TrimStartAndEnd();
+			if (ColumnName.IsEmpty())
+			{
+				ImportProblems.Add(FString::Printf(TEXT("Missing name for column %d."), ColumnIdx));
+			}
+			else if (FProperty* const* FoundProp = RowDescriptor->ColumnProperties.Find(FName(*ColumnName)))
+			{
+				ColumnProp = *FoundProp;
+				if (ColumnProperties.Contains(ColumnProp))
+				{
+					ImportProblems.Add(FString::Printf(TEXT("Duplicate column '%s'."), *ColumnName));
+					ColumnProp = nullptr;
+				}
+			}
+			else if (!DataTable->bIgnoreExtraFields)
+			{
+				ImportProblems.Add(FString::Printf(TEXT("Cannot find Property for column '%s' in struct '%s'."), *ColumnName, *RowStruct->GetName()));
+			}
+
+			ColumnProperties.Add(ColumnProp);
+		}
+	}
+
+	if (!DataTable->bIgnoreMissingFields)
+	{
+		for (TFieldIterator<FProperty> It(RowStruct); It; ++It)
+		{
+			if (!ColumnProperties.Contains(*It))
+			{
+				ImportProblems.Add(FString::Printf(TEXT("Expected column '%s' not found in input."), *DataTableUtils::GetPropertyExportName(*It)));
+			}
+		}
+	}
+
+	// Empty existing data
+	DataTable->EmptyTable();
+
+	// Each row is read into a copy of the defaults and only added once all its cells are in.
+	// AddRow broadcasts for every row, so listeners only ever see finished rows.
+	uint8* DefaultRowData = (uint8*)FMemory::Malloc(RowStruct->GetStructureSize(), RowStruct->GetMinAlignment());
+	RowStruct->InitializeStruct(DefaultRowData);
+
+	uint8* RowData = (uint8*)FMemory::Malloc(RowStruct->GetStructureSize(), RowStruct->GetMinAlignment());
+	RowStruct->InitializeStruct(RowData);
+
+	for (int32 RowIdx = 1; !Tokenizer.IsAtEnd(); ++RowIdx)
+	{
+		bool bMoreCells = Tokenizer.ReadCell(Cell);
+
+		// Blank lines, usually just the one at the end
+		if (!bMoreCells && Cell.IsEmpty())
+		{
+			continue;
+		}
+
+		const FName RowName = DataTableUtils::MakeValidName(Cell);
+
+		// Check its not 'none'
+		if (RowName.IsNone())
+		{
+			ImportProblems.Add(FString::Printf(TEXT("Row '%d' missing a name."), RowIdx));
+			if (bMoreCells)
+			{
+				Tokenizer.SkipRow(Cell);
+			}
+			continue;
+		}
+
+		// Check its not a duplicate
+		if (!DataTable->AllowDuplicateRowsOnImport() && DataTable->GetRowMap().Find(RowName) != nullptr)
+		{
+			ImportProblems.Add(FString::Printf(TEXT("Duplicate row name '%s'."), *RowName.ToString()));
+			if (bMoreCells)
+			{
+				Tokenizer.SkipRow(Cell);
+			}
+			continue;
+		}
+
+		for (int32 ColumnIdx = 1; bMoreCells; ++ColumnIdx)
+		{
+			bMoreCells = Tokenizer.ReadCell(Cell);
+
+			if (!ColumnProperties.IsValidIndex(ColumnIdx))
+			{
+				ImportProblems.Add(FString::Printf(TEXT("Too many cells on row '%s'."), *RowName.ToString()));
+				if (bMoreCells)
+				{
+					Tokenizer.SkipRow(Cell);
+				}
+				break;
+			}
+
+			FProperty* ColumnProp = ColumnProperties[ColumnIdx];
+			if (!ColumnProp)
+			{
+				continue;
+			}
+
+			const FString Error = DataTableUtils::AssignStringToProperty(Cell, ColumnProp, RowData);
+			if (Error.Len() > 0)
+			{
+				ImportProblems.Add(FString::Printf(TEXT("Problem assigning string '%s' to property '%s' on row '%s' : %s"), *Cell, *DataTableUtils::GetPropertyExportName(ColumnProp), *RowName.ToString(), *Error));
+			}
+		}
+
+		DataTable->AddRow(RowName, *(FTableRowBase*)RowData);
+		RowStruct->CopyScriptStruct(RowData, DefaultRowData);
+	}
+
+	RowStruct->DestroyStruct(RowData);
+	FMemory::Free(RowData);
+	RowStruct->DestroyStruct(DefaultRowData);
+	FMemory::Free(DefaultRowData);
+
+	YFinishImport(*DataTable, ImportProblems);
+
+	return ImportProblems.Num() == 0;
+}
@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "UObject/Class.h"
+#include "Templates/Function.h"
 #include "Serialization/JsonTypes.h"
 #include "Dom/JsonObject.h"
 #include "Serialization/JsonReader.h"
@@ -18,6 +19,12 @@ public:
 	/** FName case insensitivity can make the casing of UPROPERTIES unpredictable. Attempt to standardize output. */
 	static FString StandardizeCase(const FString& StringIn);
 
+	/**
+	 * Forgets the property names, offsets and culture chain worked out for earlier conversions.
+	 * Called after a hot reload, when a struct's layout may have changed without it being recreated.
+	 */
+	static void ResetStructCache();
+
 	/** Parse an FText from a json object (assumed to be of the form where keys are culture codes and values are strings) */
 	static bool GetTextFromObject(const TSharedRef<FJsonObject>& Obj, FText& TextOut);
 
@@ -68,7 +75,8 @@ public: // UStruct -> JSON
 	static bool UStructToJsonObject(const UStruct* StructDefinition, const void* Struct, TSharedRef<FJsonObject> OutJsonObject, int64 CheckFlags = 0, int64 SkipFlags = 0, const CustomExportCallback* ExportCb = nullptr);
 
 	/**
-	 * Converts from a UStruct to a json string containing an object, using exportText
+	 * Converts from a UStruct to a json string containing an object, using exportText.
+	 * Properties are written straight to a json writer, producing the same text as serializing UStructToJsonObject's output.
 	 *
 	 * @param StructDefinition UStruct definition that is looked over for properties
 	 * @param Struct The UStruct instance to copy out of
@@ -213,7 +221,21 @@ public: // JSON -> UStruct
 	static bool JsonValueToUProperty(const TSharedPtr<FJsonValue>& JsonValue, FProperty* Property, void* OutValue, int64 CheckFlags = 0, int64 SkipFlags = 0);
 
 	/**
-	 * Converts from a json string containing an object to a UStruct
+	 * Converts from a json string containing an object to a UStruct, reading the string's tokens straight into the
+	 * struct rather than building a Json Object first
+	 *
+	 * @param JsonString String containing JSON formatted data.
+	 * @param StructDefinition UStruct definition that is looked over for properties
+	 * @param OutStruct The UStruct instance to copy in to
+	 * @param CheckFlags Only convert properties that match at least one of these flags. If 0 check all properties.
+	 * @param SkipFlags Skip properties that match any of these flags
+	 *
+	 * @return False if the string isn't a JSON object or any properties matched but failed to deserialize
+	 */
+	static bool JsonObjectStringToUStruct(const FString& JsonString, const UStruct* StructDefinition, void* OutStruct, int64 CheckFlags = 0, int64 SkipFlags = 0);
+
+	/**
+	 * Templated version of JsonObjectStringToUStruct
 	 *
 	 * @param JsonString String containing JSON formatted data.
 	 * @param OutStruct The UStruct instance to copy in to
@@ -225,21 +247,23 @@ public: // JSON -> UStruct
 	template<typename OutStructType>
 	static bool JsonObjectStringToUStruct(const FString& JsonString, OutStructType* OutStruct, int64 CheckFlags = 0, int64 SkipFlags = 0)
 	{
-		TSharedPtr<FJsonObject> JsonObject;
-		TSharedRef<TJsonReader<> > JsonReader = TJsonReaderFactory<>::Create(JsonString);
-		if (!FJsonSerializer::Deserialize(JsonReader, JsonObject) || !JsonObject.IsValid())
-		{
-			UE_LOG(LogJson, Warning, TEXT("JsonObjectStringToUStruct - Unable to parse json=[%s]"), *JsonString);
-			return false;
-		}
-		if (!CustomJsonConverter::JsonObjectToUStruct(JsonObject.ToSharedRef(), OutStruct, CheckFlags, SkipFlags))
-		{
-			UE_LOG(LogJson, Warning, TEXT("JsonObjectStringToUStruct - Unable to deserialize. json=[%s]"), *JsonString);
-			return false;
-		}
-		return true;
+		return JsonObjectStringToUStruct(JsonString, OutStructType::StaticStruct(), OutStruct, CheckFlags, SkipFlags);
 	}
 
+	/**
+	* Converts from a json string containing an array of objects to UStructs, reading the string's tokens straight into
+	* each element
+	*
+	* @param JsonString String containing JSON formatted data.
+	* @param ElementDefinition UStruct definition of the elements
+	* @param AddElement Called for each object in the array, returns the UStruct instance to copy it in to
+	* @param CheckFlags Only convert properties that match at least one of these flags. If 0 check all properties.
+	* @param SkipFlags Skip properties that match any of these flags.
+	*
+	* @return False if the string isn't a JSON array, or one of its elements isn't an object or could not be converted.
+	*/
+	static bool JsonArrayStringToUStruct(const FString& JsonString, const UStruct* ElementDefinition, TFunctionRef<void*()> AddElement, int64 CheckFlags = 0, int64 SkipFlags = 0);
+
 	/**
 	* Converts from a json string containing an array to an array of UStructs
 	*
@@ -253,19 +277,8 @@ public: // JSON -> UStruct
 	template<typename OutStructType>
 	static bool JsonArrayStringToUStruct(const FString& JsonString, TArray<OutStructType>* OutStructArray, int64 CheckFlags = 0, int64 SkipFlags = 0)
 	{
-		TArray<TSharedPtr<FJsonValue> > JsonArray;
-		TSharedRef<TJsonReader<> > JsonReader = TJsonReaderFactory<>::Create(JsonString);
-		if (!FJsonSerializer::Deserialize(JsonReader, JsonArray))
-		{
-			UE_LOG(LogJson, Warning, TEXT("JsonArrayStringToUStruct - Unable to parse. json=[%s]"), *JsonString);
-			return false;
-		}
-		if (!JsonArrayToUStruct(JsonArray, OutStructArray, CheckFlags, SkipFlags))
-		{
-			UE_LOG(LogJson, Warning, TEXT("JsonArrayStringToUStruct - Error parsing one of the elements. json=[%s]"), *JsonString);
-			return false;
-		}
-		return true;
+		OutStructArray->Reset();
+		return JsonArrayStringToUStruct(JsonString, OutStructType::StaticStruct(), [OutStructArray]() -> void* { return &OutStructArray->AddDefaulted_GetRef(); }, CheckFlags, SkipFlags);
 	}
 
 	/**
@@ -400,6 +400,9 @@ public:
 	/** Writes the data table out as an array of objects */
 	bool WriteTable(const UDataTable& InDataTable);
 
+	/** Writes some of the data table's rows out as an array of objects, exactly as WriteTable writes them */
+	bool WriteTableRows(const UDataTable& InDataTable, TArrayView<const TPair<FName, const uint8*>> InRows);
+
 	/** Writes the data table out as a named object with each row being a sub value on that object */
 	bool WriteTableAsObject(const UDataTable& InDataTable);
 
@@ -410,13 +413,23 @@ public:
 	bool WriteStruct(const UScriptStruct* InStruct, const void* InStructData, const FString* FieldToSkip = nullptr);
 
 protected:
-	bool WriteStructEntry(const void* InRowData, const FProperty* InProperty, const void* InPropertyData);
+	/** A struct's properties with the names they are written under, worked out once per struct */
+	typedef TArray<TPair<const FProperty*, FString>> FColumnPlan;
+
+	const FColumnPlan& GetColumnPlan(const UScriptStruct* InStruct);
+
+	void WriteTableRow(const UDataTable& InDataTable, const FString& InKeyField, const FName InRowName, const uint8* InRowData);
+
+	bool WriteStructEntry(const void* InRowData, const FProperty* InProperty, const FString& InIdentifier, const void* InPropertyData);
 
 	bool WriteContainerEntry(const FProperty* InProperty, const void* InPropertyData, const FString* InIdentifier = nullptr);
 
 	EDataTableExportFlags DTExportFlags;
 	TSharedRef<FDataTableJsonWriter> JsonWriter;
 	bool bJsonWriterNeedsClose;
+
+	// Held by pointer, as nested structs add plans while an outer one is being written
+	TMap<const UScriptStruct*, TUniquePtr<FColumnPlan>> ColumnPlans;
 };
 
 /**
@@ -430,6 +443,14 @@ public:
 	FYDataTableExporterJSON(const EDataTableExportFlags InDTExportFlags, FString& OutExportText);
 };
 
+/**
+ * Reads JSON straight into a DataTable off the reader's tokens, without parsing it into FJsonObject rows first.
+ * The JSON is either an array of row objects or a single row object, which is named "_MyTempName" if it has no key field.
+ * Every row is read into a scratch row and copied in once it is filled and its name is known, then gets OnPostDataImport
+ * the same as it would from CreateTableFromJSONString.
+ * Nulls leave properties at their defaults. The Y*Entry functions always consume the value they are given and only return
+ * false when the JSON itself can't be read any further; anything wrong with a value is added to the problems instead.
+ */
 class FYDataTableImporterJSON
 {
 public:
@@ -440,16 +461,44 @@ public:
 	bool YReadTable();
 
 private:
-	bool YReadRow(const TSharedRef<FJsonObject>& InParsedTableRowObject, const int32 InRowIdx);
+	/** Checks a row name is usable, NAME_None once the problem has been added if not */
+	FName YGetRowName(const FString& InKeyValue, const int32 InRowIdx, const TCHAR* InDefaultRowName);
+
+	bool YReadRow(const int32 InRowIdx, const TCHAR* InDefaultRowName);
 
-	bool YReadStruct(const TSharedRef<FJsonObject>& InParsedObject, UScriptStruct* InStruct, const FName InRowName, void* InStructData);
+	/** Reads an object's members, starting from the one InNotation belongs to, up to and including its end */
+	bool YReadStruct(EJsonNotation InNotation, const UScriptStruct* InStruct, const FName InRowName, void* InStructData, FString* OutKeyValue);
 
-	bool YReadStructEntry(const TSharedRef<FJsonValue>& InParsedPropertyValue, const FName InRowName, const FString& InColumnName, const void* InRowData, FProperty* InProperty, void* InPropertyData);
+	bool YReadStructEntry(const EJsonNotation InNotation, const FName InRowName, const FString& InColumnName, const void* InRowData, FProperty* InProperty, void* InPropertyData);
 
-	bool YReadContainerEntry(const TSharedRef<FJsonValue>& InParsedPropertyValue, const FName InRowName, const FString& InColumnName, const int32 InArrayEntryIndex, FProperty* InProperty, void* InPropertyData);
+	bool YReadContainerEntry(const EJsonNotation InNotation, const FName InRowName, const FString& InColumnName, const int32 InArrayEntryIndex, FProperty* InProperty, void* InPropertyData);
 
 	UDataTable* DataTable;
 	const FString& JSONData;
 	TArray<FString>& ImportProblems;
+
+	TSharedPtr<TJsonReader<TCHAR>> JsonReader;
+	FString KeyField;
+	uint8* ScratchRowData;
+};
+
+/**
+ * Reads CSV straight into a DataTable in one pass, without rewriting the header or handing the text to CreateTableFromCSVString.
+ * Column titles may be a property's name, authored name or display name. The first column holds the row names.
+ * Rows are added once all their cells are read, and get OnPostDataImport the same as they would from CreateTableFromCSVString.
+ */
+class FYDataTableImporterCSV
+{
+public:
+	FYDataTableImporterCSV(UDataTable& InDataTable, const FString& InCSVData, TArray<FString>& OutProblems);
+
+	~FYDataTableImporterCSV();
+
+	bool YReadTable();
+
+private:
+	UDataTable* DataTable;
+	const FString& CSVData;
+	TArray<FString>& ImportProblems;
 };
 
@@ -3,6 +3,7 @@
 #include "EasyCsv.h"
 
 #include "EasyCsvModule.h"
+#include "EasyCsvStats.h"
 
 #include "Runtime/Launch/Resources/Version.h"
 #if ENGINE_MAJOR_VERSION >= 5
@@ -13,10 +14,109 @@
 
 #include "Misc/FileHelper.h"
 #include "Misc/Paths.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
 #include "Serialization/Csv/CsvParser.h"
 
+DEFINE_STAT(STAT_EasyCsv_ReadCsv);
+DEFINE_STAT(STAT_EasyCsv_MakeCsvInfo);
+DEFINE_STAT(STAT_EasyCsv_RowsParsed);
+DEFINE_STAT(STAT_EasyCsv_BytesParsed);
+
+FEasyCsvFileCacheLookup UEasyCsv::FileCacheLookup;
+
+namespace EasyCsv
+{
+	TArray<FString> MakeHeaders(const TArray<FString>& InFirstRow, const bool bParseHeaders, const bool bParseKeys)
+	{
+		TArray<FString> Headers;
+
+		if (bParseHeaders) //Get CSV_Headers
+		{
+			Headers = InFirstRow;
+			if (bParseKeys && Headers.Num() > 0)
+			{
+				Headers.RemoveAt(0, 1, true); //  If ParseKeys == true, take the key header out
+			}
+		}
+		else // Otherwise Generate Headers
+		{
+			// If ParseKeys == true, start at 1 to avoid 'Key' header
+			for (int32 HeaderCount = (bParseKeys ? 1 : 0); HeaderCount < InFirstRow.Num(); HeaderCount++)
+			{
+				Headers.Add("Header" + FString::FromInt(Headers.Num())); // Header0, Header1, ... Header13 ...
+			}
+		}
+
+		return Headers;
+	}
+}
+
+int32 FEasyCsvTable::FindRowIndex(const FString& InKey) const
+{
+	const int32* RowIndex = RowIndices.Find(InKey);
+	return RowIndex && CSV_Rows.IsValidIndex(*RowIndex) ? *RowIndex : INDEX_NONE;
+}
+
+void FEasyCsvTable::Reserve(const int32 InNumRows)
+{
+	CSV_Keys.Reserve(InNumRows);
+	CSV_Rows.Reserve(InNumRows);
+	RowIndices.Reserve(InNumRows);
+}
+
+void FEasyCsvTable::AddRow(FString InKey, TArray<FString>&& InValues)
+{
+	RowIndices.Add(InKey, CSV_Rows.Num());
+	CSV_Keys.Add(MoveTemp(InKey));
+	CSV_Rows.AddDefaulted_GetRef().StringValues = MoveTemp(InValues);
+}
+
+FEasyCsvInfo FEasyCsvTable::ToCsvInfo() const
+{
+	FEasyCsvInfo CsvInfo;
+	CsvInfo.CSV_Headers = CSV_Headers;
+	CsvInfo.CSV_Keys.Reserve(CSV_Keys.Num());
+	CsvInfo.CSV_Map.Reserve(CSV_Keys.Num());
+
+	for (int32 RowIndex = 0; RowIndex < CSV_Keys.Num() && RowIndex < CSV_Rows.Num(); RowIndex++)
+	{
+		const FName RowKey(*CSV_Keys[RowIndex]);
+		CsvInfo.CSV_Keys.Add(RowKey);
+		CsvInfo.CSV_Map.Add(RowKey, CSV_Rows[RowIndex]);
+	}
+
+	return CsvInfo;
+}
+
+void FEasyCsvTable::Reset()
+{
+	CSV_Keys.Reset();
+	CSV_Rows.Reset();
+	CSV_Headers.Reset();
+	RowIndices.Reset();
+}
+
+void FEasyCsvTable::PostSerialize(const FArchive& Ar)
+{
+	if (!Ar.IsLoading())
+	{
+		return;
+	}
+
+	RowIndices.Reset();
+	RowIndices.Reserve(CSV_Keys.Num());
+	for (int32 RowIndex = 0; RowIndex < CSV_Keys.Num(); RowIndex++)
+	{
+		RowIndices.Add(CSV_Keys[RowIndex], RowIndex);
+	}
+}
+
 TArray<TArray<FString>> UEasyCsv::ReadCsv(const FString& CsvContent)
 {
+	TRACE_CPUPROFILER_EVENT_SCOPE(UEasyCsv::ReadCsv);
+	SCOPE_CYCLE_COUNTER(STAT_EasyCsv_ReadCsv);
+	INC_FLOAT_STAT_BY(STAT_EasyCsv_BytesParsed, FPlatformString::ConvertedLength<UTF8CHAR>(*CsvContent, CsvContent.Len()));
+
 	TArray<TArray<FString>> Lines;
 	
 	const FCsvParser Parser(CsvContent);
@@ -43,6 +143,125 @@ TArray<TArray<FString>> UEasyCsv::ReadCsv(const FString& CsvContent)
 	return Lines;
 }
 
+TArray<TArray<FString>> UEasyCsv::ReadCsvFromUtf8(const uint8* InData, const int64 InLength)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UEasyCsv::ReadCsvFromUtf8);
+	SCOPE_CYCLE_COUNTER(STAT_EasyCsv_ReadCsv);
+	INC_FLOAT_STAT_BY(STAT_EasyCsv_BytesParsed, InLength);
+
+	TArray<TArray<FString>> Lines;
+
+	int64 Position = 0;
+
+	// Skip the byte order mark some exporters write
+	if (InLength >= 3 && InData[0] == 0xEF && InData[1] == 0xBB && InData[2] == 0xBF)
+	{
+		Position = 3;
+	}
+
+	TArray<FString> Line;
+
+	// Only needed for quoted cells with escaped quotes in them, everything else is converted straight from InData
+	TArray<ANSICHAR> UnescapedCell;
+
+	auto AddCell = [&Line](const ANSICHAR* InCellStart, const int64 InCellLength)
+	{
+		const FUTF8ToTCHAR Converted(InCellStart, static_cast<int32>(InCellLength));
+		Line.Emplace(Converted.Length(), Converted.Get());
+	};
+
+	while (Position < InLength)
+	{
+		if (InData[Position] == '"')
+		{
+			const int64 CellStart = ++Position;
+			bool bHasEscapedQuotes = false;
+
+			while (Position < InLength)
+			{
+				if (InData[Position] == '"')
+				{
+					if (Position + 1 < InLength && InData[Position + 1] == '"')
+					{
+						bHasEscapedQuotes = true;
+						Position += 2;
+						continue;
+					}
+					break;
+				}
+				Position++;
+			}
+
+			const int64 CellEnd = Position;
+
+			if (bHasEscapedQuotes)
+			{
+				UnescapedCell.Reset();
+				for (int64 Index = CellStart; Index < CellEnd; Index++)
+				{
+					UnescapedCell.Add(static_cast<ANSICHAR>(InData[Index]));
+					if (InData[Index] == '"')
+					{
+						Index++;
+					}
+				}
+				AddCell(UnescapedCell.GetData(), UnescapedCell.Num());
+			}
+			else
+			{
+				AddCell(reinterpret_cast<const ANSICHAR*>(InData + CellStart), CellEnd - CellStart);
+			}
+
+			// Step over the closing quote and drop anything between it and the next delimiter
+			while (Position < InLength && InData[Position] != ',' && InData[Position] != '\r' && InData[Position] != '\n')
+			{
+				Position++;
+			}
+		}
+		else
+		{
+			const int64 CellStart = Position;
+			while (Position < InLength && InData[Position] != ',' && InData[Position] != '\r' && InData[Position] != '\n')
+			{
+				Position++;
+			}
+			AddCell(reinterpret_cast<const ANSICHAR*>(InData + CellStart), Position - CellStart);
+		}
+
+		if (Position >= InLength)
+		{
+			break;
+		}
+
+		const uint8 Delimiter = InData[Position++];
+		if (Delimiter == ',')
+		{
+			// A trailing comma still ends with an empty cell
+			if (Position >= InLength)
+			{
+				Line.AddDefaulted();
+			}
+			continue;
+		}
+
+		if (Delimiter == '\r' && Position < InLength && InData[Position] == '\n')
+		{
+			Position++;
+		}
+
+		const int32 ColumnCount = Line.Num();
+		Lines.Add(MoveTemp(Line));
+		Line.Reset(ColumnCount);
+	}
+
+	if (Line.Num() > 0)
+	{
+		Lines.Add(MoveTemp(Line));
+	}
+
+	return Lines;
+}
+
 bool UEasyCsv::SaveStringToFile(
 	const FString& InString, const FString InDirectory, const FString Filename, const FString Extension)
 {
@@ -185,17 +404,24 @@ int32 UEasyCsv::GetColumnCount(const FEasyCsvInfo& CSV_Info)
 
 bool UEasyCsv::MakeCsvInfoStructFromString(FString InString, FEasyCsvInfo& OutCsvInfo, bool ParseHeaders, bool ParseKeys)
 {
-	// Clear current values
-	OutCsvInfo = FEasyCsvInfo();
-	
 	// Provision string
 	// Remove encapsulating parentheses
 	if (InString.Left(1) == "(") { InString = InString.RightChop(1); }
 	if (InString.Right(1) == ")") { InString = InString.LeftChop(1); }
 
-	TArray<TArray<FString>> FullSheet = ReadCsv(InString);
+	return MakeCsvInfoStructFromRows(ReadCsv(InString), OutCsvInfo, ParseHeaders, ParseKeys);
+}
 
-	if (FullSheet.Num() == 0)
+bool UEasyCsv::MakeCsvInfoStructFromRows(TArray<TArray<FString>> InRows, FEasyCsvInfo& OutCsvInfo, bool ParseHeaders, bool ParseKeys, bool bPadShortRows)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UEasyCsv::MakeCsvInfoStructFromRows);
+	SCOPE_CYCLE_COUNTER(STAT_EasyCsv_MakeCsvInfo);
+	INC_DWORD_STAT_BY(STAT_EasyCsv_RowsParsed, InRows.Num());
+
+	// Clear current values
+	OutCsvInfo = FEasyCsvInfo();
+
+	if (InRows.Num() == 0)
 	{
 		FEasyCsvModule::Print(
 			FString::Printf(TEXT("%hs: Unable to load the file specified."), __FUNCTION__),
@@ -203,34 +429,24 @@ bool UEasyCsv::MakeCsvInfoStructFromString(FString InString, FEasyCsvInfo& OutCs
 		return false;
 	}
 
-	if (ParseHeaders) //Get CSV_Headers
-	{
-		OutCsvInfo.CSV_Headers = FullSheet[0];
-		if (ParseKeys)
-		{
-			OutCsvInfo.CSV_Headers.RemoveAt(0, 1, true); //  If ParseKeys == true, take the key header out
-		}
-	}
-	else // Otherwise Generate Headers
-	{
-		TArray<FString> GeneratedHeaders;
-		// If ParseKeys == true, start at 1 to avoid 'Key' header
-		for (uint8 HeaderCount = (ParseKeys ? 1 : 0); HeaderCount < FullSheet[0].Num(); HeaderCount++) 
-		{
-			GeneratedHeaders.Add("Header" + FString::FromInt(GeneratedHeaders.Num())); // Header0, Header1, ... Header13 ...
-		}
+	const int32 ColumnCount = InRows[0].Num();
 
-		OutCsvInfo.CSV_Headers = GeneratedHeaders;
-	}
+	OutCsvInfo.CSV_Headers = EasyCsv::MakeHeaders(InRows[0], ParseHeaders, ParseKeys);
 
 	// If ParseHeaders == true, start at 1 to avoid creating row for headers
-	for (int32 LineIndex = (ParseHeaders ? 1 : 0); LineIndex < FullSheet.Num(); LineIndex++)
+	for (int32 LineIndex = (ParseHeaders ? 1 : 0); LineIndex < InRows.Num(); LineIndex++)
 	{
-		TArray<FString> Row = FullSheet[LineIndex];
+		TArray<FString>& Row = InRows[LineIndex];
+
+		// API responses leave out trailing empty cells
+		if (bPadShortRows && Row.Num() < ColumnCount)
+		{
+			Row.SetNum(ColumnCount);
+		}
 
 		FName LineKey; 
 		
-		if (ParseKeys)
+		if (ParseKeys && Row.Num() > 0)
 		{
 			LineKey = FName(*Row[0]);
 			Row.RemoveAt(0, 1, true); //Take the key out of the row
@@ -243,15 +459,124 @@ bool UEasyCsv::MakeCsvInfoStructFromString(FString InString, FEasyCsvInfo& OutCs
 			
 		OutCsvInfo.CSV_Keys.Add(LineKey);
 		FEasyCsvStringValueArray NewTextArray;
-		NewTextArray.StringValues = Row;
+		NewTextArray.StringValues = MoveTemp(Row);
 		OutCsvInfo.CSV_Map.Add(LineKey, NewTextArray);
 	}
 
 	return true;
 }
 
+bool UEasyCsv::MakeCsvInfoStructFromUtf8(
+	const TArray<uint8>& InBytes, FEasyCsvInfo& OutCsvInfo, bool ParseHeaders, bool ParseKeys)
+{
+	TArray<TArray<FString>> Rows = ReadCsvFromUtf8(InBytes.GetData(), InBytes.Num());
+
+	// Checked here rather than left to MakeCsvInfoStructFromRows, which logs, so that this stays safe off the game thread
+	if (Rows.Num() == 0)
+	{
+		OutCsvInfo = FEasyCsvInfo();
+		return false;
+	}
+
+	return MakeCsvInfoStructFromRows(MoveTemp(Rows), OutCsvInfo, ParseHeaders, ParseKeys);
+}
+
+bool UEasyCsv::MakeCsvTableFromString(FString InString, FEasyCsvTable& OutCsvTable, bool ParseHeaders, bool ParseKeys)
+{
+	// Same provisioning as MakeCsvInfoStructFromString
+	if (InString.Left(1) == "(") { InString = InString.RightChop(1); }
+	if (InString.Right(1) == ")") { InString = InString.LeftChop(1); }
+
+	TArray<TArray<FString>> Rows = ReadCsv(InString);
+	if (Rows.Num() == 0)
+	{
+		OutCsvTable.Reset();
+		FEasyCsvModule::Print(
+			FString::Printf(TEXT("%hs: Unable to load the file specified."), __FUNCTION__),
+			FEasyCsvModule::ELogType::Error);
+		return false;
+	}
+
+	return MakeCsvTableFromRows(MoveTemp(Rows), OutCsvTable, ParseHeaders, ParseKeys);
+}
+
+bool UEasyCsv::MakeCsvTableFromRows(TArray<TArray<FString>> InRows, FEasyCsvTable& OutCsvTable, bool ParseHeaders, bool ParseKeys, bool bPadShortRows)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UEasyCsv::MakeCsvTableFromRows);
+	SCOPE_CYCLE_COUNTER(STAT_EasyCsv_MakeCsvInfo);
+	INC_DWORD_STAT_BY(STAT_EasyCsv_RowsParsed, InRows.Num());
+
+	// Nothing is logged from here so that MakeCsvTableFromUtf8 stays safe off the game thread
+	OutCsvTable.Reset();
+
+	if (InRows.Num() == 0)
+	{
+		return false;
+	}
+
+	const int32 ColumnCount = InRows[0].Num();
+
+	OutCsvTable.SetHeaders(EasyCsv::MakeHeaders(InRows[0], ParseHeaders, ParseKeys));
+
+	const int32 FirstLineIndex = ParseHeaders ? 1 : 0;
+	OutCsvTable.Reserve(InRows.Num() - FirstLineIndex);
+
+	for (int32 LineIndex = FirstLineIndex; LineIndex < InRows.Num(); LineIndex++)
+	{
+		TArray<FString>& Row = InRows[LineIndex];
+
+		// API responses leave out trailing empty cells
+		if (bPadShortRows && Row.Num() < ColumnCount)
+		{
+			Row.SetNum(ColumnCount);
+		}
+
+		FString LineKey;
+
+		if (ParseKeys && Row.Num() > 0)
+		{
+			LineKey = MoveTemp(Row[0]);
+			Row.RemoveAt(0, 1, true); //Take the key out of the row
+		}
+		else // Otherwise Generate keys
+		{
+			LineKey = "Row" + FString::FromInt(LineIndex - FirstLineIndex); // Row0, Row1, ... Row13, ... Row228 ...
+		}
+
+		OutCsvTable.AddRow(MoveTemp(LineKey), MoveTemp(Row));
+	}
+
+	return true;
+}
+
+bool UEasyCsv::MakeCsvTableFromUtf8(const TArray<uint8>& InBytes, FEasyCsvTable& OutCsvTable, bool ParseHeaders, bool ParseKeys)
+{
+	return MakeCsvTableFromRows(ReadCsvFromUtf8(InBytes.GetData(), InBytes.Num()), OutCsvTable, ParseHeaders, ParseKeys);
+}
+
+TArray<FString> UEasyCsv::GetCsvTableRowAsStringArray(const FEasyCsvTable& CsvTable, const FString& RowKey, bool& Success)
+{
+	const FEasyCsvStringValueArray* Row = CsvTable.FindRow(RowKey);
+	Success = Row != nullptr;
+	return Row ? Row->StringValues : TArray<FString>();
+}
+
+FString UEasyCsv::GetCsvTableValueAsString(const FEasyCsvTable& CsvTable, const FString& ColumnName, const FString& RowKey, bool& Success)
+{
+	const int32 HeaderIndex = CsvTable.GetHeaders().Find(ColumnName);
+	const FEasyCsvStringValueArray* Row = CsvTable.FindRow(RowKey);
+
+	Success = Row && Row->StringValues.IsValidIndex(HeaderIndex);
+	return Success ? Row->StringValues[HeaderIndex] : FString();
+}
+
 bool UEasyCsv::MakeCsvInfoStructFromFile(const FString& InPath, FEasyCsvInfo& OutCsvInfo, bool ParseHeaders, bool ParseKeys)
 {
+	if (FileCacheLookup.IsBound() && FileCacheLookup.Execute(InPath, OutCsvInfo, ParseHeaders, ParseKeys))
+	{
+		return true;
+	}
+
 	FString LoadedCSV;
 	const bool SuccessfulLoad = LoadStringFromLocalFile(InPath, LoadedCSV);
 
@@ -30,15 +30,109 @@ struct FEasyCsvInfo
 		TArray<FString> CSV_Headers;
 };
 
+/**
+ * The same rows as FEasyCsvInfo, but keyed by string in a map that belongs to the table rather than by FName.
+ * FNames are never freed, so parsing sheets keyed by generated IDs (order numbers, GUIDs) into FEasyCsvInfo again and again
+ * grows the global name table for as long as the game runs. Parse those into this instead and convert with ToCsvInfo only
+ * when something needs FNames. Keys are matched ignoring case, the same as FNames.
+ */
+USTRUCT(BlueprintType)
+struct EASYCSV_API FEasyCsvTable
+{
+	GENERATED_BODY()
+
+	// INDEX_NONE if there is no such row. Where a key is repeated the last row with it wins, as in FEasyCsvInfo's map.
+	int32 FindRowIndex(const FString& InKey) const;
+
+	const FEasyCsvStringValueArray* FindRow(const FString& InKey) const
+	{
+		const int32 RowIndex = FindRowIndex(InKey);
+		return RowIndex != INDEX_NONE ? &CSV_Rows[RowIndex] : nullptr;
+	}
+
+	const TArray<FString>& GetKeys() const
+	{
+		return CSV_Keys;
+	}
+
+	// One per key, in the same order
+	const TArray<FEasyCsvStringValueArray>& GetRows() const
+	{
+		return CSV_Rows;
+	}
+
+	const TArray<FString>& GetHeaders() const
+	{
+		return CSV_Headers;
+	}
+
+	int32 Num() const
+	{
+		return CSV_Rows.Num();
+	}
+
+	void SetHeaders(TArray<FString>&& InHeaders)
+	{
+		CSV_Headers = MoveTemp(InHeaders);
+	}
+
+	void Reserve(const int32 InNumRows);
+
+	void AddRow(FString InKey, TArray<FString>&& InValues);
+
+	// Makes an FName for every key
+	FEasyCsvInfo ToCsvInfo() const;
+
+	void Reset();
+
+	// Rebuilds the row index, which isn't saved
+	void PostSerialize(const FArchive& Ar);
+
+private:
+
+	// Only changed through AddRow and Reset, which keep RowIndices in step, so lookups never write and tables can be shared between threads
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "easyCSV", meta = (AllowPrivateAccess = "true"))
+		TArray<FString> CSV_Keys;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "easyCSV", meta = (AllowPrivateAccess = "true"))
+		TArray<FEasyCsvStringValueArray> CSV_Rows;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "easyCSV", meta = (AllowPrivateAccess = "true"))
+		TArray<FString> CSV_Headers;
+
+	TMap<FString, int32> RowIndices;
+};
+
+template<>
+struct TStructOpsTypeTraits<FEasyCsvTable> : public TStructOpsTypeTraitsBase2<FEasyCsvTable>
+{
+	enum
+	{
+		WithPostSerialize = true,
+	};
+};
+
+// Answers MakeCsvInfoStructFromFile from memory instead of the file. Returns false if it doesn't have the file.
+DECLARE_DELEGATE_RetVal_FourParams(bool, FEasyCsvFileCacheLookup, const FString&, FEasyCsvInfo&, bool, bool);
+
 UCLASS()
 class EASYCSV_API UEasyCsv : public UBlueprintFunctionLibrary
 {
 	GENERATED_BODY()
 
 public:
+
+	// Bound by whatever keeps parsed files around, e.g. RuntimeDataTable's prefetch cache. Called from any thread.
+	static FEasyCsvFileCacheLookup FileCacheLookup;
 	
 	static TArray<TArray<FString>> ReadCsv(const FString& CsvContent);
 
+	/**
+	 * Same as ReadCsv, but reads UTF-8 bytes such as an HTTP response body directly, converting one cell at a time.
+	 * Does not touch UObjects or the log, so it's safe to call off the game thread.
+	 */
+	static TArray<TArray<FString>> ReadCsvFromUtf8(const uint8* InData, const int64 InLength);
+
 	/**
 	 * Saves a new file using an input string. Always overwrites and does not validate paths, so please be sure the directory exists. 
 	 * Meant for saving a CSV, but can be used for any text-based file. Returns true if write is successful.
@@ -159,6 +253,84 @@ public:
 		static bool MakeCsvInfoStructFromString(
 			FString InString, FEasyCsvInfo& OutCsvInfo, bool ParseHeaders = true, bool ParseKeys = true);
 
+	/**
+	 * Builds FEasyCsvInfo from rows that have already been split into cells, e.g. the "values" of a Google Sheets API response.
+	 * @return Whether or not the rows could be turned into a valid FEasyCsvInfo
+	 * @param InRows Every row of the sheet, with the header row first if ParseHeaders is true.
+	 * @param OutCsvInfo A struct with parsed CSV information.
+	 * @param ParseHeaders If true, the first row is treated as column labels, or headers. If false, vales will be generated.
+	 * @param ParseKeys If true, the first column is treated as row labels, or keys. If false, values will be generated.
+	 * @param bPadShortRows If true, rows shorter than the first row are padded with empty cells so that every row has a value for every header.
+	 * API responses need this as they leave out trailing empty cells. Parsed CSV keeps its rows as they were written.
+	 */
+	static bool MakeCsvInfoStructFromRows(
+		TArray<TArray<FString>> InRows, FEasyCsvInfo& OutCsvInfo, bool ParseHeaders = true, bool ParseKeys = true,
+		bool bPadShortRows = false);
+
+	/**
+	 * Parses UTF-8 encoded CSV, such as a downloaded sheet, without first converting the whole thing into an FString.
+	 * Safe to call off the game thread, which is where large downloads should be parsed.
+	 * @return Whether or not the bytes held at least one row
+	 * @param InBytes The CSV as UTF-8, with or without a byte order mark
+	 * @param OutCsvInfo A struct with parsed CSV information.
+	 * @param ParseHeaders If true, the first row is treated as column labels, or headers. If false, vales will be generated.
+	 * @param ParseKeys If true, the first column is treated as row labels, or keys. If false, values will be generated.
+	 */
+	static bool MakeCsvInfoStructFromUtf8(
+		const TArray<uint8>& InBytes, FEasyCsvInfo& OutCsvInfo, bool ParseHeaders = true, bool ParseKeys = true);
+
+	/**
+	 * Like MakeCsvInfoFromString, but keys rows by string in the table itself rather than by FName. Use this for sheets whose
+	 * keys are generated IDs that change between refreshes, since every FName made stays in memory until the game exits.
+	 * @return Whether or not the parsing was successful
+	 * @param OutCsvTable A struct with parsed CSV information. Convert it with ConvertCsvTableToCsvInfo for functions that take CSV_Info.
+	 * @param InString This is the string data found inside the CSV file. Can be loaded from a file using LoadStringFromFile.
+	 * @param ParseHeaders If true, the parser will expect the first row of the CSV to be column labels, or headers. If false, vales will be generated.
+	 * @param ParseKeys If true, the parser will expect the first column of the CSV to be row labels, or keys. If false, rows are keyed Row0, Row1 and so on.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "easyCSV|Main", meta = (Keywords = "parse", DisplayName = "Make CSV Table From String"))
+		static bool MakeCsvTableFromString(
+			FString InString, FEasyCsvTable& OutCsvTable, bool ParseHeaders = true, bool ParseKeys = true);
+
+	// MakeCsvInfoStructFromRows for FEasyCsvTable
+	static bool MakeCsvTableFromRows(
+		TArray<TArray<FString>> InRows, FEasyCsvTable& OutCsvTable, bool ParseHeaders = true, bool ParseKeys = true,
+		bool bPadShortRows = false);
+
+	// MakeCsvInfoStructFromUtf8 for FEasyCsvTable. Safe to call off the game thread.
+	static bool MakeCsvTableFromUtf8(
+		const TArray<uint8>& InBytes, FEasyCsvTable& OutCsvTable, bool ParseHeaders = true, bool ParseKeys = true);
+
+	/**
+	 * Returns all values in a row given the key of a row in the table, as an array of strings.
+	 * @param CsvTable A structure containing parsed CSV data. Can be created using MakeCsvTableFromString.
+	 * @param RowKey The key of the row, ignoring case
+	 * @param Success Whether or not the row could be found by key
+	 */
+	UFUNCTION(BlueprintPure, Category = "easyCSV|Post-Parse Operations")
+		static TArray<FString> GetCsvTableRowAsStringArray(const FEasyCsvTable& CsvTable, const FString& RowKey, bool& Success);
+
+	/**
+	 * Returns a single value given a column name and a row key as a string.
+	 * @param CsvTable A structure containing parsed CSV data. Can be created using MakeCsvTableFromString.
+	 * @param ColumnName The name of the column in the CSV
+	 * @param RowKey The key of the row, ignoring case
+	 * @param Success Whether or not the value could be found by column name and/or row key
+	 */
+	UFUNCTION(BlueprintPure, Category = "easyCSV|Post-Parse Operations")
+		static FString GetCsvTableValueAsString(const FEasyCsvTable& CsvTable, const FString& ColumnName, const FString& RowKey, bool& Success);
+
+	/**
+	 * Makes a CSV_Info struct from a table for the functions that need one. This creates an FName for every row key, which is what
+	 * the table exists to avoid, so only do it for tables whose keys don't keep changing.
+	 * @param CsvTable A structure containing parsed CSV data. Can be created using MakeCsvTableFromString.
+	 */
+	UFUNCTION(BlueprintPure, Category = "easyCSV|Post-Parse Operations", meta = (DisplayName = "Convert CSV Table To CSV Info"))
+		static FEasyCsvInfo ConvertCsvTableToCsvInfo(const FEasyCsvTable& CsvTable)
+		{
+			return CsvTable.ToCsvInfo();
+		}
+
 	/**
 	 * Used to parse a CSV into a map containing each cell's data as part of an array of FString. This is the node you want to start with.
 	 * @return Whether or not the parsing was successful
@@ -0,0 +1,15 @@
+// Copyright Jared Therriault 2019, 2022
+
+#pragma once
+
+#include "Stats/Stats.h"
+
+// Shared with RuntimeDataTable so that a whole sheet refresh, from token to import, shows up under one "stat RuntimeDataTable"
+DECLARE_STATS_GROUP(TEXT("RuntimeDataTable"), STATGROUP_RuntimeDataTable, STATCAT_Advanced);
+
+DECLARE_CYCLE_STAT_EXTERN(TEXT("EasyCsv Read CSV"), STAT_EasyCsv_ReadCsv, STATGROUP_RuntimeDataTable, EASYCSV_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("EasyCsv Make CSV Info"), STAT_EasyCsv_MakeCsvInfo, STATGROUP_RuntimeDataTable, EASYCSV_API);
+
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("EasyCsv Rows Parsed"), STAT_EasyCsv_RowsParsed, STATGROUP_RuntimeDataTable, EASYCSV_API);
+// Always counted as UTF-8, whether the CSV came in as UTF-8 or as an FString. A float stat so it doesn't wrap after 4 GB.
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("EasyCsv UTF-8 Bytes Parsed"), STAT_EasyCsv_BytesParsed, STATGROUP_RuntimeDataTable, EASYCSV_API);
@@ -3,6 +3,8 @@
 #include "CsvToGoogleSheetsHandler.h"
 
 #include "EasyCsv.h"
+#include "RuntimeDataTableA1Notation.h"
+#include "RuntimeDataTableJsonPayloadWriter.h"
 #include "RuntimeDataTableModule.h"
 
 void FCsvToGoogleSheetsHandler::InferSpecifiedRangeFromTitleAndStartingCell(const FString& InTitle,
@@ -18,17 +20,24 @@ void FCsvToGoogleSheetsHandler::InferSpecifiedRangeFromTitleAndStartingCell(cons
 		return;
 	}
 
-	// Do this to set the starting cell which is required for GetActualEndingCell
-	SpecifiedRange = FString::Printf(TEXT("'%s'!%s:%s"), *InTitle, *InStartingCell, *InStartingCell);
+	FRuntimeDataTableA1Range Range;
+	Range.SheetTitle = InTitle;
 
-	FString EndingCell;
-	GetActualEndingCell(EndingCell);
-	SpecifiedRange = FString::Printf(TEXT("'%s'!%s:%s"), *InTitle, *InStartingCell, *EndingCell);
+	if (!A1_CellToColumnAndRowIndices(InStartingCell, Range.StartColumn, Range.StartRow))
+	{
+		return;
+	}
+
+	Range.EndColumn = FMath::Max(Range.StartColumn + GetColumnCount() - 1, Range.StartColumn);
+	Range.EndRow = FMath::Max(Range.StartRow + GetRowCount() - 1, Range.StartRow);
+	// Quoted whatever the title, as it always has been, so ranges built here match the ones callers compare them with
+	SpecifiedRange = Range.ToString(true);
 }
 
 bool FCsvToGoogleSheetsHandler::ValidateCellIsNotRangeOrEmpty(const FString InCell)
 {
-	if (InCell.Contains("!") || InCell.Contains(":"))
+	int32 Index;
+	if (InCell.FindChar(TEXT('!'), Index) || InCell.FindChar(TEXT(':'), Index))
 	{
 		FRuntimeDataTableModule::Print(FString::Printf(
 			TEXT("%hs: Cell is input as range, but ranges are not permitted."),
@@ -51,39 +60,24 @@ bool FCsvToGoogleSheetsHandler::ValidateCellIsNotRangeOrEmpty(const FString InCe
 
 bool FCsvToGoogleSheetsHandler::GetActualEndingCell(FString& OutCell)
 {
-	const FString StartingCell = GetStartingCell();
-
-	int32 ColumnIndex = -1;
-	int32 RowIndex = -1;
-
-	if (A1_CellToColumnAndRowIndices(StartingCell, ColumnIndex, RowIndex))
+	FRuntimeDataTableA1Range Range;
+	if (!FRuntimeDataTableA1Range::Parse(SpecifiedRange, Range))
 	{
-		const int32 LastColumnIndex = ColumnIndex + (GetColumnCount() - 1);
-		const int32 LastRowIndex = RowIndex + (GetRowCount() - 1);
-
-		OutCell = GetCellInA1_NotationFromColumnAndRowIndices(LastColumnIndex, LastRowIndex);
-
-		return true;
+		return false;
 	}
 
-	return false;
+	OutCell = GetCellInA1_NotationFromColumnAndRowIndices(
+		Range.StartColumn + (GetColumnCount() - 1), Range.StartRow + (GetRowCount() - 1));
+
+	return true;
 }
 
 FString FCsvToGoogleSheetsHandler::GetStartingCell()
 {
-	FString StartingCell;
-	FString EndingCell;
-
-	if (SpecifiedRange.Split(":", &StartingCell, &EndingCell))
+	FRuntimeDataTableA1Range Range;
+	if (FRuntimeDataTableA1Range::Parse(SpecifiedRange, Range))
 	{
-		if (StartingCell.Contains("!"))
-		{
-			FString SheetName;
-
-			StartingCell.Split("!", &SheetName, &StartingCell);
-		}
-
-		return StartingCell;
+		return RuntimeDataTableA1::CellToString(Range.StartColumn, Range.StartRow);
 	}
 
 	return SpecifiedRange;
@@ -96,131 +90,51 @@ bool FCsvToGoogleSheetsHandler::A1_CellToColumnAndRowIndices(const FString& InCe
 		return false;
 	}
 
-	FString ColumnLetterIndex;
-	FString RowIndexString;
-
-	for (const wchar_t Char : InCell.GetCharArray())
-	{
-		FString CharAsString;
-		CharAsString.AppendChar(Char);
-
-		if (CharAsString.IsNumeric())
-		{
-			RowIndexString += CharAsString;
-		}
-		else
-		{
-			ColumnLetterIndex += CharAsString;
-		}
-	}
-
-	OutColumnIndex = ColumnLetterToIndex(ColumnLetterIndex);
-
-	if (OutColumnIndex > 0)
+	int32 Column = 0;
+	int32 Row = 0;
+	if (RuntimeDataTableA1::ParseCell(*InCell, InCell.Len(), Column, Row) != InCell.Len() || Column == 0 || Row == 0)
 	{
-		OutRowIndex = FCString::Atoi(*RowIndexString);
-
-		return OutRowIndex > 0;
+		FRuntimeDataTableModule::Print(FString::Printf(
+			TEXT("%hs: %s is not a cell in A1 notation."), __FUNCTION__, *InCell), FRuntimeDataTableModule::ELogType::Error);
+		return false;
 	}
 
-	return false;
+	OutColumnIndex = Column;
+	OutRowIndex = Row;
+	return true;
 }
 
 FString FCsvToGoogleSheetsHandler::GetCellInA1_NotationFromColumnAndRowIndices(int32 InColumnNumber, int32 InRowNumber)
 {
-	if (InColumnNumber < 1)
-	{
-		InColumnNumber = 1;
-	}
-
-	if (InRowNumber < 1)
-	{
-		InRowNumber = 1;
-	}
-
-	return FString::Printf(TEXT("%s%i"), *ColumnIndexToLetter(InColumnNumber), InRowNumber);
+	return RuntimeDataTableA1::CellToString(
+		FMath::Clamp(InColumnNumber, 1, RuntimeDataTableA1::MaxColumn), FMath::Clamp(InRowNumber, 1, RuntimeDataTableA1::MaxRow));
 }
 
 int32 FCsvToGoogleSheetsHandler::ColumnLetterToIndex(const FString& InColumnLetter)
 {
-	if (InColumnLetter.TrimStartAndEnd().IsEmpty() || InColumnLetter.IsNumeric())
+	const int32 Column = RuntimeDataTableA1::ParseColumnLetters(*InColumnLetter, InColumnLetter.Len());
+	if (Column == 0)
 	{
 		FRuntimeDataTableModule::Print(FString::Printf(
-			TEXT("%hs: Input is either empty or numeric. Aborting operation. Character: %s"),
+			TEXT("%hs: Only one to three letters found in the English alphabet can be converted to an index. Input is: %s"),
 			__FUNCTION__, *InColumnLetter), FRuntimeDataTableModule::ELogType::Error);
 		return -1;
 	}
 
-	FString ColumnLetterAsUppercase = InColumnLetter.ToUpper();
-
-	const TArray<FString>& Alphabet = GetAlphabet();
-	const int32 AlphabetCount = Alphabet.Num(); // Count of English Alphabet letters
-
-	int32 NewIndex = 0;
-
-	uint8 Count = 0;
-	while (ColumnLetterAsUppercase.Len() > 0)
-	{
-		const FString& LastLetter = ColumnLetterAsUppercase.Right(1);
-		ColumnLetterAsUppercase = ColumnLetterAsUppercase.LeftChop(1);
-		const int32 KeyIndex = Alphabet.IndexOfByKey(LastLetter);
-		if (KeyIndex < 0)
-		{
-			FRuntimeDataTableModule::Print(
-				FString::Printf(
-					TEXT("%hs: Only letters found in the English alphabet are considered for converting to index. Character: %s"),
-					__FUNCTION__, *LastLetter), FRuntimeDataTableModule::ELogType::Error);
-			return -1;
-		}
-		Count++;
-
-		switch (Count)
-		{
-		default:
-			checkNoEntry();
-
-		case 1:
-		
-			NewIndex += KeyIndex;
-			break;
-
-		case 2:
-			NewIndex += (KeyIndex + 1) * AlphabetCount;
-			break;
-
-		case 3:
-			NewIndex += (KeyIndex + 1) * AlphabetCount * AlphabetCount;
-			return NewIndex; // we return so we don't even consider counts greater than 3
-		}
-	}
-
-	return NewIndex + 1;
+	return Column;
 }
 
 FString FCsvToGoogleSheetsHandler::ColumnIndexToLetter(const int32 Index)
 { 
-	FString LetterRep;
-	if (Index < 1 || Index > MaxColumnCount - 1)
+	if (!RuntimeDataTableA1::IsValidColumn(Index))
 	{
 		FRuntimeDataTableModule::Print(FString::Printf(
 			TEXT("%hs: Input is either less than 1 or greater than %i. Aborting operation. Input is: %i"), 
-			__FUNCTION__, MaxColumnCount - 1, Index), FRuntimeDataTableModule::ELogType::Error);
-		return LetterRep;
+			__FUNCTION__, MaxColumnCount, Index), FRuntimeDataTableModule::ELogType::Error);
+		return FString();
 	}
 
-	int32 ZeroBasedIndex = Index - 1;
-
-	const TArray<FString>& Alphabet = GetAlphabet();
-	const int32 AlphabetCount = Alphabet.Num(); // Count of English Alphabet letters
-	const int32 Algo =
-		(int32)FMath::Floor(FMath::LogX( (double)AlphabetCount, ((double)ZeroBasedIndex) * ((double)AlphabetCount - 1) / (double)AlphabetCount + 1));
-	ZeroBasedIndex -= (int32)(FMath::Pow((double)AlphabetCount, (double)Algo) - 1) * AlphabetCount / (AlphabetCount - 1);
-	for (int i = Algo + 1; ZeroBasedIndex + i > 0; i--)
-	{
-		LetterRep = Alphabet[ZeroBasedIndex % AlphabetCount] + LetterRep;
-		ZeroBasedIndex /= AlphabetCount;
-	}
-	return LetterRep;
+	return RuntimeDataTableA1::ColumnToString(Index);
 }
 
 FCsvToGoogleSheetsHandler FCsvToGoogleSheetsHandler::CsvToSheetTabData(FString InCSVString)
@@ -240,37 +154,60 @@ FCsvToGoogleSheetsHandler FCsvToGoogleSheetsHandler::CsvToSheetTabData(FString I
 FString FCsvToGoogleSheetsHandler::GetAllArrayValuesAsJsonString(const bool bAddValuesKey,
 	const bool bWrapInCurlyBraces) const
 {
-	FString FinalJson = "[";
+	FRuntimeDataTableJsonPayloadWriter Writer(GetTotalValueLength() + GetRowCount() * GetColumnCount() * 3 + 16);
+
+	if (bWrapInCurlyBraces)
+	{
+		Writer.BeginObject();
+	}
+
+	WriteAllArrayValuesAsJson(Writer, bAddValuesKey);
+
+	if (bWrapInCurlyBraces)
+	{
+		Writer.EndObject();
+	}
+
+	return Writer.GetPayloadAsString();
+}
+
+void FCsvToGoogleSheetsHandler::WriteAllArrayValuesAsJson(FRuntimeDataTableJsonPayloadWriter& Writer, const bool bAddValuesKey) const
+{
+	if (bAddValuesKey)
+	{
+		Writer.BeginArray("values");
+	}
+	else
+	{
+		Writer.BeginArray();
+	}
 	
 	for (const TArray<FString>& Row : ArrayValues)
 	{
-		FinalJson += "[";
+		Writer.BeginArray();
 
 		for (const FString& Cell : Row)
 		{
-			FinalJson += FString::Printf(TEXT("\"%s\","), *Cell);
+			Writer.WriteStringValue(Cell);
 		}
 
-		// Remove last comma
-		FinalJson = FinalJson.LeftChop(1);
-
-		FinalJson += "],";
+		Writer.EndArray();
 	}
 	
-	// Remove last comma
-	FinalJson = FinalJson.LeftChop(1);
-	
-	FinalJson += "]";
+	Writer.EndArray();
+}
 
-	if (bAddValuesKey)
-	{
-		FinalJson = "\"values\": " + FinalJson;
-	}
+int32 FCsvToGoogleSheetsHandler::GetTotalValueLength() const
+{
+	int32 TotalLength = 0;
 
-	if (bWrapInCurlyBraces)
+	for (const TArray<FString>& Row : ArrayValues)
 	{
-		FinalJson = "{" + FinalJson + "}";
+		for (const FString& Cell : Row)
+		{
+			TotalLength += Cell.Len();
+		}
 	}
 
-	return FinalJson;
+	return TotalLength;
 }
@@ -2,16 +2,30 @@
 
 #include "RuntimeDataTable.h"
 
+#include "RuntimeDataTableBackupStore.h"
 #include "CsvToGoogleSheetsHandler.h"
+#include "RuntimeDataTableJsonPayloadWriter.h"
 #include "RuntimeDataTableModule.h"
+#include "RuntimeDataTableOperationSubsystem.h"
+#include "RuntimeDataTablePrefetchCache.h"
+#include "RuntimeDataTablePropertyPath.h"
 #include "RuntimeDataTableProjectSettings.h"
-
-#include "jwt-cpp/jwt.h"
-
+#include "RuntimeDataTableRequestCoalescer.h"
+#include "RuntimeDataTableRequestScheduler.h"
+#include "RuntimeDataTableSheetPoller.h"
+#include "RuntimeDataTableSheetWriteCache.h"
+#include "RuntimeDataTableSnapshot.h"
+#include "RuntimeDataTableStats.h"
+#include "RuntimeDataTableTokenManager.h"
+
+#include "Async/Async.h"
+#include "Containers/Ticker.h"
 #include "Dom/JsonObject.h"
 #include "Dom/JsonValue.h"
+#include "Engine/DataTable.h"
 #include "Engine/GameEngine.h"
 #include "Engine/UserDefinedStruct.h"
+#include "GenericPlatform/GenericPlatformHttp.h"
 #include "Interfaces/IHttpResponse.h"
 #include "Misc/Paths.h"
 #include "Runtime/Launch/Resources/Version.h"
@@ -23,6 +37,136 @@
 
 FName URuntimeDataTableObject::GetTokenOperationName = "GetToken";
 
+// Everything a multi-tab download needs to carry between its requests
+struct FRuntimeDataTableMultiTabDownload
+{
+	FRuntimeDataTableOperationParams OperationParams;
+	FRDTGetMultipleTabsDelegate CallOnComplete;
+	FString SpreadsheetId;
+	bool bParseHeaders = true;
+	bool bParseKeys = true;
+
+	// One result per requested tab, in the order they were requested
+	TArray<FRuntimeDataTableTabResult> TabResults;
+
+	// Used by public sheets, which are exported one tab per request
+	int32 NextTabIndex = 0;
+	int32 NumTabsInFlight = 0;
+	int32 NumTabsCompleted = 0;
+
+	int32 LastResponseCode = INDEX_NONE;
+};
+
+// Everything a chunked upload needs to carry between its requests
+struct FRuntimeDataTableChunkedUpload
+{
+	struct FChunk
+	{
+		// Row range in the sheet, end exclusive
+		int32 StartRow = 0;
+		int32 EndRow = 0;
+		int32 EstimatedBytes = 0;
+	};
+
+	FRuntimeDataTableTokenInfo TokenInfo;
+	FRuntimeDataTableOperationParams OperationParams;
+	FRDTGetStringDelegate CallOnProgress;
+	FRDTGetStringDelegate CallOnComplete;
+	FString SpreadsheetId;
+	int32 SheetId = INDEX_NONE;
+
+	FCsvToGoogleSheetsHandler SheetTabData;
+
+	// The token is refreshed if it is about to run out partway through the upload
+	FString TokenText;
+	FDateTime TokenExpiration;
+	bool bWaitingForToken = false;
+
+	// Refreshes in a row that came back without enough time on them, see WriteCsvToSheetChunked_SendNextChunks
+	int32 NumShortTokenRefreshes = 0;
+
+	TArray<FChunk> Chunks;
+	TArray<int32> QueuedChunkIndices;
+	int32 NumChunksInFlight = 0;
+	int32 NumChunksSucceeded = 0;
+	int32 NumChunksFailed = 0;
+
+	int32 LastResponseCode = INDEX_NONE;
+	bool bFinished = false;
+};
+
+// What FetchSheetSnapshotChanges needs once its download is back
+struct FRuntimeDataTableSnapshotFetch
+{
+	FString SnapshotName;
+	FString SheetURL;
+	FRDTSnapshotChangesDelegate CallOnComplete;
+
+	// Empty if there was no snapshot to start from, in which case every row counts as changed
+	FRuntimeDataTableSnapshot Snapshot;
+};
+
+// The columns of a flattened export that belong to members of Struct, keyed by column index.
+// UpdateArrayFromCsvInfo only matches top level member names, so these are applied after it.
+static TArray<TPair<int32, FRuntimeDataTablePropertyPath>> GetFlattenedColumns(const UStruct* Struct, const TArray<FString>& Headers)
+{
+	TArray<TPair<int32, FRuntimeDataTablePropertyPath>> FlattenedColumns;
+
+	TSharedPtr<const TArray<FRuntimeDataTablePropertyPath>> Paths;
+	for (int32 ColumnIndex = 0; ColumnIndex < Headers.Num(); ColumnIndex++)
+	{
+		if (!FRuntimeDataTablePropertyPath::IsFlattenedColumnName(Headers[ColumnIndex]))
+		{
+			continue;
+		}
+
+		if (!Paths.IsValid())
+		{
+			Paths = FRuntimeDataTablePropertyPath::Compile(Struct);
+		}
+
+		if (const FRuntimeDataTablePropertyPath* Path = FRuntimeDataTablePropertyPath::FindByColumnName(*Paths, Headers[ColumnIndex]))
+		{
+			FlattenedColumns.Emplace(ColumnIndex, *Path);
+		}
+	}
+
+	return FlattenedColumns;
+}
+
+// A 401 means the token was revoked or ran out early, so the next operation has to exchange a new one instead of reusing it
+static void InvalidateRejectedAccessToken(const FHttpRequestPtr& Request, const int32 ResponseCode)
+{
+	if (ResponseCode != 401 || !Request.IsValid())
+	{
+		return;
+	}
+
+	FString AccessToken = Request->GetHeader("Authorization");
+	if (AccessToken.RemoveFromStart("Bearer "))
+	{
+		FRuntimeDataTableTokenManager::Get().InvalidateAccessToken(AccessToken);
+	}
+}
+
+static void ApplyFlattenedColumns(
+	const TArray<TPair<int32, FRuntimeDataTablePropertyPath>>& FlattenedColumns, const TArray<FString>& StringArray,
+	void* Container, UObject* OwningObject)
+{
+	for (const TPair<int32, FRuntimeDataTablePropertyPath>& Column : FlattenedColumns)
+	{
+		if (StringArray.IsValidIndex(Column.Key) && !StringArray[Column.Key].IsEmpty())
+		{
+			if (!Column.Value.ImportValue(StringArray[Column.Key], Container, OwningObject))
+			{
+				FRuntimeDataTableModule::Print(FString::Printf(
+					TEXT("%hs: Could not read '%s' as a value for %s"), __FUNCTION__, *StringArray[Column.Key], *Column.Value.ColumnName),
+					FRuntimeDataTableModule::ELogType::Warning);
+			}
+		}
+	}
+}
+
 bool URuntimeDataTableWebToken::Init(const FString InTokenText, const int32 SecondsUntilExpiration)
 {
 	TokenText = InTokenText;
@@ -131,11 +275,18 @@ void URuntimeDataTableObject::DownloadPublicSheet(
 	FString URL = "https://docs.google.com/spreadsheets/d/" + AssetID + "/export?format=" + MIME + (gid != "" ? "&gid=" + gid : "");
 	FRuntimeDataTableModule::Print("URL to download csv is " + URL);
 
-	Request_GET_PublicSheetAsCSV(URL, CallOnComplete, OperationParams);
+	const FString CoalescingKey = FRuntimeDataTableRequestCoalescer::MakeKey(URL, nullptr);
+	if (FRuntimeDataTableRequestCoalescer::Get().TryJoin(CoalescingKey, OperationParams.OperationName, CallOnComplete))
+	{
+		return;
+	}
+
+	Request_GET_PublicSheetAsCSV(URL, CallOnComplete, OperationParams, CoalescingKey);
 }
 
 void URuntimeDataTableObject::Request_GET_PublicSheetAsCSV(
-	FString RequestURL, const FRDTGetStringDelegate& CallOnComplete, const FRuntimeDataTableOperationParams OperationParams)
+	FString RequestURL, const FRDTGetStringDelegate& CallOnComplete, const FRuntimeDataTableOperationParams OperationParams,
+	const FString& CoalescingKey)
 {
 	FHttpModule* HTTP_Module = &FHttpModule::Get();
 	TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = HTTP_Module->CreateRequest();
@@ -143,22 +294,42 @@ void URuntimeDataTableObject::Request_GET_PublicSheetAsCSV(
 	Request->SetURL(RequestURL);
 	Request->SetVerb("GET");
 	Request->SetHeader(TEXT("Accept"), "text/csv");
-	Request->OnProcessRequestComplete().BindUObject(this, &URuntimeDataTableObject::OnResponseReceived_GET_SheetAsCSV, CallOnComplete, OperationParams);
+	Request->OnProcessRequestComplete().BindUObject(
+		this, &URuntimeDataTableObject::OnResponseReceived_GET_SheetAsCSV, CallOnComplete, OperationParams, CoalescingKey);
 	Request->SetTimeout(OperationParams.RequestTimeout);
 	
-	AddToRoot();
-	Request->ProcessRequest();
+	BeginOperation(OperationParams.OperationName);
+	ProcessOperationRequest(Request);
 }
 
 void URuntimeDataTableObject::OnResponseReceived_GET_SheetAsCSV(
 	FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful,
-	FRDTGetStringDelegate CallOnComplete, const FRuntimeDataTableOperationParams OperationParams)
+	FRDTGetStringDelegate CallOnComplete, const FRuntimeDataTableOperationParams OperationParams, FString CoalescingKey)
 {
 	FRuntimeDataTableCallbackInfo CallbackInfo;
 	CallbackInfo.OperationName = OperationParams.OperationName;
 	CallbackInfo.bWasSuccessful = bWasSuccessful;
 	GenericValidateHttpResponse(Request, Response, CallbackInfo);
-	CallOnComplete.ExecuteIfBound(CallbackInfo);
+
+	if (CoalescingKey.IsEmpty())
+	{
+		CallOnComplete.ExecuteIfBound(CallbackInfo);
+	}
+	else
+	{
+		FRuntimeDataTableRequestCoalescer::Get().Complete(CoalescingKey, CallbackInfo, CallOnComplete);
+	}
+}
+
+FString URuntimeDataTableObject::GetCsvExportUrl(const FString& InSheetURL)
+{
+	return GetCsvExportUrl(GetSpreadsheetIdFromUrl(InSheetURL), GetSheetIdFromUrl(InSheetURL));
+}
+
+FString URuntimeDataTableObject::GetCsvExportUrl(const FString& InSpreadsheetId, const FString& InGid)
+{
+	// The export endpoint takes a file extension, not a MIME type
+	return GetGoogleSheetsUrlPrefix() + InSpreadsheetId + "/export?format=csv" + (!InGid.IsEmpty() ? "&gid=" + InGid : "");
 }
 
 FString URuntimeDataTableObject::GetSpreadsheetIdFromUrl(const FString SheetURL)
@@ -240,6 +411,17 @@ FString URuntimeDataTableObject::GetGoogleSheetsBatchUpdateURL(const FString InS
 	return GetGoogleSheetsApiUrlPrefix() + InSpreadsheetId + ":batchUpdate";
 }
 
+FString URuntimeDataTableObject::GetGoogleSheetsValuesBatchGetURL(const FString InSpreadsheetId)
+{
+	if (const URuntimeDataTableProjectSettings* Settings = GetDefault<URuntimeDataTableProjectSettings>())
+	{
+		return GetGoogleSheetsApiUrlPrefix() + InSpreadsheetId + Settings->GoogleSheetsValuesBatchGetCommand;
+	}
+		
+	FRuntimeDataTableModule::Print("Unable to get URuntimeDataTableProjectSettings Object", FRuntimeDataTableModule::ELogType::Error);
+	return GetGoogleSheetsApiUrlPrefix() + InSpreadsheetId + "/values:batchGet";
+}
+
 bool URuntimeDataTableObject::ValidateGoogleSheetsDownloadAndLoadBackupIfNeeded(
 	const FRuntimeDataTableCallbackInfo InCallbackInfo,
 	FEasyCsvInfo& OutCsvInfo,
@@ -253,9 +435,11 @@ bool URuntimeDataTableObject::ValidateGoogleSheetsDownloadAndLoadBackupIfNeeded(
 			FText* Result = nullptr;
 			const bool bCanMakeSaveAttempt = !BackupSavePath.IsEmpty() && FPaths::ValidatePath(BackupSavePath, Result);
 			
-			if (bCanMakeSaveAttempt && UEasyCsv::SaveStringToFileWithFullPath(InCallbackInfo.ResponseAsString, BackupSavePath))
+			// Compressing and writing both scale with the sheet, so they're left to a worker and can't be reported on here
+			if (bCanMakeSaveAttempt)
 			{
-				OutResultCode = ERuntimeDataTableBackupResultCode::DownloadSucceededAndBackupSaved;
+				FRuntimeDataTableBackupStore::SaveBackupAsync(BackupSavePath, InCallbackInfo.ResponseAsString);
+				OutResultCode = ERuntimeDataTableBackupResultCode::DownloadSucceededAndBackupSaveStarted;
 			}
 			else
 			{
@@ -269,9 +453,11 @@ bool URuntimeDataTableObject::ValidateGoogleSheetsDownloadAndLoadBackupIfNeeded(
 	}
 	else
 	{
-		if (FPaths::FileExists(BackupLoadPath))
+		TArray<uint8> BackupCsv;
+		if (FRuntimeDataTableBackupStore::HasBackup(BackupLoadPath))
 		{
-			if (UEasyCsv::MakeCsvInfoStructFromFile(BackupLoadPath, OutCsvInfo))
+			if (FRuntimeDataTableBackupStore::LoadBackup(BackupLoadPath, BackupCsv) &&
+				UEasyCsv::MakeCsvInfoStructFromUtf8(BackupCsv, OutCsvInfo))
 			{
 				OutResultCode = ERuntimeDataTableBackupResultCode::DownloadFailedAndBackupLoaded;
 			}
@@ -287,13 +473,75 @@ bool URuntimeDataTableObject::ValidateGoogleSheetsDownloadAndLoadBackupIfNeeded(
 	}
 
 	return OutResultCode == ERuntimeDataTableBackupResultCode::DownloadSucceededAndBackupCouldNotBeSaved ||
-		OutResultCode == ERuntimeDataTableBackupResultCode::DownloadSucceededAndBackupSaved ||
+		OutResultCode == ERuntimeDataTableBackupResultCode::DownloadSucceededAndBackupSaveStarted ||
 		OutResultCode == ERuntimeDataTableBackupResultCode::DownloadFailedAndBackupLoaded;
 }
 
+void URuntimeDataTableObject::ValidateGoogleSheetsDownloadAndLoadBackupIfNeededAsync(
+	const FRuntimeDataTableCallbackInfo InCallbackInfo, const FRDTGetBackupResultDelegate CallOnComplete,
+	const FString& BackupSavePath, const FString& BackupLoadPath)
+{
+	Async(EAsyncExecution::ThreadPool, [InCallbackInfo, CallOnComplete, BackupSavePath, BackupLoadPath]()
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(URuntimeDataTableObject::ValidateGoogleSheetsDownloadAndLoadBackupIfNeededAsync);
+
+		TSharedRef<FEasyCsvInfo> CsvInfo = MakeShared<FEasyCsvInfo>();
+		ERuntimeDataTableBackupResultCode ResultCode;
+
+		if (InCallbackInfo.bWasSuccessful)
+		{
+			// Checked here because MakeCsvInfoStructFromString prints on empty input, which isn't safe from a worker
+			const bool bParsed = !InCallbackInfo.ResponseAsString.IsEmpty() &&
+				UEasyCsv::MakeCsvInfoStructFromString(InCallbackInfo.ResponseAsString, *CsvInfo);
+
+			if (!bParsed)
+			{
+				ResultCode = ERuntimeDataTableBackupResultCode::DownloadSucceededButCsvCouldNotBeParsed;
+			}
+			else if (!BackupSavePath.IsEmpty() && FRuntimeDataTableBackupStore::SaveBackup(BackupSavePath, InCallbackInfo.ResponseAsString))
+			{
+				ResultCode = ERuntimeDataTableBackupResultCode::DownloadSucceededAndBackupSaved;
+			}
+			else
+			{
+				ResultCode = ERuntimeDataTableBackupResultCode::DownloadSucceededAndBackupCouldNotBeSaved;
+			}
+		}
+		else if (FRuntimeDataTableBackupStore::HasBackup(BackupLoadPath))
+		{
+			TArray<uint8> BackupCsv;
+			ResultCode =
+				FRuntimeDataTableBackupStore::LoadBackup(BackupLoadPath, BackupCsv) && UEasyCsv::MakeCsvInfoStructFromUtf8(BackupCsv, *CsvInfo) ?
+				ERuntimeDataTableBackupResultCode::DownloadFailedAndBackupLoaded :
+				ERuntimeDataTableBackupResultCode::DownloadFailedAndBackupExistsBuCouldNotBeLoaded;
+		}
+		else
+		{
+			ResultCode = ERuntimeDataTableBackupResultCode::DownloadFailedWithoutBackup;
+		}
+
+		AsyncTask(ENamedThreads::GameThread, [CallOnComplete, CsvInfo, ResultCode]()
+		{
+			const bool bHasCsvInfo =
+				ResultCode == ERuntimeDataTableBackupResultCode::DownloadSucceededAndBackupCouldNotBeSaved ||
+				ResultCode == ERuntimeDataTableBackupResultCode::DownloadSucceededAndBackupSaved ||
+				ResultCode == ERuntimeDataTableBackupResultCode::DownloadFailedAndBackupLoaded;
+
+			FRuntimeDataTableModule::Print(FString::Printf(TEXT("%hs: Result code: %s"),
+				__FUNCTION__, *UEnum::GetValueAsString(ResultCode)),
+				bHasCsvInfo ? FRuntimeDataTableModule::ELogType::Display : FRuntimeDataTableModule::ELogType::Warning);
+
+			CallOnComplete.ExecuteIfBound(bHasCsvInfo, *CsvInfo, ResultCode);
+		});
+	});
+}
+
 bool URuntimeDataTableObject::UpdateArrayFromCsvInfo_Internal(
 	FArrayProperty* ArrayProperty, void* ArrayPtr, UObject* OwningObject, FEasyCsvInfo CsvInfo, bool bNameMatch)
 {
+	TRACE_CPUPROFILER_EVENT_SCOPE(URuntimeDataTableObject::UpdateArrayFromCsvInfo_Internal);
+	SCOPE_CYCLE_COUNTER(STAT_RuntimeDataTable_UpdateArray);
+
 	if (CsvInfo.CSV_Headers.Num() < 1 || CsvInfo.CSV_Keys.Num() < 1)
 	{
 		FRuntimeDataTableModule::Print("UpdateArrayFromCSV_Info_Internal: CSV_Info is not valid. Headers length is " + FString::FromInt(CsvInfo.CSV_Headers.Num()) +
@@ -305,6 +553,9 @@ bool URuntimeDataTableObject::UpdateArrayFromCsvInfo_Internal(
 
 	if (InnerProperty->IsA(FObjectProperty::StaticClass()))
 	{
+		// Objects in the array don't have to share a class
+		TMap<const UClass*, TArray<TPair<int32, FRuntimeDataTablePropertyPath>>> FlattenedColumnsByClass;
+
 		FScriptArrayHelper ArrayHelper(ArrayProperty, ArrayPtr);
 		for (int32 i = 0; i < ArrayHelper.Num(); i++)
 		{
@@ -312,6 +563,14 @@ bool URuntimeDataTableObject::UpdateArrayFromCsvInfo_Internal(
 			FRuntimeDataTableModule::Print("OwningObject = " + OwningObject->GetName() + " with class " + OwningObject->GetClass()->GetFName().ToString());
 			TArray<FString> StringArray = CsvInfo.CSV_Map[CsvInfo.CSV_Keys[i]].StringValues;
 
+			const TArray<TPair<int32, FRuntimeDataTablePropertyPath>>* FlattenedColumns = FlattenedColumnsByClass.Find(OwningObject->GetClass());
+			if (!FlattenedColumns)
+			{
+				FlattenedColumns = &FlattenedColumnsByClass.Add(
+					OwningObject->GetClass(), GetFlattenedColumns(OwningObject->GetClass(), CsvInfo.CSV_Headers));
+			}
+			ApplyFlattenedColumns(*FlattenedColumns, StringArray, OwningObject, OwningObject);
+
 			int32 Count = 0;
 			for (int32 x = 0; x < CsvInfo.CSV_Headers.Num(); x++)
 			{
@@ -340,6 +599,11 @@ bool URuntimeDataTableObject::UpdateArrayFromCsvInfo_Internal(
 	}
 	else if (InnerProperty->IsA(FStructProperty::StaticClass()))
 	{
+		// Only name matching can tell which member a dotted column belongs to
+		const TArray<TPair<int32, FRuntimeDataTablePropertyPath>> FlattenedColumns = bNameMatch ?
+			GetFlattenedColumns(((FStructProperty*)InnerProperty)->Struct, CsvInfo.CSV_Headers) :
+			TArray<TPair<int32, FRuntimeDataTablePropertyPath>>();
+
 		FScriptArrayHelper ArrayHelper(ArrayProperty, ArrayPtr);
 		ArrayHelper.EmptyValues(ArrayHelper.Num());
 		for (int32 i = 0; i < CsvInfo.CSV_Keys.Num(); i++)
@@ -347,6 +611,8 @@ bool URuntimeDataTableObject::UpdateArrayFromCsvInfo_Internal(
 			TArray<FString> StringArray = CsvInfo.CSV_Map[CsvInfo.CSV_Keys[i]].StringValues;
 			ArrayHelper.AddValue();
 
+			ApplyFlattenedColumns(FlattenedColumns, StringArray, ArrayHelper.GetRawPtr(i), OwningObject);
+
 			UScriptStruct* Struct = ((FStructProperty*)InnerProperty)->Struct;
 			int32 Count = 0;
 			for (TFieldIterator<FProperty> It(Struct); It; ++It)
@@ -401,6 +667,141 @@ bool URuntimeDataTableObject::UpdateArrayFromCsvInfo_Internal(
 	return true;
 }
 
+bool URuntimeDataTableObject::UpdateDataTableFromCsvInfo(
+	UDataTable* DataTable, const FEasyCsvInfo& CsvInfo, const bool bRemoveMissingRows)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(URuntimeDataTableObject::UpdateDataTableFromCsvInfo);
+	SCOPE_CYCLE_COUNTER(STAT_RuntimeDataTable_UpdateDataTable);
+
+	const double StartTime = FPlatformTime::Seconds();
+
+	const UScriptStruct* RowStruct = DataTable ? DataTable->GetRowStruct() : nullptr;
+	if (!RowStruct)
+	{
+		FRuntimeDataTableModule::Print(FString::Printf(
+			TEXT("%hs: DataTable is not valid or has no row struct."), __FUNCTION__), FRuntimeDataTableModule::ELogType::Error);
+		return false;
+	}
+
+	const TArray<FRuntimeDataTablePropertyPath> Columns = FRuntimeDataTablePropertyPath::MapColumns(RowStruct, CsvInfo.CSV_Headers);
+	if (!Columns.ContainsByPredicate([](const FRuntimeDataTablePropertyPath& Column) { return Column.Leaf != nullptr; }))
+	{
+		FRuntimeDataTableModule::Print(FString::Printf(
+			TEXT("%hs: None of the %i columns match a member of %s."), __FUNCTION__, CsvInfo.CSV_Headers.Num(), *RowStruct->GetName()),
+			FRuntimeDataTableModule::ELogType::Error);
+		return false;
+	}
+
+	// Empty cells put a member back to its default rather than leaving whatever the last update left there
+	uint8* DefaultRow = static_cast<uint8*>(FMemory::Malloc(RowStruct->GetStructureSize()));
+	RowStruct->InitializeStruct(DefaultRow);
+
+	// New rows are filled in here first, so that AddRow never shows anyone a row whose cells aren't written yet
+	uint8* NewRow = static_cast<uint8*>(FMemory::Malloc(RowStruct->GetStructureSize()));
+	RowStruct->InitializeStruct(NewRow);
+
+	int32 NumRowsAdded = 0;
+	int32 NumRowsUpdated = 0;
+	int32 NumRowsRemoved = 0;
+
+	TSet<FName> RowsInCsv;
+	RowsInCsv.Reserve(CsvInfo.CSV_Keys.Num());
+
+	// AddRow and RemoveRow broadcast OnDataTableChanged each time and there's no public way to add or remove a row without it,
+	// so the listeners are set aside until every row is in and are told once at the end. Nothing below can add or remove one.
+	UDataTable::FOnDataTableChanged ChangedListeners = MoveTemp(DataTable->OnDataTableChanged());
+	DataTable->OnDataTableChanged().Clear();
+
+	for (const FName& RowKey : CsvInfo.CSV_Keys)
+	{
+		bool bAlreadyApplied = false;
+		RowsInCsv.Add(RowKey, &bAlreadyApplied);
+
+		const FEasyCsvStringValueArray* Row = CsvInfo.CSV_Map.Find(RowKey);
+		if (bAlreadyApplied || RowKey.IsNone() || !Row)
+		{
+			continue;
+		}
+
+		// Rows we already have are written over where they are
+		uint8* RowData = DataTable->FindRowUnchecked(RowKey);
+		const bool bIsNewRow = RowData == nullptr;
+		if (bIsNewRow)
+		{
+			RowStruct->CopyScriptStruct(NewRow, DefaultRow);
+			RowData = NewRow;
+		}
+
+		const int32 NumColumns = FMath::Min(Columns.Num(), Row->StringValues.Num());
+		for (int32 ColumnIndex = 0; ColumnIndex < NumColumns; ColumnIndex++)
+		{
+			const FRuntimeDataTablePropertyPath& Column = Columns[ColumnIndex];
+			if (!Column.Leaf)
+			{
+				continue;
+			}
+
+			const FString& ValueAsString = Row->StringValues[ColumnIndex];
+			if (ValueAsString.IsEmpty())
+			{
+				Column.ResetValue(RowData, DefaultRow);
+				continue;
+			}
+
+			if (!Column.ImportValue(ValueAsString, RowData, DataTable))
+			{
+				FRuntimeDataTableModule::Print(FString::Printf(
+					TEXT("%hs: Could not read '%s' as a value for %s in row %s"), __FUNCTION__, *ValueAsString,
+					*Column.ColumnName, *RowKey.ToString()), FRuntimeDataTableModule::ELogType::Warning);
+			}
+		}
+
+		if (bIsNewRow)
+		{
+			// Copies the row in
+			DataTable->AddRow(RowKey, *reinterpret_cast<const FTableRowBase*>(NewRow));
+			NumRowsAdded++;
+		}
+		else
+		{
+			NumRowsUpdated++;
+		}
+	}
+
+	RowStruct->DestroyStruct(NewRow);
+	FMemory::Free(NewRow);
+	RowStruct->DestroyStruct(DefaultRow);
+	FMemory::Free(DefaultRow);
+
+	if (bRemoveMissingRows)
+	{
+		TArray<FName> RowsToRemove;
+		for (const TPair<FName, uint8*>& Pair : DataTable->GetRowMap())
+		{
+			if (!RowsInCsv.Contains(Pair.Key))
+			{
+				RowsToRemove.Add(Pair.Key);
+			}
+		}
+
+		for (const FName& RowKey : RowsToRemove)
+		{
+			DataTable->RemoveRow(RowKey);
+		}
+		NumRowsRemoved = RowsToRemove.Num();
+	}
+
+	DataTable->OnDataTableChanged() = MoveTemp(ChangedListeners);
+	DataTable->OnDataTableChanged().Broadcast();
+
+	FRuntimeDataTableStats::RecordStage(TEXT("Import"), NAME_None, FPlatformTime::Seconds() - StartTime, 0, CsvInfo.CSV_Keys.Num());
+
+	FRuntimeDataTableModule::Print(FString::Printf(TEXT("%hs: %s: %i rows added, %i updated, %i removed"),
+		__FUNCTION__, *DataTable->GetName(), NumRowsAdded, NumRowsUpdated, NumRowsRemoved));
+
+	return true;
+}
+
 void URuntimeDataTableObject::IterateThroughPropertyAndUpdateFromString(
 	const FProperty* InnerProperty, void* ContainerPtr, const FString ValueAsString, UObject* OwningObject, bool IsUObject)
 {
@@ -432,8 +833,12 @@ void URuntimeDataTableObject::IterateThroughPropertyAndUpdateFromString(
 }
 
 FString URuntimeDataTableObject::GenerateCsvFromArray_Internal(FArrayProperty* ArrayProperty, void* ArrayPtr,
-	TArray<FString> RowKeys, UObject* OwningObject, FString MembersToInclude, const bool bSortColumnsAlphanumerically)
+	TArray<FString> RowKeys, UObject* OwningObject, FString MembersToInclude, const bool bSortColumnsAlphanumerically,
+	const bool bFlattenNestedStructs)
 {
+	TRACE_CPUPROFILER_EVENT_SCOPE(URuntimeDataTableObject::GenerateCsvFromArray_Internal);
+	SCOPE_CYCLE_COUNTER(STAT_RuntimeDataTable_GenerateCsv);
+
 	if (!ArrayProperty || !ArrayPtr || !OwningObject)
 	{
 		FRuntimeDataTableModule::Print(
@@ -494,7 +899,7 @@ FString URuntimeDataTableObject::GenerateCsvFromArray_Internal(FArrayProperty* A
 		FString TopRow;
 		IterateThroughStructPropertyAndMakeRowString(
 			StructProperty, ArrayHelper.GetRawPtr(i), RowKey, OwningObject,
-			bIsUObject, bSortColumnsAlphanumerically, NumValues, TopRow, Row, MembersWhitelist
+			bIsUObject, bSortColumnsAlphanumerically, NumValues, TopRow, Row, MembersWhitelist, bFlattenNestedStructs
 		);
 
 		//Add to local CSV
@@ -531,7 +936,8 @@ bool URuntimeDataTableObject::IsPropertyDataTableSupported(const FProperty* Prop
 void URuntimeDataTableObject::IterateThroughStructPropertyAndMakeRowString(
 		const FStructProperty* StructProperty, void* StructPtr, const FString& RowKey, UObject* OwningObject, const bool bIsUObject,
 		const bool bSortColumnsAlphanumerically,
-		uint8& OutNumValues, FString& OutTopRow, FString& OutRowString, const TArray<FString>& InMemberWhitelist)
+		uint8& OutNumValues, FString& OutTopRow, FString& OutRowString, const TArray<FString>& InMemberWhitelist,
+		const bool bFlattenNestedStructs)
 {
 	if (!StructProperty || !StructPtr || !OwningObject)
 	{
@@ -543,6 +949,48 @@ void URuntimeDataTableObject::IterateThroughStructPropertyAndMakeRowString(
 	}
 	
 	const bool bIncludeAllMembers = InMemberWhitelist.Num() == 0;
+
+	if (bFlattenNestedStructs)
+	{
+		// Objects are their own container, see IterateThroughPropertyAndUpdateFromString
+		const UStruct* ContainerStruct = bIsUObject ? static_cast<const UStruct*>(OwningObject->GetClass()) : StructProperty->Struct;
+		const void* Container = bIsUObject ? static_cast<const void*>(OwningObject) : StructPtr;
+
+		// A whitelisted member brings all of its nested members with it, or single nested members can be named by path
+		const TSharedRef<const TArray<FRuntimeDataTablePropertyPath>> Paths = FRuntimeDataTablePropertyPath::Compile(ContainerStruct);
+		TArray<const FRuntimeDataTablePropertyPath*> PathsToExport;
+		for (const FRuntimeDataTablePropertyPath& Path : *Paths)
+		{
+			if (bIncludeAllMembers || InMemberWhitelist.ContainsByPredicate([&Path](const FString& s)
+			{
+				const FString Member = s.TrimStartAndEnd();
+				return Member.Equals(Path.RootName, ESearchCase::IgnoreCase) || Member.Equals(Path.ColumnName, ESearchCase::IgnoreCase);
+			}))
+			{
+				PathsToExport.Add(&Path);
+			}
+		}
+
+		if (bSortColumnsAlphanumerically)
+		{
+			PathsToExport.Sort([](const FRuntimeDataTablePropertyPath& PathA, const FRuntimeDataTablePropertyPath& PathB)
+			{
+				return PathA.ColumnName < PathB.ColumnName;
+			});
+		}
+
+		OutTopRow = "\"Key\"";
+		OutRowString = "\"" + RowKey + "\"";
+
+		for (const FRuntimeDataTablePropertyPath* Path : PathsToExport)
+		{
+			OutTopRow += ",\"" + Path->ColumnName + "\"";
+			OutRowString += ",\"" + Path->ExportValue(Container, OwningObject).Replace(TEXT("\""), TEXT("\"\"")) + "\"";
+		}
+
+		OutNumValues = PathsToExport.Num();
+		return;
+	}
 	
 	// Walk the structs' properties
 	const UScriptStruct* Struct = StructProperty->Struct;
@@ -697,12 +1145,22 @@ void URuntimeDataTableObject::BuildGoogleSheetDownloadLinkAndGetAsCsv_Internal(
 	}
 	else if (ValidateTokenInfo(InTokenInfo, ErrorMessage))
 	{
+		// Someone else with the same account may already be downloading this sheet
+		const FString CoalescingKey = FRuntimeDataTableRequestCoalescer::MakeKey(GetCsvExportUrl(InSheetURL), &InTokenInfo);
+		if (FRuntimeDataTableRequestCoalescer::Get().TryJoin(CoalescingKey, OperationParams.OperationName, CallOnComplete))
+		{
+			return;
+		}
+
+		// Owned from here on, or being collected during the token exchange would leave the key in flight for good
+		BeginOperation(OperationParams.OperationName);
+
 		// Get the auth token then go the next function on callback
 		CreateAndAuthenticateToken(
 			InTokenInfo,
 			FRDTGetJWTDelegate::CreateUObject(
 				this, &URuntimeDataTableObject::BuildGoogleSheetDownloadLinkAndGetAsCsv_AfterToken,
-					OperationParams, CallOnComplete, InSheetURL)
+					OperationParams, CallOnComplete, InSheetURL, CoalescingKey)
 		);
 	}
 	else
@@ -715,7 +1173,8 @@ void URuntimeDataTableObject::BuildGoogleSheetDownloadLinkAndGetAsCsv_Internal(
 
 void URuntimeDataTableObject::BuildGoogleSheetDownloadLinkAndGetAsCsv_AfterToken(
 	const FRuntimeDataTableCallbackInfo CallbackInfo, URuntimeDataTableWebToken* InToken,
-	const FRuntimeDataTableOperationParams OperationParams, const FRDTGetStringDelegate CallOnComplete, const FString InSheetURL)
+	const FRuntimeDataTableOperationParams OperationParams, const FRDTGetStringDelegate CallOnComplete, const FString InSheetURL,
+	const FString CoalescingKey)
 {
 	if (!InToken || InToken->HasTokenExpired())
 	{
@@ -726,15 +1185,12 @@ void URuntimeDataTableObject::BuildGoogleSheetDownloadLinkAndGetAsCsv_AfterToken
 		FRuntimeDataTableModule::Print(FString::Printf(
 			TEXT("%hs: %s"),
 			__FUNCTION__, *FailedInfo.ResponseAsString), FRuntimeDataTableModule::ELogType::Error);
-		CallOnComplete.ExecuteIfBound(FailedInfo);
+		EndOperation();
+		FRuntimeDataTableRequestCoalescer::Get().Complete(CoalescingKey, FailedInfo, CallOnComplete);
 		return;
 	}
 
-	FString AssetID = GetSpreadsheetIdFromUrl(InSheetURL);
-	FString Gid = GetSheetIdFromUrl(InSheetURL);
-	const FString Mime = "csv";
-
-	const FString URL = GetGoogleSheetsUrlPrefix() + AssetID + "/export?format=" + Mime + (!Gid.IsEmpty() ? "&gid=" + Gid : "");
+	const FString URL = GetCsvExportUrl(InSheetURL);
 
 	FRuntimeDataTableModule::Print(FString::Printf(TEXT("%hs: URL to download csv is %s"), __FUNCTION__, *URL));
 
@@ -743,61 +1199,1061 @@ void URuntimeDataTableObject::BuildGoogleSheetDownloadLinkAndGetAsCsv_AfterToken
 		URL, false, GetMimeCsv());
 
 	Request->OnProcessRequestComplete().BindUObject(
-		this, &URuntimeDataTableObject::OnResponseReceivedGenericReturnString, OperationParams, CallOnComplete);
-	Request->ProcessRequest();
+		this, &URuntimeDataTableObject::OnResponseReceived_GET_SheetAsCSV, CallOnComplete, OperationParams, CoalescingKey);
+	ProcessOperationRequest(Request);
 }
 
-void URuntimeDataTableObject::WriteCsvToSheet_Internal(FRuntimeDataTableTokenInfo InTokenInfo,
-	const FRuntimeDataTableOperationParams OperationParams, const FRDTGetStringDelegate& CallOnComplete,
-	const FString& InSpreadsheetID, const int32 InSheetId, const FString& InCsv)
+void URuntimeDataTableObject::DownloadSheetAsCsvInfo_Internal(
+	FRuntimeDataTableTokenInfo InTokenInfo, const FRuntimeDataTableOperationParams OperationParams,
+	const FRDTGetCsvInfoDelegate& CallOnComplete, const FString& InSheetURL, const bool bSheetIsPublic,
+	const bool ParseHeaders, const bool ParseKeys)
 {
+	// Sheets in the PrefetchManifest were started at launch, so wait for that rather than downloading them again.
+	// Nothing here needs this object, which may be long gone by the time a pending prefetch finishes.
+	if (OperationParams.bUsePrefetchCache && FRuntimeDataTablePrefetchCache::Get().FindOrWait(
+		FRuntimeDataTablePrefetchCache::MakeSheetKey(InSheetURL), ParseHeaders, ParseKeys,
+		[InTokenInfo, OperationParams, CallOnComplete, InSheetURL, bSheetIsPublic, ParseHeaders, ParseKeys](const FEasyCsvInfo* CsvInfo)
+		{
+			if (!CsvInfo)
+			{
+				FRuntimeDataTableOperationParams DownloadParams = OperationParams;
+				DownloadParams.bUsePrefetchCache = false;
+				if (URuntimeDataTableObject* RuntimeDataTableObject = CreateRuntimeDataTableObject())
+				{
+					RuntimeDataTableObject->DownloadSheetAsCsvInfo_Internal(
+						InTokenInfo, DownloadParams, CallOnComplete, InSheetURL, bSheetIsPublic, ParseHeaders, ParseKeys);
+				}
+				return;
+			}
+
+			FRuntimeDataTableCallbackInfo CallbackInfo;
+			CallbackInfo.OperationName = OperationParams.OperationName;
+			CallbackInfo.bWasSuccessful = true;
+			CallbackInfo.ResponseAsString = FString::Printf(
+				TEXT("Parsed %i rows and %i columns at startup."), CsvInfo->CSV_Keys.Num(), CsvInfo->CSV_Headers.Num());
+
+			FRuntimeDataTableModule::Print(FString::Printf(
+				TEXT("URuntimeDataTableObject::DownloadSheetAsCsvInfo_Internal: %s was prefetched. %s"), *InSheetURL, *CallbackInfo.ResponseAsString));
+
+			CallOnComplete.ExecuteIfBound(CallbackInfo, *CsvInfo);
+		}))
+	{
+		return;
+	}
+
 	FString ErrorMessage;
-	if (ValidateTokenInfo(InTokenInfo, ErrorMessage))
+	if (bSheetIsPublic)
 	{
-		// Get the auth token then go the next function on callback
+		const FString URL = GetCsvExportUrl(InSheetURL);
+
+		FRuntimeDataTableModule::Print(FString::Printf(TEXT("%hs: URL to download csv is %s"), __FUNCTION__, *URL));
+
+		const TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = FHttpModule::Get().CreateRequest();
+		Request->SetURL(URL);
+		Request->SetVerb("GET");
+		Request->SetHeader(TEXT("Accept"), GetMimeCsv());
+		Request->SetTimeout(OperationParams.RequestTimeout);
+		Request->OnProcessRequestComplete().BindUObject(
+			this, &URuntimeDataTableObject::OnResponseReceived_SheetAsCsvInfo, OperationParams, CallOnComplete, ParseHeaders, ParseKeys);
+
+		BeginOperation(OperationParams.OperationName);
+		ProcessOperationRequest(Request);
+	}
+	else if (ValidateTokenInfo(InTokenInfo, ErrorMessage))
+	{
+		BeginOperation(OperationParams.OperationName);
+
 		CreateAndAuthenticateToken(
 			InTokenInfo,
 			FRDTGetJWTDelegate::CreateUObject(
-				this, &URuntimeDataTableObject::WriteCsvToSheet_AfterToken,
-					OperationParams, CallOnComplete, InSpreadsheetID, InSheetId, InCsv)
+				this, &URuntimeDataTableObject::DownloadSheetAsCsvInfo_AfterToken,
+					OperationParams, CallOnComplete, InSheetURL, ParseHeaders, ParseKeys)
 		);
 	}
+	else
+	{
+		const FString OutputMessage = FString::Printf(TEXT("InTokenInfo not valid; error: %s"), *ErrorMessage);
+		FRuntimeDataTableModule::Print(FString::Printf(TEXT("%hs:\n%s"), __FUNCTION__, *OutputMessage), FRuntimeDataTableModule::ELogType::Warning);
+		CallOnComplete.ExecuteIfBound({OperationParams.OperationName, false, OutputMessage}, FEasyCsvInfo());
+	}
 }
 
-void URuntimeDataTableObject::WriteCsvToSheet_AfterToken(
+void URuntimeDataTableObject::DownloadSheetAsCsvInfo_AfterToken(
 	const FRuntimeDataTableCallbackInfo CallbackInfo, URuntimeDataTableWebToken* InToken,
-	const FRuntimeDataTableOperationParams OperationParams, FRDTGetStringDelegate CallOnComplete,
-	const FString InSpreadsheetId, const int32 InSheetId, const FString InCsv)
+	const FRuntimeDataTableOperationParams OperationParams, const FRDTGetCsvInfoDelegate CallOnComplete,
+	const FString InSheetURL, const bool ParseHeaders, const bool ParseKeys)
 {
-	// First parse the CSV into a sheet data object and if valid, continue to step 2.
-	if (InSheetId < 0)
+	if (!InToken || InToken->HasTokenExpired())
 	{
 		FRuntimeDataTableCallbackInfo FailedInfo;
 		FailedInfo.bWasSuccessful = false;
 		FailedInfo.OperationName = OperationParams.OperationName;
-		FailedInfo.ResponseAsString =
-			"ERROR: Input 'InSheetId' was not valid. Please enter a valid sheet ID.";
+		FailedInfo.ResponseAsString = "ERROR: InToken has expired or was not successfully created.";
 		FRuntimeDataTableModule::Print(FString::Printf(
 			TEXT("%hs: %s"),
 			__FUNCTION__, *FailedInfo.ResponseAsString), FRuntimeDataTableModule::ELogType::Error);
-		CallOnComplete.ExecuteIfBound(FailedInfo);
+		EndOperation();
+		CallOnComplete.ExecuteIfBound(FailedInfo, FEasyCsvInfo());
+		return;
 	}
-	
-	FCsvToGoogleSheetsHandler SheetTabData = FCsvToGoogleSheetsHandler::CsvToSheetTabData(InCsv);
 
-	if (SheetTabData.GetRowCount() == 0)
-	{
-		FRuntimeDataTableCallbackInfo FailedInfo;
-		FailedInfo.bWasSuccessful = false;
+	const FString URL = GetCsvExportUrl(InSheetURL);
+
+	FRuntimeDataTableModule::Print(FString::Printf(TEXT("%hs: URL to download csv is %s"), __FUNCTION__, *URL));
+
+	TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = CreateAuthorizedGenericRequest_Internal(
+		InToken->GetTokenText(), OperationParams, "GET", URL, false, GetMimeCsv());
+
+	Request->OnProcessRequestComplete().BindUObject(
+		this, &URuntimeDataTableObject::OnResponseReceived_SheetAsCsvInfo, OperationParams, CallOnComplete, ParseHeaders, ParseKeys);
+	ProcessOperationRequest(Request);
+}
+
+void URuntimeDataTableObject::OnResponseReceived_SheetAsCsvInfo(
+	FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful,
+	const FRuntimeDataTableOperationParams OperationParams, FRDTGetCsvInfoDelegate CallOnComplete,
+	const bool ParseHeaders, const bool ParseKeys)
+{
+	Request->OnProcessRequestComplete().Unbind();
+
+	FRuntimeDataTableCallbackInfo CallbackInfo;
+	CallbackInfo.OperationName = OperationParams.OperationName;
+	CallbackInfo.bWasSuccessful = bWasSuccessful && Response.IsValid();
+	CallbackInfo.ResponseCode = Response.IsValid() ? Response->GetResponseCode() : INDEX_NONE;
+
+	// Same checks as GenericValidateHttpResponse, but only the first few bytes of the body are looked at
+	if (CallbackInfo.bWasSuccessful)
+	{
+		const TArray<uint8>& Content = Response->GetContent();
+		const FUTF8ToTCHAR Start(reinterpret_cast<const ANSICHAR*>(Content.GetData()), FMath::Min(Content.Num(), 100));
+		CallbackInfo.bWasSuccessful =
+			CallbackInfo.ResponseCode < 300 && !FString(Start.Length(), Start.Get()).Contains("<!DOCTYPE html>");
+	}
+	InvalidateRejectedAccessToken(Request, CallbackInfo.ResponseCode);
+
+	if (!CallbackInfo.bWasSuccessful)
+	{
+		EndOperation();
+		
+		// Failures are small, so they get the whole response like every other operation
+		CallbackInfo.ResponseAsString = Response.IsValid() ? Response->GetContentAsString() : "";
+		FRuntimeDataTableModule::Print(FString::Printf(
+			TEXT("%hs: Download failed, Response code: %i, Response:\n%s"),
+			__FUNCTION__, CallbackInfo.ResponseCode, *CallbackInfo.ResponseAsString), FRuntimeDataTableModule::ELogType::Error);
+		CallOnComplete.ExecuteIfBound(CallbackInfo, FEasyCsvInfo());
+		return;
+	}
+
+	FRuntimeDataTableModule::Print(FString::Printf(
+		TEXT("%hs: Response received, Response code: %i, parsing %i bytes on a worker thread"),
+		__FUNCTION__, CallbackInfo.ResponseCode, Response->GetContent().Num()));
+
+	// The response owns the body, so the worker keeps it alive instead of copying it. The operation stays open until the result is delivered.
+	INC_MEMORY_STAT_BY(STAT_RuntimeDataTable_ParseMemory, Response->GetContent().Num());
+
+	// Only the operation subsystem keeps this object alive, and it lets go when the engine shuts down mid-parse
+	Async(EAsyncExecution::ThreadPool, [WeakThis = TWeakObjectPtr<URuntimeDataTableObject>(this), Response, CallbackInfo, CallOnComplete, ParseHeaders, ParseKeys]() mutable
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(URuntimeDataTableObject::ParseSheetAsCsvInfo);
+		SCOPE_CYCLE_COUNTER(STAT_RuntimeDataTable_ParseDownload);
+
+		const double ParseStartTime = FPlatformTime::Seconds();
+
+		TSharedRef<FEasyCsvInfo> CsvInfo = MakeShared<FEasyCsvInfo>();
+		const bool bParsed = UEasyCsv::MakeCsvInfoStructFromUtf8(Response->GetContent(), *CsvInfo, ParseHeaders, ParseKeys);
+
+		const int32 NumBytes = Response->GetContent().Num();
+		DEC_MEMORY_STAT_BY(STAT_RuntimeDataTable_ParseMemory, NumBytes);
+		FRuntimeDataTableStats::RecordStage(TEXT("Parse"), CallbackInfo.OperationName,
+			FPlatformTime::Seconds() - ParseStartTime, NumBytes, CsvInfo->CSV_Keys.Num());
+
+		AsyncTask(ENamedThreads::GameThread, [WeakThis, CsvInfo, bParsed, CallbackInfo, CallOnComplete]() mutable
+		{
+			// Collected after the engine shut down mid-parse, at which point there's nobody left to tell
+			URuntimeDataTableObject* This = WeakThis.Get();
+			if (!This)
+			{
+				return;
+			}
+
+			This->EndOperation();
+
+			CallbackInfo.bWasSuccessful = bParsed;
+			CallbackInfo.ResponseAsString = bParsed ?
+				FString::Printf(TEXT("Parsed %i rows and %i columns."), CsvInfo->CSV_Keys.Num(), CsvInfo->CSV_Headers.Num()) :
+				FString("ERROR: The downloaded sheet was empty or could not be parsed.");
+
+			FRuntimeDataTableModule::Print(FString::Printf(TEXT("%hs: %s"), __FUNCTION__, *CallbackInfo.ResponseAsString),
+				bParsed ? FRuntimeDataTableModule::ELogType::Display : FRuntimeDataTableModule::ELogType::Error);
+
+			CallOnComplete.ExecuteIfBound(CallbackInfo, *CsvInfo);
+		});
+	});
+}
+
+int32 URuntimeDataTableObject::SubscribeToSheet(
+	const FRuntimeDataTableTokenInfo InTokenInfo, const FRuntimeDataTableOperationParams OperationParams,
+	const FString InSheetURL, const float PollIntervalSeconds,
+	const FRDTSheetRowDelegate OnRowAdded, const FRDTSheetRowDelegate OnRowChanged, const FRDTSheetRowDelegate OnRowRemoved,
+	const bool bSheetIsPublic)
+{
+	return URuntimeDataTableSheetPoller::Subscribe(
+		InTokenInfo, OperationParams, InSheetURL, bSheetIsPublic, PollIntervalSeconds, OnRowAdded, OnRowChanged, OnRowRemoved);
+}
+
+void URuntimeDataTableObject::UnsubscribeFromSheet(const int32 SubscriptionHandle)
+{
+	URuntimeDataTableSheetPoller::Unsubscribe(SubscriptionHandle);
+}
+
+int32 URuntimeDataTableObject::CancelOperation(const FName OperationName)
+{
+	URuntimeDataTableOperationSubsystem* OperationSubsystem = URuntimeDataTableOperationSubsystem::Get();
+	return OperationSubsystem ? OperationSubsystem->CancelOperation(OperationName) : 0;
+}
+
+bool URuntimeDataTableObject::LoadSheetSnapshot(const FString SnapshotName, FEasyCsvInfo& CsvInfo)
+{
+	FRuntimeDataTableSnapshot Snapshot;
+	if (!FRuntimeDataTableSnapshot::LoadNewest(SnapshotName, Snapshot))
+	{
+		FRuntimeDataTableModule::Print(FString::Printf(
+			TEXT("%hs: No snapshot named %s could be loaded"), __FUNCTION__, *SnapshotName), FRuntimeDataTableModule::ELogType::Warning);
+		return false;
+	}
+
+	CsvInfo = MoveTemp(Snapshot.CsvInfo);
+	return true;
+}
+
+void URuntimeDataTableObject::FetchSheetSnapshotChanges_Internal(
+	const FRuntimeDataTableTokenInfo& InTokenInfo, const FRuntimeDataTableOperationParams& OperationParams,
+	const FRDTSnapshotChangesDelegate& CallOnComplete, const FString& SnapshotName, const bool bSheetIsPublic)
+{
+	TSharedRef<FRuntimeDataTableSnapshotFetch> Fetch = MakeShared<FRuntimeDataTableSnapshotFetch>();
+	Fetch->SnapshotName = SnapshotName;
+	Fetch->CallOnComplete = CallOnComplete;
+
+	FRuntimeDataTableSnapshot::LoadNewest(SnapshotName, Fetch->Snapshot);
+
+	// The settings are the source of truth for the URL, the snapshot's copy is for when the entry has since been removed
+	Fetch->SheetURL = Fetch->Snapshot.SheetURL;
+	if (const URuntimeDataTableProjectSettings* Settings = GetDefault<URuntimeDataTableProjectSettings>())
+	{
+		for (const FRuntimeDataTableSnapshotSource& Source : Settings->SheetSnapshots)
+		{
+			if (Source.SnapshotName == SnapshotName && !Source.SheetURL.IsEmpty())
+			{
+				Fetch->SheetURL = Source.SheetURL;
+				break;
+			}
+		}
+	}
+
+	if (Fetch->SheetURL.IsEmpty())
+	{
+		FRuntimeDataTableCallbackInfo FailedInfo;
+		FailedInfo.bWasSuccessful = false;
+		FailedInfo.OperationName = OperationParams.OperationName;
+		FailedInfo.ResponseAsString = FString::Printf(
+			TEXT("ERROR: %s is not in the project settings' SheetSnapshots and has no snapshot to take the URL from."), *SnapshotName);
+		FRuntimeDataTableModule::Print(FString::Printf(
+			TEXT("%hs: %s"),
+			__FUNCTION__, *FailedInfo.ResponseAsString), FRuntimeDataTableModule::ELogType::Error);
+		CallOnComplete.ExecuteIfBound(FailedInfo, FEasyCsvInfo(), {}, {});
+		return;
+	}
+
+	SnapshotFetch = Fetch;
+
+	FRDTGetCsvInfoDelegate OnDownloaded;
+	OnDownloaded.BindUFunction(this, GET_FUNCTION_NAME_CHECKED(URuntimeDataTableObject, OnSheetDownloaded_SnapshotChanges));
+
+	// The point is to see what changed since the snapshot, so a prefetched copy would be no use
+	FRuntimeDataTableOperationParams DownloadParams = OperationParams;
+	DownloadParams.bUsePrefetchCache = false;
+
+	DownloadSheetAsCsvInfo_Internal(InTokenInfo, DownloadParams, OnDownloaded, Fetch->SheetURL, bSheetIsPublic, true, true);
+}
+
+void URuntimeDataTableObject::OnSheetDownloaded_SnapshotChanges(FRuntimeDataTableCallbackInfo CallbackInfo, const FEasyCsvInfo& CsvInfo)
+{
+	if (!SnapshotFetch.IsValid())
+	{
+		return;
+	}
+
+	TSharedRef<FRuntimeDataTableSnapshotFetch> Fetch = SnapshotFetch.ToSharedRef();
+	SnapshotFetch.Reset();
+
+	if (!CallbackInfo.bWasSuccessful)
+	{
+		FRuntimeDataTableModule::Print(FString::Printf(
+			TEXT("%hs: Could not download %s, falling back to its snapshot"), __FUNCTION__, *Fetch->SnapshotName),
+			FRuntimeDataTableModule::ELogType::Warning);
+		Fetch->CallOnComplete.ExecuteIfBound(CallbackInfo, Fetch->Snapshot.CsvInfo, {}, {});
+		return;
+	}
+
+	// Hashing and writing the snapshot both scale with the sheet, so neither is done on the game thread
+	BeginOperation(CallbackInfo.OperationName);
+
+	// Only the operation subsystem keeps this object alive, and it lets go when the engine shuts down mid-diff
+	Async(EAsyncExecution::ThreadPool, [WeakThis = TWeakObjectPtr<URuntimeDataTableObject>(this), Fetch, CallbackInfo, NewCsvInfo = CsvInfo]() mutable
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(URuntimeDataTableObject::DiffSheetSnapshot);
+
+		const double DiffStartTime = FPlatformTime::Seconds();
+
+		FRuntimeDataTableSnapshot NewSnapshot;
+		TArray<FName> ChangedRows;
+		TArray<FName> RemovedRows;
+		Fetch->Snapshot.Diff(NewCsvInfo, NewSnapshot.RowHashes, ChangedRows, RemovedRows);
+
+		FRuntimeDataTableStats::RecordStage(TEXT("Snapshot.Diff"), CallbackInfo.OperationName,
+			FPlatformTime::Seconds() - DiffStartTime, 0, NewCsvInfo.CSV_Keys.Num());
+
+		if (ChangedRows.Num() > 0 || RemovedRows.Num() > 0)
+		{
+			NewSnapshot.SheetURL = Fetch->SheetURL;
+			NewSnapshot.SnapshotTime = FDateTime::UtcNow();
+			NewSnapshot.CsvInfo = NewCsvInfo;
+
+			if (!NewSnapshot.Save(FRuntimeDataTableSnapshot::GetSavedSnapshotPath(Fetch->SnapshotName)))
+			{
+				UE_LOG(LogRuntimeDataTable, Warning, TEXT("%hs: Could not save the new snapshot of %s"), __FUNCTION__, *Fetch->SnapshotName);
+			}
+		}
+
+		AsyncTask(ENamedThreads::GameThread,
+			[WeakThis, Fetch, CallbackInfo, NewCsvInfo = MoveTemp(NewCsvInfo), ChangedRows = MoveTemp(ChangedRows), RemovedRows = MoveTemp(RemovedRows)]() mutable
+		{
+			// Collected after the engine shut down mid-diff, at which point there's nobody left to tell
+			URuntimeDataTableObject* This = WeakThis.Get();
+			if (!This)
+			{
+				return;
+			}
+
+			This->EndOperation();
+
+			CallbackInfo.ResponseAsString = FString::Printf(
+				TEXT("%i rows changed and %i rows removed since the snapshot."), ChangedRows.Num(), RemovedRows.Num());
+			FRuntimeDataTableModule::Print(FString::Printf(TEXT("%hs: %s: %s"), __FUNCTION__, *Fetch->SnapshotName, *CallbackInfo.ResponseAsString));
+
+			Fetch->CallOnComplete.ExecuteIfBound(CallbackInfo, NewCsvInfo, ChangedRows, RemovedRows);
+		});
+	});
+}
+
+void URuntimeDataTableObject::DownloadMultipleTabsAsCsvInfo_Internal(
+	FRuntimeDataTableTokenInfo InTokenInfo, const FRuntimeDataTableOperationParams OperationParams,
+	const FRDTGetMultipleTabsDelegate& CallOnComplete, const FString& InSpreadsheetId, const TArray<FString>& InTabNamesOrRanges,
+	const bool bSheetIsPublic, const bool ParseHeaders, const bool ParseKeys)
+{
+	if (InSpreadsheetId.IsEmpty() || InTabNamesOrRanges.Num() == 0)
+	{
+		FRuntimeDataTableCallbackInfo FailedInfo;
+		FailedInfo.bWasSuccessful = false;
+		FailedInfo.OperationName = OperationParams.OperationName;
+		FailedInfo.ResponseAsString = "ERROR: InSpreadsheetId is empty or no tabs were requested.";
+		FRuntimeDataTableModule::Print(FString::Printf(
+			TEXT("%hs: %s"),
+			__FUNCTION__, *FailedInfo.ResponseAsString), FRuntimeDataTableModule::ELogType::Error);
+		CallOnComplete.ExecuteIfBound(FailedInfo, {});
+		return;
+	}
+
+	TSharedRef<FRuntimeDataTableMultiTabDownload> Download = MakeShared<FRuntimeDataTableMultiTabDownload>();
+	Download->OperationParams = OperationParams;
+	Download->CallOnComplete = CallOnComplete;
+	Download->SpreadsheetId = InSpreadsheetId;
+	Download->bParseHeaders = ParseHeaders;
+	Download->bParseKeys = ParseKeys;
+
+	for (const FString& TabNameOrRange : InTabNamesOrRanges)
+	{
+		FRuntimeDataTableTabResult& TabResult = Download->TabResults.AddDefaulted_GetRef();
+		TabResult.TabNameOrRange = TabNameOrRange.TrimStartAndEnd();
+	}
+
+	// Stays open until the last tab is back, see DownloadMultipleTabsAsCsvInfo_Finish
+	BeginOperation(OperationParams.OperationName);
+
+	FString ErrorMessage;
+	if (bSheetIsPublic)
+	{
+		DownloadMultipleTabsAsCsvInfo_StartNextPublicExport(Download);
+	}
+	else if (ValidateTokenInfo(InTokenInfo, ErrorMessage))
+	{
+		CreateAndAuthenticateToken(
+			InTokenInfo,
+			FRDTGetJWTDelegate::CreateUObject(
+				this, &URuntimeDataTableObject::DownloadMultipleTabsAsCsvInfo_AfterToken, Download)
+		);
+	}
+	else
+	{
+		const FString OutputMessage = FString::Printf(TEXT("InTokenInfo not valid; error: %s"), *ErrorMessage);
+		FRuntimeDataTableModule::Print(FString::Printf(TEXT("%hs:\n%s"), __FUNCTION__, *OutputMessage), FRuntimeDataTableModule::ELogType::Warning);
+
+		for (FRuntimeDataTableTabResult& TabResult : Download->TabResults)
+		{
+			TabResult.ErrorMessage = OutputMessage;
+		}
+		DownloadMultipleTabsAsCsvInfo_Finish(Download);
+	}
+}
+
+void URuntimeDataTableObject::DownloadMultipleTabsAsCsvInfo_AfterToken(
+	const FRuntimeDataTableCallbackInfo CallbackInfo, URuntimeDataTableWebToken* InToken,
+	TSharedRef<FRuntimeDataTableMultiTabDownload> Download)
+{
+	if (!InToken || InToken->HasTokenExpired())
+	{
+		const FString OutputMessage = "ERROR: InToken has expired or was not successfully created.";
+		FRuntimeDataTableModule::Print(FString::Printf(
+			TEXT("%hs: %s"),
+			__FUNCTION__, *OutputMessage), FRuntimeDataTableModule::ELogType::Error);
+
+		for (FRuntimeDataTableTabResult& TabResult : Download->TabResults)
+		{
+			TabResult.ErrorMessage = OutputMessage;
+		}
+		DownloadMultipleTabsAsCsvInfo_Finish(Download);
+		return;
+	}
+
+	FString URL = GetGoogleSheetsValuesBatchGetURL(Download->SpreadsheetId) + "?majorDimension=ROWS";
+	for (const FRuntimeDataTableTabResult& TabResult : Download->TabResults)
+	{
+		// Passed through as given, the API reads a bare name as a tab if there is one by that name and as cells on the first tab otherwise
+		URL += "&ranges=" + FGenericPlatformHttp::UrlEncode(TabResult.TabNameOrRange);
+	}
+
+	FRuntimeDataTableModule::Print(FString::Printf(TEXT("%hs: URL to batch download values is %s"), __FUNCTION__, *URL));
+
+	TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = CreateAuthorizedGenericRequest_Internal(
+		InToken->GetTokenText(), Download->OperationParams, "GET", URL, false, "application/json");
+
+	Request->OnProcessRequestComplete().BindUObject(
+		this, &URuntimeDataTableObject::OnResponseReceived_BatchGetValues, Download);
+	ProcessOperationRequest(Request);
+}
+
+void URuntimeDataTableObject::OnResponseReceived_BatchGetValues(
+	FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful,
+	TSharedRef<FRuntimeDataTableMultiTabDownload> Download)
+{
+	FRuntimeDataTableCallbackInfo CallbackInfo;
+	CallbackInfo.OperationName = Download->OperationParams.OperationName;
+	CallbackInfo.bWasSuccessful = bWasSuccessful;
+	GenericValidateHttpResponse(Request, Response, CallbackInfo, false);
+	Download->LastResponseCode = CallbackInfo.ResponseCode;
+
+	const TArray<TSharedPtr<FJsonValue>>* ValueRanges = nullptr;
+	TSharedPtr<FJsonObject> JsonObject = MakeShareable(new FJsonObject());
+	const TSharedRef<TJsonReader<>> JsonReader = TJsonReaderFactory<>::Create(CallbackInfo.ResponseAsString);
+
+	if (!CallbackInfo.bWasSuccessful ||
+		!FJsonSerializer::Deserialize(JsonReader, JsonObject) || !JsonObject.IsValid() ||
+		!JsonObject->TryGetArrayField("valueRanges", ValueRanges))
+	{
+		const FString OutputMessage = FString::Printf(
+			TEXT("ERROR: Batch download failed with response code %i."), CallbackInfo.ResponseCode);
+
+		for (FRuntimeDataTableTabResult& TabResult : Download->TabResults)
+		{
+			TabResult.ErrorMessage = OutputMessage;
+		}
+		DownloadMultipleTabsAsCsvInfo_Finish(Download);
+		return;
+	}
+
+	// Value ranges come back in the order they were requested
+	for (int32 TabIndex = 0; TabIndex < Download->TabResults.Num(); TabIndex++)
+	{
+		FRuntimeDataTableTabResult& TabResult = Download->TabResults[TabIndex];
+
+		const TSharedPtr<FJsonObject>* ValueRange = nullptr;
+		if (!ValueRanges->IsValidIndex(TabIndex) || !(*ValueRanges)[TabIndex]->TryGetObject(ValueRange))
+		{
+			TabResult.ErrorMessage = "ERROR: No value range was returned for this tab.";
+			continue;
+		}
+
+		TArray<TArray<FString>> Rows;
+		const TArray<TSharedPtr<FJsonValue>>* JsonRows = nullptr;
+		if ((*ValueRange)->TryGetArrayField("values", JsonRows))
+		{
+			Rows.Reserve(JsonRows->Num());
+			for (const TSharedPtr<FJsonValue>& JsonRow : *JsonRows)
+			{
+				TArray<FString>& Row = Rows.AddDefaulted_GetRef();
+
+				const TArray<TSharedPtr<FJsonValue>>* JsonCells = nullptr;
+				if (JsonRow->TryGetArray(JsonCells))
+				{
+					Row.Reserve(JsonCells->Num());
+					for (const TSharedPtr<FJsonValue>& JsonCell : *JsonCells)
+					{
+						Row.Add(JsonCell->AsString());
+					}
+				}
+			}
+		}
+
+		TabResult.bWasSuccessful = UEasyCsv::MakeCsvInfoStructFromRows(
+			MoveTemp(Rows), TabResult.CsvInfo, Download->bParseHeaders, Download->bParseKeys, true);
+		if (!TabResult.bWasSuccessful)
+		{
+			TabResult.ErrorMessage = "ERROR: This tab has no values or could not be parsed.";
+		}
+	}
+
+	DownloadMultipleTabsAsCsvInfo_Finish(Download);
+}
+
+void URuntimeDataTableObject::DownloadMultipleTabsAsCsvInfo_StartNextPublicExport(
+	TSharedRef<FRuntimeDataTableMultiTabDownload> Download)
+{
+	int32 MaxConcurrentDownloads = 4;
+	if (const URuntimeDataTableProjectSettings* Settings = GetDefault<URuntimeDataTableProjectSettings>())
+	{
+		MaxConcurrentDownloads = FMath::Max(Settings->MaxConcurrentPublicTabDownloads, 1);
+	}
+
+	while (Download->NumTabsInFlight < MaxConcurrentDownloads && Download->NextTabIndex < Download->TabResults.Num())
+	{
+		const int32 TabIndex = Download->NextTabIndex++;
+		const FString& TabNameOrRange = Download->TabResults[TabIndex].TabNameOrRange;
+
+		// Gids go through the regular export, names and ranges through the visualization endpoint which accepts them
+		FString URL;
+		if (TabNameOrRange.IsNumeric())
+		{
+			URL = GetCsvExportUrl(Download->SpreadsheetId, TabNameOrRange);
+		}
+		else
+		{
+			FString TabName = TabNameOrRange;
+			FString Range;
+			TabNameOrRange.Split("!", &TabName, &Range);
+			TabName.TrimCharInline('\'', nullptr);
+
+			URL = GetGoogleSheetsUrlPrefix() + Download->SpreadsheetId + "/gviz/tq?tqx=out:csv&sheet=" + FGenericPlatformHttp::UrlEncode(TabName) +
+				(!Range.IsEmpty() ? "&range=" + FGenericPlatformHttp::UrlEncode(Range) : "");
+		}
+
+		FRuntimeDataTableModule::Print(FString::Printf(TEXT("%hs: URL to download csv is %s"), __FUNCTION__, *URL));
+
+		FHttpModule* HTTP_Module = &FHttpModule::Get();
+		TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = HTTP_Module->CreateRequest();
+
+		Request->SetURL(URL);
+		Request->SetVerb("GET");
+		Request->SetHeader(TEXT("Accept"), "text/csv");
+		Request->OnProcessRequestComplete().BindUObject(
+			this, &URuntimeDataTableObject::OnResponseReceived_PublicTabExport, Download, TabIndex);
+		Request->SetTimeout(Download->OperationParams.RequestTimeout);
+
+		Download->NumTabsInFlight++;
+		ProcessOperationRequest(Request);
+	}
+}
+
+void URuntimeDataTableObject::OnResponseReceived_PublicTabExport(
+	FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful,
+	TSharedRef<FRuntimeDataTableMultiTabDownload> Download, const int32 TabIndex)
+{
+	FRuntimeDataTableCallbackInfo CallbackInfo;
+	CallbackInfo.OperationName = Download->OperationParams.OperationName;
+	CallbackInfo.bWasSuccessful = bWasSuccessful;
+	GenericValidateHttpResponse(Request, Response, CallbackInfo, false);
+	Download->LastResponseCode = CallbackInfo.ResponseCode;
+
+	FRuntimeDataTableTabResult& TabResult = Download->TabResults[TabIndex];
+	if (CallbackInfo.bWasSuccessful)
+	{
+		TabResult.bWasSuccessful = UEasyCsv::MakeCsvInfoStructFromString(
+			CallbackInfo.ResponseAsString, TabResult.CsvInfo, Download->bParseHeaders, Download->bParseKeys);
+		if (!TabResult.bWasSuccessful)
+		{
+			TabResult.ErrorMessage = "ERROR: This tab was downloaded but could not be parsed.";
+		}
+	}
+	else
+	{
+		TabResult.ErrorMessage = FString::Printf(
+			TEXT("ERROR: This tab could not be downloaded, response code %i."), CallbackInfo.ResponseCode);
+	}
+
+	Download->NumTabsInFlight--;
+	Download->NumTabsCompleted++;
+
+	if (Download->NumTabsCompleted == Download->TabResults.Num())
+	{
+		DownloadMultipleTabsAsCsvInfo_Finish(Download);
+	}
+	else
+	{
+		DownloadMultipleTabsAsCsvInfo_StartNextPublicExport(Download);
+	}
+}
+
+void URuntimeDataTableObject::DownloadMultipleTabsAsCsvInfo_Finish(TSharedRef<FRuntimeDataTableMultiTabDownload> Download)
+{
+	EndOperation();
+
+	int32 NumSuccessfulTabs = 0;
+	for (const FRuntimeDataTableTabResult& TabResult : Download->TabResults)
+	{
+		if (TabResult.bWasSuccessful)
+		{
+			NumSuccessfulTabs++;
+		}
+	}
+
+	FRuntimeDataTableCallbackInfo CallbackInfo;
+	CallbackInfo.OperationName = Download->OperationParams.OperationName;
+	CallbackInfo.bWasSuccessful = NumSuccessfulTabs == Download->TabResults.Num();
+	CallbackInfo.ResponseCode = Download->LastResponseCode;
+	CallbackInfo.ResponseAsString = FString::Printf(
+		TEXT("%i of %i tabs downloaded successfully."), NumSuccessfulTabs, Download->TabResults.Num());
+
+	FRuntimeDataTableModule::Print(FString::Printf(TEXT("%hs: %s"), __FUNCTION__, *CallbackInfo.ResponseAsString),
+		CallbackInfo.bWasSuccessful ? FRuntimeDataTableModule::ELogType::Display : FRuntimeDataTableModule::ELogType::Warning);
+
+	Download->CallOnComplete.ExecuteIfBound(CallbackInfo, Download->TabResults);
+}
+
+void URuntimeDataTableObject::WriteCsvToSheet_Internal(FRuntimeDataTableTokenInfo InTokenInfo,
+	const FRuntimeDataTableOperationParams OperationParams, const FRDTGetStringDelegate& CallOnComplete,
+	const FString& InSpreadsheetID, const int32 InSheetId, const FString& InCsv)
+{
+	FString ErrorMessage;
+	if (ValidateTokenInfo(InTokenInfo, ErrorMessage))
+	{
+		BeginOperation(OperationParams.OperationName);
+
+		// Get the auth token then go the next function on callback
+		CreateAndAuthenticateToken(
+			InTokenInfo,
+			FRDTGetJWTDelegate::CreateUObject(
+				this, &URuntimeDataTableObject::WriteCsvToSheet_AfterToken,
+					OperationParams, CallOnComplete, InSpreadsheetID, InSheetId, InCsv)
+		);
+	}
+}
+
+void URuntimeDataTableObject::WriteCsvToSheet_AfterToken(
+	const FRuntimeDataTableCallbackInfo CallbackInfo, URuntimeDataTableWebToken* InToken,
+	const FRuntimeDataTableOperationParams OperationParams, FRDTGetStringDelegate CallOnComplete,
+	const FString InSpreadsheetId, const int32 InSheetId, const FString InCsv)
+{
+	// First parse the CSV into a sheet data object and if valid, continue to step 2.
+	if (InSheetId < 0)
+	{
+		FRuntimeDataTableCallbackInfo FailedInfo;
+		FailedInfo.bWasSuccessful = false;
+		FailedInfo.OperationName = OperationParams.OperationName;
+		FailedInfo.ResponseAsString =
+			"ERROR: Input 'InSheetId' was not valid. Please enter a valid sheet ID.";
+		FRuntimeDataTableModule::Print(FString::Printf(
+			TEXT("%hs: %s"),
+			__FUNCTION__, *FailedInfo.ResponseAsString), FRuntimeDataTableModule::ELogType::Error);
+		EndOperation();
+		CallOnComplete.ExecuteIfBound(FailedInfo);
+		return;
+	}
+	
+	FCsvToGoogleSheetsHandler SheetTabData = FCsvToGoogleSheetsHandler::CsvToSheetTabData(InCsv);
+
+	if (SheetTabData.GetRowCount() == 0)
+	{
+		FRuntimeDataTableCallbackInfo FailedInfo;
+		FailedInfo.bWasSuccessful = false;
+		FailedInfo.OperationName = OperationParams.OperationName;
+		FailedInfo.ResponseAsString = "ERROR: InSheetsSheet Tab Data Object has no values.";
+		FRuntimeDataTableModule::Print(FString::Printf(
+			TEXT("%hs: %s"),
+			__FUNCTION__, *FailedInfo.ResponseAsString), FRuntimeDataTableModule::ELogType::Error);
+		EndOperation();
+		CallOnComplete.ExecuteIfBound(FailedInfo);
+		return;
+	}
+	
+	if (!InToken || InToken->HasTokenExpired())
+	{
+		FRuntimeDataTableCallbackInfo FailedInfo;
+		FailedInfo.bWasSuccessful = false;
+		FailedInfo.OperationName = OperationParams.OperationName;
+		FailedInfo.ResponseAsString = "ERROR: InToken has expired or was not successfully created.";
+		FRuntimeDataTableModule::Print(FString::Printf(
+			TEXT("%hs: %s"),
+			__FUNCTION__, *FailedInfo.ResponseAsString), FRuntimeDataTableModule::ELogType::Error);
+		EndOperation();
+		CallOnComplete.ExecuteIfBound(FailedInfo);
+		return;
+	}
+
+	const FString RequestURL = GetGoogleSheetsApiUrlPrefix() + InSpreadsheetId + "?&fields=sheets.properties";
+
+	FRuntimeDataTableModule::Print(FString::Printf(TEXT("%hs: Built RequestURL:\n%s"), __FUNCTION__, *RequestURL));
+	
+	const TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request =
+		CreateAuthorizedGenericRequest_Internal(
+			InToken->GetTokenText(), OperationParams, "GET", RequestURL, false);
+	
+	Request->OnProcessRequestComplete().BindUObject(
+		this, &URuntimeDataTableObject::WriteCsvToSheet_Internal_CompareColumnCounts,
+		InToken, OperationParams, CallOnComplete, InSpreadsheetId, InSheetId, InCsv, SheetTabData
+	);
+	
+	ProcessOperationRequest(Request);
+}
+
+void URuntimeDataTableObject::WriteCsvToSheet_Internal_CompareColumnCounts(FHttpRequestPtr InRequest,
+	FHttpResponsePtr InResponse, bool bWasSuccessful, URuntimeDataTableWebToken* InToken,
+	const FRuntimeDataTableOperationParams OperationParams, FRDTGetStringDelegate CallOnComplete,
+	FString InSpreadsheetId, const int32 InSheetId, FString InCsv, FCsvToGoogleSheetsHandler SheetTabData)
+{
+	// Get the target sheet's column count
+	// Then check CSV column count against target sheet and if needed, append necessary columns to the target sheet. Else, move on to clear sheet.
+	
+	FRuntimeDataTableCallbackInfo CallbackInfo;
+	CallbackInfo.OperationName = OperationParams.OperationName;
+	CallbackInfo.bWasSuccessful = bWasSuccessful;
+	GenericValidateHttpResponse(InRequest, InResponse, CallbackInfo);
+	if (!CallbackInfo.bWasSuccessful)
+	{
+		CallbackInfo.ResponseAsString = "ERROR: The GetSpreadsheet operation was not successful.\n\n" + CallbackInfo.ResponseAsString;
+		FRuntimeDataTableModule::Print(FString::Printf(
+			TEXT("%hs: %s"),
+			__FUNCTION__, *CallbackInfo.ResponseAsString), FRuntimeDataTableModule::ELogType::Error);
+		CallOnComplete.ExecuteIfBound(CallbackInfo);
+		return;
+	}
+
+	int32 RowCount = -1;
+	int32 ColumnCount = -1;
+
+	if (GetGridPropertiesFromSpreadsheetJson(CallbackInfo.ResponseAsString, InSheetId, RowCount, ColumnCount))
+	{
+		if (!InToken || InToken->HasTokenExpired())
+		{
+			FRuntimeDataTableCallbackInfo FailedInfo;
+			FailedInfo.bWasSuccessful = false;
+			FailedInfo.OperationName = OperationParams.OperationName;
+			FailedInfo.ResponseAsString = "ERROR: InToken has expired or was not successfully created.";
+			FRuntimeDataTableModule::Print(FString::Printf(
+				TEXT("%hs: %s"),
+				__FUNCTION__, *FailedInfo.ResponseAsString), FRuntimeDataTableModule::ELogType::Error);
+			CallOnComplete.ExecuteIfBound(FailedInfo);
+			return;
+		}
+
+		if (ColumnCount < SheetTabData.GetColumnCount())
+		{
+			// If needed, append necessary columns to the target sheet.
+
+			const int32 NumberToAppend = SheetTabData.GetColumnCount() - ColumnCount;
+			
+			//Build JSON
+			const FString JsonContent =
+			"{\
+				\"requests\": \
+				[\
+					{\
+						\"appendDimension\": \
+						{\
+							\"sheetId\": " + FString::FromInt(InSheetId) + ",\
+							\"dimension\": \"COLUMNS\", \
+							\"length\": " + FString::FromInt(NumberToAppend) + "\
+						}\
+					}\
+				]\
+			}";
+
+			//Build URL
+			const FString RequestURL = GetGoogleSheetsBatchUpdateURL(InSpreadsheetId);
+
+			FRuntimeDataTableModule::Print(FString::Printf(TEXT("%hs: Built JsonContent:\n%s"), __FUNCTION__, *JsonContent));
+			FRuntimeDataTableModule::Print(FString::Printf(TEXT("%hs: Built RequestURL:\n%s"), __FUNCTION__, *RequestURL));
+
+			TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request =
+				CreateAuthorizedGenericRequest_Internal(
+					InToken->GetTokenText(), OperationParams,
+					"POST", RequestURL, false);
+
+			Request->SetContentAsString(JsonContent);
+
+			// Clear target sheet
+			Request->OnProcessRequestComplete().BindUObject(
+				this, &URuntimeDataTableObject::WriteCsvToSheet_Internal_ClearSheet,
+				InToken, OperationParams, CallOnComplete, InSpreadsheetId, InSheetId, InCsv, SheetTabData
+			);
+	
+			ProcessOperationRequest(Request);
+		}
+		else
+		{
+			// Clear target sheet
+			WriteCsvToSheet_Internal_ClearSheet(
+				InRequest, InResponse, bWasSuccessful,
+				InToken, OperationParams, CallOnComplete,
+				InSpreadsheetId, InSheetId, InCsv, SheetTabData
+			);
+		}
+	}
+}
+
+void URuntimeDataTableObject::WriteCsvToSheet_Internal_ClearSheet(FHttpRequestPtr InRequest,
+	FHttpResponsePtr InResponse, bool bWasSuccessful, URuntimeDataTableWebToken* InToken,
+	const FRuntimeDataTableOperationParams OperationParams, FRDTGetStringDelegate CallOnComplete,
+	FString InSpreadsheetId, const int32 InSheetId, FString InCsv, FCsvToGoogleSheetsHandler SheetTabData)
+{
+	FRuntimeDataTableCallbackInfo CallbackInfo;
+	CallbackInfo.OperationName = OperationParams.OperationName;
+	CallbackInfo.bWasSuccessful = bWasSuccessful;
+	GenericValidateHttpResponse(InRequest, InResponse, CallbackInfo);
+	if (!CallbackInfo.bWasSuccessful)
+	{
+		CallbackInfo.ResponseAsString = "ERROR: The ClearSheet operation was not successful.\n\n" + CallbackInfo.ResponseAsString;
+		FRuntimeDataTableModule::Print(FString::Printf(
+			TEXT("%hs: %s"),
+			__FUNCTION__, *CallbackInfo.ResponseAsString), FRuntimeDataTableModule::ELogType::Error);
+		CallOnComplete.ExecuteIfBound(CallbackInfo);
+		return;
+	}
+
+	if (InSheetId < 0)
+	{
+		FRuntimeDataTableCallbackInfo FailedInfo;
+		FailedInfo.bWasSuccessful = false;
+		FailedInfo.OperationName = OperationParams.OperationName;
+		FailedInfo.ResponseAsString =
+			"ERROR: Input 'InSheetId' was not valid. Please enter a valid sheet ID.";
+		FRuntimeDataTableModule::Print(FString::Printf(
+			TEXT("%hs: %s"),
+			__FUNCTION__, *FailedInfo.ResponseAsString), FRuntimeDataTableModule::ELogType::Error);
+		CallOnComplete.ExecuteIfBound(FailedInfo);
+	}
+
+	if (!InToken || InToken->HasTokenExpired())
+	{
+		FRuntimeDataTableCallbackInfo FailedInfo;
+		FailedInfo.bWasSuccessful = false;
+		FailedInfo.OperationName = OperationParams.OperationName;
+		FailedInfo.ResponseAsString = "ERROR: InToken has expired or was not successfully created.";
+		FRuntimeDataTableModule::Print(FString::Printf(
+			TEXT("%hs: %s"),
+			__FUNCTION__, *FailedInfo.ResponseAsString), FRuntimeDataTableModule::ELogType::Error);
+		CallOnComplete.ExecuteIfBound(FailedInfo);
+		return;
+	}
+
+	const FString DataType = "userEnteredValue";
+
+	//Build JSON
+	const FString JsonContent =
+	"{\
+		\"requests\":\
+		[\
+			{\
+				\"updateCells\":\
+				{\
+					\"range\":\
+					{\
+						\"sheetId\": " + FString::FromInt(InSheetId) + "\
+					},\
+					\"fields\": \"" + DataType + "\"\
+				}\
+			}\
+		]\
+	}";
+
+	//Build URL
+	const FString& RequestURL = GetGoogleSheetsBatchUpdateURL(InSpreadsheetId);
+
+	FRuntimeDataTableModule::Print(FString::Printf(TEXT("%hs: Built JsonContent:\n%s"), __FUNCTION__, *JsonContent));
+	FRuntimeDataTableModule::Print(FString::Printf(TEXT("%hs: Built RequestURL:\n%s"), __FUNCTION__, *RequestURL));
+	
+	TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request =
+	CreateAuthorizedGenericRequest_Internal(
+		InToken->GetTokenText(), OperationParams, "POST",
+		RequestURL, false);
+	
+	// Finally, send the CSV to target sheet.
+	Request->OnProcessRequestComplete().BindUObject(
+		this, &URuntimeDataTableObject::WriteCsvToSheet_Internal_SendCsvDataToSheet,
+		InToken, OperationParams, CallOnComplete, InSpreadsheetId, InSheetId, InCsv, SheetTabData
+	);
+
+	Request->SetContentAsString(JsonContent);
+
+	// Clearing twice is the same as clearing once
+	ProcessOperationRequest(Request, true);
+}
+
+void URuntimeDataTableObject::WriteCsvToSheet_Internal_SendCsvDataToSheet(FHttpRequestPtr InRequest,
+	FHttpResponsePtr InResponse, bool bWasSuccessful, URuntimeDataTableWebToken* InToken,
+	const FRuntimeDataTableOperationParams OperationParams, FRDTGetStringDelegate CallOnComplete,
+	FString InSpreadsheetId, const int32 InSheetId, FString InCsv, FCsvToGoogleSheetsHandler SheetTabData)
+{
+	FRuntimeDataTableCallbackInfo CallbackInfo;
+	CallbackInfo.OperationName = OperationParams.OperationName;
+	CallbackInfo.bWasSuccessful = bWasSuccessful;
+	GenericValidateHttpResponse(InRequest, InResponse, CallbackInfo);
+	if (!CallbackInfo.bWasSuccessful)
+	{
+		CallbackInfo.ResponseAsString = "ERROR: The ClearSheet operation was not successful.\n\n" + CallbackInfo.ResponseAsString;
+		FRuntimeDataTableModule::Print(FString::Printf(
+			TEXT("%hs: %s"),
+			__FUNCTION__, *CallbackInfo.ResponseAsString), FRuntimeDataTableModule::ELogType::Error);
+		CallOnComplete.ExecuteIfBound(CallbackInfo);
+		return;
+	}
+	
+	int32 OutColumnStartIndex, OutRowStartIndex;
+	if (FCsvToGoogleSheetsHandler::A1_CellToColumnAndRowIndices("A1", OutColumnStartIndex, OutRowStartIndex))
+	{
+		// {"requests":[{"appendCells":{"sheetId":0,"rows":[{"values":[{"userEnteredValue":{"stringValue":""}}]}],"fields":""}}]}
+		// Written straight to UTF-8, each cell costs its value plus 40 bytes of wrapping
+		FRuntimeDataTableJsonPayloadWriter Writer(
+			SheetTabData.GetTotalValueLength() + SheetTabData.GetRowCount() * (SheetTabData.GetColumnCount() * 40 + 16) + 128);
+		{
+			Writer.BeginObject();
+			Writer.BeginArray("requests");
+			Writer.BeginObject();
+			Writer.BeginObject("appendCells");
+			{
+				Writer.WriteNumberField("sheetId", InSheetId);
+
+				Writer.BeginArray("rows");
+				for (const TArray<FString>& Row : SheetTabData.ArrayValues)
+				{
+					Writer.BeginObject();
+					Writer.BeginArray("values");
+					for (const FString& Value : Row)
+					{
+						// We're only interested in userEnteredValue.stringValue right now for this function
+						Writer.BeginObject();
+						Writer.BeginObject("userEnteredValue");
+						Writer.WriteStringField("stringValue", Value);
+						Writer.EndObject();
+						Writer.EndObject();
+					}
+					Writer.EndArray();
+					Writer.EndObject();
+				}
+				Writer.EndArray();
+
+				Writer.WriteStringField("fields", "userEnteredValue.stringValue");
+			}
+			Writer.EndObject();
+			Writer.EndObject();
+			Writer.EndArray();
+			Writer.EndObject();
+		}
+
+		if (!InToken || InToken->HasTokenExpired())
+		{
+			FRuntimeDataTableCallbackInfo FailedInfo;
+			FailedInfo.bWasSuccessful = false;
+			FailedInfo.OperationName = OperationParams.OperationName;
+			FailedInfo.ResponseAsString = "ERROR: InToken has expired or was not successfully created.";
+			FRuntimeDataTableModule::Print(FString::Printf(
+				TEXT("%hs: %s"),
+				__FUNCTION__, *FailedInfo.ResponseAsString), FRuntimeDataTableModule::ELogType::Error);
+			CallOnComplete.ExecuteIfBound(FailedInfo);
+			return;
+		}
+
+		//Build URL
+		const FString RequestURL = GetGoogleSheetsBatchUpdateURL(InSpreadsheetId);
+
+		FRuntimeDataTableModule::Print(FString::Printf(TEXT("%hs: Built %i byte payload"), __FUNCTION__, Writer.GetPayload().Num()));
+		FRuntimeDataTableModule::Print(FString::Printf(TEXT("%hs: Built RequestURL:\n%s"), __FUNCTION__, *RequestURL));
+
+		TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request =
+			CreateAuthorizedGenericRequest_Internal(
+				InToken->GetTokenText(), OperationParams,
+				"POST", RequestURL, false);
+
+		Request->SetContent(Writer.ReleasePayload());
+	
+		Request->OnProcessRequestComplete().BindUObject(
+			this, &URuntimeDataTableObject::OnResponseReceivedGenericReturnString,
+			OperationParams, CallOnComplete
+		);
+	
+		ProcessOperationRequest(Request);
+	}
+}
+
+void URuntimeDataTableObject::WriteCsvToSheetIncremental_Internal(FRuntimeDataTableTokenInfo InTokenInfo,
+	const FRuntimeDataTableOperationParams OperationParams, const FRDTGetStringDelegate& CallOnComplete,
+	const FString& InSpreadsheetId, const int32 InSheetId, const FString& InCsv, const bool bForceFullWrite)
+{
+	FString ErrorMessage;
+	if (ValidateTokenInfo(InTokenInfo, ErrorMessage))
+	{
+		BeginOperation(OperationParams.OperationName);
+
+		// Get the auth token then go the next function on callback
+		CreateAndAuthenticateToken(
+			InTokenInfo,
+			FRDTGetJWTDelegate::CreateUObject(
+				this, &URuntimeDataTableObject::WriteCsvToSheetIncremental_AfterToken,
+					OperationParams, CallOnComplete, InSpreadsheetId, InSheetId, InCsv, bForceFullWrite)
+		);
+	}
+	else
+	{
+		const FString OutputMessage = FString::Printf(TEXT("InTokenInfo not valid; error: %s"), *ErrorMessage);
+		FRuntimeDataTableModule::Print(FString::Printf(TEXT("%hs:\n%s"), __FUNCTION__, *OutputMessage), FRuntimeDataTableModule::ELogType::Warning);
+		CallOnComplete.ExecuteIfBound({OperationParams.OperationName, false, OutputMessage});
+	}
+}
+
+void URuntimeDataTableObject::WriteCsvToSheetIncremental_AfterToken(
+	const FRuntimeDataTableCallbackInfo CallbackInfo, URuntimeDataTableWebToken* InToken,
+	const FRuntimeDataTableOperationParams OperationParams, FRDTGetStringDelegate CallOnComplete,
+	const FString InSpreadsheetId, const int32 InSheetId, const FString InCsv, const bool bForceFullWrite)
+{
+	if (InSheetId < 0)
+	{
+		FRuntimeDataTableCallbackInfo FailedInfo;
+		FailedInfo.bWasSuccessful = false;
+		FailedInfo.OperationName = OperationParams.OperationName;
+		FailedInfo.ResponseAsString =
+			"ERROR: Input 'InSheetId' was not valid. Please enter a valid sheet ID.";
+		FRuntimeDataTableModule::Print(FString::Printf(
+			TEXT("%hs: %s"),
+			__FUNCTION__, *FailedInfo.ResponseAsString), FRuntimeDataTableModule::ELogType::Error);
+		EndOperation();
+		CallOnComplete.ExecuteIfBound(FailedInfo);
+		return;
+	}
+
+	FCsvToGoogleSheetsHandler SheetTabData = FCsvToGoogleSheetsHandler::CsvToSheetTabData(InCsv);
+
+	if (SheetTabData.GetRowCount() == 0)
+	{
+		FRuntimeDataTableCallbackInfo FailedInfo;
+		FailedInfo.bWasSuccessful = false;
 		FailedInfo.OperationName = OperationParams.OperationName;
 		FailedInfo.ResponseAsString = "ERROR: InSheetsSheet Tab Data Object has no values.";
 		FRuntimeDataTableModule::Print(FString::Printf(
 			TEXT("%hs: %s"),
 			__FUNCTION__, *FailedInfo.ResponseAsString), FRuntimeDataTableModule::ELogType::Error);
+		EndOperation();
 		CallOnComplete.ExecuteIfBound(FailedInfo);
 		return;
 	}
-	
+
 	if (!InToken || InToken->HasTokenExpired())
 	{
 		FRuntimeDataTableCallbackInfo FailedInfo;
@@ -807,10 +2263,24 @@ void URuntimeDataTableObject::WriteCsvToSheet_AfterToken(
 		FRuntimeDataTableModule::Print(FString::Printf(
 			TEXT("%hs: %s"),
 			__FUNCTION__, *FailedInfo.ResponseAsString), FRuntimeDataTableModule::ELogType::Error);
+		EndOperation();
 		CallOnComplete.ExecuteIfBound(FailedInfo);
 		return;
 	}
 
+	if (bForceFullWrite)
+	{
+		FRuntimeDataTableSheetWriteCache::Get().Invalidate(InSpreadsheetId, InSheetId);
+	}
+
+	// Once we know the grid size we can go straight to the write
+	FRuntimeDataTableSheetSnapshot Snapshot;
+	if (FRuntimeDataTableSheetWriteCache::Get().FindSnapshot(InSpreadsheetId, InSheetId, Snapshot) && Snapshot.HasGridProperties())
+	{
+		WriteCsvToSheetIncremental_SendChanges(InToken, OperationParams, CallOnComplete, InSpreadsheetId, InSheetId, SheetTabData);
+		return;
+	}
+
 	const FString RequestURL = GetGoogleSheetsApiUrlPrefix() + InSpreadsheetId + "?&fields=sheets.properties";
 
 	FRuntimeDataTableModule::Print(FString::Printf(TEXT("%hs: Built RequestURL:\n%s"), __FUNCTION__, *RequestURL));
@@ -820,359 +2290,620 @@ void URuntimeDataTableObject::WriteCsvToSheet_AfterToken(
 			InToken->GetTokenText(), OperationParams, "GET", RequestURL, false);
 	
 	Request->OnProcessRequestComplete().BindUObject(
-		this, &URuntimeDataTableObject::WriteCsvToSheet_Internal_CompareColumnCounts,
-		InToken, OperationParams, CallOnComplete, InSpreadsheetId, InSheetId, InCsv, SheetTabData
+		this, &URuntimeDataTableObject::WriteCsvToSheetIncremental_OnGridPropertiesReceived,
+		InToken, OperationParams, CallOnComplete, InSpreadsheetId, InSheetId, SheetTabData
 	);
 	
-	Request->ProcessRequest();
+	ProcessOperationRequest(Request);
 }
 
-void URuntimeDataTableObject::WriteCsvToSheet_Internal_CompareColumnCounts(FHttpRequestPtr InRequest,
+void URuntimeDataTableObject::WriteCsvToSheetIncremental_OnGridPropertiesReceived(FHttpRequestPtr InRequest,
 	FHttpResponsePtr InResponse, bool bWasSuccessful, URuntimeDataTableWebToken* InToken,
 	const FRuntimeDataTableOperationParams OperationParams, FRDTGetStringDelegate CallOnComplete,
-	FString InSpreadsheetId, const int32 InSheetId, FString InCsv, FCsvToGoogleSheetsHandler SheetTabData)
+	FString InSpreadsheetId, const int32 InSheetId, FCsvToGoogleSheetsHandler SheetTabData)
 {
-	// Get the target sheet's column count
-	// Then check CSV column count against target sheet and if needed, append necessary columns to the target sheet. Else, move on to clear sheet.
-	
 	FRuntimeDataTableCallbackInfo CallbackInfo;
 	CallbackInfo.OperationName = OperationParams.OperationName;
 	CallbackInfo.bWasSuccessful = bWasSuccessful;
-	GenericValidateHttpResponse(InRequest, InResponse, CallbackInfo);
-	if (!CallbackInfo.bWasSuccessful)
+	// The operation stays open for the write that follows, every way out before it is sent ends it
+	GenericValidateHttpResponse(InRequest, InResponse, CallbackInfo, false);
+
+	int32 RowCount = -1;
+	int32 ColumnCount = -1;
+	if (!CallbackInfo.bWasSuccessful ||
+		!GetGridPropertiesFromSpreadsheetJson(CallbackInfo.ResponseAsString, InSheetId, RowCount, ColumnCount) ||
+		RowCount < 0 || ColumnCount < 0)
 	{
-		CallbackInfo.ResponseAsString = "ERROR: The GetSpreadsheet operation was not successful.\n\n" + CallbackInfo.ResponseAsString;
+		CallbackInfo.bWasSuccessful = false;
+		CallbackInfo.ResponseAsString = "ERROR: The GetSpreadsheet operation was not successful or did not contain InSheetId.\n\n" + CallbackInfo.ResponseAsString;
 		FRuntimeDataTableModule::Print(FString::Printf(
 			TEXT("%hs: %s"),
 			__FUNCTION__, *CallbackInfo.ResponseAsString), FRuntimeDataTableModule::ELogType::Error);
+		EndOperation();
 		CallOnComplete.ExecuteIfBound(CallbackInfo);
 		return;
 	}
 
-	TSharedPtr<FJsonObject> Spreadsheet = MakeShareable(new FJsonObject());
-	const TSharedRef<TJsonReader<>> JsonReader = TJsonReaderFactory<>::Create(CallbackInfo.ResponseAsString);
+	FRuntimeDataTableSheetWriteCache::Get().SetGridProperties(InSpreadsheetId, InSheetId, RowCount, ColumnCount);
+
+	if (!InToken || InToken->HasTokenExpired())
+	{
+		FRuntimeDataTableCallbackInfo FailedInfo;
+		FailedInfo.bWasSuccessful = false;
+		FailedInfo.OperationName = OperationParams.OperationName;
+		FailedInfo.ResponseAsString = "ERROR: InToken has expired or was not successfully created.";
+		FRuntimeDataTableModule::Print(FString::Printf(
+			TEXT("%hs: %s"),
+			__FUNCTION__, *FailedInfo.ResponseAsString), FRuntimeDataTableModule::ELogType::Error);
+		EndOperation();
+		CallOnComplete.ExecuteIfBound(FailedInfo);
+		return;
+	}
+
+	WriteCsvToSheetIncremental_SendChanges(InToken, OperationParams, CallOnComplete, InSpreadsheetId, InSheetId, SheetTabData);
+}
+
+void URuntimeDataTableObject::WriteCsvToSheetIncremental_SendChanges(
+	URuntimeDataTableWebToken* InToken, const FRuntimeDataTableOperationParams OperationParams,
+	const FRDTGetStringDelegate& CallOnComplete,
+	const FString& InSpreadsheetId, const int32 InSheetId, const FCsvToGoogleSheetsHandler& SheetTabData)
+{
+	FRuntimeDataTableSheetSnapshot PreviousSnapshot;
+	FRuntimeDataTableSheetWriteCache::Get().FindSnapshot(InSpreadsheetId, InSheetId, PreviousSnapshot);
 
-	if (FJsonSerializer::Deserialize(JsonReader, Spreadsheet) && Spreadsheet.IsValid())
+	// Sized for the worst case of every cell changing
+	FRuntimeDataTableJsonPayloadWriter Writer(
+		SheetTabData.GetTotalValueLength() + SheetTabData.GetRowCount() * (SheetTabData.GetColumnCount() * 40 + 16) + 512);
+	Writer.BeginObject();
+	Writer.BeginArray("requests");
+
+	FRuntimeDataTableSheetSnapshot NextSnapshot;
+	const int32 NumRequests = FRuntimeDataTableSheetWriteCache::BuildDiffRequests(
+		InSheetId, PreviousSnapshot, SheetTabData.ArrayValues, Writer, NextSnapshot);
+
+	Writer.EndArray();
+	Writer.EndObject();
+
+	if (NumRequests == 0)
+	{
+		FRuntimeDataTableCallbackInfo CallbackInfo;
+		CallbackInfo.bWasSuccessful = true;
+		CallbackInfo.OperationName = OperationParams.OperationName;
+		CallbackInfo.ResponseAsString = "No cells have changed since the last write, nothing was sent.";
+		FRuntimeDataTableModule::Print(FString::Printf(TEXT("%hs: %s"), __FUNCTION__, *CallbackInfo.ResponseAsString));
+		EndOperation();
+		CallOnComplete.ExecuteIfBound(CallbackInfo);
+		return;
+	}
+
+	// The tab is in neither state until the API confirms the write, so anything queued behind this one starts over.
+	// NextSnapshot is only recorded once the response says the sheet really holds it.
+	FRuntimeDataTableSheetWriteCache::Get().Invalidate(InSpreadsheetId, InSheetId);
+
+	// Only appendDimension makes the write unsafe to repeat, the rest write or clear fixed ranges
+	const bool bGrowsGrid =
+		NextSnapshot.GridRowCount != PreviousSnapshot.GridRowCount || NextSnapshot.GridColumnCount != PreviousSnapshot.GridColumnCount;
+
+	const FString RequestURL = GetGoogleSheetsBatchUpdateURL(InSpreadsheetId);
+
+	FRuntimeDataTableModule::Print(FString::Printf(
+		TEXT("%hs: Sending %i requests in a %i byte payload"), __FUNCTION__, NumRequests, Writer.GetPayload().Num()));
+	FRuntimeDataTableModule::Print(FString::Printf(TEXT("%hs: Built RequestURL:\n%s"), __FUNCTION__, *RequestURL));
+
+	TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request =
+		CreateAuthorizedGenericRequest_Internal(
+			InToken->GetTokenText(), OperationParams,
+			"POST", RequestURL, false);
+
+	Request->SetContent(Writer.ReleasePayload());
+
+	Request->OnProcessRequestComplete().BindUObject(
+		this, &URuntimeDataTableObject::WriteCsvToSheetIncremental_OnChangesSent,
+		OperationParams, CallOnComplete, InSpreadsheetId, InSheetId, MakeShared<FRuntimeDataTableSheetSnapshot>(MoveTemp(NextSnapshot))
+	);
+
+	ProcessOperationRequest(Request, !bGrowsGrid);
+}
+
+void URuntimeDataTableObject::WriteCsvToSheetIncremental_OnChangesSent(
+	FHttpRequestPtr InRequest, FHttpResponsePtr InResponse, bool bWasSuccessful,
+	const FRuntimeDataTableOperationParams OperationParams, FRDTGetStringDelegate CallOnComplete,
+	FString InSpreadsheetId, const int32 InSheetId, TSharedRef<FRuntimeDataTableSheetSnapshot> WrittenSnapshot)
+{
+	FRuntimeDataTableCallbackInfo CallbackInfo;
+	CallbackInfo.OperationName = OperationParams.OperationName;
+	CallbackInfo.bWasSuccessful = bWasSuccessful;
+	GenericValidateHttpResponse(InRequest, InResponse, CallbackInfo);
+
+	// A failed write leaves the tab in an unknown state, which Invalidate already recorded when the write went out
+	if (CallbackInfo.bWasSuccessful)
+	{
+		FRuntimeDataTableSheetWriteCache::Get().StoreSnapshot(InSpreadsheetId, InSheetId, MoveTemp(*WrittenSnapshot));
+	}
+
+	CallOnComplete.ExecuteIfBound(CallbackInfo);
+}
+
+void URuntimeDataTableObject::WriteCsvToSheetChunked_Internal(FRuntimeDataTableTokenInfo InTokenInfo,
+	const FRuntimeDataTableOperationParams OperationParams,
+	const FRDTGetStringDelegate& CallOnProgress, const FRDTGetStringDelegate& CallOnComplete,
+	const FString& InSpreadsheetId, const int32 InSheetId, const FString& InCsv)
+{
+	FString ErrorMessage;
+	if (!ValidateTokenInfo(InTokenInfo, ErrorMessage))
+	{
+		const FString OutputMessage = FString::Printf(TEXT("InTokenInfo not valid; error: %s"), *ErrorMessage);
+		FRuntimeDataTableModule::Print(FString::Printf(TEXT("%hs:\n%s"), __FUNCTION__, *OutputMessage), FRuntimeDataTableModule::ELogType::Warning);
+		CallOnComplete.ExecuteIfBound({OperationParams.OperationName, false, OutputMessage});
+		return;
+	}
+
+	TSharedRef<FRuntimeDataTableChunkedUpload> Upload = MakeShared<FRuntimeDataTableChunkedUpload>();
+	Upload->TokenInfo = InTokenInfo;
+	Upload->OperationParams = OperationParams;
+	Upload->CallOnProgress = CallOnProgress;
+	Upload->CallOnComplete = CallOnComplete;
+	Upload->SpreadsheetId = InSpreadsheetId;
+	Upload->SheetId = InSheetId;
+	Upload->SheetTabData = FCsvToGoogleSheetsHandler::CsvToSheetTabData(InCsv);
+
+	// Stays open until the last chunk is back, see WriteCsvToSheetChunked_Finish
+	BeginOperation(OperationParams.OperationName);
+
+	if (InSheetId < 0)
+	{
+		WriteCsvToSheetChunked_Finish(Upload, "ERROR: Input 'InSheetId' was not valid. Please enter a valid sheet ID.");
+		return;
+	}
+
+	if (Upload->SheetTabData.GetRowCount() == 0)
 	{
-		int32 RowCount = -1;
-		int32 ColumnCount = -1;
+		WriteCsvToSheetChunked_Finish(Upload, "ERROR: InSheetsSheet Tab Data Object has no values.");
+		return;
+	}
 
-		const TArray<TSharedPtr<FJsonValue>>* OutSheets;
-		Spreadsheet->TryGetArrayField("sheets", OutSheets);
+	// Split the rows into chunks by their estimated payload size. Each cell costs its value plus 40 bytes of wrapping.
+	int32 ByteBudget = 1048576;
+	if (const URuntimeDataTableProjectSettings* Settings = GetDefault<URuntimeDataTableProjectSettings>())
+	{
+		ByteBudget = FMath::Max(Settings->UploadChunkByteBudget, 16384);
+	}
 
-		if (OutSheets)
+	FRuntimeDataTableChunkedUpload::FChunk CurrentChunk;
+	const TArray<TArray<FString>>& Rows = Upload->SheetTabData.ArrayValues;
+	for (int32 RowIndex = 0; RowIndex < Rows.Num(); RowIndex++)
+	{
+		int32 RowBytes = 16;
+		for (const FString& Cell : Rows[RowIndex])
 		{
-			for (const TSharedPtr<FJsonValue>& Sheet : *OutSheets)
-			{
-				const TSharedPtr<FJsonObject>* SheetProperties;
-				Sheet->AsObject()->TryGetObjectField("properties", SheetProperties);
+			RowBytes += Cell.Len() + 40;
+		}
 
-				if (SheetProperties)
-				{
-					int32 LoopSheetId;
-					(*SheetProperties)->TryGetNumberField("sheetId", LoopSheetId);
+		if (CurrentChunk.EndRow > CurrentChunk.StartRow && CurrentChunk.EstimatedBytes + RowBytes > ByteBudget)
+		{
+			Upload->Chunks.Add(CurrentChunk);
+			CurrentChunk = FRuntimeDataTableChunkedUpload::FChunk();
+			CurrentChunk.StartRow = RowIndex;
+		}
 
-					if (LoopSheetId == InSheetId)
-					{
-						const TSharedPtr<FJsonObject>* GridProperties;
-						(*SheetProperties)->TryGetObjectField("gridProperties", GridProperties);
+		CurrentChunk.EndRow = RowIndex + 1;
+		CurrentChunk.EstimatedBytes += RowBytes;
+	}
+	Upload->Chunks.Add(CurrentChunk);
 
-						if (GridProperties)
-						{
-							(*GridProperties)->TryGetNumberField("rowCount", RowCount);
-							(*GridProperties)->TryGetNumberField("columnCount", ColumnCount);
-						}
-							
-						break;
-					}
-				}
+	for (int32 ChunkIndex = 0; ChunkIndex < Upload->Chunks.Num(); ChunkIndex++)
+	{
+		Upload->QueuedChunkIndices.Add(ChunkIndex);
+	}
+
+	FRuntimeDataTableModule::Print(FString::Printf(
+		TEXT("%hs: Split %i rows into %i chunks"), __FUNCTION__, Rows.Num(), Upload->Chunks.Num()));
+
+	CreateAndAuthenticateToken(
+		InTokenInfo,
+		FRDTGetJWTDelegate::CreateUObject(
+			this, &URuntimeDataTableObject::WriteCsvToSheetChunked_AfterToken, Upload)
+	);
+}
+
+void URuntimeDataTableObject::WriteCsvToSheetChunked_AfterToken(
+	const FRuntimeDataTableCallbackInfo CallbackInfo, URuntimeDataTableWebToken* InToken,
+	TSharedRef<FRuntimeDataTableChunkedUpload> Upload)
+{
+	if (!InToken || InToken->HasTokenExpired())
+	{
+		WriteCsvToSheetChunked_Finish(Upload, "ERROR: InToken has expired or was not successfully created.");
+		return;
+	}
+
+	Upload->TokenText = InToken->GetTokenText();
+	Upload->TokenExpiration = FDateTime::UtcNow() + FTimespan::FromSeconds(InToken->GetNumberOfSecondsUntilExpiration());
+
+	const FString RequestURL = GetGoogleSheetsApiUrlPrefix() + Upload->SpreadsheetId + "?&fields=sheets.properties";
+
+	FRuntimeDataTableModule::Print(FString::Printf(TEXT("%hs: Built RequestURL:\n%s"), __FUNCTION__, *RequestURL));
+	
+	const TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request =
+		CreateAuthorizedGenericRequest_Internal(
+			Upload->TokenText, Upload->OperationParams, "GET", RequestURL, false);
+	
+	Request->OnProcessRequestComplete().BindUObject(
+		this, &URuntimeDataTableObject::WriteCsvToSheetChunked_OnGridPropertiesReceived, Upload);
+	
+	ProcessOperationRequest(Request);
+}
+
+void URuntimeDataTableObject::WriteCsvToSheetChunked_OnGridPropertiesReceived(
+	FHttpRequestPtr InRequest, FHttpResponsePtr InResponse, bool bWasSuccessful,
+	TSharedRef<FRuntimeDataTableChunkedUpload> Upload)
+{
+	FRuntimeDataTableCallbackInfo CallbackInfo;
+	CallbackInfo.OperationName = Upload->OperationParams.OperationName;
+	CallbackInfo.bWasSuccessful = bWasSuccessful;
+	GenericValidateHttpResponse(InRequest, InResponse, CallbackInfo, false);
+	Upload->LastResponseCode = CallbackInfo.ResponseCode;
+
+	int32 RowCount = -1;
+	int32 ColumnCount = -1;
+	if (!CallbackInfo.bWasSuccessful ||
+		!GetGridPropertiesFromSpreadsheetJson(CallbackInfo.ResponseAsString, Upload->SheetId, RowCount, ColumnCount) ||
+		RowCount < 0 || ColumnCount < 0)
+	{
+		WriteCsvToSheetChunked_Finish(Upload,
+			"ERROR: The GetSpreadsheet operation was not successful or did not contain InSheetId.\n\n" + CallbackInfo.ResponseAsString);
+		return;
+	}
+
+	// Grow the grid and clear it in one request so that the chunks can be written in any order afterwards
+	const int32 NeededColumns = Upload->SheetTabData.GetColumnCount() - ColumnCount;
+	const int32 NeededRows = Upload->SheetTabData.GetRowCount() - RowCount;
+
+	FRuntimeDataTableJsonPayloadWriter Writer(512);
+	Writer.BeginObject();
+	Writer.BeginArray("requests");
+	{
+		if (NeededColumns > 0 || NeededRows > 0)
+		{
+			auto WriteAppendDimension = [&Writer, &Upload](const FString& InDimension, const int32 InLength)
+			{
+				Writer.BeginObject();
+				Writer.BeginObject("appendDimension");
+				Writer.WriteNumberField("sheetId", Upload->SheetId);
+				Writer.WriteStringField("dimension", InDimension);
+				Writer.WriteNumberField("length", InLength);
+				Writer.EndObject();
+				Writer.EndObject();
+			};
+
+			if (NeededColumns > 0)
+			{
+				WriteAppendDimension("COLUMNS", NeededColumns);
+			}
+			if (NeededRows > 0)
+			{
+				WriteAppendDimension("ROWS", NeededRows);
 			}
 		}
 
-		if (!InToken || InToken->HasTokenExpired())
+		Writer.BeginObject();
+		Writer.BeginObject("updateCells");
+		Writer.BeginObject("range");
+		Writer.WriteNumberField("sheetId", Upload->SheetId);
+		Writer.EndObject();
+		Writer.WriteStringField("fields", "userEnteredValue");
+		Writer.EndObject();
+		Writer.EndObject();
+	}
+	Writer.EndArray();
+	Writer.EndObject();
+
+	const FString RequestURL = GetGoogleSheetsBatchUpdateURL(Upload->SpreadsheetId);
+
+	TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request =
+		CreateAuthorizedGenericRequest_Internal(
+			Upload->TokenText, Upload->OperationParams, "POST", RequestURL, false);
+
+	Request->SetContent(Writer.ReleasePayload());
+
+	Request->OnProcessRequestComplete().BindUObject(
+		this, &URuntimeDataTableObject::WriteCsvToSheetChunked_OnSheetPrepared, Upload);
+
+	// A clear on its own can be repeated, growing the grid can't
+	ProcessOperationRequest(Request, NeededColumns <= 0 && NeededRows <= 0);
+}
+
+void URuntimeDataTableObject::WriteCsvToSheetChunked_OnSheetPrepared(
+	FHttpRequestPtr InRequest, FHttpResponsePtr InResponse, bool bWasSuccessful,
+	TSharedRef<FRuntimeDataTableChunkedUpload> Upload)
+{
+	FRuntimeDataTableCallbackInfo CallbackInfo;
+	CallbackInfo.OperationName = Upload->OperationParams.OperationName;
+	CallbackInfo.bWasSuccessful = bWasSuccessful;
+	GenericValidateHttpResponse(InRequest, InResponse, CallbackInfo, false);
+	Upload->LastResponseCode = CallbackInfo.ResponseCode;
+
+	if (!CallbackInfo.bWasSuccessful)
+	{
+		WriteCsvToSheetChunked_Finish(Upload,
+			"ERROR: The tab could not be resized or cleared.\n\n" + CallbackInfo.ResponseAsString);
+		return;
+	}
+
+	WriteCsvToSheetChunked_SendNextChunks(Upload);
+}
+
+void URuntimeDataTableObject::WriteCsvToSheetChunked_SendNextChunks(TSharedRef<FRuntimeDataTableChunkedUpload> Upload)
+{
+	if (Upload->bFinished || Upload->bWaitingForToken)
+	{
+		return;
+	}
+
+	int32 MaxChunksInFlight = 3;
+	if (const URuntimeDataTableProjectSettings* Settings = GetDefault<URuntimeDataTableProjectSettings>())
+	{
+		MaxChunksInFlight = FMath::Max(Settings->MaxConcurrentUploadChunks, 1);
+	}
+
+	while (Upload->NumChunksInFlight < MaxChunksInFlight && Upload->QueuedChunkIndices.Num() > 0)
+	{
+		// Don't start a chunk with a token that could run out before the chunk times out
+		const FTimespan TimeRemaining = Upload->TokenExpiration - FDateTime::UtcNow();
+		if (TimeRemaining.GetTotalSeconds() < Upload->OperationParams.RequestTimeout + 5.f)
 		{
-			FRuntimeDataTableCallbackInfo FailedInfo;
-			FailedInfo.bWasSuccessful = false;
-			FailedInfo.OperationName = OperationParams.OperationName;
-			FailedInfo.ResponseAsString = "ERROR: InToken has expired or was not successfully created.";
-			FRuntimeDataTableModule::Print(FString::Printf(
-				TEXT("%hs: %s"),
-				__FUNCTION__, *FailedInfo.ResponseAsString), FRuntimeDataTableModule::ELogType::Error);
-			CallOnComplete.ExecuteIfBound(FailedInfo);
+			// The token manager would hand the same token straight back, so give up once fresh exchanges stop helping
+			if (Upload->NumShortTokenRefreshes >= 3)
+			{
+				Upload->NumChunksFailed += Upload->QueuedChunkIndices.Num();
+				Upload->QueuedChunkIndices.Empty();
+
+				if (Upload->NumChunksInFlight == 0)
+				{
+					WriteCsvToSheetChunked_Finish(Upload,
+						"ERROR: Could not get an access token that outlasts OperationParams.RequestTimeout. Request a longer lived token or lower the timeout.");
+				}
+				return;
+			}
+
+			// Force a real exchange, the cached token may still be handed out with this little time left on it
+			FRuntimeDataTableTokenManager::Get().InvalidateAccessToken(Upload->TokenInfo);
+
+			Upload->bWaitingForToken = true;
+			CreateAndAuthenticateToken(
+				Upload->TokenInfo,
+				FRDTGetJWTDelegate::CreateUObject(
+					this, &URuntimeDataTableObject::WriteCsvToSheetChunked_OnTokenRefreshed, Upload)
+			);
 			return;
 		}
 
-		if (ColumnCount < SheetTabData.GetColumnCount())
+		const int32 ChunkIndex = Upload->QueuedChunkIndices[0];
+		Upload->QueuedChunkIndices.RemoveAt(0, 1, false);
+
+		const FRuntimeDataTableChunkedUpload::FChunk& Chunk = Upload->Chunks[ChunkIndex];
+
+		// {"requests":[{"updateCells":{"start":{...},"rows":[{"values":[{"userEnteredValue":{"stringValue":""}}]}],"fields":""}}]}
+		FRuntimeDataTableJsonPayloadWriter Writer(Chunk.EstimatedBytes + 256);
+		Writer.BeginObject();
+		Writer.BeginArray("requests");
+		Writer.BeginObject();
+		Writer.BeginObject("updateCells");
 		{
-			// If needed, append necessary columns to the target sheet.
+			Writer.BeginObject("start");
+			Writer.WriteNumberField("sheetId", Upload->SheetId);
+			Writer.WriteNumberField("rowIndex", Chunk.StartRow);
+			Writer.WriteNumberField("columnIndex", 0);
+			Writer.EndObject();
+
+			Writer.BeginArray("rows");
+			for (int32 RowIndex = Chunk.StartRow; RowIndex < Chunk.EndRow; RowIndex++)
+			{
+				Writer.BeginObject();
+				Writer.BeginArray("values");
+				for (const FString& Value : Upload->SheetTabData.ArrayValues[RowIndex])
+				{
+					Writer.BeginObject();
+					Writer.BeginObject("userEnteredValue");
+					Writer.WriteStringField("stringValue", Value);
+					Writer.EndObject();
+					Writer.EndObject();
+				}
+				Writer.EndArray();
+				Writer.EndObject();
+			}
+			Writer.EndArray();
 
-			const int32 NumberToAppend = SheetTabData.GetColumnCount() - ColumnCount;
-			
-			//Build JSON
-			const FString JsonContent =
-			"{\
-				\"requests\": \
-				[\
-					{\
-						\"appendDimension\": \
-						{\
-							\"sheetId\": " + FString::FromInt(InSheetId) + ",\
-							\"dimension\": \"COLUMNS\", \
-							\"length\": " + FString::FromInt(NumberToAppend) + "\
-						}\
-					}\
-				]\
-			}";
+			Writer.WriteStringField("fields", "userEnteredValue.stringValue");
+		}
+		Writer.EndObject();
+		Writer.EndObject();
+		Writer.EndArray();
+		Writer.EndObject();
+
+		FRuntimeDataTableModule::Print(FString::Printf(
+			TEXT("%hs: Sending chunk %i of %i (rows %i to %i, %i bytes)"),
+			__FUNCTION__, ChunkIndex + 1, Upload->Chunks.Num(), Chunk.StartRow, Chunk.EndRow - 1, Writer.GetPayload().Num()));
+
+		TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request =
+			CreateAuthorizedGenericRequest_Internal(
+				Upload->TokenText, Upload->OperationParams,
+				"POST", GetGoogleSheetsBatchUpdateURL(Upload->SpreadsheetId), false);
+
+		Request->SetContent(Writer.ReleasePayload());
 
-			//Build URL
-			const FString RequestURL = GetGoogleSheetsBatchUpdateURL(InSpreadsheetId);
+		Request->OnProcessRequestComplete().BindUObject(
+			this, &URuntimeDataTableObject::WriteCsvToSheetChunked_OnChunkSent, Upload, ChunkIndex);
 
-			FRuntimeDataTableModule::Print(FString::Printf(TEXT("%hs: Built JsonContent:\n%s"), __FUNCTION__, *JsonContent));
-			FRuntimeDataTableModule::Print(FString::Printf(TEXT("%hs: Built RequestURL:\n%s"), __FUNCTION__, *RequestURL));
+		// Each chunk writes a fixed range, so a repeat lands on the same cells
+		Upload->NumChunksInFlight++;
+		ProcessOperationRequest(Request, true);
+	}
+}
 
-			TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request =
-				CreateAuthorizedGenericRequest_Internal(
-					InToken->GetTokenText(), OperationParams,
-					"POST", RequestURL, false);
+void URuntimeDataTableObject::WriteCsvToSheetChunked_OnTokenRefreshed(
+	const FRuntimeDataTableCallbackInfo CallbackInfo, URuntimeDataTableWebToken* InToken,
+	TSharedRef<FRuntimeDataTableChunkedUpload> Upload)
+{
+	Upload->bWaitingForToken = false;
 
-			Request->SetContentAsString(JsonContent);
+	if (!InToken || InToken->HasTokenExpired())
+	{
+		// Chunks already in flight are allowed to land, everything still queued has failed
+		Upload->NumChunksFailed += Upload->QueuedChunkIndices.Num();
+		Upload->QueuedChunkIndices.Empty();
 
-			// Clear target sheet
-			Request->OnProcessRequestComplete().BindUObject(
-				this, &URuntimeDataTableObject::WriteCsvToSheet_Internal_ClearSheet,
-				InToken, OperationParams, CallOnComplete, InSpreadsheetId, InSheetId, InCsv, SheetTabData
-			);
-	
-			Request->ProcessRequest();
-		}
-		else
+		if (Upload->NumChunksInFlight == 0)
 		{
-			// Clear target sheet
-			WriteCsvToSheet_Internal_ClearSheet(
-				InRequest, InResponse, bWasSuccessful,
-				InToken, OperationParams, CallOnComplete,
-				InSpreadsheetId, InSheetId, InCsv, SheetTabData
-			);
+			WriteCsvToSheetChunked_Finish(Upload, "ERROR: The token expired partway through the upload and could not be refreshed.");
 		}
+		return;
+	}
+
+	Upload->TokenText = InToken->GetTokenText();
+	Upload->TokenExpiration = FDateTime::UtcNow() + FTimespan::FromSeconds(InToken->GetNumberOfSecondsUntilExpiration());
+
+	if (InToken->GetNumberOfSecondsUntilExpiration() < Upload->OperationParams.RequestTimeout + 5.f)
+	{
+		Upload->NumShortTokenRefreshes++;
+	}
+	else
+	{
+		Upload->NumShortTokenRefreshes = 0;
 	}
+
+	// The token may have come straight from the cache, so carry on from the next tick rather than from inside this callback
+	FTSTicker::GetCoreTicker().AddTicker(
+		FTickerDelegate::CreateUObject(this, &URuntimeDataTableObject::WriteCsvToSheetChunked_OnNextTick, Upload));
 }
 
-void URuntimeDataTableObject::WriteCsvToSheet_Internal_ClearSheet(FHttpRequestPtr InRequest,
-	FHttpResponsePtr InResponse, bool bWasSuccessful, URuntimeDataTableWebToken* InToken,
-	const FRuntimeDataTableOperationParams OperationParams, FRDTGetStringDelegate CallOnComplete,
-	FString InSpreadsheetId, const int32 InSheetId, FString InCsv, FCsvToGoogleSheetsHandler SheetTabData)
+void URuntimeDataTableObject::WriteCsvToSheetChunked_OnChunkSent(
+	FHttpRequestPtr InRequest, FHttpResponsePtr InResponse, bool bWasSuccessful,
+	TSharedRef<FRuntimeDataTableChunkedUpload> Upload, const int32 ChunkIndex)
 {
 	FRuntimeDataTableCallbackInfo CallbackInfo;
-	CallbackInfo.OperationName = OperationParams.OperationName;
+	CallbackInfo.OperationName = Upload->OperationParams.OperationName;
 	CallbackInfo.bWasSuccessful = bWasSuccessful;
-	GenericValidateHttpResponse(InRequest, InResponse, CallbackInfo);
-	if (!CallbackInfo.bWasSuccessful)
+	GenericValidateHttpResponse(InRequest, InResponse, CallbackInfo, false);
+	Upload->LastResponseCode = CallbackInfo.ResponseCode;
+	Upload->NumChunksInFlight--;
+
+	const FRuntimeDataTableChunkedUpload::FChunk& Chunk = Upload->Chunks[ChunkIndex];
+
+	// Timeouts, 429s and 5xx have already been retried by FRuntimeDataTableRequestScheduler, so this is the chunk's final outcome
+	if (CallbackInfo.bWasSuccessful)
 	{
-		CallbackInfo.ResponseAsString = "ERROR: The ClearSheet operation was not successful.\n\n" + CallbackInfo.ResponseAsString;
-		FRuntimeDataTableModule::Print(FString::Printf(
-			TEXT("%hs: %s"),
-			__FUNCTION__, *CallbackInfo.ResponseAsString), FRuntimeDataTableModule::ELogType::Error);
-		CallOnComplete.ExecuteIfBound(CallbackInfo);
-		return;
+		Upload->NumChunksSucceeded++;
 	}
-
-	if (InSheetId < 0)
+	else
 	{
-		FRuntimeDataTableCallbackInfo FailedInfo;
-		FailedInfo.bWasSuccessful = false;
-		FailedInfo.OperationName = OperationParams.OperationName;
-		FailedInfo.ResponseAsString =
-			"ERROR: Input 'InSheetId' was not valid. Please enter a valid sheet ID.";
 		FRuntimeDataTableModule::Print(FString::Printf(
-			TEXT("%hs: %s"),
-			__FUNCTION__, *FailedInfo.ResponseAsString), FRuntimeDataTableModule::ELogType::Error);
-		CallOnComplete.ExecuteIfBound(FailedInfo);
+			TEXT("%hs: Chunk %i of %i (rows %i to %i) failed with response code %i"),
+			__FUNCTION__, ChunkIndex + 1, Upload->Chunks.Num(), Chunk.StartRow, Chunk.EndRow - 1, CallbackInfo.ResponseCode),
+			FRuntimeDataTableModule::ELogType::Error);
+
+		Upload->NumChunksFailed++;
 	}
 
-	if (!InToken || InToken->HasTokenExpired())
+	FRuntimeDataTableCallbackInfo ProgressInfo;
+	ProgressInfo.OperationName = Upload->OperationParams.OperationName;
+	ProgressInfo.bWasSuccessful = CallbackInfo.bWasSuccessful;
+	ProgressInfo.ResponseCode = CallbackInfo.ResponseCode;
+	ProgressInfo.CompletedChunks = Upload->NumChunksSucceeded + Upload->NumChunksFailed;
+	ProgressInfo.TotalChunks = Upload->Chunks.Num();
+	ProgressInfo.ResponseAsString = FString::Printf(
+		TEXT("Chunk %i of %i (rows %i to %i) %s."),
+		ChunkIndex + 1, Upload->Chunks.Num(), Chunk.StartRow, Chunk.EndRow - 1,
+		CallbackInfo.bWasSuccessful ? TEXT("uploaded") : TEXT("failed"));
+	Upload->CallOnProgress.ExecuteIfBound(ProgressInfo);
+
+	if (Upload->NumChunksSucceeded + Upload->NumChunksFailed == Upload->Chunks.Num())
 	{
-		FRuntimeDataTableCallbackInfo FailedInfo;
-		FailedInfo.bWasSuccessful = false;
-		FailedInfo.OperationName = OperationParams.OperationName;
-		FailedInfo.ResponseAsString = "ERROR: InToken has expired or was not successfully created.";
-		FRuntimeDataTableModule::Print(FString::Printf(
-			TEXT("%hs: %s"),
-			__FUNCTION__, *FailedInfo.ResponseAsString), FRuntimeDataTableModule::ELogType::Error);
-		CallOnComplete.ExecuteIfBound(FailedInfo);
-		return;
+		WriteCsvToSheetChunked_Finish(Upload);
+	}
+	else
+	{
+		WriteCsvToSheetChunked_SendNextChunks(Upload);
 	}
+}
 
-	const FString DataType = "userEnteredValue";
+bool URuntimeDataTableObject::WriteCsvToSheetChunked_OnNextTick(float DeltaTime, TSharedRef<FRuntimeDataTableChunkedUpload> Upload)
+{
+	WriteCsvToSheetChunked_SendNextChunks(Upload);
 
-	//Build JSON
-	const FString JsonContent =
-	"{\
-		\"requests\":\
-		[\
-			{\
-				\"updateCells\":\
-				{\
-					\"range\":\
-					{\
-						\"sheetId\": " + FString::FromInt(InSheetId) + "\
-					},\
-					\"fields\": \"" + DataType + "\"\
-				}\
-			}\
-		]\
-	}";
+	return false;
+}
 
-	//Build URL
-	const FString& RequestURL = GetGoogleSheetsBatchUpdateURL(InSpreadsheetId);
+void URuntimeDataTableObject::WriteCsvToSheetChunked_Finish(
+	TSharedRef<FRuntimeDataTableChunkedUpload> Upload, const FString& ErrorMessage)
+{
+	if (Upload->bFinished)
+	{
+		return;
+	}
+	Upload->bFinished = true;
 
-	FRuntimeDataTableModule::Print(FString::Printf(TEXT("%hs: Built JsonContent:\n%s"), __FUNCTION__, *JsonContent));
-	FRuntimeDataTableModule::Print(FString::Printf(TEXT("%hs: Built RequestURL:\n%s"), __FUNCTION__, *RequestURL));
-	
-	TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request =
-	CreateAuthorizedGenericRequest_Internal(
-		InToken->GetTokenText(), OperationParams, "POST",
-		RequestURL, false);
-	
-	// Finally, send the CSV to target sheet.
-	Request->OnProcessRequestComplete().BindUObject(
-		this, &URuntimeDataTableObject::WriteCsvToSheet_Internal_SendCsvDataToSheet,
-		InToken, OperationParams, CallOnComplete, InSpreadsheetId, InSheetId, InCsv, SheetTabData
-	);
+	EndOperation();
 
-	Request->SetContentAsString(JsonContent);
+	FRuntimeDataTableCallbackInfo CallbackInfo;
+	CallbackInfo.OperationName = Upload->OperationParams.OperationName;
+	CallbackInfo.ResponseCode = Upload->LastResponseCode;
+	CallbackInfo.CompletedChunks = Upload->NumChunksSucceeded + Upload->NumChunksFailed;
+	CallbackInfo.TotalChunks = Upload->Chunks.Num();
+	CallbackInfo.bWasSuccessful =
+		ErrorMessage.IsEmpty() && Upload->NumChunksFailed == 0 && Upload->NumChunksSucceeded == Upload->Chunks.Num();
+	CallbackInfo.ResponseAsString = !ErrorMessage.IsEmpty() ? ErrorMessage : FString::Printf(
+		TEXT("%i of %i chunks uploaded successfully."), Upload->NumChunksSucceeded, Upload->Chunks.Num());
+
+	FRuntimeDataTableModule::Print(FString::Printf(TEXT("%hs: %s"), __FUNCTION__, *CallbackInfo.ResponseAsString),
+		CallbackInfo.bWasSuccessful ? FRuntimeDataTableModule::ELogType::Display : FRuntimeDataTableModule::ELogType::Error);
 
-	Request->ProcessRequest();
+	Upload->CallOnComplete.ExecuteIfBound(CallbackInfo);
 }
 
-void URuntimeDataTableObject::WriteCsvToSheet_Internal_SendCsvDataToSheet(FHttpRequestPtr InRequest,
-	FHttpResponsePtr InResponse, bool bWasSuccessful, URuntimeDataTableWebToken* InToken,
-	const FRuntimeDataTableOperationParams OperationParams, FRDTGetStringDelegate CallOnComplete,
-	FString InSpreadsheetId, const int32 InSheetId, FString InCsv, FCsvToGoogleSheetsHandler SheetTabData)
+bool URuntimeDataTableObject::GetGridPropertiesFromSpreadsheetJson(
+	const FString& InJson, const int32 InSheetId, int32& OutRowCount, int32& OutColumnCount)
 {
-	FRuntimeDataTableCallbackInfo CallbackInfo;
-	CallbackInfo.OperationName = OperationParams.OperationName;
-	CallbackInfo.bWasSuccessful = bWasSuccessful;
-	GenericValidateHttpResponse(InRequest, InResponse, CallbackInfo);
-	if (!CallbackInfo.bWasSuccessful)
+	TSharedPtr<FJsonObject> Spreadsheet = MakeShareable(new FJsonObject());
+	const TSharedRef<TJsonReader<>> JsonReader = TJsonReaderFactory<>::Create(InJson);
+
+	if (!FJsonSerializer::Deserialize(JsonReader, Spreadsheet) || !Spreadsheet.IsValid())
 	{
-		CallbackInfo.ResponseAsString = "ERROR: The ClearSheet operation was not successful.\n\n" + CallbackInfo.ResponseAsString;
-		FRuntimeDataTableModule::Print(FString::Printf(
-			TEXT("%hs: %s"),
-			__FUNCTION__, *CallbackInfo.ResponseAsString), FRuntimeDataTableModule::ELogType::Error);
-		CallOnComplete.ExecuteIfBound(CallbackInfo);
-		return;
+		return false;
 	}
-	
-	int32 OutColumnStartIndex, OutRowStartIndex;
-	if (FCsvToGoogleSheetsHandler::A1_CellToColumnAndRowIndices("A1", OutColumnStartIndex, OutRowStartIndex))
+
+	const TArray<TSharedPtr<FJsonValue>>* OutSheets = nullptr;
+	Spreadsheet->TryGetArrayField("sheets", OutSheets);
+
+	if (OutSheets)
 	{
-		FString JsonContent;
+		for (const TSharedPtr<FJsonValue>& Sheet : *OutSheets)
 		{
-			// Master object
-			TSharedRef<FJsonObject> JsonObject = MakeShareable(new FJsonObject);
+			const TSharedPtr<FJsonObject>* SheetProperties = nullptr;
+			Sheet->AsObject()->TryGetObjectField("properties", SheetProperties);
+
+			if (SheetProperties)
 			{
-				TArray<TSharedPtr<FJsonValue>> RequestsArray;
+				int32 LoopSheetId = INDEX_NONE;
+				(*SheetProperties)->TryGetNumberField("sheetId", LoopSheetId);
+
+				if (LoopSheetId == InSheetId)
 				{
-					// The single object which will go in the requests array, only contains UpdateCellsObject
-					TSharedPtr<FJsonObject> RequestObject = MakeShareable(new FJsonObject);
-					{
-						// Set updateCells/appendCells fields
-						TSharedPtr<FJsonObject> CellsOperationObject = MakeShareable(new FJsonObject);
-						{
-							CellsOperationObject->SetNumberField("sheetId", InSheetId);
-
-							// rows
-							TArray<TSharedPtr<FJsonValue>> RowsArray;
-							{
-								// for each row in data object
-								for (const TArray<FString>& Row : SheetTabData.ArrayValues)
-								{
-									// Create a new Row object which is the type of RowsArray
-									TSharedPtr<FJsonObject> RowObject = MakeShareable(new FJsonObject);
-									// Then make a new array for each value in the row. This will be a field in RowObject.
-									TArray<TSharedPtr<FJsonValue>> ValuesArray;
-
-									// for each value in data object's row
-									for (const FString& Value : Row)
-									{
-										// Create new object to house the cell data
-										TSharedPtr<FJsonObject> CellDataObject = MakeShareable(new FJsonObject);
-										{
-											// We're only interested in userEnteredValue.stringValue right now for this function
-											TSharedPtr<FJsonObject> UserEnteredValueObject = MakeShareable(new FJsonObject);
-											{
-												UserEnteredValueObject->SetStringField("stringValue", Value);
-											}
-											CellDataObject->SetObjectField("userEnteredValue", UserEnteredValueObject);
-										}
-
-										// Add the cell data object to our ValuesArray
-										ValuesArray.Add(MakeShareable(new FJsonValueObject(CellDataObject)));
-									}
-
-									// When we're done adding values to ValuesArray we need to add ValuesArray to RowObject as a field
-									RowObject->SetArrayField("values", ValuesArray);
-
-									// Then add RowObject to the RowsArray
-									RowsArray.Add(MakeShareable(new FJsonValueObject(RowObject)));
-								}
-							}
-							CellsOperationObject->SetArrayField("rows", RowsArray);
-
-							// fields
-							CellsOperationObject->SetStringField("fields", "userEnteredValue.stringValue");
-						}
+					const TSharedPtr<FJsonObject>* GridProperties = nullptr;
+					(*SheetProperties)->TryGetObjectField("gridProperties", GridProperties);
 
-						// Add UpdateCellsObject to RequestObject
-						RequestObject->SetObjectField("appendCells", CellsOperationObject);
+					if (GridProperties)
+					{
+						(*GridProperties)->TryGetNumberField("rowCount", OutRowCount);
+						(*GridProperties)->TryGetNumberField("columnCount", OutColumnCount);
 					}
-
-					// Add RequestObject to RequestsArray
-					RequestsArray.Add(MakeShareable(new FJsonValueObject(RequestObject)));
+						
+					break;
 				}
-
-				// Add RequestsArray to master object
-				JsonObject->SetArrayField("requests", RequestsArray);
 			}
-
-			// Serialize master object
-			const TSharedRef<TJsonWriter<>> JsonWriter = TJsonWriterFactory<>::Create(&JsonContent);
-			FJsonSerializer::Serialize(JsonObject, JsonWriter);
-		}
-
-		if (!InToken || InToken->HasTokenExpired())
-		{
-			FRuntimeDataTableCallbackInfo FailedInfo;
-			FailedInfo.bWasSuccessful = false;
-			FailedInfo.OperationName = OperationParams.OperationName;
-			FailedInfo.ResponseAsString = "ERROR: InToken has expired or was not successfully created.";
-			FRuntimeDataTableModule::Print(FString::Printf(
-				TEXT("%hs: %s"),
-				__FUNCTION__, *FailedInfo.ResponseAsString), FRuntimeDataTableModule::ELogType::Error);
-			CallOnComplete.ExecuteIfBound(FailedInfo);
-			return;
 		}
-
-		//Build URL
-		const FString RequestURL = GetGoogleSheetsBatchUpdateURL(InSpreadsheetId);
-
-		FRuntimeDataTableModule::Print(FString::Printf(TEXT("%hs: Built JsonContent:\n%s"), __FUNCTION__, *JsonContent));
-		FRuntimeDataTableModule::Print(FString::Printf(TEXT("%hs: Built RequestURL:\n%s"), __FUNCTION__, *RequestURL));
-
-		TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request =
-			CreateAuthorizedGenericRequest_Internal(
-				InToken->GetTokenText(), OperationParams,
-				"POST", RequestURL, false);
-
-		Request->SetContentAsString(JsonContent);
-	
-		Request->OnProcessRequestComplete().BindUObject(
-			this, &URuntimeDataTableObject::OnResponseReceivedGenericReturnString,
-			OperationParams, CallOnComplete
-		);
-	
-		Request->ProcessRequest();
 	}
+
+	return true;
 }
 
 void URuntimeDataTableObject::OnResponseReceivedGenericReturnString(
@@ -1202,90 +2933,34 @@ TSharedRef<IHttpRequest, ESPMode::ThreadSafe> URuntimeDataTableObject::CreateAut
 	Request->SetHeader("Content-Type", ContentType);
 	Request->SetHeader("Accept", ContentType);
 	Request->SetTimeout(OperationParams.RequestTimeout);
-	AddToRoot();
+	BeginOperation(OperationParams.OperationName);
 
 	if (bShouldProcessRequest)
 	{
-		Request->ProcessRequest();
+		ProcessOperationRequest(Request);
 	}
 
 	return Request;
 }
 
-void URuntimeDataTableObject::CreateAndAuthenticateToken_Internal(FRuntimeDataTableTokenInfo InTokenInfo, const FRDTGetJWTDelegate& CallOnComplete)
-{
-	FString ErrorMessage;
-	if (!ValidateTokenInfo(InTokenInfo, ErrorMessage))
-	{
-		FRuntimeDataTableCallbackInfo FailedInfo;
-		FailedInfo.bWasSuccessful = false;
-		FailedInfo.OperationName = GetTokenOperationName;
-		FailedInfo.ResponseAsString = "ERROR: InTokenInfo is not valid.";
-		FRuntimeDataTableModule::Print(FString::Printf(
-			TEXT("%hs: %s"),
-			__FUNCTION__, *FailedInfo.ResponseAsString), FRuntimeDataTableModule::ELogType::Error);
-		CallOnComplete.ExecuteIfBound(FailedInfo, nullptr);
-		return;
-	}
-
-	const FString& SignedToken = CreateJavaWebToken(InTokenInfo);
-
-	Request_POST_ForToken(SignedToken, CallOnComplete, InTokenInfo);
-}
-
-void URuntimeDataTableObject::Request_POST_ForToken(
-	const FString InJavaWebToken,
-	const FRDTGetJWTDelegate& CallOnComplete, const FRuntimeDataTableTokenInfo InTokenInfo)
+void URuntimeDataTableObject::CreateAndAuthenticateToken(FRuntimeDataTableTokenInfo InTokenInfo, const FRDTGetJWTDelegate& CallOnComplete)
 {
-	FHttpModule* HTTP_Module = &FHttpModule::Get();
-	TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = HTTP_Module->CreateRequest();
-
-	Request->SetURL("https://oauth2.googleapis.com/token?grant_type=urn%3Aietf%3Aparams%3Aoauth%3Agrant-type%3Ajwt-bearer&assertion=" + InJavaWebToken);
-	Request->SetVerb("POST");
-	Request->OnProcessRequestComplete().BindUObject(
-		this, &URuntimeDataTableObject::OnResponseReceivedReturnToken, InTokenInfo, CallOnComplete);
-	Request->SetTimeout(30);
-	Request->ProcessRequest();
-	AddToRoot();
-}
-
-void URuntimeDataTableObject::OnResponseReceivedReturnToken(
-	FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful,
-	FRuntimeDataTableTokenInfo InTokenInfo,	FRDTGetJWTDelegate CallOnComplete)
-{	
-	FRuntimeDataTableCallbackInfo CallbackInfo;
-	CallbackInfo.OperationName = GetTokenOperationName;
-	CallbackInfo.bWasSuccessful = bWasSuccessful;
-	GenericValidateHttpResponse(Request, Response, CallbackInfo);
-	if (CallbackInfo.bWasSuccessful)
-	{		
-		TSharedPtr<FJsonObject> PostResponse = MakeShareable(new FJsonObject());
-		const TSharedRef<TJsonReader<>> JsonReader = TJsonReaderFactory<>::Create(CallbackInfo.ResponseAsString);
-
-		if (FJsonSerializer::Deserialize(JsonReader, PostResponse) && PostResponse.IsValid())
-		{
-			URuntimeDataTableWebToken* NewToken = NewObject<URuntimeDataTableWebToken>();
-			const FString AccessToken = PostResponse->GetStringField("access_token");
-
-			CallbackInfo.bWasSuccessful = NewToken->Init(AccessToken, InTokenInfo.SecondsUntilExpiration);
-			
-			CallOnComplete.ExecuteIfBound(CallbackInfo, CallbackInfo.bWasSuccessful ? NewToken : nullptr);
-
-			return;
-		}
-	}
-	
-	CallOnComplete.ExecuteIfBound(CallbackInfo, nullptr);
+	FRuntimeDataTableTokenManager::Get().RequestAccessToken(InTokenInfo, CallOnComplete);
 }
 
 void URuntimeDataTableObject::GenericValidateHttpResponse(
-	FHttpRequestPtr Request, FHttpResponsePtr Response, FRuntimeDataTableCallbackInfo& CallbackInfo)
+	FHttpRequestPtr Request, FHttpResponsePtr Response, FRuntimeDataTableCallbackInfo& CallbackInfo, const bool bEndOperation)
 {
-	RemoveFromRoot();
+	if (bEndOperation)
+	{
+		EndOperation();
+	}
 	Request->OnProcessRequestComplete().Unbind();
 
+	// No response at all means the connection itself failed
+	CallbackInfo.bWasSuccessful = CallbackInfo.bWasSuccessful && Response.IsValid();
 	CallbackInfo.ResponseAsString = CallbackInfo.bWasSuccessful ? Response->GetContentAsString() : "";
-	CallbackInfo.ResponseCode = Response->GetResponseCode();
+	CallbackInfo.ResponseCode = Response.IsValid() ? Response->GetResponseCode() : INDEX_NONE;
 
 	// Ensure on Response Code and returned body. The Response Code may say it's a success, but that just means we got a document. May be an error document.
 	if (CallbackInfo.bWasSuccessful)
@@ -1293,6 +2968,8 @@ void URuntimeDataTableObject::GenericValidateHttpResponse(
 		CallbackInfo.bWasSuccessful = CallbackInfo.ResponseCode < 300 && !CallbackInfo.ResponseAsString.Left(100).Contains("<!DOCTYPE html>");
 	}
 
+	InvalidateRejectedAccessToken(Request, CallbackInfo.ResponseCode);
+
 	FRuntimeDataTableModule::Print(FString::Printf(
 		TEXT("%hs: %s Response received, success: %s, Response code: %i, Response:\n%s"),
 		__FUNCTION__, *Request->GetVerb(),
@@ -1302,40 +2979,47 @@ void URuntimeDataTableObject::GenericValidateHttpResponse(
 		CallbackInfo.bWasSuccessful ? FRuntimeDataTableModule::ELogType::Display : FRuntimeDataTableModule::ELogType::Error);
 }
 
-FString URuntimeDataTableObject::CreateJavaWebToken(FRuntimeDataTableTokenInfo InTokenInfo)
+void URuntimeDataTableObject::BeginOperation(const FName OperationName)
 {
-	FString ErrorMessage;
-	if (!ValidateTokenInfo(InTokenInfo, ErrorMessage))
+	if (URuntimeDataTableOperationSubsystem* OperationSubsystem = URuntimeDataTableOperationSubsystem::Get())
 	{
-		return "";
+		OperationSubsystem->BeginOperation(this, OperationName);
 	}
+	else
+	{
+		// No engine to hold on to us, e.g. during startup
+		AddToRoot();
+	}
+}
 
-	InTokenInfo.PrivateKey = InTokenInfo.PrivateKey.ReplaceEscapedCharWithChar();
-	InTokenInfo.ClaimUrl = InTokenInfo.ClaimUrl.ReplaceEscapedCharWithChar();
-	InTokenInfo.TokenUri = InTokenInfo.TokenUri.ReplaceEscapedCharWithChar();
-	
-	const jwt::builder<jwt::traits::kazuho_picojson> TokenBuilder = jwt::create()
-		.set_algorithm("RS256")
-		.set_type("JWT")
-		.set_issuer(TCHAR_TO_ANSI(*InTokenInfo.ServiceAccountEmail))
-		.set_payload_claim("scope", jwt::claim(std::string{ TCHAR_TO_ANSI(*InTokenInfo.ClaimUrl) }))
-		.set_audience(TCHAR_TO_ANSI(*InTokenInfo.TokenUri))
-		.set_expires_at(std::chrono::system_clock::now() + std::chrono::seconds{ InTokenInfo.SecondsUntilExpiration })
-		.set_issued_at(std::chrono::system_clock::now());
-	
-	const FString& TokenString =
-		FString(
-			TokenBuilder.sign(
-				jwt::algorithm::rs256("",
-				TCHAR_TO_ANSI(*InTokenInfo.PrivateKey),
-				"", ""
-				)
-			).c_str()
-		); 
-
-	FRuntimeDataTableModule::Print(FString::Printf(TEXT("%hs: Token:\n%s"), __FUNCTION__, *TokenString));
-
-	return TokenString;
+void URuntimeDataTableObject::EndOperation()
+{
+	if (URuntimeDataTableOperationSubsystem* OperationSubsystem = URuntimeDataTableOperationSubsystem::Get())
+	{
+		OperationSubsystem->EndOperation(this);
+	}
+
+	if (IsRooted())
+	{
+		RemoveFromRoot();
+	}
+}
+
+void URuntimeDataTableObject::ProcessOperationRequest(const TSharedRef<IHttpRequest, ESPMode::ThreadSafe>& Request, const bool bIsIdempotent)
+{
+	if (URuntimeDataTableOperationSubsystem* OperationSubsystem = URuntimeDataTableOperationSubsystem::Get())
+	{
+		OperationSubsystem->ProcessRequest(this, Request, bIsIdempotent);
+	}
+	else
+	{
+		FRuntimeDataTableRequestScheduler::Get().ProcessRequest(Request, bIsIdempotent);
+	}
+}
+
+FString URuntimeDataTableObject::CreateJavaWebToken(FRuntimeDataTableTokenInfo InTokenInfo)
+{
+	return FRuntimeDataTableTokenManager::Get().CreateSignedAssertion(InTokenInfo);
 }
 
 bool URuntimeDataTableObject::ValidateTokenInfo(FRuntimeDataTableTokenInfo& InTokenInfo, FString& ErrorMessage)
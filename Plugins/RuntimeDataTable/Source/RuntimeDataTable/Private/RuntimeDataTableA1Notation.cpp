@@ -0,0 +1,208 @@
+// Copyright Jared Therriault 2019, 2022
+
+#include "RuntimeDataTableA1Notation.h"
+
+namespace RuntimeDataTableA1
+{
+	// Reads a whole cell, both parts required
+	bool ParseWholeCell(const TCHAR* InCell, const int32 InLength, int32& OutColumn, int32& OutRow)
+	{
+		return ParseCell(InCell, InLength, OutColumn, OutRow) == InLength && OutColumn > 0 && OutRow > 0;
+	}
+
+	// Titles that could be read as anything else have to be quoted
+	bool DoesTitleNeedQuotes(const FString& InTitle)
+	{
+		for (const TCHAR Char : InTitle)
+		{
+			if (!FChar::IsAlnum(Char) && Char != TEXT('_'))
+			{
+				return true;
+			}
+		}
+
+		int32 Column = 0;
+		int32 Row = 0;
+		return InTitle.IsEmpty() || FChar::IsDigit(InTitle[0]) || ParseCell(*InTitle, InTitle.Len(), Column, Row) == InTitle.Len();
+	}
+}
+
+bool FRuntimeDataTableA1Range::Parse(const FString& InRange, FRuntimeDataTableA1Range& OutRange)
+{
+	OutRange = FRuntimeDataTableA1Range();
+
+	const FString Range = InRange.TrimStartAndEnd();
+	const TCHAR* Chars = *Range;
+	const int32 Length = Range.Len();
+
+	int32 CellsStart = 0;
+
+	if (Length > 0 && Chars[0] == TEXT('\''))
+	{
+		// Quotes in a quoted title are doubled
+		int32 Index = 1;
+		for (; Index < Length; Index++)
+		{
+			if (Chars[Index] == TEXT('\''))
+			{
+				if (Index + 1 < Length && Chars[Index + 1] == TEXT('\''))
+				{
+					OutRange.SheetTitle.AppendChar(TEXT('\''));
+					Index++;
+					continue;
+				}
+				break;
+			}
+			OutRange.SheetTitle.AppendChar(Chars[Index]);
+		}
+
+		if (Index + 1 >= Length || Chars[Index + 1] != TEXT('!'))
+		{
+			return false;
+		}
+		CellsStart = Index + 2;
+	}
+	else
+	{
+		int32 ExclamationIndex = INDEX_NONE;
+		if (Range.FindChar(TEXT('!'), ExclamationIndex))
+		{
+			OutRange.SheetTitle = Range.Left(ExclamationIndex);
+			CellsStart = ExclamationIndex + 1;
+		}
+	}
+
+	const TCHAR* Cells = Chars + CellsStart;
+	const int32 CellsLength = Length - CellsStart;
+
+	int32 ColonIndex = INDEX_NONE;
+	for (int32 Index = 0; Index < CellsLength; Index++)
+	{
+		if (Cells[Index] == TEXT(':'))
+		{
+			ColonIndex = Index;
+			break;
+		}
+	}
+
+	if (ColonIndex == INDEX_NONE)
+	{
+		if (!RuntimeDataTableA1::ParseWholeCell(Cells, CellsLength, OutRange.StartColumn, OutRange.StartRow))
+		{
+			return false;
+		}
+		OutRange.EndColumn = OutRange.StartColumn;
+		OutRange.EndRow = OutRange.StartRow;
+		return true;
+	}
+
+	int32 FirstColumn = 0, FirstRow = 0, SecondColumn = 0, SecondRow = 0;
+	if (!RuntimeDataTableA1::ParseWholeCell(Cells, ColonIndex, FirstColumn, FirstRow) ||
+		!RuntimeDataTableA1::ParseWholeCell(Cells + ColonIndex + 1, CellsLength - ColonIndex - 1, SecondColumn, SecondRow))
+	{
+		return false;
+	}
+
+	OutRange.StartColumn = FMath::Min(FirstColumn, SecondColumn);
+	OutRange.StartRow = FMath::Min(FirstRow, SecondRow);
+	OutRange.EndColumn = FMath::Max(FirstColumn, SecondColumn);
+	OutRange.EndRow = FMath::Max(FirstRow, SecondRow);
+	return true;
+}
+
+FString FRuntimeDataTableA1Range::ToString(const bool bAlwaysQuoteTitle) const
+{
+	FString Range;
+	Range.Reserve(SheetTitle.Len() + 24);
+
+	if (!SheetTitle.IsEmpty())
+	{
+		if (bAlwaysQuoteTitle || RuntimeDataTableA1::DoesTitleNeedQuotes(SheetTitle))
+		{
+			Range.AppendChar(TEXT('\''));
+			Range += SheetTitle.Replace(TEXT("'"), TEXT("''"));
+			Range.AppendChar(TEXT('\''));
+		}
+		else
+		{
+			Range += SheetTitle;
+		}
+		Range.AppendChar(TEXT('!'));
+	}
+
+	RuntimeDataTableA1::AppendCell(Range, StartColumn, StartRow);
+	Range.AppendChar(TEXT(':'));
+	RuntimeDataTableA1::AppendCell(Range, EndColumn, EndRow);
+
+	return Range;
+}
+
+bool FRuntimeDataTableA1Range::Intersect(const FRuntimeDataTableA1Range& A, const FRuntimeDataTableA1Range& B, FRuntimeDataTableA1Range& OutRange)
+{
+	if (A.SheetTitle != B.SheetTitle)
+	{
+		return false;
+	}
+
+	OutRange = FRuntimeDataTableA1Range(
+		FMath::Max(A.StartColumn, B.StartColumn), FMath::Max(A.StartRow, B.StartRow),
+		FMath::Min(A.EndColumn, B.EndColumn), FMath::Min(A.EndRow, B.EndRow), A.SheetTitle);
+
+	return OutRange.StartColumn <= OutRange.EndColumn && OutRange.StartRow <= OutRange.EndRow;
+}
+
+FRuntimeDataTableA1Range FRuntimeDataTableA1Range::Union(const FRuntimeDataTableA1Range& A, const FRuntimeDataTableA1Range& B)
+{
+	return FRuntimeDataTableA1Range(
+		FMath::Min(A.StartColumn, B.StartColumn), FMath::Min(A.StartRow, B.StartRow),
+		FMath::Max(A.EndColumn, B.EndColumn), FMath::Max(A.EndRow, B.EndRow), A.SheetTitle);
+}
+
+TArray<FRuntimeDataTableA1Range> FRuntimeDataTableA1Range::Tile(const int32 MaxRows, const int32 MaxColumns) const
+{
+	TArray<FRuntimeDataTableA1Range> Tiles;
+	if (!IsValid())
+	{
+		return Tiles;
+	}
+
+	const int32 TileRows = MaxRows > 0 ? MaxRows : GetRowCount();
+	const int32 TileColumns = MaxColumns > 0 ? MaxColumns : GetColumnCount();
+
+	Tiles.Reserve(FMath::DivideAndRoundUp(GetRowCount(), TileRows) * FMath::DivideAndRoundUp(GetColumnCount(), TileColumns));
+
+	for (int32 TileStartRow = StartRow; TileStartRow <= EndRow; TileStartRow += TileRows)
+	{
+		for (int32 TileStartColumn = StartColumn; TileStartColumn <= EndColumn; TileStartColumn += TileColumns)
+		{
+			Tiles.Emplace(
+				TileStartColumn, TileStartRow,
+				FMath::Min(TileStartColumn + TileColumns - 1, EndColumn), FMath::Min(TileStartRow + TileRows - 1, EndRow),
+				SheetTitle);
+		}
+	}
+
+	return Tiles;
+}
+
+bool FRuntimeDataTableA1Range::MakeBoundingBox(
+	const TArray<FIntPoint>& InDirtyCells, FRuntimeDataTableA1Range& OutRange, const FString& InSheetTitle)
+{
+	if (InDirtyCells.Num() == 0)
+	{
+		return false;
+	}
+
+	OutRange = FRuntimeDataTableA1Range(
+		InDirtyCells[0].X, InDirtyCells[0].Y, InDirtyCells[0].X, InDirtyCells[0].Y, InSheetTitle);
+
+	for (const FIntPoint& Cell : InDirtyCells)
+	{
+		OutRange.StartColumn = FMath::Min(OutRange.StartColumn, Cell.X);
+		OutRange.StartRow = FMath::Min(OutRange.StartRow, Cell.Y);
+		OutRange.EndColumn = FMath::Max(OutRange.EndColumn, Cell.X);
+		OutRange.EndRow = FMath::Max(OutRange.EndRow, Cell.Y);
+	}
+
+	return true;
+}
@@ -0,0 +1,248 @@
+// Copyright Jared Therriault 2019, 2022
+
+#include "RuntimeDataTableBackupStore.h"
+
+#include "RuntimeDataTableModule.h"
+#include "RuntimeDataTableProjectSettings.h"
+#include "RuntimeDataTableStats.h"
+
+#include "Async/Async.h"
+#include "HAL/FileManager.h"
+#include "Misc/Compression.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+FCriticalSection FRuntimeDataTableBackupStore::WriteCriticalSection;
+
+void FRuntimeDataTableBackupStore::SaveBackupAsync(const FString& InBackupPath, FString InCsv)
+{
+	// Stamped now rather than when the write runs, so that versions stay in the order they were downloaded
+	const int64 VersionTicks = FDateTime::UtcNow().GetTicks();
+
+	const int64 CsvBytes = InCsv.GetAllocatedSize();
+	INC_MEMORY_STAT_BY(STAT_RuntimeDataTable_BackupMemory, CsvBytes);
+
+	Async(EAsyncExecution::ThreadPool, [InBackupPath, Csv = MoveTemp(InCsv), VersionTicks, CsvBytes]()
+	{
+		if (!SaveBackupVersion(InBackupPath, Csv, VersionTicks))
+		{
+			// Print touches the screen, which isn't safe from here
+			UE_LOG(LogRuntimeDataTable, Warning, TEXT("FRuntimeDataTableBackupStore: Could not save backup %s"), *InBackupPath);
+		}
+
+		DEC_MEMORY_STAT_BY(STAT_RuntimeDataTable_BackupMemory, CsvBytes);
+	});
+}
+
+bool FRuntimeDataTableBackupStore::SaveBackup(const FString& InBackupPath, const FString& InCsv)
+{
+	return SaveBackupVersion(InBackupPath, InCsv, FDateTime::UtcNow().GetTicks());
+}
+
+bool FRuntimeDataTableBackupStore::LoadBackup(const FString& InBackupPath, TArray<uint8>& OutUtf8Csv)
+{
+	for (const FString& VersionPath : FindBackupVersions(InBackupPath))
+	{
+		if (ReadBackupVersion(VersionPath, OutUtf8Csv))
+		{
+			return true;
+		}
+	}
+
+	// An uncompressed backup from before versioning
+	FString LegacyCsv;
+	if (FPaths::FileExists(InBackupPath) && FFileHelper::LoadFileToString(LegacyCsv, *InBackupPath))
+	{
+		const FTCHARToUTF8 Converted(*LegacyCsv, LegacyCsv.Len());
+		OutUtf8Csv.Reset(Converted.Length());
+		OutUtf8Csv.Append(reinterpret_cast<const uint8*>(Converted.Get()), Converted.Length());
+		return true;
+	}
+
+	return false;
+}
+
+bool FRuntimeDataTableBackupStore::HasBackup(const FString& InBackupPath)
+{
+	return !InBackupPath.IsEmpty() && (FindBackupVersions(InBackupPath).Num() > 0 || FPaths::FileExists(InBackupPath));
+}
+
+TArray<FString> FRuntimeDataTableBackupStore::FindBackupVersions(const FString& InBackupPath)
+{
+	const FString Directory = FPaths::GetPath(InBackupPath);
+	const FString Prefix = FPaths::GetCleanFilename(InBackupPath) + ".";
+
+	TArray<FString> FoundFiles;
+	IFileManager::Get().FindFiles(FoundFiles, *FPaths::Combine(Directory, Prefix + "*.rdtb"), true, false);
+
+	// The ticks in the name are what orders the versions, file times don't survive being copied around
+	TArray<TPair<int64, FString>> Versions;
+	for (const FString& FoundFile : FoundFiles)
+	{
+		const FString TicksString = FoundFile.Mid(Prefix.Len(), FoundFile.Len() - Prefix.Len() - 5);
+		if (TicksString.IsNumeric())
+		{
+			Versions.Emplace(FCString::Atoi64(*TicksString), FPaths::Combine(Directory, FoundFile));
+		}
+	}
+
+	Versions.Sort([](const TPair<int64, FString>& A, const TPair<int64, FString>& B)
+	{
+		return A.Key > B.Key;
+	});
+
+	TArray<FString> VersionPaths;
+	for (TPair<int64, FString>& Version : Versions)
+	{
+		VersionPaths.Add(MoveTemp(Version.Value));
+	}
+	return VersionPaths;
+}
+
+bool FRuntimeDataTableBackupStore::SaveBackupVersion(const FString& InBackupPath, const FString& InCsv, const int64 InVersionTicks)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FRuntimeDataTableBackupStore::SaveBackupVersion);
+	SCOPE_CYCLE_COUNTER(STAT_RuntimeDataTable_SaveBackup);
+
+	const double StartTime = FPlatformTime::Seconds();
+
+	const URuntimeDataTableProjectSettings* Settings = GetDefault<URuntimeDataTableProjectSettings>();
+	const FName CompressionFormat = Settings ? Settings->BackupCompressionFormat : NAME_Zlib;
+	const int32 NumToKeep = Settings ? Settings->NumBackupVersionsToKeep : 3;
+
+	const FTCHARToUTF8 Utf8Csv(*InCsv, InCsv.Len());
+	const int32 UncompressedSize = Utf8Csv.Length();
+	if (UncompressedSize == 0)
+	{
+		return false;
+	}
+
+	int32 CompressedSize = FCompression::CompressMemoryBound(CompressionFormat, UncompressedSize);
+	TArray<uint8> CompressedData;
+	CompressedData.SetNumUninitialized(CompressedSize);
+
+	if (!FCompression::CompressMemory(CompressionFormat, CompressedData.GetData(), CompressedSize, Utf8Csv.Get(), UncompressedSize))
+	{
+		return false;
+	}
+	CompressedData.SetNum(CompressedSize, false);
+
+	TArray<uint8> FileData;
+	FMemoryWriter Writer(FileData);
+
+	uint32 Magic = FileMagic;
+	uint32 FormatVersion = FileFormatVersion;
+	FString CompressionFormatName = CompressionFormat.ToString();
+	int32 UncompressedSizeToWrite = UncompressedSize;
+
+	Writer << Magic;
+	Writer << FormatVersion;
+	Writer << CompressionFormatName;
+	Writer << UncompressedSizeToWrite;
+	Writer << CompressedData;
+
+	const FString VersionPath = FString::Printf(TEXT("%s.%lld.rdtb"), *InBackupPath, InVersionTicks);
+
+	FScopeLock Lock(&WriteCriticalSection);
+
+	IFileManager::Get().MakeDirectory(*FPaths::GetPath(InBackupPath), true);
+
+	if (!WriteFileAtomically(FileData, VersionPath))
+	{
+		return false;
+	}
+
+	// The plain CSV is what anything outside this class reads, and what LoadBackup falls back to
+	const TArrayView<const uint8> PlainCsv(reinterpret_cast<const uint8*>(Utf8Csv.Get()), UncompressedSize);
+	if (!WriteFileAtomically(PlainCsv, InBackupPath))
+	{
+		return false;
+	}
+
+	PruneBackupVersions(InBackupPath, NumToKeep);
+
+	FRuntimeDataTableStats::RecordStage(TEXT("Backup.Save"), NAME_None, FPlatformTime::Seconds() - StartTime, FileData.Num());
+
+	return true;
+}
+
+bool FRuntimeDataTableBackupStore::WriteFileAtomically(const TArrayView<const uint8> InData, const FString& InPath)
+{
+	const FString TempPath = InPath + ".tmp";
+
+	if (!FFileHelper::SaveArrayToFile(InData, *TempPath))
+	{
+		IFileManager::Get().Delete(*TempPath, false, false, true);
+		return false;
+	}
+
+	// A rename on the same volume, so readers either see the whole file or no file
+	if (!IFileManager::Get().Move(*InPath, *TempPath, true, true, false, true))
+	{
+		IFileManager::Get().Delete(*TempPath, false, false, true);
+		return false;
+	}
+
+	return true;
+}
+
+bool FRuntimeDataTableBackupStore::ReadBackupVersion(const FString& InVersionPath, TArray<uint8>& OutUtf8Csv)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FRuntimeDataTableBackupStore::ReadBackupVersion);
+	SCOPE_CYCLE_COUNTER(STAT_RuntimeDataTable_LoadBackup);
+
+	const double StartTime = FPlatformTime::Seconds();
+
+	TArray<uint8> FileData;
+	if (!FFileHelper::LoadFileToArray(FileData, *InVersionPath, FILEREAD_Silent))
+	{
+		return false;
+	}
+
+	FMemoryReader Reader(FileData);
+
+	uint32 Magic = 0;
+	uint32 FormatVersion = 0;
+	FString CompressionFormatName;
+	int32 UncompressedSize = 0;
+	TArray<uint8> CompressedData;
+
+	Reader << Magic;
+	Reader << FormatVersion;
+	if (Reader.IsError() || Magic != FileMagic || FormatVersion > FileFormatVersion)
+	{
+		return false;
+	}
+
+	Reader << CompressionFormatName;
+	Reader << UncompressedSize;
+	Reader << CompressedData;
+	if (Reader.IsError() || UncompressedSize < 0)
+	{
+		return false;
+	}
+
+	OutUtf8Csv.SetNumUninitialized(UncompressedSize);
+	if (!FCompression::UncompressMemory(
+		FName(*CompressionFormatName), OutUtf8Csv.GetData(), UncompressedSize, CompressedData.GetData(), CompressedData.Num()))
+	{
+		OutUtf8Csv.Reset();
+		return false;
+	}
+
+	FRuntimeDataTableStats::RecordStage(TEXT("Backup.Load"), NAME_None, FPlatformTime::Seconds() - StartTime, FileData.Num());
+
+	return true;
+}
+
+void FRuntimeDataTableBackupStore::PruneBackupVersions(const FString& InBackupPath, const int32 InNumToKeep)
+{
+	const TArray<FString> Versions = FindBackupVersions(InBackupPath);
+	for (int32 VersionIndex = FMath::Max(InNumToKeep, 1); VersionIndex < Versions.Num(); VersionIndex++)
+	{
+		IFileManager::Get().Delete(*Versions[VersionIndex], false, false, true);
+	}
+}
@@ -0,0 +1,334 @@
+// Copyright Jared Therriault 2019, 2022
+
+#include "RuntimeDataTableDeltaExporter.h"
+
+#include "RuntimeDataTableJsonPayloadWriter.h"
+#include "RuntimeDataTableModule.h"
+#include "RuntimeDataTableStats.h"
+
+#include "Hash/CityHash.h"
+
+namespace RuntimeDataTableDeltaExporter
+{
+	// Row strings are CSV, with the key as the first cell
+	TArray<FString> SplitRowString(const FString& InRowString)
+	{
+		TArray<TArray<FString>> Rows = UEasyCsv::ReadCsv(InRowString);
+		return Rows.Num() > 0 ? MoveTemp(Rows[0]) : TArray<FString>();
+	}
+
+	void WriteRowData(FRuntimeDataTableJsonPayloadWriter& Writer, const TArray<FString>& InCells)
+	{
+		Writer.BeginObject();
+		Writer.BeginArray("values");
+		for (const FString& Cell : InCells)
+		{
+			// An empty cell object clears the cell since "fields" still names userEnteredValue
+			Writer.BeginObject();
+			if (!Cell.IsEmpty())
+			{
+				Writer.BeginObject("userEnteredValue");
+				Writer.WriteStringField("stringValue", Cell);
+				Writer.EndObject();
+			}
+			Writer.EndObject();
+		}
+		Writer.EndArray();
+		Writer.EndObject();
+	}
+
+	void WriteDeleteRowsRequest(FRuntimeDataTableJsonPayloadWriter& Writer, const int32 InSheetId, const int32 InStartRow, const int32 InEndRow)
+	{
+		Writer.BeginObject();
+		Writer.BeginObject("deleteDimension");
+		{
+			Writer.BeginObject("range");
+			Writer.WriteNumberField("sheetId", InSheetId);
+			Writer.WriteStringField("dimension", "ROWS");
+			Writer.WriteNumberField("startIndex", InStartRow);
+			Writer.WriteNumberField("endIndex", InEndRow);
+			Writer.EndObject();
+		}
+		Writer.EndObject();
+		Writer.EndObject();
+	}
+}
+
+URuntimeDataTableDeltaExporter* URuntimeDataTableDeltaExporter::CreateDeltaExporter(const int32 SheetId)
+{
+	URuntimeDataTableDeltaExporter* Exporter = NewObject<URuntimeDataTableDeltaExporter>();
+	Exporter->SheetId = SheetId;
+	return Exporter;
+}
+
+bool URuntimeDataTableDeltaExporter::ExportChangedRows_Internal(
+	FArrayProperty* ArrayProperty, void* ArrayPtr, const TArray<FString>& RowKeys, UObject* OwningObject,
+	const FString& MembersToInclude, const bool bSortColumnsAlphanumerically, const bool bFlattenNestedStructs,
+	FString& OutCsv, TArray<FString>& OutDeletedKeys, FString& OutBatchUpdatePayload)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(URuntimeDataTableDeltaExporter::ExportChangedRows_Internal);
+	SCOPE_CYCLE_COUNTER(STAT_RuntimeDataTable_GenerateCsv);
+
+	using namespace RuntimeDataTableDeltaExporter;
+
+	OutCsv.Reset();
+	OutDeletedKeys.Reset();
+	OutBatchUpdatePayload.Reset();
+
+	if (!ArrayProperty || !ArrayPtr || !OwningObject)
+	{
+		FRuntimeDataTableModule::Print(
+			FString::Printf(TEXT("%hs: Parameters are not valid."), __FUNCTION__), FRuntimeDataTableModule::ELogType::Error);
+		return false;
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+
+	FProperty* InnerProperty = ArrayProperty->Inner;
+	const bool bIsUObject = InnerProperty->IsA(FObjectProperty::StaticClass());
+
+	// All members in objects are stored as a struct, so we can treat them as such
+	FStructProperty* StructProperty = (FStructProperty*)InnerProperty;
+
+	TArray<FString> MembersWhitelist;
+	MembersToInclude.ParseIntoArray(MembersWhitelist, TEXT(","));
+
+	enum class ERowState : uint8
+	{
+		Unchanged,
+		Changed,
+		Added
+	};
+
+	struct FExportedRow
+	{
+		FString Key;
+		FString RowString;
+		uint64 Hash = 0;
+		ERowState State = ERowState::Unchanged;
+	};
+
+	FScriptArrayHelper ArrayHelper(ArrayProperty, ArrayPtr);
+
+	TArray<FExportedRow> Rows;
+	Rows.Reserve(ArrayHelper.Num());
+
+	TSet<FString> ExportedKeys;
+	FString NewHeaderRow;
+
+	for (int32 i = 0; i < ArrayHelper.Num(); i++)
+	{
+		FString RowKey = i < RowKeys.Num() ? RowKeys[i] : FString();
+		if (RowKey.TrimStartAndEnd() == "")
+		{
+			RowKey = "Row" + FString::FromInt(i);
+		}
+
+		// A second row with the same key would have nowhere to go in the sheet
+		bool bIsDuplicate = false;
+		ExportedKeys.Add(RowKey, &bIsDuplicate);
+		if (bIsDuplicate)
+		{
+			FRuntimeDataTableModule::Print(FString::Printf(
+				TEXT("%hs: Key %s is used more than once, only the first row with it is exported."), __FUNCTION__, *RowKey),
+				FRuntimeDataTableModule::ELogType::Warning);
+			continue;
+		}
+
+		// If this is an object then we need to make OwningObject the object in question
+		if (bIsUObject)
+		{
+			OwningObject = ((FObjectProperty*)InnerProperty)->GetObjectPropertyValue(ArrayHelper.GetRawPtr(i));
+		}
+
+		FExportedRow& Row = Rows.AddDefaulted_GetRef();
+		Row.Key = RowKey;
+
+		uint8 NumValues;
+		FString TopRow;
+		URuntimeDataTableObject::IterateThroughStructPropertyAndMakeRowString(
+			StructProperty, ArrayHelper.GetRawPtr(i), RowKey, OwningObject,
+			bIsUObject, bSortColumnsAlphanumerically, NumValues, TopRow, Row.RowString, MembersWhitelist, bFlattenNestedStructs);
+
+		if (Rows.Num() == 1)
+		{
+			NewHeaderRow = TopRow;
+		}
+
+		Row.Hash = CityHash64(reinterpret_cast<const char*>(*Row.RowString), Row.RowString.Len() * sizeof(TCHAR));
+	}
+
+	// Rows can't be compared across a change of columns
+	const bool bFullExport = !bHasExported || NewHeaderRow != HeaderRow;
+
+	int32 NumChangedRows = 0;
+	for (FExportedRow& Row : Rows)
+	{
+		const uint64* PreviousHash = bFullExport ? nullptr : RowHashes.Find(Row.Key);
+		Row.State = !PreviousHash ? ERowState::Added : *PreviousHash != Row.Hash ? ERowState::Changed : ERowState::Unchanged;
+		NumChangedRows += Row.State != ERowState::Unchanged ? 1 : 0;
+	}
+
+	// Where each deleted row sits in the sheet, counting the header as row 0
+	TArray<int32> DeletedSheetRows;
+	for (int32 Index = 0; Index < SheetRowKeys.Num(); Index++)
+	{
+		if (!ExportedKeys.Contains(SheetRowKeys[Index]))
+		{
+			OutDeletedKeys.Add(SheetRowKeys[Index]);
+			DeletedSheetRows.Add(Index + 1);
+		}
+	}
+
+	const bool bHasChanges = bFullExport || NumChangedRows > 0 || OutDeletedKeys.Num() > 0;
+	if (bHasChanges)
+	{
+		// Upsert CSV
+		OutCsv = NewHeaderRow;
+		for (const FExportedRow& Row : Rows)
+		{
+			if (Row.State != ERowState::Unchanged)
+			{
+				OutCsv += "\n" + Row.RowString;
+			}
+		}
+
+		// batchUpdate body
+		FRuntimeDataTableJsonPayloadWriter Writer(OutCsv.Len() * 2);
+		Writer.BeginObject();
+		Writer.BeginArray("requests");
+
+		if (bFullExport)
+		{
+			// An updateCells with a range and no rows clears every cell in the range, here the whole tab
+			Writer.BeginObject();
+			Writer.BeginObject("updateCells");
+			Writer.BeginObject("range");
+			Writer.WriteNumberField("sheetId", SheetId);
+			Writer.EndObject();
+			Writer.WriteStringField("fields", "userEnteredValue");
+			Writer.EndObject();
+			Writer.EndObject();
+		}
+		else
+		{
+			TMap<FString, int32> SheetRowsByKey;
+			SheetRowsByKey.Reserve(SheetRowKeys.Num());
+			for (int32 Index = 0; Index < SheetRowKeys.Num(); Index++)
+			{
+				SheetRowsByKey.Add(SheetRowKeys[Index], Index + 1);
+			}
+
+			// Changed rows first, while every row is still where we left it
+			for (const FExportedRow& Row : Rows)
+			{
+				if (Row.State != ERowState::Changed)
+				{
+					continue;
+				}
+
+				Writer.BeginObject();
+				Writer.BeginObject("updateCells");
+				{
+					Writer.BeginObject("start");
+					Writer.WriteNumberField("sheetId", SheetId);
+					Writer.WriteNumberField("rowIndex", SheetRowsByKey.FindChecked(Row.Key));
+					Writer.WriteNumberField("columnIndex", 0);
+					Writer.EndObject();
+
+					Writer.BeginArray("rows");
+					WriteRowData(Writer, SplitRowString(Row.RowString));
+					Writer.EndArray();
+
+					Writer.WriteStringField("fields", "userEnteredValue");
+				}
+				Writer.EndObject();
+				Writer.EndObject();
+			}
+
+			// Bottom up, so each deletion leaves the rows of the next one where they were. Adjacent rows go in one request.
+			for (int32 Index = DeletedSheetRows.Num() - 1; Index >= 0;)
+			{
+				const int32 EndRow = DeletedSheetRows[Index] + 1;
+				int32 StartRow = DeletedSheetRows[Index];
+				for (Index--; Index >= 0 && DeletedSheetRows[Index] == StartRow - 1; Index--)
+				{
+					StartRow--;
+				}
+				WriteDeleteRowsRequest(Writer, SheetId, StartRow, EndRow);
+			}
+		}
+
+		// appendCells goes after the last row with data and grows the grid as needed
+		const bool bHasRowsToAppend = bFullExport || Rows.ContainsByPredicate([](const FExportedRow& Row) { return Row.State == ERowState::Added; });
+		if (bHasRowsToAppend)
+		{
+			Writer.BeginObject();
+			Writer.BeginObject("appendCells");
+			{
+				Writer.WriteNumberField("sheetId", SheetId);
+
+				Writer.BeginArray("rows");
+				if (bFullExport)
+				{
+					WriteRowData(Writer, SplitRowString(NewHeaderRow));
+				}
+				for (const FExportedRow& Row : Rows)
+				{
+					if (Row.State == ERowState::Added)
+					{
+						WriteRowData(Writer, SplitRowString(Row.RowString));
+					}
+				}
+				Writer.EndArray();
+
+				Writer.WriteStringField("fields", "userEnteredValue");
+			}
+			Writer.EndObject();
+			Writer.EndObject();
+		}
+
+		Writer.EndArray();
+		Writer.EndObject();
+
+		OutBatchUpdatePayload = Writer.GetPayloadAsString();
+	}
+
+	// The sheet now holds the surviving rows in their old order, then the new ones
+	if (bFullExport)
+	{
+		SheetRowKeys.Reset(Rows.Num());
+	}
+	else
+	{
+		SheetRowKeys.RemoveAll([&ExportedKeys](const FString& Key) { return !ExportedKeys.Contains(Key); });
+	}
+
+	RowHashes.Reset();
+	for (const FExportedRow& Row : Rows)
+	{
+		if (Row.State == ERowState::Added)
+		{
+			SheetRowKeys.Add(Row.Key);
+		}
+		RowHashes.Add(Row.Key, Row.Hash);
+	}
+
+	HeaderRow = NewHeaderRow;
+	bHasExported = true;
+
+	FRuntimeDataTableStats::RecordStage(TEXT("DeltaExport"), NAME_None, FPlatformTime::Seconds() - StartTime, OutCsv.Len(), NumChangedRows);
+
+	FRuntimeDataTableModule::Print(FString::Printf(TEXT("%hs: %i rows added or changed, %i removed%s"),
+		__FUNCTION__, NumChangedRows, OutDeletedKeys.Num(), bFullExport ? TEXT(" (full export)") : TEXT("")));
+
+	return bHasChanges;
+}
+
+void URuntimeDataTableDeltaExporter::Reset()
+{
+	bHasExported = false;
+	HeaderRow.Reset();
+	SheetRowKeys.Reset();
+	RowHashes.Reset();
+}
@@ -0,0 +1,186 @@
+// Copyright Jared Therriault 2019, 2022
+
+#include "RuntimeDataTableJsonPayloadWriter.h"
+
+void FRuntimeDataTableJsonPayloadWriter::BeginObject()
+{
+	WriteSeparator();
+	Payload.Add('{');
+	ScopeHasValue.Add(false);
+}
+
+void FRuntimeDataTableJsonPayloadWriter::BeginObject(const ANSICHAR* InKey)
+{
+	WriteKey(InKey);
+	BeginObject();
+}
+
+void FRuntimeDataTableJsonPayloadWriter::EndObject()
+{
+	check(ScopeHasValue.Num() > 0);
+	ScopeHasValue.Pop(false);
+	Payload.Add('}');
+}
+
+void FRuntimeDataTableJsonPayloadWriter::BeginArray()
+{
+	WriteSeparator();
+	Payload.Add('[');
+	ScopeHasValue.Add(false);
+}
+
+void FRuntimeDataTableJsonPayloadWriter::BeginArray(const ANSICHAR* InKey)
+{
+	WriteKey(InKey);
+	BeginArray();
+}
+
+void FRuntimeDataTableJsonPayloadWriter::EndArray()
+{
+	check(ScopeHasValue.Num() > 0);
+	ScopeHasValue.Pop(false);
+	Payload.Add(']');
+}
+
+void FRuntimeDataTableJsonPayloadWriter::WriteKey(const ANSICHAR* InKey)
+{
+	WriteSeparator();
+	Payload.Add('"');
+	WriteAnsi(InKey);
+	Payload.Add('"');
+	Payload.Add(':');
+	bAwaitingValue = true;
+}
+
+void FRuntimeDataTableJsonPayloadWriter::WriteStringValue(const FString& InValue)
+{
+	WriteSeparator();
+	Payload.Add('"');
+	WriteEscapedString(InValue);
+	Payload.Add('"');
+}
+
+void FRuntimeDataTableJsonPayloadWriter::WriteStringField(const ANSICHAR* InKey, const FString& InValue)
+{
+	WriteKey(InKey);
+	WriteStringValue(InValue);
+}
+
+void FRuntimeDataTableJsonPayloadWriter::WriteNumberValue(const int64 InValue)
+{
+	WriteSeparator();
+
+	ANSICHAR Buffer[24];
+	FCStringAnsi::Snprintf(Buffer, UE_ARRAY_COUNT(Buffer), "%lld", (long long)InValue);
+	WriteAnsi(Buffer);
+}
+
+void FRuntimeDataTableJsonPayloadWriter::WriteNumberField(const ANSICHAR* InKey, const int64 InValue)
+{
+	WriteKey(InKey);
+	WriteNumberValue(InValue);
+}
+
+FString FRuntimeDataTableJsonPayloadWriter::GetPayloadAsString() const
+{
+	const FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(Payload.GetData()), Payload.Num());
+	return FString(Converted.Length(), Converted.Get());
+}
+
+void FRuntimeDataTableJsonPayloadWriter::WriteSeparator()
+{
+	if (bAwaitingValue)
+	{
+		bAwaitingValue = false;
+		return;
+	}
+
+	if (ScopeHasValue.Num() > 0)
+	{
+		if (ScopeHasValue.Last())
+		{
+			Payload.Add(',');
+		}
+		ScopeHasValue.Last() = true;
+	}
+}
+
+void FRuntimeDataTableJsonPayloadWriter::WriteAnsi(const ANSICHAR* InString)
+{
+	Payload.Append(reinterpret_cast<const uint8*>(InString), FCStringAnsi::Strlen(InString));
+}
+
+void FRuntimeDataTableJsonPayloadWriter::WriteEscapedString(const FString& InValue)
+{
+	static const ANSICHAR* HexDigits = "0123456789abcdef";
+
+	const TCHAR* Chars = *InValue;
+	const int32 Length = InValue.Len();
+
+	// Most cells are plain ASCII, so assume one byte per character
+	Payload.Reserve(Payload.Num() + Length);
+
+	for (int32 CharIndex = 0; CharIndex < Length; CharIndex++)
+	{
+		uint32 CodePoint = static_cast<uint32>(Chars[CharIndex]);
+
+		// Where TCHAR is UTF-16, characters outside the BMP arrive as surrogate pairs
+		if (CodePoint >= 0xD800 && CodePoint <= 0xDFFF)
+		{
+			const uint32 NextChar = CharIndex + 1 < Length ? static_cast<uint32>(Chars[CharIndex + 1]) : 0;
+			if (CodePoint <= 0xDBFF && NextChar >= 0xDC00 && NextChar <= 0xDFFF)
+			{
+				CodePoint = 0x10000 + ((CodePoint - 0xD800) << 10) + (NextChar - 0xDC00);
+				CharIndex++;
+			}
+			else
+			{
+				// Lone surrogates can't be encoded, use the replacement character
+				CodePoint = 0xFFFD;
+			}
+		}
+
+		if (CodePoint < 0x80)
+		{
+			switch (CodePoint)
+			{
+			case '"': Payload.Add('\\'); Payload.Add('"'); break;
+			case '\\': Payload.Add('\\'); Payload.Add('\\'); break;
+			case '\n': Payload.Add('\\'); Payload.Add('n'); break;
+			case '\r': Payload.Add('\\'); Payload.Add('r'); break;
+			case '\t': Payload.Add('\\'); Payload.Add('t'); break;
+			case '\b': Payload.Add('\\'); Payload.Add('b'); break;
+			case '\f': Payload.Add('\\'); Payload.Add('f'); break;
+			default:
+				if (CodePoint < 0x20)
+				{
+					const uint8 Escape[] = { '\\', 'u', '0', '0', (uint8)HexDigits[CodePoint >> 4], (uint8)HexDigits[CodePoint & 0xF] };
+					Payload.Append(Escape, UE_ARRAY_COUNT(Escape));
+				}
+				else
+				{
+					Payload.Add(static_cast<uint8>(CodePoint));
+				}
+				break;
+			}
+		}
+		else if (CodePoint < 0x800)
+		{
+			Payload.Add(static_cast<uint8>(0xC0 | (CodePoint >> 6)));
+			Payload.Add(static_cast<uint8>(0x80 | (CodePoint & 0x3F)));
+		}
+		else if (CodePoint < 0x10000)
+		{
+			Payload.Add(static_cast<uint8>(0xE0 | (CodePoint >> 12)));
+			Payload.Add(static_cast<uint8>(0x80 | ((CodePoint >> 6) & 0x3F)));
+			Payload.Add(static_cast<uint8>(0x80 | (CodePoint & 0x3F)));
+		}
+		else
+		{
+			Payload.Add(static_cast<uint8>(0xF0 | (CodePoint >> 18)));
+			Payload.Add(static_cast<uint8>(0x80 | ((CodePoint >> 12) & 0x3F)));
+			Payload.Add(static_cast<uint8>(0x80 | ((CodePoint >> 6) & 0x3F)));
+			Payload.Add(static_cast<uint8>(0x80 | (CodePoint & 0x3F)));
+		}
+	}
+}
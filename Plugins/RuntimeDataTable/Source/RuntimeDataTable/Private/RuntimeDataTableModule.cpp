@@ -2,12 +2,19 @@
 
 #include "RuntimeDataTableModule.h"
 
+#include "RuntimeDataTablePrefetchCache.h"
+#include "RuntimeDataTablePropertyPath.h"
 #include "RuntimeDataTableProjectSettings.h"
+#include "RuntimeDataTableRequestCoalescer.h"
+#include "RuntimeDataTableRequestScheduler.h"
+#include "RuntimeDataTableSheetPoller.h"
+#include "RuntimeDataTableTokenManager.h"
 
 #include "Misc/CoreDelegates.h"
 #include "UnrealEngine.h"
 #include "Developer/Settings/Public/ISettingsModule.h"
 #include "Modules/ModuleManager.h"
+#include "UObject/UObjectGlobals.h"
 
 IMPLEMENT_MODULE(FRuntimeDataTableModule, RuntimeDataTable);
 
@@ -16,10 +23,25 @@ void FRuntimeDataTableModule::StartupModule()
 	UE_LOG(LogRuntimeDataTable, Log, TEXT("Module Startup"));
 
 	FCoreDelegates::OnFEngineLoopInitComplete.AddRaw(this, &FRuntimeDataTableModule::OnFEngineLoopInitComplete);
+
+	// Reloaded structs can change layout in place, so any property or offset cached for them has to go
+	ReloadCompleteHandle = FCoreUObjectDelegates::ReloadCompleteDelegate.AddLambda([](EReloadCompleteReason)
+	{
+		FRuntimeDataTablePropertyPath::ResetCache();
+	});
 }
 
 void FRuntimeDataTableModule::ShutdownModule()
 {	
+	FCoreUObjectDelegates::ReloadCompleteDelegate.Remove(ReloadCompleteHandle);
+	FRuntimeDataTablePropertyPath::ResetCache();
+
+	URuntimeDataTableSheetPoller::UnsubscribeAll();
+	FRuntimeDataTablePrefetchCache::Get().Reset();
+	FRuntimeDataTableRequestScheduler::Get().Reset();
+	FRuntimeDataTableRequestCoalescer::Get().Reset();
+	FRuntimeDataTableTokenManager::Get().Reset();
+	
 	UnregisterProjectSettings();
 	
 	UE_LOG(LogRuntimeDataTable, Log, TEXT("Module Shutdown"));
@@ -111,6 +133,9 @@ void FRuntimeDataTableModule::Print(FString InMessage, const ELogType InLogType)
 void FRuntimeDataTableModule::OnFEngineLoopInitComplete()
 {
 	RegisterProjectSettings();
+
+	// HTTP and the engine subsystems the downloads rely on aren't up before now
+	FRuntimeDataTablePrefetchCache::Get().StartPrefetch();
 }
 
 void FRuntimeDataTableModule::PrintToLog(const FString& LogMessage)
@@ -0,0 +1,129 @@
+// Copyright Jared Therriault 2019, 2022
+
+#include "RuntimeDataTableOperationSubsystem.h"
+
+#include "RuntimeDataTable.h"
+#include "RuntimeDataTableModule.h"
+#include "RuntimeDataTableRequestScheduler.h"
+#include "RuntimeDataTableStats.h"
+
+#include "Engine/Engine.h"
+
+URuntimeDataTableOperationSubsystem* URuntimeDataTableOperationSubsystem::Get()
+{
+	return GEngine ? GEngine->GetEngineSubsystem<URuntimeDataTableOperationSubsystem>() : nullptr;
+}
+
+void URuntimeDataTableOperationSubsystem::Deinitialize()
+{
+	CancelAllOperations();
+
+	ActiveOperations.Empty();
+	ActiveOperationObjects.Empty();
+
+	Super::Deinitialize();
+}
+
+void URuntimeDataTableOperationSubsystem::BeginOperation(URuntimeDataTableObject* InOperationObject, const FName InOperationName)
+{
+	if (!InOperationObject || ActiveOperations.Contains(InOperationObject))
+	{
+		return;
+	}
+
+	ActiveOperationObjects.Add(InOperationObject);
+
+	FActiveOperation& Operation = ActiveOperations.Add(InOperationObject);
+	Operation.OperationName = InOperationName;
+	Operation.StartTime = FPlatformTime::Seconds();
+
+	SET_DWORD_STAT(STAT_RuntimeDataTable_ActiveOperations, ActiveOperations.Num());
+}
+
+void URuntimeDataTableOperationSubsystem::EndOperation(URuntimeDataTableObject* InOperationObject)
+{
+	FActiveOperation Operation;
+	if (ActiveOperations.RemoveAndCopyValue(InOperationObject, Operation))
+	{
+		FRuntimeDataTableStats::RecordStage(TEXT("Operation"), Operation.OperationName, FPlatformTime::Seconds() - Operation.StartTime);
+	}
+	ActiveOperationObjects.Remove(InOperationObject);
+
+	SET_DWORD_STAT(STAT_RuntimeDataTable_ActiveOperations, ActiveOperations.Num());
+}
+
+void URuntimeDataTableOperationSubsystem::ProcessRequest(
+	URuntimeDataTableObject* InOperationObject, const TSharedRef<IHttpRequest, ESPMode::ThreadSafe>& InRequest,
+	const bool bIsIdempotent)
+{
+	if (FActiveOperation* Operation = ActiveOperations.Find(InOperationObject))
+	{
+		if (Operation->bCancelled)
+		{
+			FRuntimeDataTableModule::Print(FString::Printf(
+				TEXT("%hs: Operation %s was cancelled, not sending %s"), __FUNCTION__, *Operation->OperationName.ToString(), *InRequest->GetURL()),
+				FRuntimeDataTableModule::ELogType::Warning);
+			InRequest->OnProcessRequestComplete().ExecuteIfBound(InRequest, nullptr, false);
+			return;
+		}
+
+		Operation->Requests.RemoveAll([](const TWeakPtr<IHttpRequest, ESPMode::ThreadSafe>& Request)
+		{
+			return !Request.IsValid();
+		});
+		Operation->Requests.Add(InRequest);
+	}
+
+	FRuntimeDataTableRequestScheduler::Get().ProcessRequest(InRequest, bIsIdempotent);
+}
+
+int32 URuntimeDataTableOperationSubsystem::CancelOperation(const FName InOperationName)
+{
+	TArray<URuntimeDataTableObject*> OperationObjects;
+	for (const TPair<URuntimeDataTableObject*, FActiveOperation>& Pair : ActiveOperations)
+	{
+		if (Pair.Value.OperationName == InOperationName && !Pair.Value.bCancelled)
+		{
+			OperationObjects.Add(Pair.Key);
+		}
+	}
+
+	FRuntimeDataTableModule::Print(FString::Printf(
+		TEXT("%hs: Cancelling %i operations named %s"), __FUNCTION__, OperationObjects.Num(), *InOperationName.ToString()));
+
+	CancelOperations(OperationObjects);
+	return OperationObjects.Num();
+}
+
+void URuntimeDataTableOperationSubsystem::CancelAllOperations()
+{
+	TArray<URuntimeDataTableObject*> OperationObjects;
+	ActiveOperations.GenerateKeyArray(OperationObjects);
+
+	CancelOperations(OperationObjects);
+}
+
+void URuntimeDataTableOperationSubsystem::CancelOperations(const TArray<URuntimeDataTableObject*>& InOperationObjects)
+{
+	for (URuntimeDataTableObject* OperationObject : InOperationObjects)
+	{
+		// Cancelling an earlier one may have called back into something that ended this one
+		FActiveOperation* Operation = ActiveOperations.Find(OperationObject);
+		if (!Operation)
+		{
+			continue;
+		}
+
+		Operation->bCancelled = true;
+
+		// Copied because each cancelled request calls back into its operation, which may end it
+		const TArray<TWeakPtr<IHttpRequest, ESPMode::ThreadSafe>> Requests = Operation->Requests;
+		for (const TWeakPtr<IHttpRequest, ESPMode::ThreadSafe>& WeakRequest : Requests)
+		{
+			if (const TSharedPtr<IHttpRequest, ESPMode::ThreadSafe> Request = WeakRequest.Pin())
+			{
+				FRuntimeDataTableRequestScheduler::Get().CancelRequest(Request.ToSharedRef());
+			}
+		}
+	}
+}
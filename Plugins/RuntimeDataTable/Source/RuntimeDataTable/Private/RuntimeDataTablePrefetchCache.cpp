@@ -0,0 +1,293 @@
+// Copyright Jared Therriault 2019, 2022
+
+#include "RuntimeDataTablePrefetchCache.h"
+
+#include "RuntimeDataTableModule.h"
+#include "RuntimeDataTableProjectSettings.h"
+#include "RuntimeDataTableStats.h"
+
+#include "Async/Async.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+
+const FName FRuntimeDataTablePrefetchCache::OperationName = "RuntimeDataTable.Prefetch";
+
+FRuntimeDataTablePrefetchCache& FRuntimeDataTablePrefetchCache::Get()
+{
+	static FRuntimeDataTablePrefetchCache Instance;
+	return Instance;
+}
+
+void FRuntimeDataTablePrefetchCache::StartPrefetch()
+{
+	const URuntimeDataTableProjectSettings* Settings = GetDefault<URuntimeDataTableProjectSettings>();
+	if (!Settings || Settings->PrefetchManifest.Num() == 0 || IsRunningCommandlet())
+	{
+		return;
+	}
+
+	UEasyCsv::FileCacheLookup.BindLambda([](const FString& InPath, FEasyCsvInfo& OutCsvInfo, bool ParseHeaders, bool ParseKeys)
+	{
+		return Get().Find(MakeFileKey(InPath), ParseHeaders, ParseKeys, OutCsvInfo);
+	});
+
+	TArray<FRuntimeDataTablePrefetchSource> Sources = Settings->PrefetchManifest;
+	Sources.StableSort([](const FRuntimeDataTablePrefetchSource& A, const FRuntimeDataTablePrefetchSource& B)
+	{
+		return A.Priority > B.Priority;
+	});
+
+	for (const FRuntimeDataTablePrefetchSource& Source : Sources)
+	{
+		const FString SourcePath = Source.Source.TrimStartAndEnd();
+		if (SourcePath.IsEmpty())
+		{
+			continue;
+		}
+
+		const bool bIsSheet = SourcePath.StartsWith("http://") || SourcePath.StartsWith("https://");
+		const FString Key = bIsSheet ? MakeSheetKey(SourcePath) : MakeFileKey(SourcePath);
+
+		{
+			FScopeLock Lock(&CacheCriticalSection);
+
+			if (Entries.Contains(Key))
+			{
+				continue;
+			}
+
+			FEntry& Entry = Entries.Add(Key);
+			Entry.bParseHeaders = Source.bParseHeaders;
+			Entry.bParseKeys = Source.bParseKeys;
+		}
+
+		if (!bIsSheet)
+		{
+			const FString FullPath = FPaths::ConvertRelativePathToFull(FPaths::ProjectDir(), SourcePath);
+			const bool bParseHeaders = Source.bParseHeaders;
+			const bool bParseKeys = Source.bParseKeys;
+
+			// The thread pool takes them in the order they were queued, so priority still holds
+			Async(EAsyncExecution::ThreadPool, [Key, FullPath, bParseHeaders, bParseKeys]()
+			{
+				TRACE_CPUPROFILER_EVENT_SCOPE(FRuntimeDataTablePrefetchCache::PrefetchFile);
+
+				const double StartTime = FPlatformTime::Seconds();
+
+				FString Csv;
+				FEasyCsvInfo CsvInfo;
+				const bool bLoaded = UEasyCsv::LoadStringFromLocalFile(FullPath, Csv) &&
+					UEasyCsv::MakeCsvInfoStructFromString(Csv, CsvInfo, bParseHeaders, bParseKeys);
+
+				if (!bLoaded)
+				{
+					UE_LOG(LogRuntimeDataTable, Warning, TEXT("FRuntimeDataTablePrefetchCache: Could not prefetch %s"), *FullPath);
+				}
+
+				FRuntimeDataTableStats::RecordStage(
+					TEXT("Prefetch"), OperationName, FPlatformTime::Seconds() - StartTime, Csv.Len(), CsvInfo.CSV_Keys.Num());
+
+				Get().Complete(Key, bLoaded, MoveTemp(CsvInfo));
+			});
+			continue;
+		}
+
+		FRuntimeDataTableTokenInfo TokenInfo;
+		if (!Source.bSheetIsPublic)
+		{
+			const FString KeyFile = FPaths::ConvertRelativePathToFull(FPaths::ProjectDir(), Source.ServiceAccountKeyFile);
+			if (!URuntimeDataTableObject::GenerateTokenInfoFromFile(TokenInfo, KeyFile))
+			{
+				FRuntimeDataTableModule::Print(FString::Printf(
+					TEXT("%hs: Could not read the service account key file %s for %s"), __FUNCTION__, *KeyFile, *SourcePath),
+					FRuntimeDataTableModule::ELogType::Error);
+				Complete(Key, false, FEasyCsvInfo());
+				continue;
+			}
+		}
+
+		// The scheduler sends requests in the order they were made, so priority holds here too
+		URuntimeDataTablePrefetcher* Prefetcher = NewObject<URuntimeDataTablePrefetcher>();
+		Prefetcher->Start(Key, SourcePath, TokenInfo, Source.bSheetIsPublic, Source.bParseHeaders, Source.bParseKeys);
+	}
+}
+
+void FRuntimeDataTablePrefetchCache::Reset()
+{
+	UEasyCsv::FileCacheLookup.Unbind();
+
+	// Waiters are dropped rather than called. Being told there's nothing cached sends them off to download it
+	// themselves, which is the last thing anyone wants while the module is shutting down.
+	FScopeLock Lock(&CacheCriticalSection);
+	Entries.Empty();
+}
+
+FString FRuntimeDataTablePrefetchCache::MakeSheetKey(const FString& InSheetURL)
+{
+	// Edit links, share links and export links to the same tab all end up here
+	const FString SheetId = URuntimeDataTableObject::GetSheetIdFromUrl(InSheetURL);
+	return "Sheet:" + URuntimeDataTableObject::GetSpreadsheetIdFromUrl(InSheetURL) + "#" + (SheetId.IsEmpty() ? FString("0") : SheetId);
+}
+
+FString FRuntimeDataTablePrefetchCache::MakeFileKey(const FString& InPath)
+{
+	FString FullPath = FPaths::ConvertRelativePathToFull(FPaths::ProjectDir(), InPath);
+	FPaths::NormalizeFilename(FullPath);
+	return "File:" + FullPath;
+}
+
+bool FRuntimeDataTablePrefetchCache::FindOrWait(
+	const FString& InKey, const bool bParseHeaders, const bool bParseKeys, TFunction<void(const FEasyCsvInfo*)>&& OnReady)
+{
+	FEasyCsvInfo CsvInfo;
+	{
+		FScopeLock Lock(&CacheCriticalSection);
+
+		FEntry* Entry = Entries.Find(InKey);
+		if (!Entry || Entry->bParseHeaders != bParseHeaders || Entry->bParseKeys != bParseKeys)
+		{
+			return false;
+		}
+
+		if (Entry->bPending)
+		{
+			Entry->Waiters.Add(MoveTemp(OnReady));
+			return true;
+		}
+
+		if (IsExpired(*Entry))
+		{
+			Entries.Remove(InKey);
+			return false;
+		}
+
+		CsvInfo = Entry->CsvInfo;
+	}
+
+	// Answered on a later tick, the same as a download would be, so callers never see their callback run before this returns
+	AsyncTask(ENamedThreads::GameThread, [OnReady = MoveTemp(OnReady), CsvInfo = MoveTemp(CsvInfo)]()
+	{
+		OnReady(&CsvInfo);
+	});
+	return true;
+}
+
+bool FRuntimeDataTablePrefetchCache::Find(const FString& InKey, const bool bParseHeaders, const bool bParseKeys, FEasyCsvInfo& OutCsvInfo)
+{
+	FScopeLock Lock(&CacheCriticalSection);
+
+	const FEntry* Entry = Entries.Find(InKey);
+	if (!Entry || Entry->bPending || Entry->bParseHeaders != bParseHeaders || Entry->bParseKeys != bParseKeys)
+	{
+		return false;
+	}
+
+	if (IsExpired(*Entry))
+	{
+		Entries.Remove(InKey);
+		return false;
+	}
+
+	OutCsvInfo = Entry->CsvInfo;
+	return true;
+}
+
+void FRuntimeDataTablePrefetchCache::Complete(const FString& InKey, const bool bWasSuccessful, FEasyCsvInfo&& InCsvInfo)
+{
+	TArray<TFunction<void(const FEasyCsvInfo*)>> Waiters;
+	{
+		FScopeLock Lock(&CacheCriticalSection);
+
+		FEntry* Entry = Entries.Find(InKey);
+		if (!Entry)
+		{
+			return;
+		}
+
+		Waiters = MoveTemp(Entry->Waiters);
+
+		if (bWasSuccessful)
+		{
+			Entry->bPending = false;
+			Entry->CsvInfo = MoveTemp(InCsvInfo);
+			Entry->CompletedTime = FPlatformTime::Seconds();
+		}
+		else
+		{
+			// Everyone goes back to downloading it themselves
+			Entries.Remove(InKey);
+		}
+	}
+
+	if (Waiters.Num() == 0)
+	{
+		return;
+	}
+
+	// Waiters are download callbacks, which expect the game thread
+	AsyncTask(ENamedThreads::GameThread, [Waiters = MoveTemp(Waiters), InKey]()
+	{
+		FEasyCsvInfo CsvInfo;
+		bool bFound = false;
+		{
+			FRuntimeDataTablePrefetchCache& Cache = Get();
+			FScopeLock Lock(&Cache.CacheCriticalSection);
+
+			if (const FEntry* Entry = Cache.Entries.Find(InKey))
+			{
+				CsvInfo = Entry->CsvInfo;
+				bFound = true;
+			}
+		}
+
+		for (const TFunction<void(const FEasyCsvInfo*)>& Waiter : Waiters)
+		{
+			Waiter(bFound ? &CsvInfo : nullptr);
+		}
+	});
+}
+
+bool FRuntimeDataTablePrefetchCache::IsExpired(const FEntry& InEntry) const
+{
+	const URuntimeDataTableProjectSettings* Settings = GetDefault<URuntimeDataTableProjectSettings>();
+	const float Lifetime = Settings ? Settings->PrefetchCacheLifetimeSeconds : 0.f;
+
+	return Lifetime > 0.f && FPlatformTime::Seconds() - InEntry.CompletedTime > Lifetime;
+}
+
+void URuntimeDataTablePrefetcher::Start(
+	const FString& InCacheKey, const FString& InSheetURL, const FRuntimeDataTableTokenInfo& InTokenInfo,
+	const bool bSheetIsPublic, const bool bParseHeaders, const bool bParseKeys)
+{
+	AddToRoot();
+
+	CacheKey = InCacheKey;
+	StartTime = FPlatformTime::Seconds();
+
+	FRuntimeDataTableOperationParams OperationParams;
+	OperationParams.OperationName = FRuntimeDataTablePrefetchCache::OperationName;
+	OperationParams.bUsePrefetchCache = false;
+
+	FRDTGetCsvInfoDelegate OnDownloaded;
+	OnDownloaded.BindUFunction(this, GET_FUNCTION_NAME_CHECKED(URuntimeDataTablePrefetcher, OnSheetDownloaded));
+
+	URuntimeDataTableObject::DownloadSheetAsCsvInfo(
+		InTokenInfo, OperationParams, OnDownloaded, InSheetURL, bSheetIsPublic, bParseHeaders, bParseKeys);
+}
+
+void URuntimeDataTablePrefetcher::OnSheetDownloaded(FRuntimeDataTableCallbackInfo CallbackInfo, const FEasyCsvInfo& CsvInfo)
+{
+	FRuntimeDataTableStats::RecordStage(
+		TEXT("Prefetch"), CallbackInfo.OperationName, FPlatformTime::Seconds() - StartTime, 0, CsvInfo.CSV_Keys.Num());
+
+	if (!CallbackInfo.bWasSuccessful)
+	{
+		FRuntimeDataTableModule::Print(FString::Printf(
+			TEXT("%hs: Could not prefetch %s: %s"), __FUNCTION__, *CacheKey, *CallbackInfo.ResponseAsString),
+			FRuntimeDataTableModule::ELogType::Warning);
+	}
+
+	FRuntimeDataTablePrefetchCache::Get().Complete(CacheKey, CallbackInfo.bWasSuccessful, FEasyCsvInfo(CsvInfo));
+
+	RemoveFromRoot();
+}
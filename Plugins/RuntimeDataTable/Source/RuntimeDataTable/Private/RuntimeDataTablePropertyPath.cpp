@@ -0,0 +1,287 @@
+// Copyright Jared Therriault 2019, 2022
+
+#include "RuntimeDataTablePropertyPath.h"
+
+#include "RuntimeDataTable.h"
+
+#include "Engine/UserDefinedStruct.h"
+#include "Runtime/Launch/Resources/Version.h"
+#include "UObject/PropertyPortFlags.h"
+
+// Everything worked out about one struct's columns
+struct FRuntimeDataTableCompiledPaths
+{
+	TWeakObjectPtr<const UStruct> Struct;
+	TSharedPtr<const TArray<FRuntimeDataTablePropertyPath>> Paths;
+
+	// The last headers MapColumns was asked about, the same sheet tends to be applied to the same table over and over
+	TArray<FString> MappedHeaders;
+	TArray<FRuntimeDataTablePropertyPath> MappedColumns;
+	bool bHasMappedColumns = false;
+};
+
+// Game thread only
+static TMap<const UStruct*, FRuntimeDataTableCompiledPaths> CompiledPathCache;
+
+static void CompileMembers(
+	const UStruct* Struct, const FString& Prefix, const FString& RootName, const int32 BaseOffset,
+	TArray<FRuntimeDataTablePropertyPath>& OutPaths)
+{
+	for (TFieldIterator<FProperty> It(Struct); It; ++It)
+	{
+		const FProperty* Property = *It;
+		if (!URuntimeDataTableObject::IsPropertyDataTableSupported(Property))
+		{
+			continue;
+		}
+
+		const FString MemberName = Property->GetAuthoredName().TrimStartAndEnd();
+
+		// Never assume ArrayDim is always 1
+		for (int32 ArrayIndex = 0; ArrayIndex < Property->ArrayDim; ArrayIndex++)
+		{
+			FString ColumnName = Prefix + MemberName;
+			if (Property->ArrayDim > 1)
+			{
+				ColumnName += FString::Printf(TEXT("[%i]"), ArrayIndex);
+			}
+
+			const int32 Offset = BaseOffset + Property->GetOffset_ForInternal() + ArrayIndex * Property->ElementSize;
+
+			if (FRuntimeDataTablePropertyPath::ShouldFlatten(Property))
+			{
+				CompileMembers(
+					CastFieldChecked<FStructProperty>(Property)->Struct, ColumnName + ".",
+					Prefix.IsEmpty() ? MemberName : RootName, Offset, OutPaths);
+				continue;
+			}
+
+			FRuntimeDataTablePropertyPath& Path = OutPaths.AddDefaulted_GetRef();
+			Path.ColumnName = MoveTemp(ColumnName);
+			Path.RootName = Prefix.IsEmpty() ? MemberName : RootName;
+			Path.Leaf = Property;
+			Path.Offset = Offset;
+		}
+	}
+}
+
+FString FRuntimeDataTablePropertyPath::ExportValue(const void* Container, UObject* OwningObject) const
+{
+	const void* ValuePtr = GetValuePtr(Container);
+
+	if (const FBoolProperty* BoolProperty = CastField<FBoolProperty>(Leaf))
+	{
+		return BoolProperty->GetPropertyValue(ValuePtr) ? TEXT("True") : TEXT("False");
+	}
+
+	if (const FNumericProperty* NumericProperty = CastField<FNumericProperty>(Leaf))
+	{
+		// Enum bytes export as the enumerator's name
+		if (!NumericProperty->IsEnum())
+		{
+			return NumericProperty->GetNumericPropertyValueToString(ValuePtr);
+		}
+	}
+	else if (Leaf->IsA<FStrProperty>())
+	{
+		return *static_cast<const FString*>(ValuePtr);
+	}
+	else if (Leaf->IsA<FNameProperty>())
+	{
+		return static_cast<const FName*>(ValuePtr)->ToString();
+	}
+	else if (const FObjectProperty* ObjectProperty = CastField<FObjectProperty>(Leaf))
+	{
+		// Exporting hard references as text can crash, the path is all an import needs anyway.
+		// Soft, weak and lazy references don't load anything to export, so they go through ExportText below.
+		const UObject* Object = ObjectProperty->GetObjectPropertyValue(ValuePtr);
+		return Object ? Object->GetPathName() : TEXT("None");
+	}
+
+	FString AsString;
+	Leaf->ExportText_Direct(AsString, ValuePtr, ValuePtr, OwningObject, PPF_None);
+	return AsString;
+}
+
+bool FRuntimeDataTablePropertyPath::ImportValue(const FString& ValueAsString, void* Container, UObject* OwningObject) const
+{
+	void* ValuePtr = GetValuePtr(Container);
+
+	if (const FBoolProperty* BoolProperty = CastField<FBoolProperty>(Leaf))
+	{
+		BoolProperty->SetPropertyValue(ValuePtr, FCString::ToBool(*ValueAsString));
+		return true;
+	}
+
+	if (const FNumericProperty* NumericProperty = CastField<FNumericProperty>(Leaf))
+	{
+		if (!NumericProperty->IsEnum())
+		{
+			// SetNumericPropertyValueFromString writes 0 for anything it can't read, so check first
+			const FString Trimmed = ValueAsString.TrimStartAndEnd();
+			if (!Trimmed.IsNumeric())
+			{
+				return false;
+			}
+
+			NumericProperty->SetNumericPropertyValueFromString(ValuePtr, *Trimmed);
+			return true;
+		}
+	}
+	else if (Leaf->IsA<FStrProperty>())
+	{
+		*static_cast<FString*>(ValuePtr) = ValueAsString;
+		return true;
+	}
+	else if (Leaf->IsA<FNameProperty>())
+	{
+		*static_cast<FName*>(ValuePtr) = FName(*ValueAsString);
+		return true;
+	}
+
+#if ENGINE_MAJOR_VERSION >= 5 && ENGINE_MINOR_VERSION >= 1
+	return Leaf->ImportText_Direct(*ValueAsString, ValuePtr, OwningObject, PPF_None) != nullptr;
+#else
+	return Leaf->ImportText(*ValueAsString, ValuePtr, PPF_None, OwningObject) != nullptr;
+#endif
+}
+
+void FRuntimeDataTablePropertyPath::ResetValue(void* Container, const void* DefaultContainer) const
+{
+	Leaf->CopySingleValue(GetValuePtr(Container), GetValuePtr(DefaultContainer));
+}
+
+FRuntimeDataTablePropertyPath FRuntimeDataTablePropertyPath::MakeTopLevel(const FProperty* Property)
+{
+	FRuntimeDataTablePropertyPath Path;
+	Path.ColumnName = Property->GetAuthoredName().TrimStartAndEnd();
+	Path.RootName = Path.ColumnName;
+	Path.Leaf = Property;
+	Path.Offset = Property->GetOffset_ForInternal();
+	return Path;
+}
+
+static TSharedRef<const TArray<FRuntimeDataTablePropertyPath>> CompilePaths(const UStruct* InStruct)
+{
+	TSharedRef<TArray<FRuntimeDataTablePropertyPath>> Paths = MakeShared<TArray<FRuntimeDataTablePropertyPath>>();
+	CompileMembers(InStruct, FString(), FString(), 0, *Paths);
+	return Paths;
+}
+
+// InStruct's cache entry, compiled if it wasn't there. Null for structs whose layout can change under us.
+static FRuntimeDataTableCompiledPaths* FindOrAddCompiledPaths(const UStruct* InStruct)
+{
+#if WITH_EDITOR
+	// Blueprint structs and classes are recompiled in place in the editor, which would leave cached offsets pointing at the old layout
+	const UClass* AsClass = Cast<UClass>(InStruct);
+	if (InStruct->IsA<UUserDefinedStruct>() || (AsClass && !AsClass->HasAnyClassFlags(CLASS_Native)))
+	{
+		return nullptr;
+	}
+#endif
+
+	if (FRuntimeDataTableCompiledPaths* Cached = CompiledPathCache.Find(InStruct))
+	{
+		if (Cached->Struct.Get() == InStruct)
+		{
+			return Cached;
+		}
+	}
+
+	// Only ever a handful of row structs in use, this is just so it can't grow without bound
+	if (CompiledPathCache.Num() >= 64)
+	{
+		CompiledPathCache.Reset();
+	}
+
+	// Replaces what a destroyed struct at the same address left behind
+	FRuntimeDataTableCompiledPaths& Compiled = CompiledPathCache.Add(InStruct);
+	Compiled.Struct = InStruct;
+	Compiled.Paths = CompilePaths(InStruct);
+
+	return &Compiled;
+}
+
+TSharedRef<const TArray<FRuntimeDataTablePropertyPath>> FRuntimeDataTablePropertyPath::Compile(const UStruct* InStruct)
+{
+	if (const FRuntimeDataTableCompiledPaths* Compiled = FindOrAddCompiledPaths(InStruct))
+	{
+		return Compiled->Paths.ToSharedRef();
+	}
+	return CompilePaths(InStruct);
+}
+
+TArray<FRuntimeDataTablePropertyPath> FRuntimeDataTablePropertyPath::MapColumns(const UStruct* InStruct, const TArray<FString>& Headers)
+{
+	FRuntimeDataTableCompiledPaths* Compiled = FindOrAddCompiledPaths(InStruct);
+	if (Compiled && Compiled->bHasMappedColumns && Compiled->MappedHeaders == Headers)
+	{
+		return Compiled->MappedColumns;
+	}
+
+	const TSharedRef<const TArray<FRuntimeDataTablePropertyPath>> FlattenedPaths = Compiled ? Compiled->Paths.ToSharedRef() : CompilePaths(InStruct);
+
+	// Matched the same way as UpdateArrayFromCsvInfo with name matching on
+	TArray<FRuntimeDataTablePropertyPath> Columns;
+	Columns.Reserve(Headers.Num());
+	for (const FString& Header : Headers)
+	{
+		const FString ColumnName = Header.TrimStartAndEnd();
+
+		// Dotted columns from a flattened export go straight to the nested member
+		if (IsFlattenedColumnName(ColumnName))
+		{
+			const FRuntimeDataTablePropertyPath* FlattenedPath = FindByColumnName(*FlattenedPaths, ColumnName);
+			Columns.Add(FlattenedPath ? *FlattenedPath : FRuntimeDataTablePropertyPath());
+			continue;
+		}
+
+		FProperty* MatchingProperty = nullptr;
+		for (TFieldIterator<FProperty> It(InStruct); It; ++It)
+		{
+			if (It->GetAuthoredName().TrimStartAndEnd().Equals(ColumnName, ESearchCase::IgnoreCase) &&
+				URuntimeDataTableObject::IsPropertyDataTableSupported(*It))
+			{
+				MatchingProperty = *It;
+				break;
+			}
+		}
+		Columns.Add(MatchingProperty ? MakeTopLevel(MatchingProperty) : FRuntimeDataTablePropertyPath());
+	}
+
+	if (Compiled)
+	{
+		Compiled->MappedHeaders = Headers;
+		Compiled->MappedColumns = Columns;
+		Compiled->bHasMappedColumns = true;
+	}
+
+	return Columns;
+}
+
+void FRuntimeDataTablePropertyPath::ResetCache()
+{
+	CompiledPathCache.Reset();
+}
+
+const FRuntimeDataTablePropertyPath* FRuntimeDataTablePropertyPath::FindByColumnName(
+	const TArray<FRuntimeDataTablePropertyPath>& Paths, const FString& ColumnName)
+{
+	const FString TrimmedName = ColumnName.TrimStartAndEnd();
+	return Paths.FindByPredicate([&TrimmedName](const FRuntimeDataTablePropertyPath& Path)
+	{
+		return Path.ColumnName.Equals(TrimmedName, ESearchCase::IgnoreCase);
+	});
+}
+
+bool FRuntimeDataTablePropertyPath::ShouldFlatten(const FProperty* Property)
+{
+	const FStructProperty* StructProperty = CastField<FStructProperty>(Property);
+	if (!StructProperty || !StructProperty->Struct || !StructProperty->Struct->PropertyLink)
+	{
+		return false;
+	}
+
+	// These have a text format designers already know, and their members often aren't reflected
+	return !(StructProperty->Struct->StructFlags & (STRUCT_ImportTextItemNative | STRUCT_ExportTextItemNative));
+}
@@ -0,0 +1,86 @@
+// Copyright Jared Therriault 2019, 2022
+
+#include "RuntimeDataTableRequestCoalescer.h"
+
+#include "RuntimeDataTableModule.h"
+#include "RuntimeDataTableProjectSettings.h"
+
+FRuntimeDataTableRequestCoalescer& FRuntimeDataTableRequestCoalescer::Get()
+{
+	static FRuntimeDataTableRequestCoalescer Instance;
+	return Instance;
+}
+
+FString FRuntimeDataTableRequestCoalescer::MakeKey(const FString& InExportUrl, const FRuntimeDataTableTokenInfo* InTokenInfo)
+{
+	// Two accounts may not see the same sheet, so they never share a response
+	return InTokenInfo ?
+		FString::Printf(TEXT("%s|%s|%s"), *InExportUrl, *InTokenInfo->ServiceAccountEmail, *InTokenInfo->ClaimUrl) :
+		InExportUrl + "|public";
+}
+
+bool FRuntimeDataTableRequestCoalescer::TryJoin(
+	const FString& InKey, const FName InOperationName, const FRDTGetStringDelegate& CallOnComplete)
+{
+	const URuntimeDataTableProjectSettings* Settings = GetDefault<URuntimeDataTableProjectSettings>();
+	if (!Settings || !Settings->bCoalesceIdenticalDownloads)
+	{
+		return false;
+	}
+
+	if (const FRecentResponse* RecentResponse = RecentResponses.Find(InKey))
+	{
+		if (FPlatformTime::Seconds() < RecentResponse->TimeOfExpiration)
+		{
+			FRuntimeDataTableModule::Print(FString::Printf(TEXT("%hs: Reusing recent response for %s"), __FUNCTION__, *InKey));
+
+			FRuntimeDataTableCallbackInfo CallbackInfo = RecentResponse->CallbackInfo;
+			CallbackInfo.OperationName = InOperationName;
+			CallOnComplete.ExecuteIfBound(CallbackInfo);
+			return true;
+		}
+
+		RecentResponses.Remove(InKey);
+	}
+
+	if (TArray<FWaitingCaller>* WaitingCallers = InFlight.Find(InKey))
+	{
+		FRuntimeDataTableModule::Print(FString::Printf(TEXT("%hs: Joining download already in flight for %s"), __FUNCTION__, *InKey));
+
+		WaitingCallers->Add({InOperationName, CallOnComplete});
+		return true;
+	}
+
+	InFlight.Add(InKey);
+	return false;
+}
+
+void FRuntimeDataTableRequestCoalescer::Complete(
+	const FString& InKey, const FRuntimeDataTableCallbackInfo& CallbackInfo, const FRDTGetStringDelegate& LeaderCallOnComplete)
+{
+	TArray<FWaitingCaller> WaitingCallers;
+	InFlight.RemoveAndCopyValue(InKey, WaitingCallers);
+
+	const URuntimeDataTableProjectSettings* Settings = GetDefault<URuntimeDataTableProjectSettings>();
+	if (Settings && Settings->bCoalesceIdenticalDownloads && Settings->CoalescedDownloadTtlSeconds > 0.f && CallbackInfo.bWasSuccessful)
+	{
+		FRecentResponse& RecentResponse = RecentResponses.Add(InKey);
+		RecentResponse.CallbackInfo = CallbackInfo;
+		RecentResponse.TimeOfExpiration = FPlatformTime::Seconds() + Settings->CoalescedDownloadTtlSeconds;
+	}
+
+	LeaderCallOnComplete.ExecuteIfBound(CallbackInfo);
+
+	for (const FWaitingCaller& WaitingCaller : WaitingCallers)
+	{
+		FRuntimeDataTableCallbackInfo CallerInfo = CallbackInfo;
+		CallerInfo.OperationName = WaitingCaller.OperationName;
+		WaitingCaller.CallOnComplete.ExecuteIfBound(CallerInfo);
+	}
+}
+
+void FRuntimeDataTableRequestCoalescer::Reset()
+{
+	InFlight.Empty();
+	RecentResponses.Empty();
+}
@@ -0,0 +1,358 @@
+// Copyright Jared Therriault 2019, 2022
+
+#include "RuntimeDataTableRequestScheduler.h"
+
+#include "RuntimeDataTable.h"
+#include "RuntimeDataTableModule.h"
+#include "RuntimeDataTableProjectSettings.h"
+#include "RuntimeDataTableStats.h"
+
+#include "HttpModule.h"
+#include "Interfaces/IHttpResponse.h"
+
+FRuntimeDataTableRequestScheduler& FRuntimeDataTableRequestScheduler::Get()
+{
+	static FRuntimeDataTableRequestScheduler Instance;
+	return Instance;
+}
+
+void FRuntimeDataTableRequestScheduler::ProcessRequest(const TSharedRef<IHttpRequest, ESPMode::ThreadSafe>& InRequest, const bool bIsIdempotent)
+{
+	const URuntimeDataTableProjectSettings* Settings = GetDefault<URuntimeDataTableProjectSettings>();
+
+	TSharedRef<FScheduledRequest> ScheduledRequest = MakeShared<FScheduledRequest>(InRequest);
+	ScheduledRequest->OnComplete = InRequest->OnProcessRequestComplete();
+	ScheduledRequest->bIsIdempotent = bIsIdempotent || InRequest->GetVerb() == "GET" || InRequest->GetVerb() == "HEAD";
+	ScheduledRequest->bIsRateLimited = InRequest->GetURL().StartsWith(URuntimeDataTableObject::GetGoogleSheetsApiUrlPrefix());
+
+	if (Settings && Settings->MaxQueuedRequests > 0 && Queue.Num() >= Settings->MaxQueuedRequests)
+	{
+		FRuntimeDataTableModule::Print(FString::Printf(
+			TEXT("%hs: %i requests are already queued, failing %s"), __FUNCTION__, Queue.Num(), *InRequest->GetURL()),
+			FRuntimeDataTableModule::ELogType::Error);
+		CompleteWithoutResponse(ScheduledRequest);
+		return;
+	}
+
+	Queue.Add(ScheduledRequest);
+	PumpQueue();
+	UpdateQueueStats();
+}
+
+bool FRuntimeDataTableRequestScheduler::CancelRequest(const TSharedRef<IHttpRequest, ESPMode::ThreadSafe>& InRequest)
+{
+	const auto IsInRequest = [&InRequest](const TSharedRef<FScheduledRequest>& ScheduledRequest)
+	{
+		return ScheduledRequest->OriginalRequest == InRequest;
+	};
+
+	if (const TSharedRef<FScheduledRequest>* Queued = Queue.FindByPredicate(IsInRequest))
+	{
+		const TSharedRef<FScheduledRequest> ScheduledRequest = *Queued;
+		Queue.Remove(ScheduledRequest);
+		UpdateQueueStats();
+		CompleteWithoutResponse(ScheduledRequest);
+		return true;
+	}
+
+	if (const TSharedRef<FScheduledRequest>* Waiting = WaitingToRetry.FindByPredicate(IsInRequest))
+	{
+		const TSharedRef<FScheduledRequest> ScheduledRequest = *Waiting;
+		FTSTicker::GetCoreTicker().RemoveTicker(ScheduledRequest->RetryTickerHandle);
+		WaitingToRetry.Remove(ScheduledRequest);
+		UpdateQueueStats();
+		CompleteWithoutResponse(ScheduledRequest);
+		return true;
+	}
+
+	if (const TSharedRef<FScheduledRequest>* Sent = InFlight.FindByPredicate(IsInRequest))
+	{
+		// The HTTP module completes it for us, OnRequestComplete sees the flag and doesn't retry
+		const TSharedRef<FScheduledRequest> ScheduledRequest = *Sent;
+		ScheduledRequest->bCancelled = true;
+		ScheduledRequest->Request->CancelRequest();
+		return true;
+	}
+
+	return false;
+}
+
+void FRuntimeDataTableRequestScheduler::Reset()
+{
+	if (PumpTickerHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(PumpTickerHandle);
+		PumpTickerHandle.Reset();
+	}
+
+	TArray<TSharedRef<FScheduledRequest>> Abandoned = MoveTemp(Queue);
+	for (const TSharedRef<FScheduledRequest>& ScheduledRequest : WaitingToRetry)
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(ScheduledRequest->RetryTickerHandle);
+		Abandoned.Add(ScheduledRequest);
+	}
+	Queue.Empty();
+	WaitingToRetry.Empty();
+
+	AvailableTokens = -1.0;
+	PausedUntil = 0.0;
+
+	UpdateQueueStats();
+
+	for (const TSharedRef<FScheduledRequest>& ScheduledRequest : Abandoned)
+	{
+		CompleteWithoutResponse(ScheduledRequest);
+	}
+}
+
+void FRuntimeDataTableRequestScheduler::PumpQueue()
+{
+	const URuntimeDataTableProjectSettings* Settings = GetDefault<URuntimeDataTableProjectSettings>();
+	const bool bLimitRequestRate = Settings && Settings->bLimitRequestRate;
+	const int32 MaxConcurrentRequests = Settings ? Settings->MaxConcurrentRequests : 0;
+
+	const double Now = FPlatformTime::Seconds();
+	RefillTokens(Now);
+
+	// Rate limited requests keep their order among themselves, everything else goes past them while they wait
+	bool bHasRateLimitedRequestWaiting = false;
+	for (int32 QueueIndex = 0; QueueIndex < Queue.Num();)
+	{
+		// Nothing to wait for on a timer, the next request to come back pumps the queue again
+		if (MaxConcurrentRequests > 0 && InFlight.Num() >= MaxConcurrentRequests)
+		{
+			return;
+		}
+
+		const TSharedRef<FScheduledRequest> ScheduledRequest = Queue[QueueIndex];
+		if (ScheduledRequest->bIsRateLimited)
+		{
+			if (bHasRateLimitedRequestWaiting || Now < PausedUntil || (bLimitRequestRate && AvailableTokens < 1.0))
+			{
+				bHasRateLimitedRequestWaiting = true;
+				QueueIndex++;
+				continue;
+			}
+
+			if (bLimitRequestRate)
+			{
+				AvailableTokens -= 1.0;
+			}
+		}
+
+		Queue.RemoveAt(QueueIndex, 1, false);
+		Send(ScheduledRequest);
+	}
+
+	if (!bHasRateLimitedRequestWaiting || PumpTickerHandle.IsValid())
+	{
+		return;
+	}
+
+	// Come back when the next token is due or the pause is over, whichever is later
+	double Delay = 0.0;
+	if (bLimitRequestRate)
+	{
+		const double TokensPerSecond = FMath::Max(Settings->MaxRequestsPerMinute, 1) / 60.0;
+		Delay = (1.0 - AvailableTokens) / TokensPerSecond;
+	}
+	Delay = FMath::Max(Delay, PausedUntil - Now);
+
+	PumpTickerHandle = FTSTicker::GetCoreTicker().AddTicker(
+		FTickerDelegate::CreateRaw(this, &FRuntimeDataTableRequestScheduler::OnPumpTimerElapsed),
+		static_cast<float>(FMath::Max(Delay, 0.01)));
+}
+
+bool FRuntimeDataTableRequestScheduler::OnPumpTimerElapsed(float DeltaTime)
+{
+	PumpTickerHandle.Reset();
+	PumpQueue();
+
+	return false;
+}
+
+void FRuntimeDataTableRequestScheduler::RefillTokens(const double Now)
+{
+	const URuntimeDataTableProjectSettings* Settings = GetDefault<URuntimeDataTableProjectSettings>();
+	const double BurstSize = Settings ? FMath::Max(Settings->RequestBurstSize, 1) : 1.0;
+	const double TokensPerSecond = (Settings ? FMath::Max(Settings->MaxRequestsPerMinute, 1) : 60) / 60.0;
+
+	// The bucket starts out full
+	if (AvailableTokens < 0.0)
+	{
+		AvailableTokens = BurstSize;
+		LastRefillTime = Now;
+		return;
+	}
+
+	AvailableTokens = FMath::Min(BurstSize, AvailableTokens + (Now - LastRefillTime) * TokensPerSecond);
+	LastRefillTime = Now;
+}
+
+void FRuntimeDataTableRequestScheduler::Send(const TSharedRef<FScheduledRequest>& ScheduledRequest)
+{
+	ScheduledRequest->Attempts++;
+	InFlight.Add(ScheduledRequest);
+	INC_DWORD_STAT(STAT_RuntimeDataTable_RequestsSent);
+	ScheduledRequest->Request->OnProcessRequestComplete().BindRaw(
+		this, &FRuntimeDataTableRequestScheduler::OnRequestComplete, ScheduledRequest);
+	ScheduledRequest->Request->ProcessRequest();
+}
+
+void FRuntimeDataTableRequestScheduler::OnRequestComplete(
+	FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful, TSharedRef<FScheduledRequest> ScheduledRequest)
+{
+	const URuntimeDataTableProjectSettings* Settings = GetDefault<URuntimeDataTableProjectSettings>();
+	const int32 MaxRetries = Settings ? Settings->MaxRequestRetries : 0;
+
+	InFlight.Remove(ScheduledRequest);
+
+	if (Response.IsValid())
+	{
+		INC_FLOAT_STAT_BY(STAT_RuntimeDataTable_BytesDownloaded, Response->GetContentLength());
+	}
+
+	if (!ScheduledRequest->bCancelled && IsRetryable(Response, bWasSuccessful, ScheduledRequest->bIsIdempotent) &&
+		ScheduledRequest->Attempts <= MaxRetries)
+	{
+		const float RetryDelay = GetRetryDelay(Response, ScheduledRequest->Attempts);
+		const int32 ResponseCode = Response.IsValid() ? Response->GetResponseCode() : INDEX_NONE;
+
+		// We're over quota, so everyone else waits too rather than earning their own 429
+		if (ResponseCode == 429 && ScheduledRequest->bIsRateLimited)
+		{
+			PausedUntil = FMath::Max(PausedUntil, FPlatformTime::Seconds() + RetryDelay);
+			AvailableTokens = FMath::Min(AvailableTokens, 0.0);
+		}
+
+		FRuntimeDataTableModule::Print(FString::Printf(
+			TEXT("%hs: %s %s failed with response code %i, retrying in %.1f seconds (attempt %i of %i)"),
+			__FUNCTION__, *Request->GetVerb(), *Request->GetURL(), ResponseCode, RetryDelay,
+			ScheduledRequest->Attempts + 1, MaxRetries + 1), FRuntimeDataTableModule::ELogType::Warning);
+
+		INC_DWORD_STAT(STAT_RuntimeDataTable_RequestsRetried);
+
+		ScheduledRequest->Request->OnProcessRequestComplete().Unbind();
+		ScheduledRequest->Request = CloneRequest(ScheduledRequest->Request);
+
+		WaitingToRetry.Add(ScheduledRequest);
+		ScheduledRequest->RetryTickerHandle = FTSTicker::GetCoreTicker().AddTicker(
+			FTickerDelegate::CreateRaw(this, &FRuntimeDataTableRequestScheduler::OnRetryDelayElapsed, ScheduledRequest),
+			RetryDelay);
+		PumpQueue();
+		UpdateQueueStats();
+		return;
+	}
+
+	// Just the last attempt, the time spent retrying shows up in the operation's own latency
+	FRuntimeDataTableStats::RecordStage(
+		TEXT("Http"), NAME_None, Request->GetElapsedTime(), Response.IsValid() ? Response->GetContentLength() : 0);
+
+	// Hand the caller their own delegate back, then let them know how it went
+	Request->OnProcessRequestComplete() = ScheduledRequest->OnComplete;
+	ScheduledRequest->OnComplete.ExecuteIfBound(Request, Response, bWasSuccessful);
+
+	// A slot has opened up
+	PumpQueue();
+	UpdateQueueStats();
+}
+
+bool FRuntimeDataTableRequestScheduler::OnRetryDelayElapsed(float DeltaTime, TSharedRef<FScheduledRequest> ScheduledRequest)
+{
+	WaitingToRetry.Remove(ScheduledRequest);
+	ScheduledRequest->RetryTickerHandle.Reset();
+
+	// Retries go to the front, they've already waited their turn once
+	Queue.Insert(ScheduledRequest, 0);
+	PumpQueue();
+	UpdateQueueStats();
+
+	return false;
+}
+
+void FRuntimeDataTableRequestScheduler::UpdateQueueStats() const
+{
+	SET_DWORD_STAT(STAT_RuntimeDataTable_RequestsQueued, Queue.Num() + WaitingToRetry.Num());
+	SET_DWORD_STAT(STAT_RuntimeDataTable_RequestsInFlight, InFlight.Num());
+}
+
+bool FRuntimeDataTableRequestScheduler::IsRetryable(const FHttpResponsePtr& Response, const bool bWasSuccessful, const bool bIsIdempotent)
+{
+	// No response at all means the connection failed or timed out. The server may still have applied the request.
+	if (!bWasSuccessful || !Response.IsValid())
+	{
+		return bIsIdempotent;
+	}
+
+	// A 429 is turned away before anything is done, so it's always safe to send again
+	const int32 ResponseCode = Response->GetResponseCode();
+	return ResponseCode == 429 || (bIsIdempotent && ResponseCode >= 500 && ResponseCode != 501 && ResponseCode != 505);
+}
+
+float FRuntimeDataTableRequestScheduler::GetRetryDelay(const FHttpResponsePtr& Response, const int32 Attempts)
+{
+	const URuntimeDataTableProjectSettings* Settings = GetDefault<URuntimeDataTableProjectSettings>();
+	const float InitialDelay = Settings ? Settings->InitialRetryDelaySeconds : 1.f;
+	const float MaxDelay = Settings ? Settings->MaxRetryDelaySeconds : 64.f;
+
+	// Half fixed, half random, so that everyone who got a 429 at the same moment doesn't come back at the same moment
+	const float Backoff = FMath::Min(InitialDelay * FMath::Pow(2.f, static_cast<float>(Attempts - 1)), MaxDelay);
+	float Delay = Backoff * FMath::FRandRange(0.5f, 1.f);
+
+	if (Response.IsValid())
+	{
+		const FString RetryAfter = Response->GetHeader("Retry-After").TrimStartAndEnd();
+		if (!RetryAfter.IsEmpty())
+		{
+			// Either a number of seconds or an HTTP date
+			FDateTime RetryAfterDate;
+			if (RetryAfter.IsNumeric())
+			{
+				Delay = FMath::Max(Delay, FCString::Atof(*RetryAfter));
+			}
+			else if (FDateTime::ParseHttpDate(RetryAfter, RetryAfterDate))
+			{
+				Delay = FMath::Max(Delay, static_cast<float>((RetryAfterDate - FDateTime::UtcNow()).GetTotalSeconds()));
+			}
+		}
+	}
+
+	return FMath::Max(Delay, 0.1f);
+}
+
+TSharedRef<IHttpRequest, ESPMode::ThreadSafe> FRuntimeDataTableRequestScheduler::CloneRequest(
+	const TSharedRef<IHttpRequest, ESPMode::ThreadSafe>& InRequest)
+{
+	TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Clone = FHttpModule::Get().CreateRequest();
+
+	Clone->SetURL(InRequest->GetURL());
+	Clone->SetVerb(InRequest->GetVerb());
+
+	for (const FString& Header : InRequest->GetAllHeaders())
+	{
+		FString HeaderName;
+		FString HeaderValue;
+		if (Header.Split(TEXT(":"), &HeaderName, &HeaderValue))
+		{
+			Clone->SetHeader(HeaderName.TrimStartAndEnd(), HeaderValue.TrimStartAndEnd());
+		}
+	}
+
+	if (InRequest->GetContentLength() > 0)
+	{
+		Clone->SetContent(InRequest->GetContent());
+	}
+
+	if (const TOptional<float> Timeout = InRequest->GetTimeout())
+	{
+		Clone->SetTimeout(Timeout.GetValue());
+	}
+
+	return Clone;
+}
+
+void FRuntimeDataTableRequestScheduler::CompleteWithoutResponse(const TSharedRef<FScheduledRequest>& ScheduledRequest)
+{
+	ScheduledRequest->Request->OnProcessRequestComplete() = ScheduledRequest->OnComplete;
+	ScheduledRequest->OnComplete.ExecuteIfBound(ScheduledRequest->Request, nullptr, false);
+}
@@ -0,0 +1,264 @@
+// Copyright Jared Therriault 2019, 2022
+
+#include "RuntimeDataTableSheetPoller.h"
+
+#include "RuntimeDataTableModule.h"
+#include "RuntimeDataTableRequestCoalescer.h"
+#include "RuntimeDataTableSnapshot.h"
+
+TMap<FString, URuntimeDataTableSheetPoller*> URuntimeDataTableSheetPoller::Pollers;
+TMap<int32, URuntimeDataTableSheetPoller*> URuntimeDataTableSheetPoller::PollersBySubscription;
+int32 URuntimeDataTableSheetPoller::NextSubscriptionHandle = 0;
+
+int32 URuntimeDataTableSheetPoller::Subscribe(
+	const FRuntimeDataTableTokenInfo& InTokenInfo, const FRuntimeDataTableOperationParams& OperationParams,
+	const FString& InSheetURL, const bool bSheetIsPublic, const float InPollIntervalSeconds,
+	const FRDTSheetRowDelegate& OnRowAdded, const FRDTSheetRowDelegate& OnRowChanged, const FRDTSheetRowDelegate& OnRowRemoved)
+{
+	if (InSheetURL.IsEmpty())
+	{
+		FRuntimeDataTableModule::Print(FString::Printf(
+			TEXT("%hs: InSheetURL is empty."), __FUNCTION__), FRuntimeDataTableModule::ELogType::Error);
+		return INDEX_NONE;
+	}
+
+	const FString PollerKey = FRuntimeDataTableRequestCoalescer::MakeKey(
+		URuntimeDataTableObject::GetCsvExportUrl(InSheetURL), bSheetIsPublic ? nullptr : &InTokenInfo);
+
+	URuntimeDataTableSheetPoller* Poller = Pollers.FindRef(PollerKey);
+	if (!Poller)
+	{
+		Poller = NewObject<URuntimeDataTableSheetPoller>();
+		Poller->AddToRoot();
+		Poller->TokenInfo = InTokenInfo;
+		Poller->OperationParams = OperationParams;
+		Poller->SheetURL = InSheetURL;
+		Poller->PollerKey = PollerKey;
+		Poller->bSheetIsPublic = bSheetIsPublic;
+		Pollers.Add(PollerKey, Poller);
+
+		FRuntimeDataTableModule::Print(FString::Printf(TEXT("%hs: Started polling %s"), __FUNCTION__, *InSheetURL));
+	}
+
+	const int32 SubscriptionHandle = NextSubscriptionHandle++;
+
+	FSubscriber& Subscriber = Poller->Subscribers.Add(SubscriptionHandle);
+	Subscriber.PollIntervalSeconds = FMath::Max(InPollIntervalSeconds, 1.f);
+	Subscriber.OnRowAdded = OnRowAdded;
+	Subscriber.OnRowChanged = OnRowChanged;
+	Subscriber.OnRowRemoved = OnRowRemoved;
+
+	PollersBySubscription.Add(SubscriptionHandle, Poller);
+
+	// Late subscribers are caught up with what we already have rather than waiting for the next change
+	if (Poller->bHasSnapshot)
+	{
+		for (const FName& RowKey : Poller->Snapshot.CSV_Keys)
+		{
+			OnRowAdded.ExecuteIfBound(RowKey, Poller->Snapshot.CSV_Map.FindRef(RowKey));
+		}
+	}
+
+	Poller->UpdatePollInterval();
+
+	if (!Poller->bHasSnapshot && !Poller->bDownloadInFlight)
+	{
+		Poller->Poll();
+	}
+
+	return SubscriptionHandle;
+}
+
+void URuntimeDataTableSheetPoller::Unsubscribe(const int32 InSubscriptionHandle)
+{
+	URuntimeDataTableSheetPoller* Poller = nullptr;
+	if (!PollersBySubscription.RemoveAndCopyValue(InSubscriptionHandle, Poller) || !Poller)
+	{
+		return;
+	}
+
+	Poller->Subscribers.Remove(InSubscriptionHandle);
+
+	if (Poller->Subscribers.Num() == 0)
+	{
+		FRuntimeDataTableModule::Print(FString::Printf(TEXT("%hs: Stopped polling %s"), __FUNCTION__, *Poller->SheetURL));
+
+		Pollers.Remove(Poller->PollerKey);
+		Poller->Stop();
+		Poller->RemoveFromRoot();
+	}
+	else
+	{
+		Poller->UpdatePollInterval();
+	}
+}
+
+void URuntimeDataTableSheetPoller::UnsubscribeAll()
+{
+	for (const TPair<FString, URuntimeDataTableSheetPoller*>& Pair : Pollers)
+	{
+		Pair.Value->Stop();
+
+		// Called from module shutdown, by which point there may be no object system left to unroot from
+		if (UObjectInitialized())
+		{
+			Pair.Value->RemoveFromRoot();
+		}
+	}
+
+	Pollers.Empty();
+	PollersBySubscription.Empty();
+}
+
+void URuntimeDataTableSheetPoller::Poll()
+{
+	bDownloadInFlight = true;
+
+	FRDTGetCsvInfoDelegate OnDownloaded;
+	OnDownloaded.BindUFunction(this, GET_FUNCTION_NAME_CHECKED(URuntimeDataTableSheetPoller, OnSheetDownloaded));
+
+	// A prefetched copy is a fine first snapshot, but every poll after that has to see the sheet as it is now
+	FRuntimeDataTableOperationParams PollParams = OperationParams;
+	PollParams.bUsePrefetchCache = PollParams.bUsePrefetchCache && !bHasSnapshot;
+
+	URuntimeDataTableObject::DownloadSheetAsCsvInfo(TokenInfo, PollParams, OnDownloaded, SheetURL, bSheetIsPublic);
+}
+
+bool URuntimeDataTableSheetPoller::OnPollTimerElapsed(float DeltaTime)
+{
+	// A slow download just means this tick is skipped
+	if (!bDownloadInFlight)
+	{
+		Poll();
+	}
+
+	return true;
+}
+
+void URuntimeDataTableSheetPoller::UpdatePollInterval()
+{
+	float ShortestInterval = TNumericLimits<float>::Max();
+	for (const TPair<int32, FSubscriber>& Pair : Subscribers)
+	{
+		ShortestInterval = FMath::Min(ShortestInterval, Pair.Value.PollIntervalSeconds);
+	}
+
+	if (PollTickerHandle.IsValid() && FMath::IsNearlyEqual(ShortestInterval, PollIntervalSeconds))
+	{
+		return;
+	}
+
+	Stop();
+
+	PollIntervalSeconds = ShortestInterval;
+	PollTickerHandle = FTSTicker::GetCoreTicker().AddTicker(
+		FTickerDelegate::CreateUObject(this, &URuntimeDataTableSheetPoller::OnPollTimerElapsed), PollIntervalSeconds);
+}
+
+void URuntimeDataTableSheetPoller::Stop()
+{
+	if (PollTickerHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(PollTickerHandle);
+		PollTickerHandle.Reset();
+	}
+}
+
+void URuntimeDataTableSheetPoller::OnSheetDownloaded(FRuntimeDataTableCallbackInfo CallbackInfo, const FEasyCsvInfo& CsvInfo)
+{
+	bDownloadInFlight = false;
+
+	if (Subscribers.Num() == 0)
+	{
+		return;
+	}
+
+	if (!CallbackInfo.bWasSuccessful)
+	{
+		FRuntimeDataTableModule::Print(FString::Printf(
+			TEXT("%hs: Polling %s failed, will try again next interval: %s"), __FUNCTION__, *SheetURL, *CallbackInfo.ResponseAsString),
+			FRuntimeDataTableModule::ELogType::Warning);
+		return;
+	}
+
+	// With different columns the same values mean something else, so every row counts as changed
+	const bool bHeadersChanged = bHasSnapshot && Snapshot.CSV_Headers != CsvInfo.CSV_Headers;
+
+	TMap<FName, uint32> NewRowHashes;
+	NewRowHashes.Reserve(CsvInfo.CSV_Keys.Num());
+
+	TArray<FName> AddedRows;
+	TArray<FName> ChangedRows;
+	TArray<FName> RemovedRows;
+
+	for (const FName& RowKey : CsvInfo.CSV_Keys)
+	{
+		if (NewRowHashes.Contains(RowKey))
+		{
+			continue;
+		}
+
+		const FEasyCsvStringValueArray* Row = CsvInfo.CSV_Map.Find(RowKey);
+		const uint32 RowHash = Row ? FRuntimeDataTableSnapshot::HashRow(Row->StringValues) : 0;
+		NewRowHashes.Add(RowKey, RowHash);
+
+		if (const uint32* PreviousHash = RowHashes.Find(RowKey))
+		{
+			if (bHeadersChanged || *PreviousHash != RowHash)
+			{
+				ChangedRows.Add(RowKey);
+			}
+		}
+		else
+		{
+			AddedRows.Add(RowKey);
+		}
+	}
+
+	for (const TPair<FName, uint32>& Pair : RowHashes)
+	{
+		if (!NewRowHashes.Contains(Pair.Key))
+		{
+			RemovedRows.Add(Pair.Key);
+		}
+	}
+
+	if (bHasSnapshot && AddedRows.Num() == 0 && ChangedRows.Num() == 0 && RemovedRows.Num() == 0)
+	{
+		return;
+	}
+
+	FRuntimeDataTableModule::Print(FString::Printf(TEXT("%hs: %s changed: %i rows added, %i changed, %i removed"),
+		__FUNCTION__, *SheetURL, AddedRows.Num(), ChangedRows.Num(), RemovedRows.Num()));
+
+	// Removed rows are reported with the values they had last time, so grab those before the snapshot is replaced
+	TArray<FEasyCsvStringValueArray> RemovedRowValues;
+	for (const FName& RowKey : RemovedRows)
+	{
+		RemovedRowValues.Add(Snapshot.CSV_Map.FindRef(RowKey));
+	}
+
+	Snapshot = CsvInfo;
+	RowHashes = MoveTemp(NewRowHashes);
+	bHasSnapshot = true;
+
+	// Copied in case a subscriber unsubscribes from inside its delegate
+	TArray<FSubscriber> SubscribersToNotify;
+	Subscribers.GenerateValueArray(SubscribersToNotify);
+
+	for (const FSubscriber& Subscriber : SubscribersToNotify)
+	{
+		for (int32 Index = 0; Index < RemovedRows.Num(); Index++)
+		{
+			Subscriber.OnRowRemoved.ExecuteIfBound(RemovedRows[Index], RemovedRowValues[Index]);
+		}
+		for (const FName& RowKey : AddedRows)
+		{
+			Subscriber.OnRowAdded.ExecuteIfBound(RowKey, Snapshot.CSV_Map.FindRef(RowKey));
+		}
+		for (const FName& RowKey : ChangedRows)
+		{
+			Subscriber.OnRowChanged.ExecuteIfBound(RowKey, Snapshot.CSV_Map.FindRef(RowKey));
+		}
+	}
+}
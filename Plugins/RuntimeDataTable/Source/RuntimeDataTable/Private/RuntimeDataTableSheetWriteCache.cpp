@@ -0,0 +1,296 @@
+// Copyright Jared Therriault 2019, 2022
+
+#include "RuntimeDataTableSheetWriteCache.h"
+
+#include "RuntimeDataTableA1Notation.h"
+#include "RuntimeDataTableJsonPayloadWriter.h"
+
+#include "Misc/ScopeLock.h"
+
+namespace RuntimeDataTableSheetWriteCache
+{
+	static const FString EmptyCell;
+
+	const FString& GetCell(const TArray<TArray<FString>>& InValues, const int32 InRow, const int32 InColumn)
+	{
+		return InValues.IsValidIndex(InRow) && InValues[InRow].IsValidIndex(InColumn) ? InValues[InRow][InColumn] : EmptyCell;
+	}
+
+	int32 GetWidestRow(const TArray<TArray<FString>>& InValues)
+	{
+		int32 Widest = 0;
+		for (const TArray<FString>& Row : InValues)
+		{
+			Widest = FMath::Max(Widest, Row.Num());
+		}
+		return Widest;
+	}
+
+	void WriteAppendDimensionRequest(
+		FRuntimeDataTableJsonPayloadWriter& Writer, const int32 InSheetId, const FString& InDimension, const int32 InLength)
+	{
+		Writer.BeginObject();
+		Writer.BeginObject("appendDimension");
+		Writer.WriteNumberField("sheetId", InSheetId);
+		Writer.WriteStringField("dimension", InDimension);
+		Writer.WriteNumberField("length", InLength);
+		Writer.EndObject();
+		Writer.EndObject();
+	}
+
+	// An updateCells with a range and no rows clears every cell in the range. A negative end means "to the edge of the grid".
+	void WriteClearRangeRequest(FRuntimeDataTableJsonPayloadWriter& Writer,
+		const int32 InSheetId, const int32 InStartRow, const int32 InEndRow, const int32 InStartColumn, const int32 InEndColumn)
+	{
+		Writer.BeginObject();
+		Writer.BeginObject("updateCells");
+		{
+			Writer.BeginObject("range");
+			Writer.WriteNumberField("sheetId", InSheetId);
+			if (InEndRow >= 0)
+			{
+				Writer.WriteNumberField("startRowIndex", InStartRow);
+				Writer.WriteNumberField("endRowIndex", InEndRow);
+			}
+			if (InEndColumn >= 0)
+			{
+				Writer.WriteNumberField("startColumnIndex", InStartColumn);
+				Writer.WriteNumberField("endColumnIndex", InEndColumn);
+			}
+			Writer.EndObject();
+
+			Writer.WriteStringField("fields", "userEnteredValue");
+		}
+		Writer.EndObject();
+		Writer.EndObject();
+	}
+
+	void WriteUpdateCellsRequest(FRuntimeDataTableJsonPayloadWriter& Writer,
+		const int32 InSheetId, const TArray<TArray<FString>>& InValues,
+		const int32 InStartRow, const int32 InEndRow, const int32 InStartColumn, const int32 InEndColumn)
+	{
+		Writer.BeginObject();
+		Writer.BeginObject("updateCells");
+		{
+			Writer.BeginObject("start");
+			Writer.WriteNumberField("sheetId", InSheetId);
+			Writer.WriteNumberField("rowIndex", InStartRow);
+			Writer.WriteNumberField("columnIndex", InStartColumn);
+			Writer.EndObject();
+
+			Writer.BeginArray("rows");
+			for (int32 RowIndex = InStartRow; RowIndex < InEndRow; RowIndex++)
+			{
+				Writer.BeginObject();
+				Writer.BeginArray("values");
+				for (int32 ColumnIndex = InStartColumn; ColumnIndex < InEndColumn; ColumnIndex++)
+				{
+					// An empty cell object clears the cell since "fields" still names userEnteredValue
+					Writer.BeginObject();
+					const FString& Value = GetCell(InValues, RowIndex, ColumnIndex);
+					if (!Value.IsEmpty())
+					{
+						Writer.BeginObject("userEnteredValue");
+						Writer.WriteStringField("stringValue", Value);
+						Writer.EndObject();
+					}
+					Writer.EndObject();
+				}
+				Writer.EndArray();
+				Writer.EndObject();
+			}
+			Writer.EndArray();
+
+			Writer.WriteStringField("fields", "userEnteredValue");
+		}
+		Writer.EndObject();
+		Writer.EndObject();
+	}
+}
+
+FRuntimeDataTableSheetWriteCache& FRuntimeDataTableSheetWriteCache::Get()
+{
+	static FRuntimeDataTableSheetWriteCache Instance;
+	return Instance;
+}
+
+bool FRuntimeDataTableSheetWriteCache::FindSnapshot(
+	const FString& InSpreadsheetId, const int32 InSheetId, FRuntimeDataTableSheetSnapshot& OutSnapshot) const
+{
+	FScopeLock Lock(&CacheCriticalSection);
+
+	if (const FRuntimeDataTableSheetSnapshot* Snapshot = Snapshots.Find(MakeCacheKey(InSpreadsheetId, InSheetId)))
+	{
+		OutSnapshot = *Snapshot;
+		return true;
+	}
+
+	return false;
+}
+
+void FRuntimeDataTableSheetWriteCache::SetGridProperties(
+	const FString& InSpreadsheetId, const int32 InSheetId, const int32 InRowCount, const int32 InColumnCount)
+{
+	FScopeLock Lock(&CacheCriticalSection);
+
+	FRuntimeDataTableSheetSnapshot& Snapshot = Snapshots.FindOrAdd(MakeCacheKey(InSpreadsheetId, InSheetId));
+	Snapshot.GridRowCount = InRowCount;
+	Snapshot.GridColumnCount = InColumnCount;
+	Snapshot.bHasWrittenValues = false;
+	Snapshot.Values.Empty();
+}
+
+void FRuntimeDataTableSheetWriteCache::StoreSnapshot(
+	const FString& InSpreadsheetId, const int32 InSheetId, FRuntimeDataTableSheetSnapshot InSnapshot)
+{
+	FScopeLock Lock(&CacheCriticalSection);
+
+	Snapshots.Add(MakeCacheKey(InSpreadsheetId, InSheetId), MoveTemp(InSnapshot));
+}
+
+void FRuntimeDataTableSheetWriteCache::Invalidate(const FString& InSpreadsheetId, const int32 InSheetId)
+{
+	FScopeLock Lock(&CacheCriticalSection);
+
+	Snapshots.Remove(MakeCacheKey(InSpreadsheetId, InSheetId));
+}
+
+void FRuntimeDataTableSheetWriteCache::Reset()
+{
+	FScopeLock Lock(&CacheCriticalSection);
+
+	Snapshots.Empty();
+}
+
+int32 FRuntimeDataTableSheetWriteCache::BuildDiffRequests(
+	const int32 InSheetId, const FRuntimeDataTableSheetSnapshot& Previous, const TArray<TArray<FString>>& InValues,
+	FRuntimeDataTableJsonPayloadWriter& Writer, FRuntimeDataTableSheetSnapshot& OutNextSnapshot)
+{
+	using namespace RuntimeDataTableSheetWriteCache;
+
+	int32 NumRequests = 0;
+
+	OutNextSnapshot.GridRowCount = Previous.GridRowCount;
+	OutNextSnapshot.GridColumnCount = Previous.GridColumnCount;
+	OutNextSnapshot.bHasWrittenValues = true;
+	OutNextSnapshot.Values = InValues;
+
+	const int32 NewRowCount = InValues.Num();
+	const int32 NewColumnCount = GetWidestRow(InValues);
+
+	// Grow the grid first, updateCells can't write outside of it
+	if (NewColumnCount > Previous.GridColumnCount)
+	{
+		WriteAppendDimensionRequest(Writer, InSheetId, "COLUMNS", NewColumnCount - Previous.GridColumnCount);
+		NumRequests++;
+		OutNextSnapshot.GridColumnCount = NewColumnCount;
+	}
+	if (NewRowCount > Previous.GridRowCount)
+	{
+		WriteAppendDimensionRequest(Writer, InSheetId, "ROWS", NewRowCount - Previous.GridRowCount);
+		NumRequests++;
+		OutNextSnapshot.GridRowCount = NewRowCount;
+	}
+
+	// Without a snapshot we don't know what's in the tab, so clear it all and diff against nothing
+	static const TArray<TArray<FString>> NoValues;
+	const TArray<TArray<FString>>& PreviousValues = Previous.bHasWrittenValues ? Previous.Values : NoValues;
+
+	if (!Previous.bHasWrittenValues)
+	{
+		WriteClearRangeRequest(Writer, InSheetId, 0, -1, 0, -1);
+		NumRequests++;
+	}
+	else
+	{
+		const int32 PreviousRowCount = PreviousValues.Num();
+		const int32 PreviousColumnCount = GetWidestRow(PreviousValues);
+
+		// Rows that held data last time but don't anymore
+		if (PreviousRowCount > NewRowCount && PreviousColumnCount > 0)
+		{
+			WriteClearRangeRequest(Writer, InSheetId, NewRowCount, PreviousRowCount, 0, PreviousColumnCount);
+			NumRequests++;
+		}
+
+		// Columns that held data last time but don't anymore, in the rows that are still there
+		const int32 SharedRowCount = FMath::Min(NewRowCount, PreviousRowCount);
+		if (PreviousColumnCount > NewColumnCount && SharedRowCount > 0)
+		{
+			WriteClearRangeRequest(Writer, InSheetId, 0, SharedRowCount, NewColumnCount, PreviousColumnCount);
+			NumRequests++;
+		}
+	}
+
+	// Find the changed span of each row, then merge adjacent rows with overlapping spans into one block.
+	// Ranges here are A1 bounds, so 1-based and inclusive.
+	TArray<FRuntimeDataTableA1Range> Blocks;
+	TArray<FIntPoint> DirtyCorners;
+
+	for (int32 RowIndex = 0; RowIndex < NewRowCount; RowIndex++)
+	{
+		int32 FirstChangedColumn = INDEX_NONE;
+		int32 LastChangedColumn = INDEX_NONE;
+
+		for (int32 ColumnIndex = 0; ColumnIndex < NewColumnCount; ColumnIndex++)
+		{
+			if (!GetCell(InValues, RowIndex, ColumnIndex).Equals(GetCell(PreviousValues, RowIndex, ColumnIndex), ESearchCase::CaseSensitive))
+			{
+				if (FirstChangedColumn == INDEX_NONE)
+				{
+					FirstChangedColumn = ColumnIndex;
+				}
+				LastChangedColumn = ColumnIndex;
+			}
+		}
+
+		if (FirstChangedColumn == INDEX_NONE)
+		{
+			continue;
+		}
+
+		const FRuntimeDataTableA1Range RowSpan(FirstChangedColumn + 1, RowIndex + 1, LastChangedColumn + 1, RowIndex + 1);
+		DirtyCorners.Emplace(RowSpan.StartColumn, RowSpan.StartRow);
+		DirtyCorners.Emplace(RowSpan.EndColumn, RowSpan.EndRow);
+
+		// The last block's columns on this row, to see whether the spans overlap
+		FRuntimeDataTableA1Range Overlap;
+		const bool bExtendsLastBlock = Blocks.Num() > 0 && Blocks.Last().EndRow == RowSpan.StartRow - 1 &&
+			FRuntimeDataTableA1Range::Intersect(
+				FRuntimeDataTableA1Range(Blocks.Last().StartColumn, RowSpan.StartRow, Blocks.Last().EndColumn, RowSpan.EndRow), RowSpan, Overlap);
+
+		if (bExtendsLastBlock)
+		{
+			Blocks.Last() = FRuntimeDataTableA1Range::Union(Blocks.Last(), RowSpan);
+		}
+		else
+		{
+			Blocks.Add(RowSpan);
+		}
+	}
+
+	// When the blocks already cover most of their bounding box, one request over the box costs about the same bytes as all of them
+	FRuntimeDataTableA1Range BoundingBox;
+	if (Blocks.Num() > 1 && FRuntimeDataTableA1Range::MakeBoundingBox(DirtyCorners, BoundingBox))
+	{
+		int64 BlockCellCount = 0;
+		for (const FRuntimeDataTableA1Range& Block : Blocks)
+		{
+			BlockCellCount += Block.GetCellCount();
+		}
+
+		if (BlockCellCount * 2 >= BoundingBox.GetCellCount())
+		{
+			Blocks.Reset();
+			Blocks.Add(BoundingBox);
+		}
+	}
+
+	for (const FRuntimeDataTableA1Range& Block : Blocks)
+	{
+		WriteUpdateCellsRequest(Writer, InSheetId, InValues, Block.StartRow - 1, Block.EndRow, Block.StartColumn - 1, Block.EndColumn);
+		NumRequests++;
+	}
+
+	return NumRequests;
+}
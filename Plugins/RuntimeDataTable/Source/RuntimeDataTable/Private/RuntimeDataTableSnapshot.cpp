@@ -0,0 +1,260 @@
+// Copyright Jared Therriault 2019, 2022
+
+#include "RuntimeDataTableSnapshot.h"
+
+#include "RuntimeDataTableProjectSettings.h"
+#include "RuntimeDataTableStats.h"
+
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+FString FRuntimeDataTableSnapshot::GetCookedSnapshotPath(const FString& InSnapshotName)
+{
+	const URuntimeDataTableProjectSettings* Settings = GetDefault<URuntimeDataTableProjectSettings>();
+	const FString SnapshotDirectory = Settings ? Settings->SnapshotDirectory : FString("RuntimeDataTable/Snapshots");
+
+	return FPaths::Combine(FPaths::ProjectContentDir(), SnapshotDirectory, InSnapshotName + ".rdts");
+}
+
+FString FRuntimeDataTableSnapshot::GetSavedSnapshotPath(const FString& InSnapshotName)
+{
+	return FPaths::Combine(FPaths::ProjectSavedDir(), "RuntimeDataTable", "Snapshots", InSnapshotName + ".rdts");
+}
+
+bool FRuntimeDataTableSnapshot::LoadNewest(const FString& InSnapshotName, FRuntimeDataTableSnapshot& OutSnapshot)
+{
+	const FString CookedPath = GetCookedSnapshotPath(InSnapshotName);
+	const FString SavedPath = GetSavedSnapshotPath(InSnapshotName);
+
+	FDateTime CookedTime;
+	FDateTime SavedTime;
+	const bool bHasCooked = ReadSnapshotTime(CookedPath, CookedTime);
+	const bool bHasSaved = ReadSnapshotTime(SavedPath, SavedTime);
+
+	// A new build ships a newer snapshot than what the previous one fetched, so the saved one doesn't always win
+	if (bHasSaved && (!bHasCooked || SavedTime > CookedTime) && OutSnapshot.Load(SavedPath))
+	{
+		return true;
+	}
+
+	return bHasCooked && OutSnapshot.Load(CookedPath);
+}
+
+bool FRuntimeDataTableSnapshot::Load(const FString& InPath)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FRuntimeDataTableSnapshot::Load);
+
+	const double StartTime = FPlatformTime::Seconds();
+
+	// Read in one go rather than mapped, every row is copied out into FStrings and FNames either way
+	TArray<uint8> FileData;
+	if (!FFileHelper::LoadFileToArray(FileData, *InPath, FILEREAD_Silent))
+	{
+		return false;
+	}
+
+	FMemoryReader Reader(FileData);
+
+	uint32 Magic = 0;
+	uint32 FormatVersion = 0;
+	Reader << Magic;
+	Reader << FormatVersion;
+	if (Reader.IsError() || Magic != FileMagic || FormatVersion > FileFormatVersion)
+	{
+		return false;
+	}
+
+	int64 SnapshotTicks = 0;
+	int32 NumRows = 0;
+
+	Reader << SheetURL;
+	Reader << SnapshotTicks;
+	Reader << CsvInfo.CSV_Headers;
+	Reader << NumRows;
+	if (Reader.IsError() || NumRows < 0)
+	{
+		return false;
+	}
+
+	// Every row is at least an empty key, an empty value array and a hash, which bounds a corrupt count before anything is reserved
+	constexpr int64 MinBytesPerRow = sizeof(int32) + sizeof(int32) + sizeof(uint32);
+	if (NumRows > (Reader.TotalSize() - Reader.Tell()) / MinBytesPerRow)
+	{
+		return false;
+	}
+
+	SnapshotTime = FDateTime(SnapshotTicks);
+
+	CsvInfo.CSV_Keys.Reset(NumRows);
+	CsvInfo.CSV_Map.Reset();
+	CsvInfo.CSV_Map.Reserve(NumRows);
+	RowHashes.Reset();
+	RowHashes.Reserve(NumRows);
+
+	for (int32 RowIndex = 0; RowIndex < NumRows && !Reader.IsError(); RowIndex++)
+	{
+		FString RowKeyString;
+		FEasyCsvStringValueArray Row;
+		uint32 RowHash = 0;
+
+		Reader << RowKeyString;
+		Reader << Row.StringValues;
+		Reader << RowHash;
+
+		const FName RowKey(*RowKeyString);
+		CsvInfo.CSV_Keys.Add(RowKey);
+		CsvInfo.CSV_Map.Add(RowKey, MoveTemp(Row));
+		RowHashes.Add(RowKey, RowHash);
+	}
+
+	if (Reader.IsError())
+	{
+		return false;
+	}
+
+	FRuntimeDataTableStats::RecordStage(
+		TEXT("Snapshot.Load"), NAME_None, FPlatformTime::Seconds() - StartTime, FileData.Num(), CsvInfo.CSV_Keys.Num());
+
+	return true;
+}
+
+bool FRuntimeDataTableSnapshot::Save(const FString& InPath) const
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FRuntimeDataTableSnapshot::Save);
+
+	TArray<uint8> FileData;
+	FMemoryWriter Writer(FileData);
+
+	uint32 Magic = FileMagic;
+	uint32 FormatVersion = FileFormatVersion;
+	FString SheetURLToWrite = SheetURL;
+	int64 SnapshotTicks = SnapshotTime.GetTicks();
+	TArray<FString> Headers = CsvInfo.CSV_Headers;
+	int32 NumRows = CsvInfo.CSV_Keys.Num();
+
+	Writer << Magic;
+	Writer << FormatVersion;
+	Writer << SheetURLToWrite;
+	Writer << SnapshotTicks;
+	Writer << Headers;
+	Writer << NumRows;
+
+	for (const FName& RowKey : CsvInfo.CSV_Keys)
+	{
+		FString RowKeyString = RowKey.ToString();
+		TArray<FString> Values = CsvInfo.CSV_Map.FindRef(RowKey).StringValues;
+		uint32 RowHash = RowHashes.Contains(RowKey) ? RowHashes[RowKey] : HashRow(Values);
+
+		Writer << RowKeyString;
+		Writer << Values;
+		Writer << RowHash;
+	}
+
+	const FString TempPath = InPath + ".tmp";
+
+	IFileManager::Get().MakeDirectory(*FPaths::GetPath(InPath), true);
+
+	if (!FFileHelper::SaveArrayToFile(FileData, *TempPath) ||
+		!IFileManager::Get().Move(*InPath, *TempPath, true, true, false, true))
+	{
+		IFileManager::Get().Delete(*TempPath, false, false, true);
+		return false;
+	}
+
+	return true;
+}
+
+void FRuntimeDataTableSnapshot::ComputeRowHashes()
+{
+	RowHashes.Reset();
+	RowHashes.Reserve(CsvInfo.CSV_Keys.Num());
+
+	for (const FName& RowKey : CsvInfo.CSV_Keys)
+	{
+		if (const FEasyCsvStringValueArray* Row = CsvInfo.CSV_Map.Find(RowKey))
+		{
+			RowHashes.Add(RowKey, HashRow(Row->StringValues));
+		}
+	}
+}
+
+void FRuntimeDataTableSnapshot::Diff(
+	const FEasyCsvInfo& InNewer, TMap<FName, uint32>& OutNewRowHashes, TArray<FName>& OutChangedRows, TArray<FName>& OutRemovedRows) const
+{
+	// With different columns the same values mean something else
+	const bool bHeadersChanged = CsvInfo.CSV_Headers != InNewer.CSV_Headers;
+
+	OutNewRowHashes.Reset();
+	OutNewRowHashes.Reserve(InNewer.CSV_Keys.Num());
+
+	for (const FName& RowKey : InNewer.CSV_Keys)
+	{
+		const FEasyCsvStringValueArray* Row = InNewer.CSV_Map.Find(RowKey);
+		if (!Row || OutNewRowHashes.Contains(RowKey))
+		{
+			continue;
+		}
+
+		const uint32 RowHash = HashRow(Row->StringValues);
+		OutNewRowHashes.Add(RowKey, RowHash);
+
+		const uint32* PreviousHash = RowHashes.Find(RowKey);
+		if (bHeadersChanged || !PreviousHash || *PreviousHash != RowHash)
+		{
+			OutChangedRows.Add(RowKey);
+		}
+	}
+
+	for (const TPair<FName, uint32>& Pair : RowHashes)
+	{
+		if (!OutNewRowHashes.Contains(Pair.Key))
+		{
+			OutRemovedRows.Add(Pair.Key);
+		}
+	}
+}
+
+uint32 FRuntimeDataTableSnapshot::HashRow(const TArray<FString>& InValues)
+{
+	uint32 Hash = GetTypeHash(InValues.Num());
+	for (const FString& Value : InValues)
+	{
+		Hash = HashCombine(Hash, FCrc::StrCrc32(*Value));
+	}
+	return Hash;
+}
+
+bool FRuntimeDataTableSnapshot::ReadSnapshotTime(const FString& InPath, FDateTime& OutSnapshotTime)
+{
+	// Just the header, the rows aren't needed to tell which snapshot is newer
+	const TUniquePtr<FArchive> Reader(IFileManager::Get().CreateFileReader(*InPath, FILEREAD_Silent));
+	if (!Reader.IsValid())
+	{
+		return false;
+	}
+
+	uint32 Magic = 0;
+	uint32 FormatVersion = 0;
+	FString StoredSheetURL;
+	int64 SnapshotTicks = 0;
+
+	*Reader << Magic;
+	*Reader << FormatVersion;
+	if (Reader->IsError() || Magic != FileMagic || FormatVersion > FileFormatVersion)
+	{
+		return false;
+	}
+
+	*Reader << StoredSheetURL;
+	*Reader << SnapshotTicks;
+	if (Reader->IsError())
+	{
+		return false;
+	}
+
+	OutSnapshotTime = FDateTime(SnapshotTicks);
+	return true;
+}
@@ -0,0 +1,152 @@
+// Copyright Jared Therriault 2019, 2022
+
+#include "RuntimeDataTableStats.h"
+
+#include "HAL/IConsoleManager.h"
+#include "Misc/ScopeLock.h"
+#include "Trace/Trace.inl"
+
+DEFINE_STAT(STAT_RuntimeDataTable_SignAssertion);
+DEFINE_STAT(STAT_RuntimeDataTable_ParseDownload);
+DEFINE_STAT(STAT_RuntimeDataTable_UpdateDataTable);
+DEFINE_STAT(STAT_RuntimeDataTable_UpdateArray);
+DEFINE_STAT(STAT_RuntimeDataTable_GenerateCsv);
+DEFINE_STAT(STAT_RuntimeDataTable_SaveBackup);
+DEFINE_STAT(STAT_RuntimeDataTable_LoadBackup);
+
+DEFINE_STAT(STAT_RuntimeDataTable_RequestsSent);
+DEFINE_STAT(STAT_RuntimeDataTable_RequestsRetried);
+DEFINE_STAT(STAT_RuntimeDataTable_RequestsQueued);
+DEFINE_STAT(STAT_RuntimeDataTable_RequestsInFlight);
+DEFINE_STAT(STAT_RuntimeDataTable_BytesDownloaded);
+DEFINE_STAT(STAT_RuntimeDataTable_ActiveOperations);
+
+DEFINE_STAT(STAT_RuntimeDataTable_ParseMemory);
+DEFINE_STAT(STAT_RuntimeDataTable_BackupMemory);
+
+UE_TRACE_CHANNEL_DEFINE(RuntimeDataTableChannel)
+
+UE_TRACE_EVENT_BEGIN(RuntimeDataTable, Stage)
+	UE_TRACE_EVENT_FIELD(uint64, Cycle)
+	UE_TRACE_EVENT_FIELD(double, DurationSeconds)
+	UE_TRACE_EVENT_FIELD(int64, NumBytes)
+	UE_TRACE_EVENT_FIELD(int32, NumRows)
+	UE_TRACE_EVENT_FIELD(UE::Trace::WideString, StageName)
+	UE_TRACE_EVENT_FIELD(UE::Trace::WideString, OperationName)
+UE_TRACE_EVENT_END()
+
+FCriticalSection FRuntimeDataTableStats::HistogramsCriticalSection;
+TMap<FString, FRuntimeDataTableStats::FLatencyHistogram> FRuntimeDataTableStats::Histograms;
+
+static FAutoConsoleCommandWithOutputDevice DumpLatencyCommand(
+	TEXT("RuntimeDataTable.DumpLatency"),
+	TEXT("Prints how long each stage of each RuntimeDataTable operation has taken so far, as histograms."),
+	FConsoleCommandWithOutputDeviceDelegate::CreateStatic(&FRuntimeDataTableStats::DumpLatencyHistograms));
+
+static FAutoConsoleCommand ResetLatencyCommand(
+	TEXT("RuntimeDataTable.ResetLatency"),
+	TEXT("Empties the histograms printed by RuntimeDataTable.DumpLatency."),
+	FConsoleCommandDelegate::CreateStatic(&FRuntimeDataTableStats::ResetLatencyHistograms));
+
+void FRuntimeDataTableStats::RecordStage(
+	const TCHAR* InStageName, const FName InOperationName, const double InDurationSeconds,
+	const int64 InNumBytes, const int32 InNumRows)
+{
+	const FString OperationName = InOperationName.IsNone() ? FString() : InOperationName.ToString();
+
+	UE_TRACE_LOG(RuntimeDataTable, Stage, RuntimeDataTableChannel)
+		<< Stage.Cycle(FPlatformTime::Cycles64())
+		<< Stage.DurationSeconds(InDurationSeconds)
+		<< Stage.NumBytes(InNumBytes)
+		<< Stage.NumRows(InNumRows)
+		<< Stage.StageName(InStageName)
+		<< Stage.OperationName(*OperationName, OperationName.Len());
+
+	FScopeLock Lock(&HistogramsCriticalSection);
+
+	Histograms.FindOrAdd(InStageName).Add(InDurationSeconds);
+	if (!OperationName.IsEmpty())
+	{
+		Histograms.FindOrAdd(FString::Printf(TEXT("%s:%s"), InStageName, *OperationName)).Add(InDurationSeconds);
+	}
+}
+
+void FRuntimeDataTableStats::DumpLatencyHistograms(FOutputDevice& Ar)
+{
+	FScopeLock Lock(&HistogramsCriticalSection);
+
+	TArray<FString> Names;
+	Histograms.GenerateKeyArray(Names);
+	Names.Sort();
+
+	Ar.Logf(TEXT("RuntimeDataTable latency, %i histograms:"), Names.Num());
+
+	for (const FString& Name : Names)
+	{
+		const FLatencyHistogram& Histogram = Histograms[Name];
+
+		Ar.Logf(TEXT("  %s: count %i, mean %.1fms, min %.1fms, max %.1fms, p50 < %.0fms, p90 < %.0fms, p99 < %.0fms"),
+			*Name, Histogram.Count,
+			Histogram.TotalSeconds * 1000.0 / FMath::Max(Histogram.Count, 1),
+			Histogram.MinSeconds * 1000.0, Histogram.MaxSeconds * 1000.0,
+			Histogram.GetPercentileUpperBoundMs(0.5f),
+			Histogram.GetPercentileUpperBoundMs(0.9f),
+			Histogram.GetPercentileUpperBoundMs(0.99f));
+
+		// Only the buckets something landed in, most operations span a handful of them
+		FString BucketsLine;
+		for (int32 BucketIndex = 0; BucketIndex < NumBuckets; BucketIndex++)
+		{
+			if (Histogram.Buckets[BucketIndex] == 0)
+			{
+				continue;
+			}
+
+			BucketsLine += BucketIndex < NumBuckets - 1 ?
+				FString::Printf(TEXT(" [<%ims] %i"), 1 << BucketIndex, Histogram.Buckets[BucketIndex]) :
+				FString::Printf(TEXT(" [>=%ims] %i"), 1 << (NumBuckets - 2), Histogram.Buckets[BucketIndex]);
+		}
+		Ar.Logf(TEXT("   %s"), *BucketsLine);
+	}
+}
+
+void FRuntimeDataTableStats::ResetLatencyHistograms()
+{
+	FScopeLock Lock(&HistogramsCriticalSection);
+	Histograms.Empty();
+}
+
+void FRuntimeDataTableStats::FLatencyHistogram::Add(const double InSeconds)
+{
+	const double Milliseconds = InSeconds * 1000.0;
+
+	int32 BucketIndex = 0;
+	while (BucketIndex < NumBuckets - 1 && Milliseconds >= static_cast<double>(1 << BucketIndex))
+	{
+		BucketIndex++;
+	}
+
+	Buckets[BucketIndex]++;
+	Count++;
+	TotalSeconds += InSeconds;
+	MinSeconds = FMath::Min(MinSeconds, InSeconds);
+	MaxSeconds = FMath::Max(MaxSeconds, InSeconds);
+}
+
+double FRuntimeDataTableStats::FLatencyHistogram::GetPercentileUpperBoundMs(const float InPercentile) const
+{
+	const int32 Target = FMath::CeilToInt(Count * InPercentile);
+
+	int32 Seen = 0;
+	for (int32 BucketIndex = 0; BucketIndex < NumBuckets - 1; BucketIndex++)
+	{
+		Seen += Buckets[BucketIndex];
+		if (Seen >= Target)
+		{
+			return static_cast<double>(1 << BucketIndex);
+		}
+	}
+
+	// Somewhere in the open-ended bucket, the max is the best we can say
+	return MaxSeconds * 1000.0;
+}
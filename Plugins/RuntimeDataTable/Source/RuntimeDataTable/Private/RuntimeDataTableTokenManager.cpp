@@ -0,0 +1,368 @@
+// Copyright Jared Therriault 2019, 2022
+
+#include "RuntimeDataTableTokenManager.h"
+
+#include "RuntimeDataTableModule.h"
+#include "RuntimeDataTableProjectSettings.h"
+#include "RuntimeDataTableStats.h"
+
+#include "jwt-cpp/jwt.h"
+
+#include "Dom/JsonObject.h"
+#include "Interfaces/IHttpResponse.h"
+#include "Misc/ScopeLock.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+
+FRuntimeDataTableTokenManager& FRuntimeDataTableTokenManager::Get()
+{
+	static FRuntimeDataTableTokenManager Instance;
+	return Instance;
+}
+
+void FRuntimeDataTableTokenManager::RequestAccessToken(
+	FRuntimeDataTableTokenInfo InTokenInfo, const FRDTGetJWTDelegate& CallOnComplete)
+{
+	FString ErrorMessage;
+	if (!URuntimeDataTableObject::ValidateTokenInfo(InTokenInfo, ErrorMessage))
+	{
+		FRuntimeDataTableCallbackInfo FailedInfo;
+		FailedInfo.bWasSuccessful = false;
+		FailedInfo.OperationName = URuntimeDataTableObject::GetTokenOperationName;
+		FailedInfo.ResponseAsString = "ERROR: InTokenInfo is not valid.";
+		FRuntimeDataTableModule::Print(FString::Printf(
+			TEXT("%hs: %s"),
+			__FUNCTION__, *FailedInfo.ResponseAsString), FRuntimeDataTableModule::ELogType::Error);
+		CallOnComplete.ExecuteIfBound(FailedInfo, nullptr);
+		return;
+	}
+
+	const URuntimeDataTableProjectSettings* Settings = GetDefault<URuntimeDataTableProjectSettings>();
+	if (!Settings || !Settings->bCacheAccessTokens)
+	{
+		// Caching is off, every caller gets its own exchange like before
+		SendTokenRequest(InTokenInfo, "", CallOnComplete);
+		return;
+	}
+
+	const FString CacheKey = MakeCacheKey(InTokenInfo);
+
+	FString CachedAccessToken;
+	FDateTime CachedTimeOfExpiration;
+	bool bShouldSendRequest = false;
+	{
+		FScopeLock Lock(&CacheCriticalSection);
+
+		FCachedAccessToken& CachedToken = CachedTokens.FindOrAdd(CacheKey);
+		CachedToken.bUsedSinceLastRefresh = true;
+
+		const FTimespan TimeRemaining = CachedToken.TimeOfExpiration - FDateTime::UtcNow();
+		if (!CachedToken.AccessToken.IsEmpty() && TimeRemaining.GetTotalSeconds() > MinimumUsableSeconds)
+		{
+			CachedAccessToken = CachedToken.AccessToken;
+			CachedTimeOfExpiration = CachedToken.TimeOfExpiration;
+		}
+		else
+		{
+			CachedToken.PendingCallbacks.Add(CallOnComplete);
+
+			// Only the first caller starts the exchange, everyone else piggybacks on it
+			if (!CachedToken.bRefreshInFlight)
+			{
+				CachedToken.bRefreshInFlight = true;
+				CachedToken.bUsedSinceLastRefresh = false;
+				CachedToken.TokenInfo = InTokenInfo;
+				bShouldSendRequest = true;
+			}
+		}
+	}
+
+	if (!CachedAccessToken.IsEmpty())
+	{
+		FRuntimeDataTableModule::Print(FString::Printf(
+			TEXT("%hs: Reusing cached access token for %s"), __FUNCTION__, *InTokenInfo.ServiceAccountEmail));
+
+		FRuntimeDataTableCallbackInfo CallbackInfo;
+		CallbackInfo.OperationName = URuntimeDataTableObject::GetTokenOperationName;
+		CallbackInfo.bWasSuccessful = true;
+		ExecuteWithToken(CallOnComplete, CallbackInfo, CachedAccessToken, CachedTimeOfExpiration);
+	}
+	else if (bShouldSendRequest)
+	{
+		SendTokenRequest(InTokenInfo, CacheKey, FRDTGetJWTDelegate());
+	}
+}
+
+void FRuntimeDataTableTokenManager::InvalidateAccessToken(FRuntimeDataTableTokenInfo InTokenInfo)
+{
+	FString ErrorMessage;
+	URuntimeDataTableObject::ValidateTokenInfo(InTokenInfo, ErrorMessage);
+
+	FScopeLock Lock(&CacheCriticalSection);
+
+	if (FCachedAccessToken* CachedToken = CachedTokens.Find(MakeCacheKey(InTokenInfo)))
+	{
+		CachedToken->AccessToken.Empty();
+		CachedToken->TimeOfExpiration = FDateTime::MinValue();
+	}
+}
+
+void FRuntimeDataTableTokenManager::InvalidateAccessToken(const FString& InAccessToken)
+{
+	if (InAccessToken.IsEmpty())
+	{
+		return;
+	}
+
+	FScopeLock Lock(&CacheCriticalSection);
+
+	for (TPair<FString, FCachedAccessToken>& Pair : CachedTokens)
+	{
+		if (Pair.Value.AccessToken == InAccessToken)
+		{
+			Pair.Value.AccessToken.Empty();
+			Pair.Value.TimeOfExpiration = FDateTime::MinValue();
+		}
+	}
+}
+
+void FRuntimeDataTableTokenManager::Reset()
+{
+	FScopeLock Lock(&CacheCriticalSection);
+
+	for (TPair<FString, FCachedAccessToken>& Pair : CachedTokens)
+	{
+		if (Pair.Value.RefreshTickerHandle.IsValid())
+		{
+			FTSTicker::GetCoreTicker().RemoveTicker(Pair.Value.RefreshTickerHandle);
+		}
+	}
+
+	CachedTokens.Empty();
+	CachedSigners.Empty();
+}
+
+FString FRuntimeDataTableTokenManager::CreateSignedAssertion(FRuntimeDataTableTokenInfo InTokenInfo)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FRuntimeDataTableTokenManager::CreateSignedAssertion);
+	SCOPE_CYCLE_COUNTER(STAT_RuntimeDataTable_SignAssertion);
+
+	FString ErrorMessage;
+	if (!URuntimeDataTableObject::ValidateTokenInfo(InTokenInfo, ErrorMessage))
+	{
+		return "";
+	}
+
+	InTokenInfo.PrivateKey = InTokenInfo.PrivateKey.ReplaceEscapedCharWithChar();
+	InTokenInfo.ClaimUrl = InTokenInfo.ClaimUrl.ReplaceEscapedCharWithChar();
+	InTokenInfo.TokenUri = InTokenInfo.TokenUri.ReplaceEscapedCharWithChar();
+
+	const TSharedPtr<jwt::algorithm::rs256> Signer = FindOrCreateSigner(InTokenInfo.PrivateKey);
+	if (!Signer.IsValid())
+	{
+		return "";
+	}
+
+	const jwt::builder<jwt::traits::kazuho_picojson> TokenBuilder = jwt::create()
+		.set_algorithm("RS256")
+		.set_type("JWT")
+		.set_issuer(TCHAR_TO_ANSI(*InTokenInfo.ServiceAccountEmail))
+		.set_payload_claim("scope", jwt::claim(std::string{ TCHAR_TO_ANSI(*InTokenInfo.ClaimUrl) }))
+		.set_audience(TCHAR_TO_ANSI(*InTokenInfo.TokenUri))
+		.set_expires_at(std::chrono::system_clock::now() + std::chrono::seconds{ InTokenInfo.SecondsUntilExpiration })
+		.set_issued_at(std::chrono::system_clock::now());
+
+	const FString& TokenString = FString(TokenBuilder.sign(*Signer).c_str());
+
+	FRuntimeDataTableModule::Print(FString::Printf(TEXT("%hs: Token:\n%s"), __FUNCTION__, *TokenString));
+
+	return TokenString;
+}
+
+FString FRuntimeDataTableTokenManager::MakeCacheKey(const FRuntimeDataTableTokenInfo& InTokenInfo)
+{
+	// The key hash keeps a rotated key for the same account from picking up the old account's token
+	return FString::Printf(TEXT("%s|%s|%s|%08x"),
+		*InTokenInfo.ServiceAccountEmail, *InTokenInfo.ClaimUrl, *InTokenInfo.TokenUri, GetTypeHash(InTokenInfo.PrivateKey));
+}
+
+TSharedPtr<jwt::algorithm::rs256> FRuntimeDataTableTokenManager::FindOrCreateSigner(const FString& InPrivateKey)
+{
+	FScopeLock Lock(&CacheCriticalSection);
+
+	if (const TSharedPtr<jwt::algorithm::rs256>* ExistingSigner = CachedSigners.Find(InPrivateKey))
+	{
+		return *ExistingSigner;
+	}
+
+	// Parsing the PEM is the expensive part of signing, so it only happens once per key
+	TSharedPtr<jwt::algorithm::rs256> NewSigner = MakeShared<jwt::algorithm::rs256>("", TCHAR_TO_ANSI(*InPrivateKey), "", "");
+	CachedSigners.Add(InPrivateKey, NewSigner);
+
+	return NewSigner;
+}
+
+void FRuntimeDataTableTokenManager::SendTokenRequest(
+	const FRuntimeDataTableTokenInfo& InTokenInfo, const FString& CacheKey, const FRDTGetJWTDelegate& UncachedCallback)
+{
+	const FString SignedToken = CreateSignedAssertion(InTokenInfo);
+
+	FHttpModule* HTTP_Module = &FHttpModule::Get();
+	TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = HTTP_Module->CreateRequest();
+
+	Request->SetURL(InTokenInfo.TokenUri + "?grant_type=urn%3Aietf%3Aparams%3Aoauth%3Agrant-type%3Ajwt-bearer&assertion=" + SignedToken);
+	Request->SetVerb("POST");
+	Request->OnProcessRequestComplete().BindRaw(
+		this, &FRuntimeDataTableTokenManager::OnTokenResponseReceived, CacheKey, InTokenInfo, UncachedCallback);
+	Request->SetTimeout(30);
+	Request->ProcessRequest();
+}
+
+void FRuntimeDataTableTokenManager::OnTokenResponseReceived(
+	FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful,
+	FString CacheKey, FRuntimeDataTableTokenInfo InTokenInfo, FRDTGetJWTDelegate UncachedCallback)
+{
+	Request->OnProcessRequestComplete().Unbind();
+
+	FRuntimeDataTableStats::RecordStage(
+		TEXT("Token"), URuntimeDataTableObject::GetTokenOperationName, Request->GetElapsedTime(),
+		Response.IsValid() ? Response->GetContentLength() : 0);
+
+	FRuntimeDataTableCallbackInfo CallbackInfo;
+	CallbackInfo.OperationName = URuntimeDataTableObject::GetTokenOperationName;
+	CallbackInfo.bWasSuccessful = bWasSuccessful && Response.IsValid();
+	CallbackInfo.ResponseAsString = CallbackInfo.bWasSuccessful ? Response->GetContentAsString() : "";
+	CallbackInfo.ResponseCode = Response.IsValid() ? Response->GetResponseCode() : INDEX_NONE;
+
+	FString AccessToken;
+	int32 SecondsUntilExpiration = InTokenInfo.SecondsUntilExpiration;
+	if (CallbackInfo.bWasSuccessful && CallbackInfo.ResponseCode < 300)
+	{
+		TSharedPtr<FJsonObject> PostResponse = MakeShareable(new FJsonObject());
+		const TSharedRef<TJsonReader<>> JsonReader = TJsonReaderFactory<>::Create(CallbackInfo.ResponseAsString);
+
+		if (FJsonSerializer::Deserialize(JsonReader, PostResponse) && PostResponse.IsValid())
+		{
+			PostResponse->TryGetStringField("access_token", AccessToken);
+
+			// The access token usually outlives the assertion by a wide margin, trust the server on how long
+			int32 ExpiresIn = 0;
+			if (PostResponse->TryGetNumberField("expires_in", ExpiresIn) && ExpiresIn > 0)
+			{
+				SecondsUntilExpiration = ExpiresIn;
+			}
+		}
+	}
+	CallbackInfo.bWasSuccessful = !AccessToken.IsEmpty();
+
+	FRuntimeDataTableModule::Print(FString::Printf(
+		TEXT("%hs: Token response received, success: %s, Response code: %i"),
+		__FUNCTION__, *FString(CallbackInfo.bWasSuccessful ? "true" : "false"), CallbackInfo.ResponseCode),
+		CallbackInfo.bWasSuccessful ? FRuntimeDataTableModule::ELogType::Display : FRuntimeDataTableModule::ELogType::Error);
+
+	const FDateTime TimeOfExpiration = FDateTime::UtcNow() + FTimespan::FromSeconds(SecondsUntilExpiration);
+
+	if (CacheKey.IsEmpty())
+	{
+		ExecuteWithToken(UncachedCallback, CallbackInfo, AccessToken, TimeOfExpiration);
+		return;
+	}
+
+	TArray<FRDTGetJWTDelegate> CallbacksToExecute;
+	{
+		FScopeLock Lock(&CacheCriticalSection);
+
+		if (FCachedAccessToken* CachedToken = CachedTokens.Find(CacheKey))
+		{
+			CachedToken->bRefreshInFlight = false;
+
+			// A failed background refresh leaves the previous token in place until it actually runs out
+			if (CallbackInfo.bWasSuccessful)
+			{
+				CachedToken->AccessToken = AccessToken;
+				CachedToken->TimeOfExpiration = TimeOfExpiration;
+				ScheduleBackgroundRefresh(*CachedToken, CacheKey);
+			}
+
+			CallbacksToExecute = MoveTemp(CachedToken->PendingCallbacks);
+		}
+	}
+
+	for (const FRDTGetJWTDelegate& Callback : CallbacksToExecute)
+	{
+		ExecuteWithToken(Callback, CallbackInfo, AccessToken, TimeOfExpiration);
+	}
+}
+
+bool FRuntimeDataTableTokenManager::OnRefreshTimerElapsed(float DeltaTime, FString CacheKey)
+{
+	FRuntimeDataTableTokenInfo TokenInfo;
+	bool bShouldSendRequest = false;
+	{
+		FScopeLock Lock(&CacheCriticalSection);
+
+		if (FCachedAccessToken* CachedToken = CachedTokens.Find(CacheKey))
+		{
+			CachedToken->RefreshTickerHandle.Reset();
+
+			// Nobody has asked for this token since it was issued, let it lapse rather than keep refreshing forever
+			if (CachedToken->bUsedSinceLastRefresh && !CachedToken->bRefreshInFlight)
+			{
+				CachedToken->bRefreshInFlight = true;
+				CachedToken->bUsedSinceLastRefresh = false;
+				TokenInfo = CachedToken->TokenInfo;
+				bShouldSendRequest = true;
+			}
+		}
+	}
+
+	if (bShouldSendRequest)
+	{
+		FRuntimeDataTableModule::Print(FString::Printf(
+			TEXT("%hs: Refreshing access token for %s in the background"), __FUNCTION__, *TokenInfo.ServiceAccountEmail));
+
+		SendTokenRequest(TokenInfo, CacheKey, FRDTGetJWTDelegate());
+	}
+
+	// One-shot, the next refresh is scheduled when this one completes
+	return false;
+}
+
+void FRuntimeDataTableTokenManager::ScheduleBackgroundRefresh(FCachedAccessToken& CachedToken, const FString& CacheKey)
+{
+	if (CachedToken.RefreshTickerHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(CachedToken.RefreshTickerHandle);
+	}
+
+	int32 RefreshMarginSeconds = 60;
+	if (const URuntimeDataTableProjectSettings* Settings = GetDefault<URuntimeDataTableProjectSettings>())
+	{
+		RefreshMarginSeconds = Settings->AccessTokenRefreshMarginSeconds;
+	}
+
+	const double SecondsUntilRefresh = FMath::Max(
+		(CachedToken.TimeOfExpiration - FDateTime::UtcNow()).GetTotalSeconds() - RefreshMarginSeconds, 1.0);
+
+	CachedToken.RefreshTickerHandle = FTSTicker::GetCoreTicker().AddTicker(
+		FTickerDelegate::CreateRaw(this, &FRuntimeDataTableTokenManager::OnRefreshTimerElapsed, CacheKey),
+		SecondsUntilRefresh);
+}
+
+void FRuntimeDataTableTokenManager::ExecuteWithToken(
+	const FRDTGetJWTDelegate& CallOnComplete, FRuntimeDataTableCallbackInfo CallbackInfo,
+	const FString& AccessToken, const FDateTime& TimeOfExpiration)
+{
+	if (!CallbackInfo.bWasSuccessful)
+	{
+		CallOnComplete.ExecuteIfBound(CallbackInfo, nullptr);
+		return;
+	}
+
+	// Each caller gets its own token object so that none of them can invalidate another's
+	URuntimeDataTableWebToken* NewToken = NewObject<URuntimeDataTableWebToken>();
+	const int32 SecondsRemaining = (int32)(TimeOfExpiration - FDateTime::UtcNow()).GetTotalSeconds();
+	CallbackInfo.bWasSuccessful = NewToken->Init(AccessToken, SecondsRemaining);
+
+	CallOnComplete.ExecuteIfBound(CallbackInfo, CallbackInfo.bWasSuccessful ? NewToken : nullptr);
+}
@@ -4,6 +4,8 @@
 
 #include "Containers/UnrealString.h"
 
+class FRuntimeDataTableJsonPayloadWriter;
+
 struct FCsvToGoogleSheetsHandler
 {
 	void InferSpecifiedRangeFromTitleAndStartingCell(
@@ -15,6 +17,7 @@ struct FCsvToGoogleSheetsHandler
 
 	FString GetStartingCell();
 
+	// Column and row are 1-based. See RuntimeDataTableA1 for the conversions without logging.
 	static bool A1_CellToColumnAndRowIndices(const FString& InCell, int32& OutColumnIndex, int32& OutRowIndex);
 
 	static FString GetCellInA1_NotationFromColumnAndRowIndices(
@@ -42,16 +45,15 @@ struct FCsvToGoogleSheetsHandler
 	static FCsvToGoogleSheetsHandler CsvToSheetTabData(FString InCSVString);
 	
 	FString GetAllArrayValuesAsJsonString(const bool bAddValuesKey, const bool bWrapInCurlyBraces) const;
+
+	// Writes ArrayValues as a JSON array of arrays of strings, optionally as the "values" field of the current object
+	void WriteAllArrayValuesAsJson(FRuntimeDataTableJsonPayloadWriter& Writer, const bool bAddValuesKey) const;
+
+	// Total length of every cell, a lower bound for the size of any payload built from ArrayValues
+	int32 GetTotalValueLength() const;
 	
 	FString SpecifiedRange = "A1";
 
-	// ReSharper disable once CppConstValueFunctionReturnType
-	static const TArray<FString> GetAlphabet()
-	{
-		return { "A", "B", "C", "D", "E", "F", "G", "H", "I", "J", "K", "L", "M",
-			"N", "O", "P", "Q", "R", "S", "T", "U", "V", "W", "X", "Y", "Z" };
-	}
-
 	TArray<TArray<FString>> ArrayValues;
 
 	static constexpr int32 MaxColumnCount = 18278;
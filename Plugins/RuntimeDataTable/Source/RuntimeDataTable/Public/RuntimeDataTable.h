@@ -9,10 +9,17 @@
 
 #include "RuntimeDataTable.generated.h"
 
+class UDataTable;
 class URuntimeDataTableObject;
 class URuntimeDataTableWebToken;
 
+class FRuntimeDataTableTokenManager;
+
 struct FCsvToGoogleSheetsHandler;
+struct FRuntimeDataTableMultiTabDownload;
+struct FRuntimeDataTableChunkedUpload;
+struct FRuntimeDataTableSnapshotFetch;
+struct FRuntimeDataTableSheetSnapshot;
 
 // Returned in every delegate
 USTRUCT(BlueprintType)
@@ -31,6 +38,14 @@ struct FRuntimeDataTableCallbackInfo
 
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Runtime DataTable")
 	int32 ResponseCode = INDEX_NONE;
+
+	/** For operations sent as several requests, how many of them have finished. Zero otherwise. */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Runtime DataTable")
+	int32 CompletedChunks = 0;
+
+	/** For operations sent as several requests, how many there are in total. Zero otherwise. */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Runtime DataTable")
+	int32 TotalChunks = 0;
 };
 
 // Used to return a JWT internally. Don't use this.
@@ -51,6 +66,10 @@ struct FRuntimeDataTableOperationParams
 	/** How long to wait for the operation to complete before a timeout is considered */
 	UPROPERTY(BlueprintReadWrite, Category = "Runtime DataTable")
 	float RequestTimeout = 30.f;
+
+	/** If the sheet is in the project settings' PrefetchManifest, use the copy fetched at startup rather than downloading it again */
+	UPROPERTY(BlueprintReadWrite, Category = "Runtime DataTable")
+	bool bUsePrefetchCache = true;
 };
 
 // Used to build an authentication token
@@ -75,12 +94,47 @@ struct FRuntimeDataTableTokenInfo
 	UPROPERTY(BlueprintReadWrite, Category = "Runtime DataTable")
 		FString TokenUri = "https://oauth2.googleapis.com/token";
 
-	// How long should this token last? Min is 1 second, Max is 3600 seconds (1 hour).
-	// Generally it's best practice to keep the expiration short and generate a new token for each operation.
+	// How long should the signed assertion last? Min is 1 second, Max is 3600 seconds (1 hour).
+	// The access token it is exchanged for lasts as long as Google says it does and is cached between operations.
 	UPROPERTY(BlueprintReadWrite, Category = "Runtime DataTable")
 		int32 SecondsUntilExpiration = 30;
 };
 
+// One tab's worth of a multi-tab download
+USTRUCT(BlueprintType)
+struct FRuntimeDataTableTabResult
+{
+	GENERATED_BODY()
+
+	/** The tab name, gid or A1 range this result was requested with */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Runtime DataTable")
+	FString TabNameOrRange;
+
+	/** Whether this particular tab was downloaded and parsed */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Runtime DataTable")
+	bool bWasSuccessful = false;
+
+	/** The parsed tab. Empty if bWasSuccessful is false. */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Runtime DataTable")
+	FEasyCsvInfo CsvInfo;
+
+	/** Why this tab failed, if it did */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Runtime DataTable")
+	FString ErrorMessage;
+};
+
+DECLARE_DYNAMIC_DELEGATE_TwoParams(
+	FRDTGetMultipleTabsDelegate, FRuntimeDataTableCallbackInfo, CallbackInfo, const TArray<FRuntimeDataTableTabResult>&, TabResults);
+
+DECLARE_DYNAMIC_DELEGATE_TwoParams(
+	FRDTGetCsvInfoDelegate, FRuntimeDataTableCallbackInfo, CallbackInfo, const FEasyCsvInfo&, CsvInfo);
+
+DECLARE_DYNAMIC_DELEGATE_TwoParams(FRDTSheetRowDelegate, FName, RowKey, const FEasyCsvStringValueArray&, RowValues);
+
+DECLARE_DYNAMIC_DELEGATE_FourParams(
+	FRDTSnapshotChangesDelegate, FRuntimeDataTableCallbackInfo, CallbackInfo, const FEasyCsvInfo&, CsvInfo,
+	const TArray<FName>&, ChangedRows, const TArray<FName>&, RemovedRows);
+
 UENUM(BlueprintType)
 enum class ERuntimeDataTableBackupResultCode : uint8
 {
@@ -89,9 +143,14 @@ enum class ERuntimeDataTableBackupResultCode : uint8
 	DownloadSucceededButCsvCouldNotBeParsed,
 	DownloadFailedAndBackupLoaded,
 	DownloadSucceededAndBackupSaved,
-	DownloadSucceededAndBackupCouldNotBeSaved
+	DownloadSucceededAndBackupCouldNotBeSaved,
+	// Only from ValidateGoogleSheetsDownloadAndLoadBackupIfNeeded, which leaves the save running in the background. Failures are logged.
+	DownloadSucceededAndBackupSaveStarted
 };
 
+DECLARE_DYNAMIC_DELEGATE_ThreeParams(
+	FRDTGetBackupResultDelegate, bool, bHasCsvInfo, const FEasyCsvInfo&, CsvInfo, ERuntimeDataTableBackupResultCode, ResultCode);
+
 // A class that contains authentication token information
 UCLASS()
 class RUNTIMEDATATABLE_API URuntimeDataTableWebToken : public UObject
@@ -189,6 +248,12 @@ public:
 	UFUNCTION()
 	static FString GetGoogleSheetsUrlPrefix();
 
+	// docs.google.com/spreadsheets/d/{spreadsheetId}/export?format=csv&gid={gid}
+	static FString GetCsvExportUrl(const FString& InSheetURL);
+
+	// The same, for a spreadsheet id and a gid that may be empty
+	static FString GetCsvExportUrl(const FString& InSpreadsheetId, const FString& InGid);
+
 	UFUNCTION()
 	static FString GetMimeCsv();
 
@@ -204,6 +269,10 @@ public:
 	UFUNCTION()
 	static FString GetGoogleSheetsBatchUpdateURL(const FString InSpreadsheetId);
 
+	// sheets.googleapis.com/v4/spreadsheets/{spreadsheetId}/values:batchGet
+	UFUNCTION()
+	static FString GetGoogleSheetsValuesBatchGetURL(const FString InSpreadsheetId);
+
 	/**
 	 * If you want to have row keys generated for you on export, insert the return value from this function into the export function's "Keys" parameter. You can also use "Make Array" with blank entries in blueprint or create a new TArray<FName> (or simply "{}") in C++ if you prefer.
 	 * @return This is a blank array of FName. This signifies to the function that we should generate row keys on export. 
@@ -239,22 +308,154 @@ public:
 		}
 	}
 	
+	/**
+	 * Like BuildGoogleSheetDownloadLinkAndGetAsCsv, but the download is parsed into an FEasyCsvInfo on a worker thread as soon as it arrives.
+	 * The response body is read straight from its UTF-8 bytes, so the game thread never holds it as a string; only the finished CsvInfo is handed back.
+	 * Prefer this over calling MakeCsvInfoFromString on the downloaded string for anything larger than a few hundred rows.
+	 * @param InTokenInfo A validated URuntimeDataTableWebToken object. Used to authenticate the Sheets operation. Can be default if the sheet is public.
+	 * @param OperationParams Generic request operation parameters
+	 * @param InSheetURL The URL at which this sheet can be found.
+	 * @param CallOnComplete Called on the game thread once the sheet has been downloaded and parsed. CallbackInfo.ResponseAsString only holds the response if the request failed.
+	 * @param bSheetIsPublic Set this parameter to true if your sheet does not require authentication because it is public and you have not provided a valid InTokenInfo. This avoids token validation.
+	 * @param ParseHeaders If true, the first row of the sheet is treated as column labels, or headers.
+	 * @param ParseKeys If true, the first column of the sheet is treated as row labels, or keys.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Runtime DataTable", meta = (AdvancedDisplay = "ParseHeaders, ParseKeys"))
+		static void DownloadSheetAsCsvInfo(
+			const FRuntimeDataTableTokenInfo InTokenInfo, const FRuntimeDataTableOperationParams OperationParams,
+			const FRDTGetCsvInfoDelegate CallOnComplete, const FString InSheetURL, const bool bSheetIsPublic = false,
+			const bool ParseHeaders = true, const bool ParseKeys = true)
+	{
+		if (URuntimeDataTableObject* RuntimeDataTableObject = CreateRuntimeDataTableObject())
+		{
+			RuntimeDataTableObject->DownloadSheetAsCsvInfo_Internal(
+				InTokenInfo, OperationParams, CallOnComplete, InSheetURL, bSheetIsPublic, ParseHeaders, ParseKeys);
+		}
+	}
+
+	/**
+	 * Keep an eye on a sheet and be told whenever one of its rows is added, changed or removed.
+	 * The sheet is downloaded in the background every PollIntervalSeconds and compared row by row with the previous download, keyed by the first column.
+	 * Nothing is called if nothing changed. Every subscriber to the same sheet shares one poller, which polls at the shortest interval asked for.
+	 * On subscribing, OnRowAdded is called for every row the sheet has, straight away if another subscriber has already downloaded it.
+	 * @param InTokenInfo A validated URuntimeDataTableWebToken object. Used to authenticate the Sheets operation. Can be default if the sheet is public.
+	 * @param OperationParams Generic request operation parameters, used for every poll.
+	 * @param InSheetURL The URL at which this sheet can be found.
+	 * @param PollIntervalSeconds How often to check the sheet for changes. Min is 1 second, but mind your API quota.
+	 * @param bSheetIsPublic Set this parameter to true if your sheet does not require authentication because it is public and you have not provided a valid InTokenInfo.
+	 * @return A handle to pass to UnsubscribeFromSheet, or -1 if the subscription could not be made.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Runtime DataTable")
+		static int32 SubscribeToSheet(
+			const FRuntimeDataTableTokenInfo InTokenInfo, const FRuntimeDataTableOperationParams OperationParams,
+			const FString InSheetURL, const float PollIntervalSeconds,
+			const FRDTSheetRowDelegate OnRowAdded, const FRDTSheetRowDelegate OnRowChanged, const FRDTSheetRowDelegate OnRowRemoved,
+			const bool bSheetIsPublic = false);
+
+	/**
+	 * Stop receiving changes from a sheet. The sheet stops being polled once it has no subscribers left.
+	 * @param SubscriptionHandle The handle returned by SubscribeToSheet.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Runtime DataTable")
+		static void UnsubscribeFromSheet(const int32 SubscriptionHandle);
+
+	/**
+	 * Cancel every Google Sheets operation still running under OperationName, whatever it is doing.
+	 * Each cancelled operation still calls its OnComplete, once, as a failure.
+	 * Operations still waiting on their access token fail as soon as it arrives, without sending anything.
+	 * @param OperationName The OperationName from the OperationParams the operations were started with.
+	 * @return How many operations were cancelled.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Runtime DataTable")
+		static int32 CancelOperation(const FName OperationName);
+
+	/**
+	 * Load a sheet snapshot baked into the build by URuntimeDataTableSnapshotCommandlet, or the newer copy of it saved by FetchSheetSnapshotChanges.
+	 * Snapshots are read straight from disk with no download and no CSV parse, so the data is there from the first frame.
+	 * @param SnapshotName The SnapshotName of an entry in the project settings' SheetSnapshots.
+	 * @param CsvInfo The sheet as it was when the snapshot was taken.
+	 * @return Whether a snapshot could be found and read.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Runtime DataTable")
+		static bool LoadSheetSnapshot(const FString SnapshotName, FEasyCsvInfo& CsvInfo);
+
+	/**
+	 * Download the current version of a snapshotted sheet and find out which rows differ from the newest snapshot on disk.
+	 * If anything changed, the download becomes the new snapshot in Saved so the next LoadSheetSnapshot starts from it.
+	 * If the download fails, CallOnComplete still gets the snapshot's CsvInfo, with bWasSuccessful false and no changed rows.
+	 * @param InTokenInfo A validated URuntimeDataTableWebToken object. Used to authenticate the Sheets operation. Can be default if the sheet is public.
+	 * @param OperationParams Generic request operation parameters
+	 * @param CallOnComplete Called on the game thread with the whole sheet, the keys of rows that are new or changed, and the keys of rows that are gone.
+	 * @param SnapshotName The SnapshotName of an entry in the project settings' SheetSnapshots. Its SheetURL is the one downloaded.
+	 * @param bSheetIsPublic Set this parameter to true if your sheet does not require authentication because it is public and you have not provided a valid InTokenInfo.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Runtime DataTable")
+		static void FetchSheetSnapshotChanges(
+			const FRuntimeDataTableTokenInfo InTokenInfo, const FRuntimeDataTableOperationParams OperationParams,
+			const FRDTSnapshotChangesDelegate CallOnComplete, const FString SnapshotName, const bool bSheetIsPublic = false)
+	{
+		if (URuntimeDataTableObject* RuntimeDataTableObject = CreateRuntimeDataTableObject())
+		{
+			RuntimeDataTableObject->FetchSheetSnapshotChanges_Internal(
+				InTokenInfo, OperationParams, CallOnComplete, SnapshotName, bSheetIsPublic);
+		}
+	}
+
+	/**
+	 * Download several tabs or ranges of the same spreadsheet in one operation and parse each into its own FEasyCsvInfo.
+	 * Private sheets are fetched with a single values:batchGet request. Public sheets are exported tab by tab, a few at a time.
+	 * @param InTokenInfo A validated URuntimeDataTableWebToken object. Used to authenticate the Sheets operation. Can be default if the sheet is public.
+	 * @param OperationParams Generic request operation parameters
+	 * @param InSpreadsheetId This is the spreadsheet ID number or key. Get it from your spreadsheet URL by calling GetSpreadsheetIdFromUrl.
+	 * @param InTabNamesOrRanges Tab names ("Weapons"), A1 ranges ("Weapons!A1:F200") or, for public sheets, gids ("0", "1437462410").
+	 * @param CallOnComplete Called once every tab has finished. CallbackInfo is only successful if every tab was; check each TabResult for details.
+	 * @param bSheetIsPublic Set this parameter to true if your sheet does not require authentication because it is public and you have not provided a valid InTokenInfo. This avoids token validation.
+	 * @param ParseHeaders If true, the first row of each tab is treated as column labels, or headers.
+	 * @param ParseKeys If true, the first column of each tab is treated as row labels, or keys.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Runtime DataTable", meta = (AdvancedDisplay = "ParseHeaders, ParseKeys"))
+		static void DownloadMultipleTabsAsCsvInfo(
+			const FRuntimeDataTableTokenInfo InTokenInfo, const FRuntimeDataTableOperationParams OperationParams,
+			const FRDTGetMultipleTabsDelegate CallOnComplete, const FString InSpreadsheetId, const TArray<FString>& InTabNamesOrRanges,
+			const bool bSheetIsPublic = false, const bool ParseHeaders = true, const bool ParseKeys = true)
+	{
+		if (URuntimeDataTableObject* RuntimeDataTableObject = CreateRuntimeDataTableObject())
+		{
+			RuntimeDataTableObject->DownloadMultipleTabsAsCsvInfo_Internal(
+				InTokenInfo, OperationParams, CallOnComplete, InSpreadsheetId, InTabNamesOrRanges, bSheetIsPublic, ParseHeaders, ParseKeys);
+		}
+	}
+	
 	/**
 	 * Determines if your CSV download was successful and tries to save the download to BackupSavePath if provided.
 	 * If the download failed, will attempt to load the CSV from a local backup.
 	 * If a CSV exists after that, will attempt to create and output FEasyCsvInfo from it.
+	 * Deprecated: parsing the download and loading the backup both block the game thread, use ValidateGoogleSheetsDownloadAndLoadBackupIfNeededAsync.
 	 * @return Whether FEasyCsvInfo could be parsed or not, regardless of whether it came from Google Sheets or a backup.
 	 * @param InCallbackInfo A struct generated after calling BuildGoogleSheetDownloadLinkAndGetAsCsv. Contains information about the response from Google.
 	 * @param OutCsvInfo If the download succeeded or the backup was loaded, this is the output FEasyCsvInfo.
 	 * @param OutResultCode A result code describing the action or error resulting from this function.
-	 * @param BackupSavePath Optional: If you have downloaded a sheet, you may save the sheet to a local path on disk.
+	 * @param BackupSavePath Optional: If you have downloaded a sheet, you may save the sheet to a local path on disk. Saved in the background, as the plain CSV and a new compressed version; DownloadSucceededAndBackupSaveStarted means the save was started, not that it succeeded.
 	 * @param BackupLoadPath Optional: If no "InSheetURL" is specified or the sheet could not be downloaded for any reason, will attempt to load the CSV from the local disk at the specified path instead.
 	 */
-	UFUNCTION(BlueprintCallable, Category = "Runtime DataTable")
+	UFUNCTION(BlueprintCallable, Category = "Runtime DataTable", meta=(DeprecatedFunction, DeprecationMessage="Blocks the game thread on parsing and disk IO. Use ValidateGoogleSheetsDownloadAndLoadBackupIfNeededAsync instead."))
 		static bool ValidateGoogleSheetsDownloadAndLoadBackupIfNeeded(
 			const FRuntimeDataTableCallbackInfo InCallbackInfo,
 			FEasyCsvInfo& OutCsvInfo, ERuntimeDataTableBackupResultCode& OutResultCode,
 			const FString& BackupSavePath = "", const FString& BackupLoadPath = "");
+
+	/**
+	 * Same as ValidateGoogleSheetsDownloadAndLoadBackupIfNeeded, but parsing the download, saving the backup and loading the fallback all happen on a worker thread.
+	 * Backups are compressed and versioned, see NumBackupVersionsToKeep and BackupCompressionFormat in project settings.
+	 * @param InCallbackInfo A struct generated after calling BuildGoogleSheetDownloadLinkAndGetAsCsv. Contains information about the response from Google.
+	 * @param CallOnComplete Called on the game thread with the parsed FEasyCsvInfo, if there is one, and a result code describing where it came from.
+	 * @param BackupSavePath Optional: If you have downloaded a sheet, you may save the sheet to a local path on disk. DownloadSucceededAndBackupSaved means the save has finished.
+	 * @param BackupLoadPath Optional: If the sheet could not be downloaded for any reason, will attempt to load the newest backup at the specified path instead.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Runtime DataTable")
+		static void ValidateGoogleSheetsDownloadAndLoadBackupIfNeededAsync(
+			const FRuntimeDataTableCallbackInfo InCallbackInfo, const FRDTGetBackupResultDelegate CallOnComplete,
+			const FString& BackupSavePath = "", const FString& BackupLoadPath = "");
 	
 	// Export
 
@@ -280,6 +481,57 @@ public:
 		}
 	}
 
+	/**
+	 * Like WriteCsvToSheet, but only sends the cells that changed since the last time this tab was written to in this session.
+	 * The first write to a tab reads its size and rewrites it completely, every write after that is a single batchUpdate request
+	 * containing only the grid growth, the cells to clear and the runs of cells that changed. Nothing is sent if nothing changed.
+	 * Changes made to the sheet by anyone else are not detected. Set bForceFullWrite if the sheet may have been edited by hand.
+	 * @param InTokenInfo A validated URuntimeDataTableWebToken object. Used to authenticate the Sheets operation. When writing to a sheet, you must provide a valid InTokenInfo even if the sheet is public.
+	 * @param OperationParams Generic request operation parameters
+	 * @param InSpreadsheetId This is the spreadsheet ID number or key. Get it from your spreadsheet URL by calling GetSpreadsheetIdFromUrl.
+	 * @param InSheetId The GID for the desired sheet tab
+	 * @param InCsv This is the Csv data represented as a string.
+	 * @param CallOnComplete This delegate will be called when the operation completes and tell you whether or not it was successful and return the response as a string.
+	 * @param bForceFullWrite If true, forget what was last written to this tab and rewrite it completely.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Runtime DataTable", meta = (AdvancedDisplay = "bForceFullWrite"))
+	static void WriteCsvToSheetIncremental(
+		FRuntimeDataTableTokenInfo InTokenInfo, const FRuntimeDataTableOperationParams OperationParams,
+		const FRDTGetStringDelegate& CallOnComplete, const FString InSpreadsheetId, const int32 InSheetId,
+		const FString InCsv, const bool bForceFullWrite = false)
+	{
+		if (URuntimeDataTableObject* RuntimeDataTableObject = CreateRuntimeDataTableObject())
+		{
+			RuntimeDataTableObject->WriteCsvToSheetIncremental_Internal(
+				InTokenInfo, OperationParams, CallOnComplete, InSpreadsheetId, InSheetId, InCsv, bForceFullWrite);
+		}
+	}
+
+	/**
+	 * Like WriteCsvToSheet, but for data too large to send in one request. The rows are split into chunks of roughly
+	 * UploadChunkByteBudget bytes each (see project settings), which are sent a few at a time and retried individually by the request scheduler if they fail.
+	 * The tab is resized and cleared first, so the chunks can land in any order.
+	 * @param InTokenInfo A validated URuntimeDataTableWebToken object. Used to authenticate the Sheets operation. When writing to a sheet, you must provide a valid InTokenInfo even if the sheet is public.
+	 * @param OperationParams Generic request operation parameters. RequestTimeout applies to each chunk rather than the whole upload.
+	 * @param InSpreadsheetId This is the spreadsheet ID number or key. Get it from your spreadsheet URL by calling GetSpreadsheetIdFromUrl.
+	 * @param InSheetId The GID for the desired sheet tab
+	 * @param InCsv This is the Csv data represented as a string.
+	 * @param CallOnProgress Called each time a chunk finishes. CompletedChunks and TotalChunks in the CallbackInfo tell you how far along the upload is.
+	 * @param CallOnComplete Called once every chunk has been sent or has run out of retries. Only successful if every chunk was.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Runtime DataTable")
+	static void WriteCsvToSheetChunked(
+		FRuntimeDataTableTokenInfo InTokenInfo, const FRuntimeDataTableOperationParams OperationParams,
+		const FRDTGetStringDelegate& CallOnProgress, const FRDTGetStringDelegate& CallOnComplete,
+		const FString InSpreadsheetId, const int32 InSheetId, const FString InCsv)
+	{
+		if (URuntimeDataTableObject* RuntimeDataTableObject = CreateRuntimeDataTableObject())
+		{
+			RuntimeDataTableObject->WriteCsvToSheetChunked_Internal(
+				InTokenInfo, OperationParams, CallOnProgress, CallOnComplete, InSpreadsheetId, InSheetId, InCsv);
+		}
+	}
+
 	// Local CSV
 
 	// Import
@@ -352,6 +604,19 @@ public:
 	static bool UpdateArrayFromCsvInfo_Internal(
 		FArrayProperty* ArrayProperty, void* ArrayPtr, UObject* OwningObject, FEasyCsvInfo CsvInfo, bool bNameMatch = false);
 
+	/**
+	 * Applies a CSV_Info struct straight to an existing DataTable, keyed by row name.
+	 * Rows the table already has are updated where they are, rows it doesn't have are added, and optionally rows missing from the CSV are removed.
+	 * Columns are matched to members of the table's row struct by name, ignoring case, and columns from a flattened export such as "Stats.Health" go to the nested member. Columns that match nothing are skipped and empty cells reset a member to its default.
+	 * OnDataTableChanged is broadcast once when done, however many rows were added, updated or removed.
+	 * @param DataTable The table to update. Must have a row struct.
+	 * @param CsvInfo The data to apply, from MakeCsvInfoFromString, DownloadSheetAsCsvInfo or similar. Keys must have been parsed for rows to line up with the table's row names.
+	 * @param bRemoveMissingRows If true, rows in the table that aren't in CsvInfo are removed.
+	 * @return Whether the table could be updated.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Runtime DataTable", meta = (Keywords = "Refresh, Sync"))
+	static bool UpdateDataTableFromCsvInfo(UDataTable* DataTable, const FEasyCsvInfo& CsvInfo, const bool bRemoveMissingRows = true);
+
 	// Export
 
 	/**
@@ -362,13 +627,14 @@ public:
 	 * @param Keys A set of keys used in the first column of the CSV to uniquely identify rows. Does not enforce unique values, so be sure to do that prior to calling. An array is required, but you don't need to match the number of keys to the number of structs. They will be auto-generated if not supplied in matching numbers. For all generated keys, use "AutoGenerateKeys()."
 	 * @param MembersToInclude Optional: Names of variables in your structs or objects that you want to export. Separate names by comma. Leave blank to include all variables, but be careful when using objects. Leaving this blank will include EVERY variable name including inherited and engine variables. For help creating this whitelist for objects, see GetAllObjectVariableNames().
 	 * @param bSortColumnsAlphanumerically If true, sort columns 0->9, A->Z
+	 * @param bFlattenNestedStructs If true, members of struct members get their own columns named by path, e.g. "Stats.Health", instead of the whole struct going in one cell as text. Both UpdateArrayFromCsvInfo with MatchStructMemberNames and UpdateDataTableFromCsvInfo read these columns back.
 	 * @param OwningObject The object or instantiation of a class that has the struct array as one of its variables. Defaults to the calling object or 'Self' and only applies to struct arrays.
 	 */
 	UFUNCTION(BlueprintCallable, Category = "Runtime DataTable", CustomThunk,
-		meta = (AdvancedDisplay = "OwningObject", ArrayParm = "ArrayToExport", DefaultToSelf = "OwningObject", Keywords="Export, String"))
+		meta = (AdvancedDisplay = "bFlattenNestedStructs, OwningObject", ArrayParm = "ArrayToExport", DefaultToSelf = "OwningObject", Keywords="Export, String"))
 		static void GenerateCsvFromArray(
 			const TArray<int32>& ArrayToExport, FString& OutCSV_String, TArray<FName> Keys,
-			FString MembersToInclude, const bool bSortColumnsAlphanumerically, const UObject* OwningObject
+			FString MembersToInclude, const bool bSortColumnsAlphanumerically, const bool bFlattenNestedStructs, const UObject* OwningObject
 		);
 
 	DECLARE_FUNCTION(execGenerateCsvFromArray)
@@ -415,6 +681,8 @@ public:
 
 		P_GET_PROPERTY(FBoolProperty, bSortColumnsAlphabetically);
 
+		P_GET_PROPERTY(FBoolProperty, bFlattenNestedStructs);
+
 		//Owning object parameter
 		P_GET_PROPERTY(FObjectProperty, OwningObject);
 
@@ -422,7 +690,7 @@ public:
 		P_FINISH;
 
 		FString FinalCSV = GenerateCsvFromArray_Internal(
-			ArrayProperty, ArrayPtr, RowKeys, OwningObject, MembersToInclude, bSortColumnsAlphabetically);
+			ArrayProperty, ArrayPtr, RowKeys, OwningObject, MembersToInclude, bSortColumnsAlphabetically, bFlattenNestedStructs);
 
 		OutStringProp->SetPropertyValue(OutStringPtr, FinalCSV);
 	}
@@ -435,10 +703,12 @@ public:
 	 * @param OwningObject Object which owns the data. Ignored for an array of objects.
 	 * @param MembersToInclude Optional: Names of variables in your structs or objects that you want to export. Separate names by comma. Leave blank to include all variables, but be careful when using objects. Leaving this blank will include EVERY variable name including inherited and engine variables. For help creating this whitelist for objects, see GetAllObjectVariableNames().
 	 * @param bSortColumnsAlphanumerically If true, sort columns 0->9, A->Z
+	 * @param bFlattenNestedStructs If true, members of struct members get their own columns named by path, e.g. "Stats.Health". See FRuntimeDataTablePropertyPath.
 	 */
 	static FString GenerateCsvFromArray_Internal(
 		FArrayProperty* ArrayProperty, void* ArrayPtr, TArray<FString> RowKeys,
-		UObject* OwningObject = nullptr, FString MembersToInclude = "", const bool bSortColumnsAlphanumerically = false
+		UObject* OwningObject = nullptr, FString MembersToInclude = "", const bool bSortColumnsAlphanumerically = false,
+		const bool bFlattenNestedStructs = false
 );
 
 	/**
@@ -467,13 +737,8 @@ protected:
 		return RuntimeDataTableObject;
 	}
 
-	static void CreateAndAuthenticateToken(FRuntimeDataTableTokenInfo InTokenInfo, const FRDTGetJWTDelegate& CallOnComplete)
-	{
-		if (URuntimeDataTableObject* RuntimeDataTableObject = CreateRuntimeDataTableObject())
-		{
-			RuntimeDataTableObject->CreateAndAuthenticateToken_Internal(InTokenInfo, CallOnComplete);
-		}
-	}
+	// Access tokens are shared process-wide, see FRuntimeDataTableTokenManager
+	static void CreateAndAuthenticateToken(FRuntimeDataTableTokenInfo InTokenInfo, const FRDTGetJWTDelegate& CallOnComplete);
 
 	/**
 	 * Takes in a single property (not an array, not a whole struct or object but one by one) and CSV cell data (as FString) then populates the values with the strings, converting them as necessary to the correct data types.
@@ -498,11 +763,13 @@ protected:
 	 * @param OutTopRow Out: What are the headers?
 	 * @param OutRowString Out: Row As String
 	 * @param InMemberWhitelist Names of variables in your structs or objects that you want to include in the output string. 
+	 * @param bFlattenNestedStructs If true, members of struct members get their own columns named by path, e.g. "Stats.Health"
 	*/
 	static void IterateThroughStructPropertyAndMakeRowString(
 		const FStructProperty* StructProperty, void* StructPtr, const FString& RowKey, UObject* OwningObject, const bool bIsUObject,
 		const bool bSortColumnsAlphanumerically,
-		uint8& OutNumValues, FString& OutTopRow, FString& OutRowString, const TArray<FString>& InMemberWhitelist);
+		uint8& OutNumValues, FString& OutTopRow, FString& OutRowString, const TArray<FString>& InMemberWhitelist,
+		const bool bFlattenNestedStructs = false);
 
 	// Do not call
 	void BuildGoogleSheetDownloadLinkAndGetAsCsv_Internal(
@@ -512,7 +779,57 @@ protected:
 	// Do not call
 	void BuildGoogleSheetDownloadLinkAndGetAsCsv_AfterToken(
 		const FRuntimeDataTableCallbackInfo CallbackInfo, URuntimeDataTableWebToken* InToken,
-		const FRuntimeDataTableOperationParams OperationParams, const FRDTGetStringDelegate CallOnComplete, const FString InSheetURL);
+		const FRuntimeDataTableOperationParams OperationParams, const FRDTGetStringDelegate CallOnComplete, const FString InSheetURL,
+		const FString CoalescingKey);
+
+	// Do not call
+	void DownloadSheetAsCsvInfo_Internal(
+		FRuntimeDataTableTokenInfo InTokenInfo, const FRuntimeDataTableOperationParams OperationParams,
+		const FRDTGetCsvInfoDelegate& CallOnComplete, const FString& InSheetURL, const bool bSheetIsPublic,
+		const bool ParseHeaders, const bool ParseKeys);
+	// Do not call
+	void DownloadSheetAsCsvInfo_AfterToken(
+		const FRuntimeDataTableCallbackInfo CallbackInfo, URuntimeDataTableWebToken* InToken,
+		const FRuntimeDataTableOperationParams OperationParams, const FRDTGetCsvInfoDelegate CallOnComplete,
+		const FString InSheetURL, const bool ParseHeaders, const bool ParseKeys);
+	// Do not call
+	void OnResponseReceived_SheetAsCsvInfo(
+		FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful,
+		const FRuntimeDataTableOperationParams OperationParams, FRDTGetCsvInfoDelegate CallOnComplete,
+		const bool ParseHeaders, const bool ParseKeys);
+
+	// Do not call
+	void FetchSheetSnapshotChanges_Internal(
+		const FRuntimeDataTableTokenInfo& InTokenInfo, const FRuntimeDataTableOperationParams& OperationParams,
+		const FRDTSnapshotChangesDelegate& CallOnComplete, const FString& SnapshotName, const bool bSheetIsPublic);
+	// Do not call
+	UFUNCTION()
+	void OnSheetDownloaded_SnapshotChanges(FRuntimeDataTableCallbackInfo CallbackInfo, const FEasyCsvInfo& CsvInfo);
+
+	// Set while FetchSheetSnapshotChanges is waiting on its download
+	TSharedPtr<FRuntimeDataTableSnapshotFetch> SnapshotFetch;
+
+	// Do not call
+	void DownloadMultipleTabsAsCsvInfo_Internal(
+		FRuntimeDataTableTokenInfo InTokenInfo, const FRuntimeDataTableOperationParams OperationParams,
+		const FRDTGetMultipleTabsDelegate& CallOnComplete, const FString& InSpreadsheetId, const TArray<FString>& InTabNamesOrRanges,
+		const bool bSheetIsPublic, const bool ParseHeaders, const bool ParseKeys);
+	// Do not call
+	void DownloadMultipleTabsAsCsvInfo_AfterToken(
+		const FRuntimeDataTableCallbackInfo CallbackInfo, URuntimeDataTableWebToken* InToken,
+		TSharedRef<FRuntimeDataTableMultiTabDownload> Download);
+	// Do not call
+	void OnResponseReceived_BatchGetValues(
+		FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful,
+		TSharedRef<FRuntimeDataTableMultiTabDownload> Download);
+	// Do not call
+	void DownloadMultipleTabsAsCsvInfo_StartNextPublicExport(TSharedRef<FRuntimeDataTableMultiTabDownload> Download);
+	// Do not call
+	void OnResponseReceived_PublicTabExport(
+		FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful,
+		TSharedRef<FRuntimeDataTableMultiTabDownload> Download, const int32 TabIndex);
+	// Do not call
+	void DownloadMultipleTabsAsCsvInfo_Finish(TSharedRef<FRuntimeDataTableMultiTabDownload> Download);
 
 	// Do not call
 	void WriteCsvToSheet_Internal(
@@ -546,6 +863,70 @@ protected:
 		FString InSpreadsheetId, const int32 InSheetId, FString InCsv,
 		FCsvToGoogleSheetsHandler SheetTabData);
 
+	// Do not call
+	void WriteCsvToSheetIncremental_Internal(
+		FRuntimeDataTableTokenInfo InTokenInfo, const FRuntimeDataTableOperationParams OperationParams,
+		const FRDTGetStringDelegate& CallOnComplete, const FString& InSpreadsheetId, const int32 InSheetId,
+		const FString& InCsv, const bool bForceFullWrite);
+	// Do not call
+	void WriteCsvToSheetIncremental_AfterToken(
+		const FRuntimeDataTableCallbackInfo CallbackInfo, URuntimeDataTableWebToken* InToken,
+		const FRuntimeDataTableOperationParams OperationParams, FRDTGetStringDelegate CallOnComplete,
+		const FString InSpreadsheetId, const int32 InSheetId, const FString InCsv, const bool bForceFullWrite);
+	// Do not call
+	void WriteCsvToSheetIncremental_OnGridPropertiesReceived(
+		FHttpRequestPtr InRequest, FHttpResponsePtr InResponse, bool bWasSuccessful,
+		URuntimeDataTableWebToken* InToken, const FRuntimeDataTableOperationParams OperationParams,
+		FRDTGetStringDelegate CallOnComplete,
+		FString InSpreadsheetId, const int32 InSheetId, FCsvToGoogleSheetsHandler SheetTabData);
+	// Do not call
+	void WriteCsvToSheetIncremental_SendChanges(
+		URuntimeDataTableWebToken* InToken, const FRuntimeDataTableOperationParams OperationParams,
+		const FRDTGetStringDelegate& CallOnComplete,
+		const FString& InSpreadsheetId, const int32 InSheetId, const FCsvToGoogleSheetsHandler& SheetTabData);
+	// Do not call
+	void WriteCsvToSheetIncremental_OnChangesSent(
+		FHttpRequestPtr InRequest, FHttpResponsePtr InResponse, bool bWasSuccessful,
+		const FRuntimeDataTableOperationParams OperationParams, FRDTGetStringDelegate CallOnComplete,
+		FString InSpreadsheetId, const int32 InSheetId, TSharedRef<FRuntimeDataTableSheetSnapshot> WrittenSnapshot);
+
+	// Do not call
+	void WriteCsvToSheetChunked_Internal(
+		FRuntimeDataTableTokenInfo InTokenInfo, const FRuntimeDataTableOperationParams OperationParams,
+		const FRDTGetStringDelegate& CallOnProgress, const FRDTGetStringDelegate& CallOnComplete,
+		const FString& InSpreadsheetId, const int32 InSheetId, const FString& InCsv);
+	// Do not call
+	void WriteCsvToSheetChunked_AfterToken(
+		const FRuntimeDataTableCallbackInfo CallbackInfo, URuntimeDataTableWebToken* InToken,
+		TSharedRef<FRuntimeDataTableChunkedUpload> Upload);
+	// Do not call
+	void WriteCsvToSheetChunked_OnGridPropertiesReceived(
+		FHttpRequestPtr InRequest, FHttpResponsePtr InResponse, bool bWasSuccessful,
+		TSharedRef<FRuntimeDataTableChunkedUpload> Upload);
+	// Do not call
+	void WriteCsvToSheetChunked_OnSheetPrepared(
+		FHttpRequestPtr InRequest, FHttpResponsePtr InResponse, bool bWasSuccessful,
+		TSharedRef<FRuntimeDataTableChunkedUpload> Upload);
+	// Do not call
+	void WriteCsvToSheetChunked_SendNextChunks(TSharedRef<FRuntimeDataTableChunkedUpload> Upload);
+	// Do not call
+	void WriteCsvToSheetChunked_OnTokenRefreshed(
+		const FRuntimeDataTableCallbackInfo CallbackInfo, URuntimeDataTableWebToken* InToken,
+		TSharedRef<FRuntimeDataTableChunkedUpload> Upload);
+	// Do not call
+	void WriteCsvToSheetChunked_OnChunkSent(
+		FHttpRequestPtr InRequest, FHttpResponsePtr InResponse, bool bWasSuccessful,
+		TSharedRef<FRuntimeDataTableChunkedUpload> Upload, const int32 ChunkIndex);
+	// Do not call
+	bool WriteCsvToSheetChunked_OnNextTick(float DeltaTime, TSharedRef<FRuntimeDataTableChunkedUpload> Upload);
+	// Do not call
+	void WriteCsvToSheetChunked_Finish(TSharedRef<FRuntimeDataTableChunkedUpload> Upload, const FString& ErrorMessage = "");
+
+	// Reads rowCount and columnCount for InSheetId out of a spreadsheets.get response with fields=sheets.properties.
+	// Returns false if the response could not be parsed. The counts are left as they were if InSheetId is not in it.
+	static bool GetGridPropertiesFromSpreadsheetJson(
+		const FString& InJson, const int32 InSheetId, int32& OutRowCount, int32& OutColumnCount);
+
 	/**
 	 * Creates a download link for a Google Sheet from an edit/share link.
 	 * Sheet Must be visible to or editable by anyone with the link.
@@ -556,13 +937,15 @@ protected:
 	// Sends the actual request to Google for the Sheet download
 	// Do not call
 	void Request_GET_PublicSheetAsCSV(
-		FString RequestURL, const FRDTGetStringDelegate& CallOnComplete, const FRuntimeDataTableOperationParams OperationParams);
+		FString RequestURL, const FRDTGetStringDelegate& CallOnComplete, const FRuntimeDataTableOperationParams OperationParams,
+		const FString& CoalescingKey = "");
 
 	// Called when a response is received or the timeout threshold is reached. Handles what we do with the response.
+	// Everyone who joined the download via FRuntimeDataTableRequestCoalescer is called back from here too.
 	// Do not call
 	void OnResponseReceived_GET_SheetAsCSV(
 		FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful,
-		FRDTGetStringDelegate CallOnComplete, const FRuntimeDataTableOperationParams OperationParams);
+		FRDTGetStringDelegate CallOnComplete, const FRuntimeDataTableOperationParams OperationParams, FString CoalescingKey);
 	
 	// Do not call
 	void OnResponseReceivedGenericReturnString(
@@ -576,21 +959,25 @@ protected:
 		const FString InVerb, const FString InURL,
 		const bool bShouldProcessRequest = true, const FString ContentType = GetMimeCsv());
 	
+	// Operations with several requests in flight pass bEndOperation = false and call EndOperation once the last one has returned
+	void GenericValidateHttpResponse(
+		FHttpRequestPtr Request, FHttpResponsePtr Response, FRuntimeDataTableCallbackInfo& CallbackInfo, const bool bEndOperation = true);
+
+	// Do not call. Keeps this object alive until EndOperation, see URuntimeDataTableOperationSubsystem
+	void BeginOperation(const FName OperationName);
+
 	// Do not call
-	void CreateAndAuthenticateToken_Internal(FRuntimeDataTableTokenInfo InTokenInfo, const FRDTGetJWTDelegate& CallOnComplete);
-	
-	// Do not call
-	void Request_POST_ForToken(
-		const FString InJavaWebToken, const FRDTGetJWTDelegate& CallOnComplete, const FRuntimeDataTableTokenInfo InTokenInfo);
-	
-	// Do not call
-	void OnResponseReceivedReturnToken(
-		FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful, FRuntimeDataTableTokenInfo InTokenInfo, FRDTGetJWTDelegate CallOnComplete);
-	
-	void GenericValidateHttpResponse(FHttpRequestPtr Request, FHttpResponsePtr Response, FRuntimeDataTableCallbackInfo& CallbackInfo);
+	void EndOperation();
+
+	// Do not call. Use instead of FRuntimeDataTableRequestScheduler::ProcessRequest so that the request can be cancelled with its operation.
+	// See there for bIsIdempotent.
+	void ProcessOperationRequest(const TSharedRef<IHttpRequest, ESPMode::ThreadSafe>& Request, const bool bIsIdempotent = false);
 	
 	static FString CreateJavaWebToken(FRuntimeDataTableTokenInfo InTokenInfo);
 	static bool ValidateTokenInfo(FRuntimeDataTableTokenInfo& InTokenInfo, FString& ErrorMessage);
 
 	static FName GetTokenOperationName;
+
+	friend class FRuntimeDataTableTokenManager;
+	friend class URuntimeDataTableDeltaExporter;
 };
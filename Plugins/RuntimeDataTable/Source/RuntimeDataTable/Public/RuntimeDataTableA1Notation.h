@@ -0,0 +1,256 @@
+// Copyright Jared Therriault 2019, 2022
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Integer conversions between column and row numbers and A1 notation. Columns and rows are 1-based, as they are in A1
+ * notation itself, so column 1 is "A" and column 27 is "AA". Nothing here allocates, and everything but the FString
+ * helpers can run at compile time.
+ */
+namespace RuntimeDataTableA1
+{
+	constexpr int32 AlphabetCount = 26;
+
+	// "ZZZ", the most a sheet can have
+	constexpr int32 MaxColumn = AlphabetCount + AlphabetCount * AlphabetCount + AlphabetCount * AlphabetCount * AlphabetCount;
+
+	// Sheets are capped at ten million cells, so rows can't get near this either
+	constexpr int32 MaxRow = 10000000;
+
+	constexpr bool IsValidColumn(const int32 Column)
+	{
+		return Column >= 1 && Column <= MaxColumn;
+	}
+
+	constexpr bool IsValidRow(const int32 Row)
+	{
+		return Row >= 1 && Row <= MaxRow;
+	}
+
+	constexpr int32 GetColumnLetterCount(const int32 Column)
+	{
+		return Column <= AlphabetCount ? 1 : Column <= AlphabetCount + AlphabetCount * AlphabetCount ? 2 : 3;
+	}
+
+	/**
+	 * Writes the letters for Column into OutLetters, which needs room for three, without a terminator.
+	 * @return How many letters were written, 0 if Column is out of range.
+	 */
+	template <typename CharType>
+	constexpr int32 WriteColumnLetters(int32 Column, CharType* OutLetters)
+	{
+		if (!IsValidColumn(Column))
+		{
+			return 0;
+		}
+
+		// Bijective base 26, there is no zero digit
+		const int32 LetterCount = GetColumnLetterCount(Column);
+		for (int32 LetterIndex = LetterCount - 1; LetterIndex >= 0; LetterIndex--)
+		{
+			Column--;
+			OutLetters[LetterIndex] = static_cast<CharType>('A' + Column % AlphabetCount);
+			Column /= AlphabetCount;
+		}
+
+		return LetterCount;
+	}
+
+	// Column number for Letters, ignoring case. 0 if they aren't all letters or go past MaxColumn.
+	template <typename CharType>
+	constexpr int32 ParseColumnLetters(const CharType* Letters, const int32 Length)
+	{
+		if (Length < 1 || Length > 3)
+		{
+			return 0;
+		}
+
+		int32 Column = 0;
+		for (int32 Index = 0; Index < Length; Index++)
+		{
+			const CharType Char = Letters[Index];
+			const int32 Digit =
+				Char >= 'A' && Char <= 'Z' ? Char - 'A' + 1 :
+				Char >= 'a' && Char <= 'z' ? Char - 'a' + 1 : 0;
+
+			if (Digit == 0)
+			{
+				return 0;
+			}
+			Column = Column * AlphabetCount + Digit;
+		}
+
+		return IsValidColumn(Column) ? Column : 0;
+	}
+
+	/**
+	 * Reads a cell such as "B12" or "$B$12" from the start of Cell.
+	 * Either part may be missing, as in the "B" of "B:D" or the "3" of "3:5", in which case it comes back as 0.
+	 * @return How many characters were read, 0 if Cell doesn't start with a cell.
+	 */
+	template <typename CharType>
+	constexpr int32 ParseCell(const CharType* Cell, const int32 Length, int32& OutColumn, int32& OutRow)
+	{
+		OutColumn = 0;
+		OutRow = 0;
+
+		int32 Index = 0;
+		if (Index < Length && Cell[Index] == '$')
+		{
+			Index++;
+		}
+
+		const int32 LettersStart = Index;
+		while (Index < Length && ((Cell[Index] >= 'A' && Cell[Index] <= 'Z') || (Cell[Index] >= 'a' && Cell[Index] <= 'z')))
+		{
+			Index++;
+		}
+
+		if (Index > LettersStart)
+		{
+			OutColumn = ParseColumnLetters(Cell + LettersStart, Index - LettersStart);
+			if (OutColumn == 0)
+			{
+				return 0;
+			}
+		}
+
+		if (Index < Length && Cell[Index] == '$')
+		{
+			Index++;
+		}
+
+		const int32 DigitsStart = Index;
+		while (Index < Length && Cell[Index] >= '0' && Cell[Index] <= '9')
+		{
+			OutRow = OutRow * 10 + (Cell[Index] - '0');
+			if (OutRow > MaxRow)
+			{
+				return 0;
+			}
+			Index++;
+		}
+
+		if (Index > DigitsStart && OutRow == 0)
+		{
+			return 0;
+		}
+
+		return OutColumn > 0 || OutRow > 0 ? Index : 0;
+	}
+
+	// Appends e.g. "B12". Nothing is appended if either is out of range.
+	inline void AppendCell(FString& Out, const int32 Column, const int32 Row)
+	{
+		TCHAR Letters[3] = {};
+		const int32 LetterCount = WriteColumnLetters(Column, Letters);
+		if (LetterCount > 0 && IsValidRow(Row))
+		{
+			Out.AppendChars(Letters, LetterCount);
+			Out.AppendInt(Row);
+		}
+	}
+
+	inline FString ColumnToString(const int32 Column)
+	{
+		TCHAR Letters[3] = {};
+		const int32 LetterCount = WriteColumnLetters(Column, Letters);
+		return FString(LetterCount, Letters);
+	}
+
+	inline FString CellToString(const int32 Column, const int32 Row)
+	{
+		FString Cell;
+		Cell.Reserve(10);
+		AppendCell(Cell, Column, Row);
+		return Cell;
+	}
+
+	static_assert(MaxColumn == 18278, "ZZZ");
+	static_assert(ParseColumnLetters("A", 1) == 1 && ParseColumnLetters("Z", 1) == 26 && ParseColumnLetters("AA", 2) == 27, "A1 columns");
+	static_assert(ParseColumnLetters("AAA", 3) == 703 && ParseColumnLetters("ZZZ", 3) == MaxColumn, "A1 columns");
+}
+
+/**
+ * A rectangle of cells, optionally on a named tab, as in "'Sheet 1'!A1:C10". Bounds are 1-based and inclusive.
+ * Whole row or column ranges such as "A:C" aren't supported, every range here has all four bounds.
+ * The algebra is for working out the fewest, smallest writes that cover a set of changed cells.
+ */
+struct RUNTIMEDATATABLE_API FRuntimeDataTableA1Range
+{
+	// Empty for a range with no tab
+	FString SheetTitle;
+
+	int32 StartColumn = 1;
+	int32 StartRow = 1;
+	int32 EndColumn = 1;
+	int32 EndRow = 1;
+
+	FRuntimeDataTableA1Range() = default;
+
+	FRuntimeDataTableA1Range(const int32 InStartColumn, const int32 InStartRow, const int32 InEndColumn, const int32 InEndRow,
+		const FString& InSheetTitle = FString())
+		: SheetTitle(InSheetTitle)
+		, StartColumn(InStartColumn)
+		, StartRow(InStartRow)
+		, EndColumn(InEndColumn)
+		, EndRow(InEndRow)
+	{}
+
+	// Reads "A1", "A1:C10", "Sheet1!A1:C10" or "'Sheet 1'!A1:C10". The cells may be given in either order.
+	static bool Parse(const FString& InRange, FRuntimeDataTableA1Range& OutRange);
+
+	// Back to A1 notation, quoting the tab's title only where it has to be unless bAlwaysQuoteTitle
+	FString ToString(const bool bAlwaysQuoteTitle = false) const;
+
+	bool IsValid() const
+	{
+		return RuntimeDataTableA1::IsValidColumn(StartColumn) && RuntimeDataTableA1::IsValidColumn(EndColumn) &&
+			RuntimeDataTableA1::IsValidRow(StartRow) && RuntimeDataTableA1::IsValidRow(EndRow) &&
+			StartColumn <= EndColumn && StartRow <= EndRow;
+	}
+
+	int32 GetColumnCount() const
+	{
+		return EndColumn - StartColumn + 1;
+	}
+
+	int32 GetRowCount() const
+	{
+		return EndRow - StartRow + 1;
+	}
+
+	int64 GetCellCount() const
+	{
+		return static_cast<int64>(GetColumnCount()) * GetRowCount();
+	}
+
+	bool Contains(const int32 Column, const int32 Row) const
+	{
+		return Column >= StartColumn && Column <= EndColumn && Row >= StartRow && Row <= EndRow;
+	}
+
+	// The cells in both. False if they don't overlap or are on different tabs.
+	static bool Intersect(const FRuntimeDataTableA1Range& A, const FRuntimeDataTableA1Range& B, FRuntimeDataTableA1Range& OutRange);
+
+	// The smallest range holding both, which is the union when one contains the other or they share a full edge
+	static FRuntimeDataTableA1Range Union(const FRuntimeDataTableA1Range& A, const FRuntimeDataTableA1Range& B);
+
+	// Splits into ranges of at most MaxRows by MaxColumns, row by row from the top left
+	TArray<FRuntimeDataTableA1Range> Tile(const int32 MaxRows, const int32 MaxColumns) const;
+
+	/**
+	 * The smallest range holding every dirty cell, given as column and row pairs.
+	 * @return False if there are no dirty cells.
+	 */
+	static bool MakeBoundingBox(
+		const TArray<FIntPoint>& InDirtyCells, FRuntimeDataTableA1Range& OutRange, const FString& InSheetTitle = FString());
+
+	bool operator==(const FRuntimeDataTableA1Range& Other) const
+	{
+		return StartColumn == Other.StartColumn && StartRow == Other.StartRow && EndColumn == Other.EndColumn &&
+			EndRow == Other.EndRow && SheetTitle == Other.SheetTitle;
+	}
+};
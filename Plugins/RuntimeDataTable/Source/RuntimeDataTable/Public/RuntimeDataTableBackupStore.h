@@ -0,0 +1,52 @@
+// Copyright Jared Therriault 2019, 2022
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Reads and writes the local backups made of downloaded sheets.
+ * Each save writes the plain UTF-8 CSV at the path it was asked for, same as always, and also a new compressed version
+ * next to it ("Weapons.csv" gets "Weapons.csv.<ticks>.rdtb"). Both are written to a temp file first and renamed into place
+ * so that a crash mid-write never leaves a half-written backup behind.
+ * Only the newest NumBackupVersionsToKeep versions are kept. Loading prefers the versions and falls back to the plain CSV.
+ * Everything except the *Async functions blocks on disk IO, so keep those off the game thread.
+ */
+class RUNTIMEDATATABLE_API FRuntimeDataTableBackupStore
+{
+public:
+
+	/** Writes InCsv to the backup at InBackupPath and as its newest version, on a background thread. */
+	static void SaveBackupAsync(const FString& InBackupPath, FString InCsv);
+
+	/** Writes InCsv to the backup at InBackupPath and as its newest version, then prunes old versions. */
+	static bool SaveBackup(const FString& InBackupPath, const FString& InCsv);
+
+	/**
+	 * Loads the newest readable version of the backup at InBackupPath as UTF-8.
+	 * A version that fails to decompress is skipped in favour of the one before it.
+	 */
+	static bool LoadBackup(const FString& InBackupPath, TArray<uint8>& OutUtf8Csv);
+
+	static bool HasBackup(const FString& InBackupPath);
+
+	/** Full paths of every version of the backup at InBackupPath, newest first. */
+	static TArray<FString> FindBackupVersions(const FString& InBackupPath);
+
+private:
+
+	static bool SaveBackupVersion(const FString& InBackupPath, const FString& InCsv, const int64 InVersionTicks);
+
+	static bool WriteFileAtomically(const TArrayView<const uint8> InData, const FString& InPath);
+
+	static bool ReadBackupVersion(const FString& InVersionPath, TArray<uint8>& OutUtf8Csv);
+
+	static void PruneBackupVersions(const FString& InBackupPath, const int32 InNumToKeep);
+
+	// 'RDTB'
+	static constexpr uint32 FileMagic = 0x42544452;
+	static constexpr uint32 FileFormatVersion = 1;
+
+	// Keeps two saves of the same backup from pruning each other's files mid-write
+	static FCriticalSection WriteCriticalSection;
+};
@@ -0,0 +1,127 @@
+// Copyright Jared Therriault 2019, 2022
+
+#pragma once
+
+#include "RuntimeDataTable.h"
+
+#include "RuntimeDataTableDeltaExporter.generated.h"
+
+/**
+ * Remembers what GenerateCsvFromArray produced last time, keyed by row key, so that the next export only carries the rows
+ * that were added or changed since, plus the keys of the rows that are gone.
+ * Rows are compared by a hash of their CSV text, so a whole array is still walked and stringified on every export but only
+ * the difference is kept and sent. A change of columns counts as every row having changed.
+ * The state moves on as soon as an export returns. If sending the result fails, call Reset so the next export is a full one.
+ */
+UCLASS(BlueprintType)
+class RUNTIMEDATATABLE_API URuntimeDataTableDeltaExporter : public UObject
+{
+	GENERATED_BODY()
+
+public:
+
+	/**
+	 * Makes an exporter with nothing exported yet, so its first export contains every row.
+	 * Keep a reference to it for as long as you want to export deltas.
+	 * @param SheetId The tab the batchUpdate payloads are written for. The tab is assumed to hold nothing but this exporter's rows, under one header row.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Runtime DataTable", meta = (Keywords = "Delta, Upsert, Export"))
+	static URuntimeDataTableDeltaExporter* CreateDeltaExporter(const int32 SheetId = 0);
+
+	/**
+	 * Like GenerateCsvFromArray, but only includes the rows that were added or changed since the last export.
+	 * @param ArrayToExport An array of the structs or objects you'd like to export.
+	 * @param bHasChanges Out: False if nothing was added, changed or removed, in which case there is nothing to send.
+	 * @param OutCSV_String Out: The header row followed by the added and changed rows, for upserting by key.
+	 * @param OutDeletedKeys Out: Keys that were exported last time but aren't in this array.
+	 * @param OutBatchUpdatePayload Out: A Google Sheets spreadsheets.batchUpdate body that brings the tab from the last export to this one. Changed rows are updated in place, removed rows are deleted and new rows are appended.
+	 * @param Keys Used to tell rows apart between exports, so they must be unique and stay with the same element. Missing keys are generated from the element's index, as in GenerateCsvFromArray, which only holds up for arrays that are only ever appended to.
+	 * @param MembersToInclude Optional: Names of variables in your structs or objects that you want to export. Separate names by comma.
+	 * @param bSortColumnsAlphanumerically If true, sort columns 0->9, A->Z
+	 * @param bFlattenNestedStructs If true, members of struct members get their own columns named by path, e.g. "Stats.Health".
+	 * @param OwningObject The object or instantiation of a class that has the struct array as one of its variables. Defaults to the calling object or 'Self' and only applies to struct arrays.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Runtime DataTable", CustomThunk,
+		meta = (AdvancedDisplay = "bFlattenNestedStructs, OwningObject", ArrayParm = "ArrayToExport", DefaultToSelf = "OwningObject",
+			Keywords = "Delta, Upsert, Export, String"))
+	void ExportChangedRows(
+		const TArray<int32>& ArrayToExport, bool& bHasChanges, FString& OutCSV_String, TArray<FName>& OutDeletedKeys,
+		FString& OutBatchUpdatePayload, TArray<FName> Keys, FString MembersToInclude, const bool bSortColumnsAlphanumerically,
+		const bool bFlattenNestedStructs, const UObject* OwningObject);
+
+	DECLARE_FUNCTION(execExportChangedRows)
+	{
+		Stack.MostRecentPropertyAddress = nullptr;
+		Stack.MostRecentProperty = nullptr;
+
+		//Structs parameter
+		Stack.StepCompiledIn<FArrayProperty>(NULL);
+		void* ArrayPtr = Stack.MostRecentPropertyAddress;
+		if (!ArrayPtr)
+		{
+			return;
+		}
+		auto ArrayProperty = (FArrayProperty*)(Stack.MostRecentProperty);
+
+		P_GET_UBOOL_REF(bHasChanges);
+		P_GET_PROPERTY_REF(FStrProperty, OutCSV_String);
+		P_GET_TARRAY_REF(FName, OutDeletedKeys);
+		P_GET_PROPERTY_REF(FStrProperty, OutBatchUpdatePayload);
+
+		//Keys parameter
+		P_GET_TARRAY(FName, Keys);
+		TArray<FString> RowKeys;
+		RowKeys.Reserve(Keys.Num());
+		for (const FName& Key : Keys)
+		{
+			RowKeys.Add(Key.ToString());
+		}
+
+		P_GET_PROPERTY(FStrProperty, MembersToInclude);
+
+		P_GET_PROPERTY(FBoolProperty, bSortColumnsAlphabetically);
+
+		P_GET_PROPERTY(FBoolProperty, bFlattenNestedStructs);
+
+		//Owning object parameter
+		P_GET_PROPERTY(FObjectProperty, OwningObject);
+
+		// We need this to wrap up the stack
+		P_FINISH;
+
+		TArray<FString> DeletedKeys;
+		bHasChanges = P_THIS->ExportChangedRows_Internal(
+			ArrayProperty, ArrayPtr, RowKeys, OwningObject, MembersToInclude, bSortColumnsAlphabetically, bFlattenNestedStructs,
+			OutCSV_String, DeletedKeys, OutBatchUpdatePayload);
+
+		OutDeletedKeys.Reset(DeletedKeys.Num());
+		for (const FString& DeletedKey : DeletedKeys)
+		{
+			OutDeletedKeys.Add(FName(*DeletedKey));
+		}
+	}
+
+	/**
+	 * Internal call for ExportChangedRows. Parameters are the same as GenerateCsvFromArray_Internal's.
+	 * @return False if nothing was added, changed or removed since the last export.
+	 */
+	bool ExportChangedRows_Internal(
+		FArrayProperty* ArrayProperty, void* ArrayPtr, const TArray<FString>& RowKeys, UObject* OwningObject,
+		const FString& MembersToInclude, const bool bSortColumnsAlphanumerically, const bool bFlattenNestedStructs,
+		FString& OutCsv, TArray<FString>& OutDeletedKeys, FString& OutBatchUpdatePayload);
+
+	// Forgets everything exported so far, the next export will contain every row
+	UFUNCTION(BlueprintCallable, Category = "Runtime DataTable")
+	void Reset();
+
+private:
+
+	int32 SheetId = 0;
+
+	bool bHasExported = false;
+	FString HeaderRow;
+
+	// Row keys in the order their rows sit in the sheet, below the header
+	TArray<FString> SheetRowKeys;
+	TMap<FString, uint64> RowHashes;
+};
@@ -0,0 +1,69 @@
+// Copyright Jared Therriault 2019, 2022
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Writes condensed JSON straight into a UTF-8 request body, escaping strings as it goes.
+ * Sheets payloads are mostly one small object per cell, so building them with FJsonObject means several allocations per cell
+ * plus a TCHAR string that then has to be converted to UTF-8 for the request. This skips both.
+ * Keys are expected to be ASCII literals. Commas are handled for you; it's up to the caller to balance Begin/End calls.
+ */
+class RUNTIMEDATATABLE_API FRuntimeDataTableJsonPayloadWriter
+{
+public:
+
+	explicit FRuntimeDataTableJsonPayloadWriter(const int32 InExpectedSize = 0)
+	{
+		Payload.Reserve(InExpectedSize);
+	}
+
+	void BeginObject();
+	void BeginObject(const ANSICHAR* InKey);
+	void EndObject();
+
+	void BeginArray();
+	void BeginArray(const ANSICHAR* InKey);
+	void EndArray();
+
+	// Writes a key without a value, for the rare payload that is a bare "key": value fragment
+	void WriteKey(const ANSICHAR* InKey);
+
+	void WriteStringValue(const FString& InValue);
+	void WriteStringField(const ANSICHAR* InKey, const FString& InValue);
+
+	void WriteNumberValue(const int64 InValue);
+	void WriteNumberField(const ANSICHAR* InKey, const int64 InValue);
+
+	const TArray<uint8>& GetPayload() const
+	{
+		return Payload;
+	}
+
+	// Hands the payload over, e.g. to IHttpRequest::SetContent. The writer is empty afterwards.
+	TArray<uint8> ReleasePayload()
+	{
+		ScopeHasValue.Reset();
+		bAwaitingValue = false;
+		return MoveTemp(Payload);
+	}
+
+	// Only meant for logging, this is the round trip the writer exists to avoid
+	FString GetPayloadAsString() const;
+
+private:
+
+	// Writes a comma if the current scope already has a value and this isn't the value of a key
+	void WriteSeparator();
+
+	void WriteAnsi(const ANSICHAR* InString);
+	void WriteEscapedString(const FString& InValue);
+
+	TArray<uint8> Payload;
+
+	// One entry per open object/array, true once something has been written into it
+	TArray<bool, TInlineAllocator<16>> ScopeHasValue;
+
+	bool bAwaitingValue = false;
+};
@@ -34,4 +34,6 @@ private:
 	static void PrintToLog(const FString& LogMessage);
 	static void PrintWarningToLog(const FString& LogMessage);
 	static void PrintErrorToLog(const FString& LogMessage);
+
+	FDelegateHandle ReloadCompleteHandle;
 };
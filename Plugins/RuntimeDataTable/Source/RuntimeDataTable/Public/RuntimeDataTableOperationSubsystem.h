@@ -0,0 +1,79 @@
+// Copyright Jared Therriault 2019, 2022
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "Interfaces/IHttpRequest.h"
+#include "Subsystems/EngineSubsystem.h"
+
+#include "RuntimeDataTableOperationSubsystem.generated.h"
+
+class URuntimeDataTableObject;
+
+/**
+ * Owns every URuntimeDataTableObject that has an operation in flight, instead of each of them sitting in the root set.
+ * An operation is begun by its object before it asks for an access token or sends its first request, and ended once its
+ * callback is due. While it's running, the subsystem holds the only reference to the object and remembers which requests
+ * it has sent, so that everything under one OperationName can be cancelled together. Cancelled operations still call back once, as failures.
+ * Anything left running when the engine shuts down is cancelled the same way.
+ * How many requests are out at once is limited by FRuntimeDataTableRequestScheduler, see MaxConcurrentRequests.
+ * Game thread only.
+ */
+UCLASS()
+class RUNTIMEDATATABLE_API URuntimeDataTableOperationSubsystem : public UEngineSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	// Null before the engine is up and after it's gone
+	static URuntimeDataTableOperationSubsystem* Get();
+
+	virtual void Deinitialize() override;
+
+	// Beginning an operation that is already running does nothing, so there's no need to match every call with EndOperation
+	void BeginOperation(URuntimeDataTableObject* InOperationObject, const FName InOperationName);
+
+	void EndOperation(URuntimeDataTableObject* InOperationObject);
+
+	/**
+	 * Sends InRequest through FRuntimeDataTableRequestScheduler on behalf of InOperationObject's operation.
+	 * Requests made for an operation that has been cancelled fail straight away.
+	 */
+	void ProcessRequest(
+		URuntimeDataTableObject* InOperationObject, const TSharedRef<IHttpRequest, ESPMode::ThreadSafe>& InRequest,
+		const bool bIsIdempotent = false);
+
+	// Returns how many operations were cancelled
+	int32 CancelOperation(const FName InOperationName);
+
+	void CancelAllOperations();
+
+	int32 GetNumActiveOperations() const
+	{
+		return ActiveOperations.Num();
+	}
+
+private:
+
+	struct FActiveOperation
+	{
+		FName OperationName;
+
+		double StartTime = 0.0;
+
+		bool bCancelled = false;
+
+		// Weak so that finished requests can go, the scheduler holds on to the ones still running
+		TArray<TWeakPtr<IHttpRequest, ESPMode::ThreadSafe>> Requests;
+	};
+
+	void CancelOperations(const TArray<URuntimeDataTableObject*>& InOperationObjects);
+
+	// Referenced from here rather than rooted, this is what keeps them from being collected mid-operation
+	UPROPERTY(Transient)
+	TSet<TObjectPtr<URuntimeDataTableObject>> ActiveOperationObjects;
+
+	TMap<URuntimeDataTableObject*, FActiveOperation> ActiveOperations;
+};
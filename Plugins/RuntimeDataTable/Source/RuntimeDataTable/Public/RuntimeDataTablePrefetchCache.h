@@ -0,0 +1,96 @@
+// Copyright Jared Therriault 2019, 2022
+
+#pragma once
+
+#include "RuntimeDataTable.h"
+
+#include "RuntimeDataTablePrefetchCache.generated.h"
+
+/**
+ * Fetches and parses everything in the project settings' PrefetchManifest as soon as the engine is up, all at once and
+ * highest priority first, so that the first Blueprint to need a sheet doesn't have to wait for its own download.
+ * DownloadSheetAsCsvInfo and MakeCsvInfoFromFile check here before doing anything. A source that is ready is answered
+ * on the next tick, one still being fetched is waited on, and one that failed or has outlived PrefetchCacheLifetimeSeconds
+ * falls through to the normal download. Thread safe.
+ */
+class RUNTIMEDATATABLE_API FRuntimeDataTablePrefetchCache
+{
+public:
+
+	static FRuntimeDataTablePrefetchCache& Get();
+
+	// Starts everything in the manifest. Does nothing in commandlets.
+	void StartPrefetch();
+
+	// Drops everything, including anyone still waiting on a fetch. Their callbacks are never called.
+	void Reset();
+
+	static FString MakeSheetKey(const FString& InSheetURL);
+	static FString MakeFileKey(const FString& InPath);
+
+	/**
+	 * If InKey is cached with the same parse options, OnReady is called with it on the game thread, never before this returns.
+	 * If it was still being fetched and the fetch failed, OnReady is called with nullptr.
+	 * Returns false, without calling OnReady, if there is nothing to wait for.
+	 */
+	bool FindOrWait(
+		const FString& InKey, const bool bParseHeaders, const bool bParseKeys, TFunction<void(const FEasyCsvInfo*)>&& OnReady);
+
+	// Only what's ready, for callers that can't wait
+	bool Find(const FString& InKey, const bool bParseHeaders, const bool bParseKeys, FEasyCsvInfo& OutCsvInfo);
+
+	// Called by whatever fetched InKey
+	void Complete(const FString& InKey, const bool bWasSuccessful, FEasyCsvInfo&& InCsvInfo);
+
+	static const FName OperationName;
+
+private:
+
+	FRuntimeDataTablePrefetchCache() {}
+
+	struct FEntry
+	{
+		bool bPending = true;
+		bool bParseHeaders = true;
+		bool bParseKeys = true;
+
+		FEasyCsvInfo CsvInfo;
+		double CompletedTime = 0.0;
+
+		TArray<TFunction<void(const FEasyCsvInfo*)>> Waiters;
+	};
+
+	// Whether InEntry has outlived PrefetchCacheLifetimeSeconds
+	bool IsExpired(const FEntry& InEntry) const;
+
+	FCriticalSection CacheCriticalSection;
+
+	TMap<FString, FEntry> Entries;
+};
+
+/**
+ * Downloads one sheet from the PrefetchManifest into FRuntimeDataTablePrefetchCache.
+ * Only exists because the download functions call back through dynamic delegates.
+ */
+UCLASS()
+class RUNTIMEDATATABLE_API URuntimeDataTablePrefetcher : public UObject
+{
+	GENERATED_BODY()
+
+public:
+
+	void Start(
+		const FString& InCacheKey, const FString& InSheetURL, const FRuntimeDataTableTokenInfo& InTokenInfo,
+		const bool bSheetIsPublic, const bool bParseHeaders, const bool bParseKeys);
+
+protected:
+
+	// Do not call
+	UFUNCTION()
+	void OnSheetDownloaded(FRuntimeDataTableCallbackInfo CallbackInfo, const FEasyCsvInfo& CsvInfo);
+
+private:
+
+	FString CacheKey;
+	double StartTime = 0.0;
+};
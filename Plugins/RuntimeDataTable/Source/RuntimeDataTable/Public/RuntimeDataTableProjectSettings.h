@@ -4,6 +4,68 @@
 
 #include "RuntimeDataTableProjectSettings.generated.h"
 
+// A sheet baked into the build by the RuntimeDataTableSnapshot commandlet
+USTRUCT()
+struct FRuntimeDataTableSnapshotSource
+{
+	GENERATED_BODY()
+
+	/**
+	 *What to call the snapshot. Pass this to LoadSheetSnapshot and FetchSheetSnapshotChanges.
+	 */
+	UPROPERTY(Config, EditAnywhere, Category="Snapshot")
+	FString SnapshotName;
+
+	UPROPERTY(Config, EditAnywhere, Category="Snapshot")
+	FString SheetURL;
+
+	UPROPERTY(Config, EditAnywhere, Category="Snapshot")
+	bool bSheetIsPublic = false;
+
+	/**
+	 *The service account key file used to download the sheet if it isn't public. Only read by the commandlet, it isn't shipped.
+	 */
+	UPROPERTY(Config, EditAnywhere, Category="Snapshot", meta=(EditCondition="!bSheetIsPublic"))
+	FString ServiceAccountKeyFile;
+};
+
+// A sheet or CSV file fetched as soon as the game starts
+USTRUCT()
+struct FRuntimeDataTablePrefetchSource
+{
+	GENERATED_BODY()
+
+	/**
+	 *A sheet URL, or the path to a CSV file. Relative paths are relative to the project directory.
+	 */
+	UPROPERTY(Config, EditAnywhere, Category="Prefetch")
+	FString Source;
+
+	/**
+	 *Higher priorities are started first.
+	 */
+	UPROPERTY(Config, EditAnywhere, Category="Prefetch")
+	int32 Priority = 0;
+
+	UPROPERTY(Config, EditAnywhere, Category="Prefetch")
+	bool bSheetIsPublic = false;
+
+	/**
+	 *The service account key file used to download the sheet if it isn't public. It must be staged with the build.
+	 */
+	UPROPERTY(Config, EditAnywhere, Category="Prefetch", meta=(EditCondition="!bSheetIsPublic"))
+	FString ServiceAccountKeyFile;
+
+	/**
+	 *Must match what the game later asks for, or the prefetched copy isn't used.
+	 */
+	UPROPERTY(Config, EditAnywhere, Category="Prefetch")
+	bool bParseHeaders = true;
+
+	UPROPERTY(Config, EditAnywhere, Category="Prefetch")
+	bool bParseKeys = true;
+};
+
 UCLASS(config = Engine, defaultconfig)
 class RUNTIMEDATATABLE_API URuntimeDataTableProjectSettings : public UObject
 {
@@ -83,6 +145,145 @@ public:
 	UPROPERTY(Config, EditAnywhere, Category="Google Sheets Operator|Logging")
 	float ErrorMessagesOnScreenLifetime;
 
+	/**
+	 *If true, OAuth access tokens are cached per service account and shared by every operation until shortly before they expire.
+	 *If false, every operation signs and exchanges its own token, which costs an extra round trip each time.
+	 */
+	UPROPERTY(Config, EditAnywhere, Category="Google Sheets Operator|Authentication")
+	bool bCacheAccessTokens = true;
+
+	/**
+	 *How many seconds before a cached access token expires it should be refreshed in the background.
+	 *Tokens are only refreshed if they have been used since they were last issued.
+	 */
+	UPROPERTY(Config, EditAnywhere, Category="Google Sheets Operator|Authentication", meta=(ClampMin=15, EditCondition="bCacheAccessTokens"))
+	int32 AccessTokenRefreshMarginSeconds = 60;
+
+	/**
+	 *How many tabs of a public sheet may be downloading at the same time during a multi-tab download.
+	 *Private sheets don't need this as all of their tabs are fetched in a single request.
+	 */
+	UPROPERTY(Config, EditAnywhere, Category="Google Sheets Operator|Networking", meta=(ClampMin=1, ClampMax=16))
+	int32 MaxConcurrentPublicTabDownloads = 4;
+
+	/**
+	 *Roughly how large each request of a chunked upload may be, in bytes. Rows are never split across chunks.
+	 *Smaller chunks are less likely to time out, larger chunks use fewer requests.
+	 */
+	UPROPERTY(Config, EditAnywhere, Category="Google Sheets Operator|Networking", meta=(ClampMin=16384))
+	int32 UploadChunkByteBudget = 1048576;
+
+	/**
+	 *How many chunks of a chunked upload may be in flight at the same time.
+	 */
+	UPROPERTY(Config, EditAnywhere, Category="Google Sheets Operator|Networking", meta=(ClampMin=1, ClampMax=16))
+	int32 MaxConcurrentUploadChunks = 3;
+
+	/**
+	 *If true, downloads of the same sheet by the same account that overlap share one request, and every caller is called back from its response.
+	 */
+	UPROPERTY(Config, EditAnywhere, Category="Google Sheets Operator|Networking")
+	bool bCoalesceIdenticalDownloads = true;
+
+	/**
+	 *For how many seconds a successful coalesced download is handed to anyone else who asks for it instead of downloading it again. 0 turns this off.
+	 *Keep this short, edits made to the sheet in the meantime won't be seen.
+	 */
+	UPROPERTY(Config, EditAnywhere, Category="Google Sheets Operator|Networking", meta=(ClampMin=0, EditCondition="bCoalesceIdenticalDownloads"))
+	float CoalescedDownloadTtlSeconds = 0.f;
+
+	/**
+	 *If true, requests to the Sheets API are queued and let out no faster than MaxRequestsPerMinute, shared across every operation.
+	 *Public sheet exports from GoogleSheetsUrlPrefix are not part of the API quota and are never held back.
+	 *If false, requests are sent as soon as they are made, but are still retried according to MaxRequestRetries.
+	 */
+	UPROPERTY(Config, EditAnywhere, Category="Google Sheets Operator|Networking|Rate Limiting")
+	bool bLimitRequestRate = true;
+
+	/**
+	 *The sustained number of requests per minute. The Sheets API's default quota is 60 per minute per user for both reads and writes.
+	 */
+	UPROPERTY(Config, EditAnywhere, Category="Google Sheets Operator|Networking|Rate Limiting", meta=(ClampMin=1, EditCondition="bLimitRequestRate"))
+	int32 MaxRequestsPerMinute = 60;
+
+	/**
+	 *How many requests may go out back to back after a quiet period before the per-minute rate kicks in.
+	 */
+	UPROPERTY(Config, EditAnywhere, Category="Google Sheets Operator|Networking|Rate Limiting", meta=(ClampMin=1, EditCondition="bLimitRequestRate"))
+	int32 RequestBurstSize = 10;
+
+	/**
+	 *How many requests may wait in the queue. Anything made while the queue is full fails straight away. 0 means no limit.
+	 */
+	UPROPERTY(Config, EditAnywhere, Category="Google Sheets Operator|Networking|Rate Limiting", meta=(ClampMin=0))
+	int32 MaxQueuedRequests = 512;
+
+	/**
+	 *How many requests may be waiting on Google at once, across every operation. Anything over this stays queued until one comes back. 0 means no limit.
+	 *This applies whether or not bLimitRequestRate is on.
+	 */
+	UPROPERTY(Config, EditAnywhere, Category="Google Sheets Operator|Networking|Rate Limiting", meta=(ClampMin=0))
+	int32 MaxConcurrentRequests = 16;
+
+	/**
+	 *How many times a request that timed out or got a 429 or 5xx response is sent again before its operation is told it failed.
+	 *Only a 429 is retried for requests that add to the sheet, such as appendCells, as they may have gone through before timing out.
+	 */
+	UPROPERTY(Config, EditAnywhere, Category="Google Sheets Operator|Networking|Rate Limiting", meta=(ClampMin=0))
+	int32 MaxRequestRetries = 4;
+
+	/**
+	 *The delay before the first retry, doubled for every retry after that. A random part of each delay is taken off so that retries spread out.
+	 *A Retry-After header from the server always wins if it asks for longer.
+	 */
+	UPROPERTY(Config, EditAnywhere, Category="Google Sheets Operator|Networking|Rate Limiting", meta=(ClampMin=0.1))
+	float InitialRetryDelaySeconds = 1.f;
+
+	/**
+	 *The longest the backoff may grow to, not counting Retry-After.
+	 */
+	UPROPERTY(Config, EditAnywhere, Category="Google Sheets Operator|Networking|Rate Limiting", meta=(ClampMin=1))
+	float MaxRetryDelaySeconds = 64.f;
+
+	/**
+	 *How many versions of each sheet backup are kept on disk. The newest readable one is loaded when a download fails.
+	 */
+	UPROPERTY(Config, EditAnywhere, Category="Google Sheets Operator|Backups", meta=(ClampMin=1))
+	int32 NumBackupVersionsToKeep = 3;
+
+	/**
+	 *The FCompression format backups are written with, e.g. Zlib, Gzip or Oodle. Backups remember their own format, so changing this doesn't break older ones.
+	 */
+	UPROPERTY(Config, EditAnywhere, Category="Google Sheets Operator|Backups")
+	FName BackupCompressionFormat = NAME_Zlib;
+
+	/**
+	 *Sheets to bake into the build, so that they can be used before anything has been downloaded.
+	 *Snapshots are written by running the editor with -run=RuntimeDataTableSnapshot, typically right before cooking.
+	 */
+	UPROPERTY(Config, EditAnywhere, Category="Google Sheets Operator|Snapshots")
+	TArray<FRuntimeDataTableSnapshotSource> SheetSnapshots;
+
+	/**
+	 *Where snapshots are written, relative to the project's Content directory.
+	 *Add this directory to "Additional Non-Asset Directories To Copy" in packaging settings so the files ship with the build.
+	 */
+	UPROPERTY(Config, EditAnywhere, Category="Google Sheets Operator|Snapshots")
+	FString SnapshotDirectory = "RuntimeDataTable/Snapshots";
+
+	/**
+	 *Sheets and CSV files to fetch and parse in parallel as soon as the game starts, highest priority first.
+	 *DownloadSheetAsCsvInfo and MakeCsvInfoFromFile are answered from what was fetched, or wait for it if it's still on its way.
+	 */
+	UPROPERTY(Config, EditAnywhere, Category="Google Sheets Operator|Prefetch")
+	TArray<FRuntimeDataTablePrefetchSource> PrefetchManifest;
+
+	/**
+	 *How long a prefetched copy is used for before downloads go back to fetching the sheet. 0 means forever.
+	 */
+	UPROPERTY(Config, EditAnywhere, Category="Google Sheets Operator|Prefetch", meta=(ClampMin="0"))
+	float PrefetchCacheLifetimeSeconds = 300.f;
+
 	/**
 	 *Determines the beginning of the URL used to build a locator for a spreadsheet resource.
 	 *Only change this parameter if you know you need to.
@@ -111,6 +312,13 @@ public:
 	UPROPERTY(Config, EditAnywhere, Category="Google Sheets Operator|Advanced|URI")
 	FString GoogleSheetsValuesBatchUpdateCommand = "/values:batchUpdate";
 
+	/**
+	 *The command used to read several ranges of sheet values in one request.
+	 *Only change this parameter if you know you need to.
+	 */
+	UPROPERTY(Config, EditAnywhere, Category="Google Sheets Operator|Advanced|URI")
+	FString GoogleSheetsValuesBatchGetCommand = "/values:batchGet";
+
 	/**
 	 *The selector used to specify data as type CSV.
 	 *Only change this parameter if you know you need to.
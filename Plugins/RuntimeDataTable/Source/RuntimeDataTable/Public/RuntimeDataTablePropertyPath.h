@@ -0,0 +1,76 @@
+// Copyright Jared Therriault 2019, 2022
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * One CSV column's worth of a struct or object, which may be a member of a member, e.g. "Stats.Health".
+ * Nested structs are stored inline, so the member offsets along the path are added up once when compiled and every read
+ * and write after that is a single pointer offset. Plain values are read and written directly, anything else goes
+ * through ExportText_Direct and ImportText_Direct on the leaf alone.
+ */
+struct RUNTIMEDATATABLE_API FRuntimeDataTablePropertyPath
+{
+	// Dotted, with an index for each element of a static array, e.g. "Stats.Resistances[2]"
+	FString ColumnName;
+
+	// Authored name of the top level member the path starts at, for member whitelists
+	FString RootName;
+
+	const FProperty* Leaf = nullptr;
+
+	// From the start of the container to the leaf value
+	int32 Offset = 0;
+
+	void* GetValuePtr(void* Container) const
+	{
+		return static_cast<uint8*>(Container) + Offset;
+	}
+
+	const void* GetValuePtr(const void* Container) const
+	{
+		return static_cast<const uint8*>(Container) + Offset;
+	}
+
+	FString ExportValue(const void* Container, UObject* OwningObject) const;
+
+	// Returns false, leaving the value as it was, if ValueAsString could not be read as the leaf's type
+	bool ImportValue(const FString& ValueAsString, void* Container, UObject* OwningObject) const;
+
+	// Puts the leaf back to what it is in DefaultContainer
+	void ResetValue(void* Container, const void* DefaultContainer) const;
+
+	// A path to the whole of a top level member, ignoring any elements past the first, as the unflattened columns have always done
+	static FRuntimeDataTablePropertyPath MakeTopLevel(const FProperty* Property);
+
+	/**
+	 * Every DataTable supported member of InStruct, with struct members flattened into their own members. Structs with their
+	 * own text format, such as FGameplayTag or FSoftObjectPath, are left whole.
+	 * Compiled once per struct and cached. Game thread only.
+	 */
+	static TSharedRef<const TArray<FRuntimeDataTablePropertyPath>> Compile(const UStruct* InStruct);
+
+	/**
+	 * Where each of Headers goes in InStruct, with an empty path (no Leaf) for headers that don't match a supported member.
+	 * Dotted headers go to the flattened member, the rest to the top level member with that authored name.
+	 * The last mapping is cached alongside Compile's paths. Game thread only.
+	 */
+	static TArray<FRuntimeDataTablePropertyPath> MapColumns(const UStruct* InStruct, const TArray<FString>& Headers);
+
+	// Forgets everything Compile and MapColumns have cached, for when a reload may have changed a struct's layout in place
+	static void ResetCache();
+
+	// The path in Paths named ColumnName, ignoring case
+	static const FRuntimeDataTablePropertyPath* FindByColumnName(
+		const TArray<FRuntimeDataTablePropertyPath>& Paths, const FString& ColumnName);
+
+	// Whether a column name could only have come from a flattened export
+	static bool IsFlattenedColumnName(const FString& ColumnName)
+	{
+		int32 Index;
+		return ColumnName.FindChar(TEXT('.'), Index) || ColumnName.FindChar(TEXT('['), Index);
+	}
+
+	static bool ShouldFlatten(const FProperty* Property);
+};
@@ -0,0 +1,56 @@
+// Copyright Jared Therriault 2019, 2022
+
+#pragma once
+
+#include "RuntimeDataTable.h"
+
+/**
+ * Lets identical sheet downloads share one request.
+ * Downloads are keyed by their export URL plus whoever is asking for it (a service account and scope, or "public").
+ * The first caller for a key sends the request; anyone asking for the same key while it's in flight is attached to it
+ * and called back from the same response, with their own OperationName. Successful responses can also be reused for
+ * a short while afterwards, see CoalescedDownloadTtlSeconds in project settings.
+ * Game thread only.
+ */
+class RUNTIMEDATATABLE_API FRuntimeDataTableRequestCoalescer
+{
+public:
+
+	static FRuntimeDataTableRequestCoalescer& Get();
+
+	static FString MakeKey(const FString& InExportUrl, const FRuntimeDataTableTokenInfo* InTokenInfo);
+
+	/**
+	 * Returns true if CallOnComplete has been attached to a download already in flight or answered from a recent response,
+	 * in which case the caller must not send a request of its own.
+	 * Returns false if the caller should go ahead and must call Complete with the same key when it's done, failures included.
+	 * Until then everyone who joins is waiting on it, so a caller that is a UObject has to be kept alive (see BeginOperation).
+	 */
+	bool TryJoin(const FString& InKey, const FName InOperationName, const FRDTGetStringDelegate& CallOnComplete);
+
+	/** Calls back the caller that sent the request, then everyone who joined it. */
+	void Complete(const FString& InKey, const FRuntimeDataTableCallbackInfo& CallbackInfo, const FRDTGetStringDelegate& LeaderCallOnComplete);
+
+	void Reset();
+
+private:
+
+	FRuntimeDataTableRequestCoalescer() {}
+
+	struct FWaitingCaller
+	{
+		FName OperationName;
+		FRDTGetStringDelegate CallOnComplete;
+	};
+
+	struct FRecentResponse
+	{
+		FRuntimeDataTableCallbackInfo CallbackInfo;
+		double TimeOfExpiration = 0.0;
+	};
+
+	// An entry exists for as long as its download is in flight, even if nobody has joined it yet
+	TMap<FString, TArray<FWaitingCaller>> InFlight;
+
+	TMap<FString, FRecentResponse> RecentResponses;
+};
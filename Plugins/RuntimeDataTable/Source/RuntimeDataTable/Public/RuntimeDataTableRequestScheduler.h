@@ -0,0 +1,128 @@
+// Copyright Jared Therriault 2019, 2022
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "Containers/Ticker.h"
+#include "Interfaces/IHttpRequest.h"
+
+/**
+ * Process-wide gate that every Google request made by URuntimeDataTableObject goes through.
+ * Sheets API requests are let out at the rate set in project settings by a token bucket, so a burst of operations queues up
+ * instead of blowing through the API quota all at once. Anything else, such as public CSV exports, isn't rate limited.
+ * Responses that say to slow down (429) are sent again after an exponential, jittered delay that respects Retry-After,
+ * and pause every other Sheets API request for that long. Timeouts and 5xx responses are only sent again for requests
+ * that are safe to repeat, since the server may have applied them before failing.
+ * No more than MaxConcurrentRequests are out at any one time, the rest wait their turn in the queue.
+ * The request's own OnProcessRequestComplete only fires once, with the final outcome.
+ * Game thread only, like the rest of the HTTP callbacks in this module.
+ */
+class RUNTIMEDATATABLE_API FRuntimeDataTableRequestScheduler
+{
+public:
+
+	static FRuntimeDataTableRequestScheduler& Get();
+
+	/**
+	 * Use instead of InRequest->ProcessRequest(). Bind OnProcessRequestComplete before calling this.
+	 * Retries are sent as copies of InRequest, so the request passed to the completion delegate may not be InRequest itself.
+	 * @param bIsIdempotent Whether sending InRequest twice leaves the sheet the same as sending it once, e.g. updateCells or
+	 * values:batchUpdate, but not appendCells or appendDimension. GET requests always are.
+	 */
+	void ProcessRequest(const TSharedRef<IHttpRequest, ESPMode::ThreadSafe>& InRequest, const bool bIsIdempotent = false);
+
+	/**
+	 * Stops InRequest wherever it is: queued, waiting to retry or already sent. It won't be retried, and its completion
+	 * delegate fires without a response. Returns false if the request isn't one of ours or has already completed.
+	 */
+	bool CancelRequest(const TSharedRef<IHttpRequest, ESPMode::ThreadSafe>& InRequest);
+
+	int32 GetNumQueuedRequests() const
+	{
+		return Queue.Num();
+	}
+
+	int32 GetNumRequestsInFlight() const
+	{
+		return InFlight.Num();
+	}
+
+	/** Fails everything still queued or waiting to retry and empties the bucket. */
+	void Reset();
+
+private:
+
+	FRuntimeDataTableRequestScheduler() {}
+
+	struct FScheduledRequest
+	{
+		TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request;
+
+		// What the caller handed us, which is how CancelRequest finds this again once Request has been replaced by a retry
+		TSharedRef<IHttpRequest, ESPMode::ThreadSafe> OriginalRequest;
+
+		// The caller's completion delegate, only fired once we're done retrying
+		FHttpRequestCompleteDelegate OnComplete;
+
+		int32 Attempts = 0;
+
+		// Timeouts and 5xx are only retried for these, see ProcessRequest
+		bool bIsIdempotent = false;
+
+		// Only requests to the Sheets API count against its quota
+		bool bIsRateLimited = false;
+
+		bool bCancelled = false;
+
+		FTSTicker::FDelegateHandle RetryTickerHandle;
+
+		explicit FScheduledRequest(const TSharedRef<IHttpRequest, ESPMode::ThreadSafe>& InRequest)
+			: Request(InRequest)
+			, OriginalRequest(InRequest)
+		{}
+	};
+
+	// Sends as many queued requests as the bucket allows and schedules the next pump if any are left
+	void PumpQueue();
+
+	bool OnPumpTimerElapsed(float DeltaTime);
+
+	// Tops the bucket up for the time passed since the last refill
+	void RefillTokens(const double Now);
+
+	void Send(const TSharedRef<FScheduledRequest>& ScheduledRequest);
+
+	void OnRequestComplete(
+		FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful, TSharedRef<FScheduledRequest> ScheduledRequest);
+
+	bool OnRetryDelayElapsed(float DeltaTime, TSharedRef<FScheduledRequest> ScheduledRequest);
+
+	void UpdateQueueStats() const;
+
+	static bool IsRetryable(const FHttpResponsePtr& Response, const bool bWasSuccessful, const bool bIsIdempotent);
+
+	// Retry-After if the server sent one, otherwise exponential backoff with jitter
+	static float GetRetryDelay(const FHttpResponsePtr& Response, const int32 Attempts);
+
+	// A completed request can't be sent again, so retries go out as a copy
+	static TSharedRef<IHttpRequest, ESPMode::ThreadSafe> CloneRequest(const TSharedRef<IHttpRequest, ESPMode::ThreadSafe>& InRequest);
+
+	static void CompleteWithoutResponse(const TSharedRef<FScheduledRequest>& ScheduledRequest);
+
+	TArray<TSharedRef<FScheduledRequest>> Queue;
+
+	// Requests sitting out a retry delay, kept so that Reset can fail them
+	TArray<TSharedRef<FScheduledRequest>> WaitingToRetry;
+
+	// Sent and not back yet, counted against MaxConcurrentRequests
+	TArray<TSharedRef<FScheduledRequest>> InFlight;
+
+	double AvailableTokens = -1.0;
+	double LastRefillTime = 0.0;
+
+	// Set by a 429, no rate limited request leaves the queue before this time
+	double PausedUntil = 0.0;
+
+	FTSTicker::FDelegateHandle PumpTickerHandle;
+};
@@ -0,0 +1,82 @@
+// Copyright Jared Therriault 2019, 2022
+
+#pragma once
+
+#include "RuntimeDataTable.h"
+
+#include "Containers/Ticker.h"
+
+#include "RuntimeDataTableSheetPoller.generated.h"
+
+/**
+ * Downloads one sheet on a timer on behalf of everyone subscribed to it and tells them which rows changed.
+ * There is only ever one poller per sheet and account, no matter how many subscribers it has. It polls at the shortest
+ * interval any of them asked for. Each download is parsed off the game thread and every row is hashed. Subscribers
+ * only hear about rows whose hash differs from the previous download, so a sheet that hasn't changed costs one
+ * request and nothing else. Use SubscribeToSheet and UnsubscribeFromSheet on URuntimeDataTableObject rather than this class directly.
+ */
+UCLASS()
+class RUNTIMEDATATABLE_API URuntimeDataTableSheetPoller : public UObject
+{
+	GENERATED_BODY()
+
+public:
+
+	// Returns a handle for Unsubscribe, or INDEX_NONE if the subscription could not be made
+	static int32 Subscribe(
+		const FRuntimeDataTableTokenInfo& InTokenInfo, const FRuntimeDataTableOperationParams& OperationParams,
+		const FString& InSheetURL, const bool bSheetIsPublic, const float InPollIntervalSeconds,
+		const FRDTSheetRowDelegate& OnRowAdded, const FRDTSheetRowDelegate& OnRowChanged, const FRDTSheetRowDelegate& OnRowRemoved);
+
+	// The poller stops once its last subscriber is gone
+	static void Unsubscribe(const int32 InSubscriptionHandle);
+
+	static void UnsubscribeAll();
+
+protected:
+
+	// Do not call
+	UFUNCTION()
+	void OnSheetDownloaded(FRuntimeDataTableCallbackInfo CallbackInfo, const FEasyCsvInfo& CsvInfo);
+
+private:
+
+	struct FSubscriber
+	{
+		float PollIntervalSeconds = 0.f;
+
+		FRDTSheetRowDelegate OnRowAdded;
+		FRDTSheetRowDelegate OnRowChanged;
+		FRDTSheetRowDelegate OnRowRemoved;
+	};
+
+	void Poll();
+
+	bool OnPollTimerElapsed(float DeltaTime);
+
+	// Restarts the timer at the shortest interval any subscriber wants
+	void UpdatePollInterval();
+
+	void Stop();
+
+	FRuntimeDataTableTokenInfo TokenInfo;
+	FRuntimeDataTableOperationParams OperationParams;
+	FString SheetURL;
+	FString PollerKey;
+	bool bSheetIsPublic = false;
+
+	TMap<int32, FSubscriber> Subscribers;
+
+	float PollIntervalSeconds = 0.f;
+	FTSTicker::FDelegateHandle PollTickerHandle;
+	bool bDownloadInFlight = false;
+
+	// The last successful download and the hash of each of its rows
+	bool bHasSnapshot = false;
+	FEasyCsvInfo Snapshot;
+	TMap<FName, uint32> RowHashes;
+
+	static TMap<FString, URuntimeDataTableSheetPoller*> Pollers;
+	static TMap<int32, URuntimeDataTableSheetPoller*> PollersBySubscription;
+	static int32 NextSubscriptionHandle;
+};
@@ -0,0 +1,73 @@
+// Copyright Jared Therriault 2019, 2022
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FRuntimeDataTableJsonPayloadWriter;
+
+// What we believe a sheet tab looks like after our last write to it
+struct RUNTIMEDATATABLE_API FRuntimeDataTableSheetSnapshot
+{
+	// The size of the tab's grid, which is not the same as the size of the data in it
+	int32 GridRowCount = INDEX_NONE;
+	int32 GridColumnCount = INDEX_NONE;
+
+	// False until a write has gone out, in which case the tab's contents are unknown and must be cleared
+	bool bHasWrittenValues = false;
+
+	TArray<TArray<FString>> Values;
+
+	bool HasGridProperties() const
+	{
+		return GridRowCount > INDEX_NONE && GridColumnCount > INDEX_NONE;
+	}
+};
+
+/**
+ * Process-wide record of the grid size and last written values of every sheet tab WriteCsvToSheetIncremental has touched.
+ * Lets a write skip the metadata request and send only the cells that changed since the previous write.
+ * Edits made to the sheet by anyone else are not seen, so force a full write if the sheet may have been changed by hand.
+ */
+class RUNTIMEDATATABLE_API FRuntimeDataTableSheetWriteCache
+{
+public:
+
+	static FRuntimeDataTableSheetWriteCache& Get();
+
+	// Returns false if we know nothing about this tab
+	bool FindSnapshot(const FString& InSpreadsheetId, const int32 InSheetId, FRuntimeDataTableSheetSnapshot& OutSnapshot) const;
+
+	// Grid size has just been read from the API, whatever values we had recorded can no longer be trusted
+	void SetGridProperties(const FString& InSpreadsheetId, const int32 InSheetId, const int32 InRowCount, const int32 InColumnCount);
+
+	void StoreSnapshot(const FString& InSpreadsheetId, const int32 InSheetId, FRuntimeDataTableSheetSnapshot InSnapshot);
+
+	void Invalidate(const FString& InSpreadsheetId, const int32 InSheetId);
+
+	void Reset();
+
+	/**
+	 * Writes the batchUpdate requests that turn the Previous snapshot into InValues and outputs the snapshot the sheet will be in afterwards.
+	 * Dimension changes come first, then a clear of any cells that no longer hold data, then one updateCells per run of changed cells,
+	 * or a single one over the bounding box of every changed cell when the runs already cover at least half of it.
+	 * @param Writer Must be inside the "requests" array of the batchUpdate body.
+	 * @return The number of requests written. Zero means nothing has changed.
+	 */
+	static int32 BuildDiffRequests(
+		const int32 InSheetId, const FRuntimeDataTableSheetSnapshot& Previous, const TArray<TArray<FString>>& InValues,
+		FRuntimeDataTableJsonPayloadWriter& Writer, FRuntimeDataTableSheetSnapshot& OutNextSnapshot);
+
+private:
+
+	FRuntimeDataTableSheetWriteCache() {}
+
+	static FString MakeCacheKey(const FString& InSpreadsheetId, const int32 InSheetId)
+	{
+		return InSpreadsheetId + "|" + FString::FromInt(InSheetId);
+	}
+
+	mutable FCriticalSection CacheCriticalSection;
+
+	TMap<FString, FRuntimeDataTableSheetSnapshot> Snapshots;
+};
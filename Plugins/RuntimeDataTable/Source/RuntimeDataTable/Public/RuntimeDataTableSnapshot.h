@@ -0,0 +1,52 @@
+// Copyright Jared Therriault 2019, 2022
+
+#pragma once
+
+#include "EasyCsv.h"
+
+/**
+ * A sheet as it was when it was downloaded, already parsed, with a hash of each row.
+ * Snapshots are written into the project's content by URuntimeDataTableSnapshotCommandlet so that they ship with the
+ * build, and read back in one read rather than a download and a parse. Once a newer version of the
+ * sheet has been fetched at runtime, it's written to Saved and preferred from then on.
+ * Reading and writing are safe from any thread.
+ */
+struct RUNTIMEDATATABLE_API FRuntimeDataTableSnapshot
+{
+	FString SheetURL;
+	FDateTime SnapshotTime;
+	FEasyCsvInfo CsvInfo;
+	TMap<FName, uint32> RowHashes;
+
+	// Where the commandlet writes the snapshot, under the project's Content directory
+	static FString GetCookedSnapshotPath(const FString& InSnapshotName);
+
+	// Where newer versions fetched at runtime are kept
+	static FString GetSavedSnapshotPath(const FString& InSnapshotName);
+
+	// Whichever of the cooked and saved snapshots is newer
+	static bool LoadNewest(const FString& InSnapshotName, FRuntimeDataTableSnapshot& OutSnapshot);
+
+	bool Load(const FString& InPath);
+
+	// Written next to InPath first and moved into place, so a reader never sees half a file
+	bool Save(const FString& InPath) const;
+
+	void ComputeRowHashes();
+
+	/**
+	 * Compares InNewer with this snapshot row by row.
+	 * OutChangedRows are new or different in InNewer, OutRemovedRows are in this snapshot but not in InNewer.
+	 * If the headers differ, every row counts as changed.
+	 */
+	void Diff(const FEasyCsvInfo& InNewer, TMap<FName, uint32>& OutNewRowHashes, TArray<FName>& OutChangedRows, TArray<FName>& OutRemovedRows) const;
+
+	static uint32 HashRow(const TArray<FString>& InValues);
+
+private:
+
+	static bool ReadSnapshotTime(const FString& InPath, FDateTime& OutSnapshotTime);
+
+	static constexpr uint32 FileMagic = 0x53544452;
+	static constexpr uint32 FileFormatVersion = 1;
+};
@@ -0,0 +1,74 @@
+// Copyright Jared Therriault 2019, 2022
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "EasyCsvStats.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "Trace/Trace.h"
+
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Sign Token Assertion"), STAT_RuntimeDataTable_SignAssertion, STATGROUP_RuntimeDataTable, RUNTIMEDATATABLE_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Parse Download"), STAT_RuntimeDataTable_ParseDownload, STATGROUP_RuntimeDataTable, RUNTIMEDATATABLE_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Update DataTable From CSV"), STAT_RuntimeDataTable_UpdateDataTable, STATGROUP_RuntimeDataTable, RUNTIMEDATATABLE_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Update Array From CSV"), STAT_RuntimeDataTable_UpdateArray, STATGROUP_RuntimeDataTable, RUNTIMEDATATABLE_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Generate CSV From Array"), STAT_RuntimeDataTable_GenerateCsv, STATGROUP_RuntimeDataTable, RUNTIMEDATATABLE_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Save Backup"), STAT_RuntimeDataTable_SaveBackup, STATGROUP_RuntimeDataTable, RUNTIMEDATATABLE_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Load Backup"), STAT_RuntimeDataTable_LoadBackup, STATGROUP_RuntimeDataTable, RUNTIMEDATATABLE_API);
+
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Requests Sent"), STAT_RuntimeDataTable_RequestsSent, STATGROUP_RuntimeDataTable, RUNTIMEDATATABLE_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Requests Retried"), STAT_RuntimeDataTable_RequestsRetried, STATGROUP_RuntimeDataTable, RUNTIMEDATATABLE_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Requests Queued"), STAT_RuntimeDataTable_RequestsQueued, STATGROUP_RuntimeDataTable, RUNTIMEDATATABLE_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Requests In Flight"), STAT_RuntimeDataTable_RequestsInFlight, STATGROUP_RuntimeDataTable, RUNTIMEDATATABLE_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Active Operations"), STAT_RuntimeDataTable_ActiveOperations, STATGROUP_RuntimeDataTable, RUNTIMEDATATABLE_API);
+
+// Float stats are kept as doubles, so unlike a DWORD this doesn't wrap after 4 GB in a long session
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("Bytes Downloaded"), STAT_RuntimeDataTable_BytesDownloaded, STATGROUP_RuntimeDataTable, RUNTIMEDATATABLE_API);
+
+DECLARE_MEMORY_STAT_EXTERN(TEXT("Downloads Being Parsed"), STAT_RuntimeDataTable_ParseMemory, STATGROUP_RuntimeDataTable, RUNTIMEDATATABLE_API);
+DECLARE_MEMORY_STAT_EXTERN(TEXT("Backups Being Written"), STAT_RuntimeDataTable_BackupMemory, STATGROUP_RuntimeDataTable, RUNTIMEDATATABLE_API);
+
+// Turn on with -trace=cpu,RuntimeDataTable to see each stage with its operation name and sizes in Insights
+UE_TRACE_CHANNEL_EXTERN(RuntimeDataTableChannel, RUNTIMEDATATABLE_API);
+
+/**
+ * Where the time goes in a sheet refresh: token, HTTP, parse, import and backup.
+ * Each stage that finishes is added to a latency histogram for that stage, and for that stage of that operation if
+ * the operation is known, and is sent as a trace event on RuntimeDataTableChannel.
+ * "RuntimeDataTable.DumpLatency" prints the histograms, "RuntimeDataTable.ResetLatency" empties them.
+ * Thread safe.
+ */
+class RUNTIMEDATATABLE_API FRuntimeDataTableStats
+{
+public:
+
+	static void RecordStage(
+		const TCHAR* InStageName, const FName InOperationName, const double InDurationSeconds,
+		const int64 InNumBytes = 0, const int32 InNumRows = 0);
+
+	static void DumpLatencyHistograms(FOutputDevice& Ar);
+
+	static void ResetLatencyHistograms();
+
+private:
+
+	// Bucket 0 is under 1ms, bucket N is under 2^N ms, the last one is everything slower
+	static constexpr int32 NumBuckets = 18;
+
+	struct FLatencyHistogram
+	{
+		int32 Buckets[NumBuckets] = {};
+		int32 Count = 0;
+		double TotalSeconds = 0.0;
+		double MinSeconds = TNumericLimits<double>::Max();
+		double MaxSeconds = 0.0;
+
+		void Add(const double InSeconds);
+
+		// The upper bound of the bucket the percentile falls in, in ms
+		double GetPercentileUpperBoundMs(const float InPercentile) const;
+	};
+
+	static FCriticalSection HistogramsCriticalSection;
+	static TMap<FString, FLatencyHistogram> Histograms;
+};
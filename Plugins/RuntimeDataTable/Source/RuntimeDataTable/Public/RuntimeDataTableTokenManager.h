@@ -0,0 +1,98 @@
+// Copyright Jared Therriault 2019, 2022
+
+#pragma once
+
+#include "RuntimeDataTable.h"
+
+#include "Containers/Ticker.h"
+#include "Interfaces/IHttpRequest.h"
+
+namespace jwt
+{
+	namespace algorithm
+	{
+		struct rs256;
+	}
+}
+
+/**
+ * Process-wide cache of OAuth access tokens, keyed by service account, scope and token endpoint.
+ * Every operation used to sign a fresh JWT and trade it for an access token before doing any real work.
+ * Now the first caller pays for that exchange and everyone else reuses the result until shortly before it expires.
+ * Callers that arrive while an exchange is in flight wait on that exchange instead of starting their own,
+ * and tokens that are still in use are refreshed in the background before they run out.
+ */
+class RUNTIMEDATATABLE_API FRuntimeDataTableTokenManager
+{
+public:
+
+	static FRuntimeDataTableTokenManager& Get();
+
+	/**
+	 * Calls back with a valid access token for the given service account, either straight from the cache or
+	 * after a (shared) exchange with the token endpoint. The delegate may be executed before this method returns.
+	 */
+	void RequestAccessToken(FRuntimeDataTableTokenInfo InTokenInfo, const FRDTGetJWTDelegate& CallOnComplete);
+
+	/** Drops the cached token for the given service account, e.g. after the API rejected it with a 401. */
+	void InvalidateAccessToken(FRuntimeDataTableTokenInfo InTokenInfo);
+
+	/** Same as above for whichever service account the token was issued to, for when only the bearer token is at hand. */
+	void InvalidateAccessToken(const FString& InAccessToken);
+
+	/** Drops every cached token and parsed private key and stops all background refreshes. */
+	void Reset();
+
+	/** Signs a JWT assertion for the given token info, reusing the parsed private key where possible. */
+	FString CreateSignedAssertion(FRuntimeDataTableTokenInfo InTokenInfo);
+
+private:
+
+	FRuntimeDataTableTokenManager() {}
+
+	struct FCachedAccessToken
+	{
+		FRuntimeDataTableTokenInfo TokenInfo;
+
+		FString AccessToken;
+		FDateTime TimeOfExpiration = FDateTime::MinValue();
+
+		// Only tokens that are actually being used get refreshed in the background
+		bool bUsedSinceLastRefresh = false;
+		bool bRefreshInFlight = false;
+
+		// Everyone waiting on the in-flight exchange
+		TArray<FRDTGetJWTDelegate> PendingCallbacks;
+
+		FTSTicker::FDelegateHandle RefreshTickerHandle;
+	};
+
+	static FString MakeCacheKey(const FRuntimeDataTableTokenInfo& InTokenInfo);
+
+	// Tokens with fewer seconds than this left are never handed out, callers wait for the refresh instead
+	static constexpr int32 MinimumUsableSeconds = 10;
+
+	TSharedPtr<jwt::algorithm::rs256> FindOrCreateSigner(const FString& InPrivateKey);
+
+	void SendTokenRequest(
+		const FRuntimeDataTableTokenInfo& InTokenInfo, const FString& CacheKey, const FRDTGetJWTDelegate& UncachedCallback);
+
+	void OnTokenResponseReceived(
+		FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful,
+		FString CacheKey, FRuntimeDataTableTokenInfo InTokenInfo, FRDTGetJWTDelegate UncachedCallback);
+
+	bool OnRefreshTimerElapsed(float DeltaTime, FString CacheKey);
+
+	void ScheduleBackgroundRefresh(FCachedAccessToken& CachedToken, const FString& CacheKey);
+
+	static void ExecuteWithToken(
+		const FRDTGetJWTDelegate& CallOnComplete, FRuntimeDataTableCallbackInfo CallbackInfo,
+		const FString& AccessToken, const FDateTime& TimeOfExpiration);
+
+	FCriticalSection CacheCriticalSection;
+
+	TMap<FString, FCachedAccessToken> CachedTokens;
+
+	// Keyed by the unescaped PEM so the same key is only ever parsed once
+	TMap<FString, TSharedPtr<jwt::algorithm::rs256>> CachedSigners;
+};
@@ -0,0 +1,296 @@
+// Copyright Jared Therriault 2019, 2022
+
+#include "RuntimeDataTableBenchmark.h"
+
+#include "RuntimeDataTableMockSheetsServer.h"
+#include "RuntimeDataTableModule.h"
+#include "RuntimeDataTableProjectSettings.h"
+#include "RuntimeDataTableStats.h"
+
+#include "HAL/IConsoleManager.h"
+#include "UObject/StrongObjectPtr.h"
+
+#define UI UI_ST
+THIRD_PARTY_INCLUDES_START
+#include <openssl/bio.h>
+#include <openssl/bn.h>
+#include <openssl/evp.h>
+#include <openssl/pem.h>
+#include <openssl/rsa.h>
+THIRD_PARTY_INCLUDES_END
+#undef UI
+
+static const FString BenchmarkReadSpreadsheetId = "benchmark-read";
+static const FString BenchmarkWriteSpreadsheetId = "benchmark-write";
+
+// Only one run at a time
+static TStrongObjectPtr<URuntimeDataTableBenchmark> ActiveBenchmark;
+
+static FAutoConsoleCommand BenchmarkCommand(
+	TEXT("RuntimeDataTable.Benchmark"),
+	TEXT("Downloads and writes a generated sheet against a local stand-in for Google and prints the throughput. ")
+	TEXT("Args: Rows= Columns= Downloads= Writes= LatencyMs= JitterMs= KBps= ErrorRate= Quota= Seed= Port="),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&URuntimeDataTableBenchmark::Run));
+
+void URuntimeDataTableBenchmark::Run(const TArray<FString>& Args)
+{
+	if (ActiveBenchmark.IsValid())
+	{
+		UE_LOG(LogRuntimeDataTable, Warning, TEXT("%hs: A benchmark is already running"), __FUNCTION__);
+		return;
+	}
+
+	const FString Params = FString::Join(Args, TEXT(" "));
+
+	URuntimeDataTableBenchmark* Benchmark = NewObject<URuntimeDataTableBenchmark>();
+	FParse::Value(*Params, TEXT("Rows="), Benchmark->NumRows);
+	FParse::Value(*Params, TEXT("Columns="), Benchmark->NumColumns);
+	FParse::Value(*Params, TEXT("Downloads="), Benchmark->NumDownloads);
+	FParse::Value(*Params, TEXT("Writes="), Benchmark->NumWrites);
+	Benchmark->NumRows = FMath::Max(Benchmark->NumRows, 1);
+	Benchmark->NumColumns = FMath::Max(Benchmark->NumColumns, 1);
+
+	FRuntimeDataTableMockSheetsServer::FFaultInjection FaultInjection;
+	float LatencyMs = 0.f;
+	float JitterMs = 0.f;
+	int32 KBps = 0;
+	uint32 Port = FRuntimeDataTableMockSheetsServer::DefaultPort;
+	FParse::Value(*Params, TEXT("LatencyMs="), LatencyMs);
+	FParse::Value(*Params, TEXT("JitterMs="), JitterMs);
+	FParse::Value(*Params, TEXT("KBps="), KBps);
+	FParse::Value(*Params, TEXT("ErrorRate="), FaultInjection.ErrorRate);
+	FParse::Value(*Params, TEXT("Quota="), FaultInjection.QuotaRequestsPerMinute);
+	FParse::Value(*Params, TEXT("Seed="), FaultInjection.RandomSeed);
+	FParse::Value(*Params, TEXT("Port="), Port);
+	FaultInjection.LatencySeconds = LatencyMs / 1000.f;
+	FaultInjection.LatencyJitterSeconds = JitterMs / 1000.f;
+	FaultInjection.BytesPerSecond = static_cast<int64>(KBps) * 1024;
+
+	FRuntimeDataTableMockSheetsServer& Server = FRuntimeDataTableMockSheetsServer::Get();
+	Benchmark->bStartedServer = !Server.IsRunning();
+	if (!Server.Start(Port))
+	{
+		UE_LOG(LogRuntimeDataTable, Error, TEXT("%hs: Could not start the mock server on port %u"), __FUNCTION__, Port);
+		return;
+	}
+
+	// Header row, then one row per key
+	TStringBuilder<1024> Builder;
+	Builder << TEXT("Key");
+	for (int32 ColumnIndex = 0; ColumnIndex < Benchmark->NumColumns; ColumnIndex++)
+	{
+		Builder.Appendf(TEXT(",Column%i"), ColumnIndex);
+	}
+	Builder << TEXT("\r\n");
+	for (int32 RowIndex = 0; RowIndex < Benchmark->NumRows; RowIndex++)
+	{
+		Builder.Appendf(TEXT("Row%i"), RowIndex);
+		for (int32 ColumnIndex = 0; ColumnIndex < Benchmark->NumColumns; ColumnIndex++)
+		{
+			Builder.Appendf(TEXT(",%i.%i"), RowIndex, ColumnIndex);
+		}
+		Builder << TEXT("\r\n");
+	}
+	Benchmark->Csv = Builder.ToString();
+
+	Server.SetSheet(BenchmarkReadSpreadsheetId, 0, "Sheet1", Benchmark->Csv);
+	Server.SetSheet(BenchmarkWriteSpreadsheetId, 0, "Sheet1", "");
+	Server.SetFaultInjection(FaultInjection);
+	Server.ResetStats();
+	FRuntimeDataTableStats::ResetLatencyHistograms();
+
+	// Identical downloads would otherwise share one request, and every one of them would be counted as a full sheet
+	URuntimeDataTableProjectSettings* Settings = GetMutableDefault<URuntimeDataTableProjectSettings>();
+	Benchmark->bPreviousCoalesceIdenticalDownloads = Settings->bCoalesceIdenticalDownloads;
+	Settings->bCoalesceIdenticalDownloads = false;
+
+	ActiveBenchmark.Reset(Benchmark);
+
+	UE_LOG(LogRuntimeDataTable, Display,
+		TEXT("%hs: %i downloads and %i writes of %i rows x %i columns (%i bytes), latency %.0fms +%.0fms, %i KB/s, error rate %.2f, quota %i/min"),
+		__FUNCTION__, Benchmark->NumDownloads, Benchmark->NumWrites, Benchmark->NumRows, Benchmark->NumColumns, Benchmark->Csv.Len(),
+		LatencyMs, JitterMs, KBps, FaultInjection.ErrorRate, FaultInjection.QuotaRequestsPerMinute);
+
+	Benchmark->StartDownloads();
+}
+
+void URuntimeDataTableBenchmark::StartDownloads()
+{
+	NumPending = NumDownloads;
+	NumFailed = 0;
+	NumBytes = 0;
+	PhaseStartTime = FPlatformTime::Seconds();
+
+	if (NumPending == 0)
+	{
+		StartWrites();
+		return;
+	}
+
+	FRuntimeDataTableOperationParams OperationParams;
+	OperationParams.OperationName = "Benchmark.Download";
+
+	FRDTGetCsvInfoDelegate OnDownloaded;
+	OnDownloaded.BindUFunction(this, GET_FUNCTION_NAME_CHECKED(URuntimeDataTableBenchmark, OnSheetDownloaded));
+
+	const FString SheetURL = FRuntimeDataTableMockSheetsServer::Get().GetSheetURL(BenchmarkReadSpreadsheetId, 0);
+	for (int32 DownloadIndex = 0; DownloadIndex < NumDownloads; DownloadIndex++)
+	{
+		URuntimeDataTableObject::DownloadSheetAsCsvInfo(FRuntimeDataTableTokenInfo(), OperationParams, OnDownloaded, SheetURL, true);
+	}
+}
+
+void URuntimeDataTableBenchmark::OnSheetDownloaded(FRuntimeDataTableCallbackInfo CallbackInfo, const FEasyCsvInfo& CsvInfo)
+{
+	if (!CallbackInfo.bWasSuccessful || CsvInfo.CSV_Keys.Num() != NumRows)
+	{
+		NumFailed++;
+	}
+	else
+	{
+		NumBytes += Csv.Len();
+	}
+
+	if (--NumPending > 0)
+	{
+		return;
+	}
+
+	DownloadSeconds = FPlatformTime::Seconds() - PhaseStartTime;
+	NumDownloadsFailed = NumFailed;
+	NumDownloadBytes = NumBytes;
+
+	StartWrites();
+}
+
+void URuntimeDataTableBenchmark::StartWrites()
+{
+	NumPending = NumWrites;
+	NumFailed = 0;
+	NumBytes = 0;
+	PhaseStartTime = FPlatformTime::Seconds();
+
+	if (PrivateKey.IsEmpty() && NumWrites > 0)
+	{
+		PrivateKey = GeneratePrivateKey();
+	}
+
+	if (NumPending == 0 || PrivateKey.IsEmpty())
+	{
+		NumFailed = NumPending;
+		Finish();
+		return;
+	}
+
+	FRuntimeDataTableTokenInfo TokenInfo;
+	TokenInfo.PrivateKey = PrivateKey;
+	TokenInfo.ServiceAccountEmail = "benchmark@localhost";
+	TokenInfo.TokenUri = FRuntimeDataTableMockSheetsServer::Get().GetTokenUri();
+
+	FRuntimeDataTableOperationParams OperationParams;
+	OperationParams.OperationName = "Benchmark.Write";
+
+	FRDTGetStringDelegate OnWritten;
+	OnWritten.BindUFunction(this, GET_FUNCTION_NAME_CHECKED(URuntimeDataTableBenchmark, OnSheetWritten));
+
+	for (int32 WriteIndex = 0; WriteIndex < NumWrites; WriteIndex++)
+	{
+		URuntimeDataTableObject::WriteCsvToSheet(TokenInfo, OperationParams, OnWritten, BenchmarkWriteSpreadsheetId, 0, Csv);
+	}
+}
+
+void URuntimeDataTableBenchmark::OnSheetWritten(FRuntimeDataTableCallbackInfo CallbackInfo)
+{
+	if (!CallbackInfo.bWasSuccessful)
+	{
+		NumFailed++;
+	}
+	else
+	{
+		NumBytes += Csv.Len();
+	}
+
+	if (--NumPending == 0)
+	{
+		Finish();
+	}
+}
+
+void URuntimeDataTableBenchmark::Finish()
+{
+	const double WriteSeconds = FPlatformTime::Seconds() - PhaseStartTime;
+
+	FRuntimeDataTableMockSheetsServer& Server = FRuntimeDataTableMockSheetsServer::Get();
+	const FRuntimeDataTableMockSheetsServer::FServerStats& ServerStats = Server.GetStats();
+
+	// The write has to round trip, or its throughput doesn't mean much
+	FString WrittenCsv;
+	const bool bWriteMatches = NumWrites == 0 ||
+		(Server.GetSheetAsCsv(BenchmarkWriteSpreadsheetId, 0, WrittenCsv) && WrittenCsv == Csv);
+
+	auto Throughput = [](const int64 InBytes, const double InSeconds)
+	{
+		return InSeconds > 0.0 ? InBytes / InSeconds / (1024.0 * 1024.0) : 0.0;
+	};
+
+	UE_LOG(LogRuntimeDataTable, Display, TEXT("RuntimeDataTable.Benchmark results"));
+	UE_LOG(LogRuntimeDataTable, Display, TEXT("  Downloads: %i ok, %i failed in %.3fs, %.2f MB/s, %.1f sheets/s"),
+		NumDownloads - NumDownloadsFailed, NumDownloadsFailed, DownloadSeconds, Throughput(NumDownloadBytes, DownloadSeconds),
+		DownloadSeconds > 0.0 ? (NumDownloads - NumDownloadsFailed) / DownloadSeconds : 0.0);
+	UE_LOG(LogRuntimeDataTable, Display, TEXT("  Writes: %i ok, %i failed in %.3fs, %.2f MB/s, %.1f sheets/s, round trip %s"),
+		NumWrites - NumFailed, NumFailed, WriteSeconds, Throughput(NumBytes, WriteSeconds),
+		WriteSeconds > 0.0 ? (NumWrites - NumFailed) / WriteSeconds : 0.0, bWriteMatches ? TEXT("matches") : TEXT("DOES NOT MATCH"));
+	UE_LOG(LogRuntimeDataTable, Display, TEXT("  Server: %i requests, %i injected errors, %i quota rejections, %lld bytes in, %lld bytes out"),
+		ServerStats.NumRequests, ServerStats.NumInjectedErrors, ServerStats.NumQuotaRejections,
+		ServerStats.NumBytesReceived, ServerStats.NumBytesSent);
+
+	FRuntimeDataTableStats::DumpLatencyHistograms(*GLog);
+
+	GetMutableDefault<URuntimeDataTableProjectSettings>()->bCoalesceIdenticalDownloads = bPreviousCoalesceIdenticalDownloads;
+
+	Server.SetFaultInjection(FRuntimeDataTableMockSheetsServer::FFaultInjection());
+	if (bStartedServer)
+	{
+		Server.Stop();
+	}
+
+	ActiveBenchmark.Reset();
+}
+
+FString URuntimeDataTableBenchmark::GeneratePrivateKey()
+{
+	FString Pem;
+
+	BIGNUM* Exponent = BN_new();
+	RSA* Rsa = RSA_new();
+	EVP_PKEY* Key = EVP_PKEY_new();
+
+	if (Exponent && Rsa && Key && BN_set_word(Exponent, RSA_F4) == 1 &&
+		RSA_generate_key_ex(Rsa, 2048, Exponent, nullptr) == 1 && EVP_PKEY_assign_RSA(Key, Rsa) == 1)
+	{
+		// Key owns it now
+		Rsa = nullptr;
+
+		// PKCS#8, which is what service account key files have
+		BIO* Bio = BIO_new(BIO_s_mem());
+		if (Bio && PEM_write_bio_PrivateKey(Bio, Key, nullptr, nullptr, 0, nullptr, nullptr) == 1)
+		{
+			char* PemData = nullptr;
+			const long PemLength = BIO_get_mem_data(Bio, &PemData);
+			Pem = FString(static_cast<int32>(PemLength), PemData);
+		}
+		BIO_free(Bio);
+	}
+
+	EVP_PKEY_free(Key);
+	RSA_free(Rsa);
+	BN_free(Exponent);
+
+	if (Pem.IsEmpty())
+	{
+		UE_LOG(LogRuntimeDataTable, Error, TEXT("%hs: Could not generate a key, writes will be skipped"), __FUNCTION__);
+	}
+
+	// Escaped the way it is in a key file
+	return Pem.Replace(TEXT("\n"), TEXT("\\n"));
+}
@@ -0,0 +1,6 @@
+// Copyright Jared Therriault 2019, 2022
+
+#include "Modules/ModuleManager.h"
+
+// The mock Sheets server, the benchmark and the snapshot commandlet, none of which belong in a shipping build
+IMPLEMENT_MODULE(FDefaultModuleImpl, RuntimeDataTableDeveloper);
@@ -0,0 +1,664 @@
+// Copyright Jared Therriault 2019, 2022
+
+#include "RuntimeDataTableMockSheetsServer.h"
+
+#include "RuntimeDataTableModule.h"
+#include "RuntimeDataTableProjectSettings.h"
+
+#include "Dom/JsonObject.h"
+#include "Dom/JsonValue.h"
+#include "GenericPlatform/GenericPlatformHttp.h"
+#include "HttpServerModule.h"
+#include "HttpServerRequest.h"
+#include "HttpServerResponse.h"
+#include "IHttpRouter.h"
+#include "Serialization/Csv/CsvParser.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+
+FRuntimeDataTableMockSheetsServer& FRuntimeDataTableMockSheetsServer::Get()
+{
+	static FRuntimeDataTableMockSheetsServer Instance;
+	return Instance;
+}
+
+bool FRuntimeDataTableMockSheetsServer::Start(const uint32 InPort)
+{
+	if (bIsRunning)
+	{
+		return Port == InPort;
+	}
+
+	Router = FHttpServerModule::Get().GetHttpRouter(InPort, true);
+	if (!Router.IsValid())
+	{
+		UE_LOG(LogRuntimeDataTable, Error, TEXT("%hs: Could not listen on port %u"), __FUNCTION__, InPort);
+		return false;
+	}
+
+	Port = InPort;
+
+	RouteHandles.Add(Router->BindRoute(FHttpPath("/spreadsheets/d"), EHttpServerRequestVerbs::VERB_GET,
+		FHttpRequestHandler::CreateRaw(this, &FRuntimeDataTableMockSheetsServer::HandleExportRequest)));
+	RouteHandles.Add(Router->BindRoute(FHttpPath("/v4/spreadsheets"), EHttpServerRequestVerbs::VERB_GET | EHttpServerRequestVerbs::VERB_POST,
+		FHttpRequestHandler::CreateRaw(this, &FRuntimeDataTableMockSheetsServer::HandleApiRequest)));
+	RouteHandles.Add(Router->BindRoute(FHttpPath("/token"), EHttpServerRequestVerbs::VERB_POST,
+		FHttpRequestHandler::CreateRaw(this, &FRuntimeDataTableMockSheetsServer::HandleTokenRequest)));
+
+	FHttpServerModule::Get().StartAllListeners();
+
+	URuntimeDataTableProjectSettings* Settings = GetMutableDefault<URuntimeDataTableProjectSettings>();
+	PreviousGoogleSheetsUrlPrefix = Settings->GoogleSheetsUrlPrefix;
+	PreviousGoogleSheetsApiUrlPrefix = Settings->GoogleSheetsApiUrlPrefix;
+	Settings->GoogleSheetsUrlPrefix = FString::Printf(TEXT("http://127.0.0.1:%u/spreadsheets/d/"), Port);
+	Settings->GoogleSheetsApiUrlPrefix = FString::Printf(TEXT("http://127.0.0.1:%u/v4/spreadsheets/"), Port);
+
+	RandomStream.Initialize(FaultInjection.RandomSeed);
+	bIsRunning = true;
+
+	UE_LOG(LogRuntimeDataTable, Display, TEXT("%hs: Listening on port %u"), __FUNCTION__, Port);
+	return true;
+}
+
+void FRuntimeDataTableMockSheetsServer::Stop()
+{
+	if (!bIsRunning)
+	{
+		return;
+	}
+
+	for (const TPair<uint32, FTSTicker::FDelegateHandle>& PendingResponse : PendingResponses)
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(PendingResponse.Value);
+	}
+	PendingResponses.Reset();
+
+	// Only our own routes, anything else in the process may be listening on the same module
+	for (const FHttpRouteHandle& RouteHandle : RouteHandles)
+	{
+		Router->UnbindRoute(RouteHandle);
+	}
+	RouteHandles.Reset();
+	Router.Reset();
+
+	URuntimeDataTableProjectSettings* Settings = GetMutableDefault<URuntimeDataTableProjectSettings>();
+	Settings->GoogleSheetsUrlPrefix = PreviousGoogleSheetsUrlPrefix;
+	Settings->GoogleSheetsApiUrlPrefix = PreviousGoogleSheetsApiUrlPrefix;
+
+	RecentRequestTimes.Reset();
+	IssuedAccessTokens.Reset();
+	bIsRunning = false;
+}
+
+void FRuntimeDataTableMockSheetsServer::SetFaultInjection(const FFaultInjection& InFaultInjection)
+{
+	FaultInjection = InFaultInjection;
+	RandomStream.Initialize(FaultInjection.RandomSeed);
+	RecentRequestTimes.Reset();
+}
+
+void FRuntimeDataTableMockSheetsServer::SetSheet(
+	const FString& InSpreadsheetId, const int32 InSheetId, const FString& InTitle, const FString& InCsv)
+{
+	FMockSheet* Sheet = FindSheet(InSpreadsheetId, InSheetId);
+	if (!Sheet)
+	{
+		Sheet = &Spreadsheets.FindOrAdd(InSpreadsheetId).AddDefaulted_GetRef();
+		Sheet->SheetId = InSheetId;
+	}
+
+	Sheet->Title = InTitle;
+	Sheet->Cells.Reset();
+
+	const FCsvParser Parser(InCsv);
+	for (const TArray<const TCHAR*>& Row : Parser.GetRows())
+	{
+		TArray<FString>& CellRow = Sheet->Cells.AddDefaulted_GetRef();
+		for (const TCHAR* Cell : Row)
+		{
+			CellRow.Add(Cell);
+		}
+		Sheet->ColumnCount = FMath::Max(Sheet->ColumnCount, CellRow.Num());
+	}
+
+	// Like a new Google sheet, there's always a bit of room
+	Sheet->RowCount = FMath::Max(Sheet->Cells.Num(), 1000);
+	Sheet->ColumnCount = FMath::Max(Sheet->ColumnCount, 26);
+}
+
+bool FRuntimeDataTableMockSheetsServer::GetSheetAsCsv(const FString& InSpreadsheetId, const int32 InSheetId, FString& OutCsv) const
+{
+	if (const TArray<FMockSheet>* Sheets = Spreadsheets.Find(InSpreadsheetId))
+	{
+		for (const FMockSheet& Sheet : *Sheets)
+		{
+			if (Sheet.SheetId == InSheetId)
+			{
+				OutCsv = Sheet.ToCsv();
+				return true;
+			}
+		}
+	}
+	return false;
+}
+
+void FRuntimeDataTableMockSheetsServer::RemoveAllSheets()
+{
+	Spreadsheets.Reset();
+}
+
+FString FRuntimeDataTableMockSheetsServer::GetSheetURL(const FString& InSpreadsheetId, const int32 InSheetId) const
+{
+	return FString::Printf(TEXT("http://127.0.0.1:%u/spreadsheets/d/%s/edit#gid=%i"), Port, *InSpreadsheetId, InSheetId);
+}
+
+FString FRuntimeDataTableMockSheetsServer::GetTokenUri() const
+{
+	return FString::Printf(TEXT("http://127.0.0.1:%u/token"), Port);
+}
+
+void FRuntimeDataTableMockSheetsServer::ResetStats()
+{
+	Stats = FServerStats();
+}
+
+void FRuntimeDataTableMockSheetsServer::FMockSheet::SetCell(const int32 InRow, const int32 InColumn, const FString& InValue)
+{
+	if (InRow < 0 || InColumn < 0)
+	{
+		return;
+	}
+
+	if (!Cells.IsValidIndex(InRow))
+	{
+		if (InValue.IsEmpty())
+		{
+			return;
+		}
+		Cells.SetNum(InRow + 1);
+	}
+
+	TArray<FString>& Row = Cells[InRow];
+	if (!Row.IsValidIndex(InColumn))
+	{
+		if (InValue.IsEmpty())
+		{
+			return;
+		}
+		Row.SetNum(InColumn + 1);
+	}
+
+	Row[InColumn] = InValue;
+	RowCount = FMath::Max(RowCount, InRow + 1);
+	ColumnCount = FMath::Max(ColumnCount, InColumn + 1);
+}
+
+FString FRuntimeDataTableMockSheetsServer::FMockSheet::ToCsv() const
+{
+	// Google leaves off trailing empty rows and columns
+	int32 LastRow = INDEX_NONE;
+	int32 LastColumn = INDEX_NONE;
+	for (int32 RowIndex = 0; RowIndex < Cells.Num(); RowIndex++)
+	{
+		for (int32 ColumnIndex = Cells[RowIndex].Num() - 1; ColumnIndex >= 0; ColumnIndex--)
+		{
+			if (!Cells[RowIndex][ColumnIndex].IsEmpty())
+			{
+				LastRow = RowIndex;
+				LastColumn = FMath::Max(LastColumn, ColumnIndex);
+				break;
+			}
+		}
+	}
+
+	FString Csv;
+	for (int32 RowIndex = 0; RowIndex <= LastRow; RowIndex++)
+	{
+		for (int32 ColumnIndex = 0; ColumnIndex <= LastColumn; ColumnIndex++)
+		{
+			if (ColumnIndex > 0)
+			{
+				Csv += TEXT(',');
+			}
+
+			const FString& Cell = Cells[RowIndex].IsValidIndex(ColumnIndex) ? Cells[RowIndex][ColumnIndex] : FString();
+			int32 Unused;
+			if (Cell.FindChar(TEXT(','), Unused) || Cell.FindChar(TEXT('"'), Unused) ||
+				Cell.FindChar(TEXT('\n'), Unused) || Cell.FindChar(TEXT('\r'), Unused))
+			{
+				Csv += TEXT('"') + Cell.Replace(TEXT("\""), TEXT("\"\"")) + TEXT('"');
+			}
+			else
+			{
+				Csv += Cell;
+			}
+		}
+		Csv += TEXT("\r\n");
+	}
+	return Csv;
+}
+
+FRuntimeDataTableMockSheetsServer::FMockSheet* FRuntimeDataTableMockSheetsServer::FindSheet(const FString& InSpreadsheetId, const int32 InSheetId)
+{
+	if (TArray<FMockSheet>* Sheets = Spreadsheets.Find(InSpreadsheetId))
+	{
+		return Sheets->FindByPredicate([InSheetId](const FMockSheet& Sheet) { return Sheet.SheetId == InSheetId; });
+	}
+	return nullptr;
+}
+
+FRuntimeDataTableMockSheetsServer::FMockSheet* FRuntimeDataTableMockSheetsServer::FindSheetByTitle(
+	const FString& InSpreadsheetId, const FString& InTitle)
+{
+	if (TArray<FMockSheet>* Sheets = Spreadsheets.Find(InSpreadsheetId))
+	{
+		return Sheets->FindByPredicate([&InTitle](const FMockSheet& Sheet) { return Sheet.Title == InTitle; });
+	}
+	return nullptr;
+}
+
+bool FRuntimeDataTableMockSheetsServer::HandleExportRequest(const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete)
+{
+	if (!AdmitRequest(Request, OnComplete))
+	{
+		return true;
+	}
+
+	// <SpreadsheetId>/export?format=csv&gid=<SheetId> or <SpreadsheetId>/gviz/tq?tqx=out:csv&sheet=<Title>
+	TArray<FString> PathParts;
+	Request.RelativePath.GetPath().ParseIntoArray(PathParts, TEXT("/"));
+
+	FMockSheet* Sheet = nullptr;
+	if (PathParts.Num() == 2 && PathParts[1] == "export")
+	{
+		// The export endpoint only takes a file extension here, anything else (such as a MIME type) is a client bug
+		const FString* Format = Request.QueryParams.Find("format");
+		if (!Format || *Format != "csv")
+		{
+			Respond(OnComplete, MakeErrorResponse(400, "INVALID_ARGUMENT", "Unsupported export format."));
+			return true;
+		}
+
+		const FString* Gid = Request.QueryParams.Find("gid");
+		Sheet = FindSheet(PathParts[0], Gid ? FCString::Atoi(**Gid) : 0);
+	}
+	else if (PathParts.Num() == 3 && PathParts[1] == "gviz")
+	{
+		const FString* Title = Request.QueryParams.Find("sheet");
+		Sheet = Title ? FindSheetByTitle(PathParts[0], FGenericPlatformHttp::UrlDecode(*Title)) : nullptr;
+	}
+
+	if (!Sheet)
+	{
+		Respond(OnComplete, MakeErrorResponse(404, "NOT_FOUND", "No such spreadsheet or tab."));
+		return true;
+	}
+
+	Respond(OnComplete, FHttpServerResponse::Create(Sheet->ToCsv(), TEXT("text/csv")));
+	return true;
+}
+
+bool FRuntimeDataTableMockSheetsServer::HandleApiRequest(const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete)
+{
+	if (!AdmitRequest(Request, OnComplete))
+	{
+		return true;
+	}
+
+	if (!IsAuthorized(Request))
+	{
+		Respond(OnComplete, MakeErrorResponse(401, "UNAUTHENTICATED", "Request is missing a valid access token."));
+		return true;
+	}
+
+	// <SpreadsheetId>, <SpreadsheetId>:batchUpdate or <SpreadsheetId>/values:batchUpdate
+	TArray<FString> PathParts;
+	Request.RelativePath.GetPath().ParseIntoArray(PathParts, TEXT("/"));
+
+	FString SpreadsheetId = PathParts.Num() > 0 ? PathParts[0] : FString();
+	FString Command;
+	if (PathParts.Num() == 2)
+	{
+		Command = PathParts[1];
+	}
+	else
+	{
+		SpreadsheetId.Split(TEXT(":"), &SpreadsheetId, &Command);
+		Command = Command.IsEmpty() ? FString() : ":" + Command;
+	}
+
+	if (!Spreadsheets.Contains(SpreadsheetId))
+	{
+		Respond(OnComplete, MakeErrorResponse(404, "NOT_FOUND", "Requested entity was not found."));
+		return true;
+	}
+
+	if (Request.Verb == EHttpServerRequestVerbs::VERB_GET && Command.IsEmpty())
+	{
+		Respond(OnComplete, MakeMetadataResponse(SpreadsheetId));
+		return true;
+	}
+
+	if (Request.Verb != EHttpServerRequestVerbs::VERB_POST || (Command != ":batchUpdate" && Command != "values:batchUpdate"))
+	{
+		Respond(OnComplete, MakeErrorResponse(404, "NOT_FOUND", FString::Printf(TEXT("%s is not supported here."), *Command)));
+		return true;
+	}
+
+	const FUTF8ToTCHAR BodyText(reinterpret_cast<const ANSICHAR*>(Request.Body.GetData()), Request.Body.Num());
+	TSharedPtr<FJsonObject> Body;
+	if (!FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(FString(BodyText.Length(), BodyText.Get())), Body) || !Body.IsValid())
+	{
+		Respond(OnComplete, MakeErrorResponse(400, "INVALID_ARGUMENT", "Invalid JSON payload received."));
+		return true;
+	}
+
+	Respond(OnComplete, Command == ":batchUpdate" ? ApplyBatchUpdate(SpreadsheetId, Body) : ApplyValuesBatchUpdate(SpreadsheetId, Body));
+	return true;
+}
+
+bool FRuntimeDataTableMockSheetsServer::HandleTokenRequest(const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete)
+{
+	if (!AdmitRequest(Request, OnComplete))
+	{
+		return true;
+	}
+
+	// The assertion isn't checked, only that there is one
+	if (!Request.QueryParams.Contains("assertion"))
+	{
+		Respond(OnComplete, MakeErrorResponse(400, "invalid_request", "Missing required parameter: assertion"));
+		return true;
+	}
+
+	const FString AccessToken = FString::Printf(TEXT("mock-token-%i"), IssuedAccessTokens.Num());
+	IssuedAccessTokens.Add(AccessToken);
+
+	Respond(OnComplete, FHttpServerResponse::Create(FString::Printf(
+		TEXT("{\"access_token\":\"%s\",\"expires_in\":3599,\"token_type\":\"Bearer\"}"), *AccessToken), TEXT("application/json")));
+	return true;
+}
+
+bool FRuntimeDataTableMockSheetsServer::AdmitRequest(const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete)
+{
+	Stats.NumRequests++;
+	Stats.NumBytesReceived += Request.Body.Num();
+
+	if (FaultInjection.QuotaRequestsPerMinute > 0)
+	{
+		const double Now = FPlatformTime::Seconds();
+		RecentRequestTimes.RemoveAll([Now](const double RequestTime) { return Now - RequestTime >= 60.0; });
+
+		if (RecentRequestTimes.Num() >= FaultInjection.QuotaRequestsPerMinute)
+		{
+			Stats.NumQuotaRejections++;
+
+			TUniquePtr<FHttpServerResponse> Response = MakeErrorResponse(429, "RESOURCE_EXHAUSTED", "Quota exceeded.");
+			const int32 RetryAfterSeconds = FMath::Max(1, FMath::CeilToInt(RecentRequestTimes[0] + 60.0 - Now));
+			Response->Headers.Add("Retry-After", { FString::FromInt(RetryAfterSeconds) });
+			Respond(OnComplete, MoveTemp(Response));
+			return false;
+		}
+
+		RecentRequestTimes.Add(Now);
+	}
+
+	if (FaultInjection.ErrorRate > 0.f && RandomStream.FRand() < FaultInjection.ErrorRate)
+	{
+		Stats.NumInjectedErrors++;
+		Respond(OnComplete, MakeErrorResponse(FaultInjection.ErrorResponseCode, "UNAVAILABLE", "Injected error."));
+		return false;
+	}
+
+	return true;
+}
+
+bool FRuntimeDataTableMockSheetsServer::IsAuthorized(const FHttpServerRequest& Request) const
+{
+	const TArray<FString>* Authorization = Request.Headers.Find("Authorization");
+	if (!Authorization || Authorization->Num() == 0)
+	{
+		return false;
+	}
+
+	FString AccessToken = (*Authorization)[0];
+	return AccessToken.RemoveFromStart("Bearer ") && IssuedAccessTokens.Contains(AccessToken);
+}
+
+TUniquePtr<FHttpServerResponse> FRuntimeDataTableMockSheetsServer::ApplyBatchUpdate(
+	const FString& InSpreadsheetId, const TSharedPtr<FJsonObject>& InBody)
+{
+	const TArray<TSharedPtr<FJsonValue>>* Requests = nullptr;
+	if (!InBody->TryGetArrayField("requests", Requests))
+	{
+		return MakeErrorResponse(400, "INVALID_ARGUMENT", "Missing requests.");
+	}
+
+	// Every kind of cell value the plugin sends is read as its text
+	auto GetCellValue = [](const TSharedPtr<FJsonValue>& CellValue) -> FString
+	{
+		const TSharedPtr<FJsonObject>* Cell = nullptr;
+		const TSharedPtr<FJsonObject>* UserEnteredValue = nullptr;
+		if (CellValue->TryGetObject(Cell) && (*Cell)->TryGetObjectField("userEnteredValue", UserEnteredValue))
+		{
+			for (const TPair<FString, TSharedPtr<FJsonValue>>& Pair : (*UserEnteredValue)->Values)
+			{
+				return Pair.Value->AsString();
+			}
+		}
+		return FString();
+	};
+
+	auto WriteRows = [&GetCellValue](FMockSheet& Sheet, const TArray<TSharedPtr<FJsonValue>>& Rows, const int32 StartRow, const int32 StartColumn)
+	{
+		for (int32 RowOffset = 0; RowOffset < Rows.Num(); RowOffset++)
+		{
+			const TSharedPtr<FJsonObject>* Row = nullptr;
+			const TArray<TSharedPtr<FJsonValue>>* Values = nullptr;
+			if (Rows[RowOffset]->TryGetObject(Row) && (*Row)->TryGetArrayField("values", Values))
+			{
+				for (int32 ColumnOffset = 0; ColumnOffset < Values->Num(); ColumnOffset++)
+				{
+					Sheet.SetCell(StartRow + RowOffset, StartColumn + ColumnOffset, GetCellValue((*Values)[ColumnOffset]));
+				}
+			}
+		}
+	};
+
+	for (const TSharedPtr<FJsonValue>& RequestValue : *Requests)
+	{
+		const TSharedPtr<FJsonObject> Request = RequestValue->AsObject();
+		const TSharedPtr<FJsonObject>* Params = nullptr;
+
+		if (Request->TryGetObjectField("updateCells", Params))
+		{
+			const TArray<TSharedPtr<FJsonValue>>* Rows = nullptr;
+			(*Params)->TryGetArrayField("rows", Rows);
+
+			const TSharedPtr<FJsonObject>* Start = nullptr;
+			const TSharedPtr<FJsonObject>* Range = nullptr;
+			if ((*Params)->TryGetObjectField("start", Start))
+			{
+				FMockSheet* Sheet = FindSheet(InSpreadsheetId, (*Start)->GetIntegerField("sheetId"));
+				if (!Sheet)
+				{
+					return MakeErrorResponse(400, "INVALID_ARGUMENT", "No grid with the given sheetId.");
+				}
+				if (Rows)
+				{
+					WriteRows(*Sheet, *Rows, (*Start)->GetIntegerField("rowIndex"), (*Start)->GetIntegerField("columnIndex"));
+				}
+			}
+			else if ((*Params)->TryGetObjectField("range", Range))
+			{
+				FMockSheet* Sheet = FindSheet(InSpreadsheetId, (*Range)->GetIntegerField("sheetId"));
+				if (!Sheet)
+				{
+					return MakeErrorResponse(400, "INVALID_ARGUMENT", "No grid with the given sheetId.");
+				}
+
+				// A range without rows clears it, missing bounds are unbounded
+				int32 StartRow = 0, EndRow = Sheet->RowCount, StartColumn = 0, EndColumn = Sheet->ColumnCount;
+				(*Range)->TryGetNumberField("startRowIndex", StartRow);
+				(*Range)->TryGetNumberField("endRowIndex", EndRow);
+				(*Range)->TryGetNumberField("startColumnIndex", StartColumn);
+				(*Range)->TryGetNumberField("endColumnIndex", EndColumn);
+
+				for (int32 RowIndex = StartRow; RowIndex < FMath::Min(EndRow, Sheet->Cells.Num()); RowIndex++)
+				{
+					for (int32 ColumnIndex = StartColumn; ColumnIndex < FMath::Min(EndColumn, Sheet->Cells[RowIndex].Num()); ColumnIndex++)
+					{
+						Sheet->Cells[RowIndex][ColumnIndex].Reset();
+					}
+				}
+				if (Rows)
+				{
+					WriteRows(*Sheet, *Rows, StartRow, StartColumn);
+				}
+			}
+		}
+		else if (Request->TryGetObjectField("appendDimension", Params))
+		{
+			FMockSheet* Sheet = FindSheet(InSpreadsheetId, (*Params)->GetIntegerField("sheetId"));
+			if (!Sheet)
+			{
+				return MakeErrorResponse(400, "INVALID_ARGUMENT", "No grid with the given sheetId.");
+			}
+
+			int32& Count = (*Params)->GetStringField("dimension") == "COLUMNS" ? Sheet->ColumnCount : Sheet->RowCount;
+			Count += (*Params)->GetIntegerField("length");
+		}
+		else if (Request->TryGetObjectField("appendCells", Params))
+		{
+			FMockSheet* Sheet = FindSheet(InSpreadsheetId, (*Params)->GetIntegerField("sheetId"));
+			if (!Sheet)
+			{
+				return MakeErrorResponse(400, "INVALID_ARGUMENT", "No grid with the given sheetId.");
+			}
+
+			const TArray<TSharedPtr<FJsonValue>>* Rows = nullptr;
+			if ((*Params)->TryGetArrayField("rows", Rows))
+			{
+				WriteRows(*Sheet, *Rows, Sheet->Cells.Num(), 0);
+			}
+		}
+		else
+		{
+			return MakeErrorResponse(400, "INVALID_ARGUMENT", "Unsupported request kind.");
+		}
+	}
+
+	return FHttpServerResponse::Create(
+		FString::Printf(TEXT("{\"spreadsheetId\":\"%s\",\"replies\":[]}"), *InSpreadsheetId), TEXT("application/json"));
+}
+
+TUniquePtr<FHttpServerResponse> FRuntimeDataTableMockSheetsServer::ApplyValuesBatchUpdate(
+	const FString& InSpreadsheetId, const TSharedPtr<FJsonObject>& InBody)
+{
+	const TArray<TSharedPtr<FJsonValue>>* Data = nullptr;
+	if (!InBody->TryGetArrayField("data", Data))
+	{
+		return MakeErrorResponse(400, "INVALID_ARGUMENT", "Missing data.");
+	}
+
+	int32 TotalUpdatedCells = 0;
+	for (const TSharedPtr<FJsonValue>& ValueRangeValue : *Data)
+	{
+		const TSharedPtr<FJsonObject> ValueRange = ValueRangeValue->AsObject();
+
+		// 'Title'!A1:C3, only the top left cell matters
+		FString Title;
+		FString Cells;
+		if (!ValueRange->GetStringField("range").Split(TEXT("!"), &Title, &Cells))
+		{
+			return MakeErrorResponse(400, "INVALID_ARGUMENT", "Ranges must name their tab.");
+		}
+		Title.TrimQuotesInline();
+
+		FMockSheet* Sheet = FindSheetByTitle(InSpreadsheetId, Title);
+		if (!Sheet)
+		{
+			return MakeErrorResponse(400, "INVALID_ARGUMENT", FString::Printf(TEXT("Unable to parse range: %s"), *ValueRange->GetStringField("range")));
+		}
+
+		int32 StartColumn = 0;
+		int32 CharIndex = 0;
+		for (; CharIndex < Cells.Len() && FChar::IsAlpha(Cells[CharIndex]); CharIndex++)
+		{
+			StartColumn = StartColumn * 26 + (FChar::ToUpper(Cells[CharIndex]) - TEXT('A') + 1);
+		}
+		const int32 StartRow = FMath::Max(FCString::Atoi(*Cells.Mid(CharIndex)), 1) - 1;
+		StartColumn = FMath::Max(StartColumn, 1) - 1;
+
+		const TArray<TSharedPtr<FJsonValue>>* Rows = nullptr;
+		if (ValueRange->TryGetArrayField("values", Rows))
+		{
+			for (int32 RowOffset = 0; RowOffset < Rows->Num(); RowOffset++)
+			{
+				const TArray<TSharedPtr<FJsonValue>>& Values = (*Rows)[RowOffset]->AsArray();
+				for (int32 ColumnOffset = 0; ColumnOffset < Values.Num(); ColumnOffset++)
+				{
+					Sheet->SetCell(StartRow + RowOffset, StartColumn + ColumnOffset, Values[ColumnOffset]->AsString());
+				}
+				TotalUpdatedCells += Values.Num();
+			}
+		}
+	}
+
+	return FHttpServerResponse::Create(FString::Printf(
+		TEXT("{\"spreadsheetId\":\"%s\",\"totalUpdatedCells\":%i}"), *InSpreadsheetId, TotalUpdatedCells), TEXT("application/json"));
+}
+
+TUniquePtr<FHttpServerResponse> FRuntimeDataTableMockSheetsServer::MakeMetadataResponse(const FString& InSpreadsheetId)
+{
+	TArray<FString> SheetJsons;
+	for (const FMockSheet& Sheet : Spreadsheets.FindChecked(InSpreadsheetId))
+	{
+		SheetJsons.Add(FString::Printf(
+			TEXT("{\"properties\":{\"sheetId\":%i,\"title\":\"%s\",\"gridProperties\":{\"rowCount\":%i,\"columnCount\":%i}}}"),
+			Sheet.SheetId, *Sheet.Title.ReplaceCharWithEscapedChar(), Sheet.RowCount, Sheet.ColumnCount));
+	}
+
+	return FHttpServerResponse::Create(
+		FString::Printf(TEXT("{\"sheets\":[%s]}"), *FString::Join(SheetJsons, TEXT(","))), TEXT("application/json"));
+}
+
+void FRuntimeDataTableMockSheetsServer::Respond(const FHttpResultCallback& OnComplete, TUniquePtr<FHttpServerResponse> Response)
+{
+	Stats.NumBytesSent += Response->Body.Num();
+
+	float Delay = FaultInjection.LatencySeconds + FaultInjection.LatencyJitterSeconds * RandomStream.FRand();
+	if (FaultInjection.BytesPerSecond > 0)
+	{
+		Delay += static_cast<float>(Response->Body.Num()) / FaultInjection.BytesPerSecond;
+	}
+
+	if (Delay <= 0.f)
+	{
+		OnComplete(MoveTemp(Response));
+		return;
+	}
+
+	// Delegates copy their payload, the response can't be copied
+	TSharedRef<TUniquePtr<FHttpServerResponse>> HeldResponse = MakeShared<TUniquePtr<FHttpServerResponse>>(MoveTemp(Response));
+
+	// Handles stay valid after their ticker has fired, so each response takes its own out when it's sent
+	const uint32 ResponseId = NextPendingResponseId++;
+	PendingResponses.Add(ResponseId, FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda(
+		[this, OnComplete, HeldResponse, ResponseId](float)
+		{
+			PendingResponses.Remove(ResponseId);
+			OnComplete(MoveTemp(*HeldResponse));
+			return false;
+		}), Delay));
+}
+
+TUniquePtr<FHttpServerResponse> FRuntimeDataTableMockSheetsServer::MakeErrorResponse(
+	const int32 InCode, const FString& InStatus, const FString& InMessage)
+{
+	TUniquePtr<FHttpServerResponse> Response = FHttpServerResponse::Create(FString::Printf(
+		TEXT("{\"error\":{\"code\":%i,\"message\":\"%s\",\"status\":\"%s\"}}"), InCode, *InMessage.ReplaceCharWithEscapedChar(), *InStatus),
+		TEXT("application/json"));
+	Response->Code = static_cast<EHttpServerResponseCodes>(InCode);
+	return Response;
+}
@@ -0,0 +1,139 @@
+// Copyright Jared Therriault 2019, 2022
+
+#include "RuntimeDataTableSnapshotCommandlet.h"
+
+#include "RuntimeDataTableModule.h"
+#include "RuntimeDataTableProjectSettings.h"
+#include "RuntimeDataTableSnapshot.h"
+
+#include "Async/TaskGraphInterfaces.h"
+#include "Containers/Ticker.h"
+#include "HttpManager.h"
+#include "Misc/Paths.h"
+
+URuntimeDataTableSnapshotCommandlet::URuntimeDataTableSnapshotCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = true;
+	LogToConsole = true;
+}
+
+int32 URuntimeDataTableSnapshotCommandlet::Main(const FString& Params)
+{
+	const URuntimeDataTableProjectSettings* Settings = GetDefault<URuntimeDataTableProjectSettings>();
+	if (!Settings || Settings->SheetSnapshots.Num() == 0)
+	{
+		UE_LOG(LogRuntimeDataTable, Display, TEXT("%hs: No SheetSnapshots in the project settings, nothing to do"), __FUNCTION__);
+		return 0;
+	}
+
+	TArray<FString> OnlySnapshots;
+	FString SnapshotsParam;
+	if (FParse::Value(*Params, TEXT("Snapshots="), SnapshotsParam, false))
+	{
+		SnapshotsParam.ParseIntoArray(OnlySnapshots, TEXT("+"));
+	}
+
+	float TimeoutSeconds = 120.f;
+	FParse::Value(*Params, TEXT("Timeout="), TimeoutSeconds);
+
+	NumFailed = 0;
+	PendingSnapshots.Reset();
+
+	for (const FRuntimeDataTableSnapshotSource& Source : Settings->SheetSnapshots)
+	{
+		if (Source.SnapshotName.IsEmpty() || Source.SheetURL.IsEmpty() ||
+			(OnlySnapshots.Num() > 0 && !OnlySnapshots.Contains(Source.SnapshotName)))
+		{
+			continue;
+		}
+
+		FRuntimeDataTableTokenInfo TokenInfo;
+		if (!Source.bSheetIsPublic)
+		{
+			const FString KeyFile = FPaths::IsRelative(Source.ServiceAccountKeyFile) ?
+				FPaths::Combine(FPaths::ProjectDir(), Source.ServiceAccountKeyFile) : Source.ServiceAccountKeyFile;
+
+			if (!URuntimeDataTableObject::GenerateTokenInfoFromFile(TokenInfo, KeyFile, 300))
+			{
+				UE_LOG(LogRuntimeDataTable, Error, TEXT("%hs: %s: could not read the service account key file %s"),
+					__FUNCTION__, *Source.SnapshotName, *KeyFile);
+				NumFailed++;
+				continue;
+			}
+		}
+
+		FRuntimeDataTableOperationParams OperationParams;
+		OperationParams.OperationName = FName(*Source.SnapshotName);
+		OperationParams.RequestTimeout = TimeoutSeconds;
+
+		PendingSnapshots.Add(OperationParams.OperationName, Source.SheetURL);
+
+		FRDTGetCsvInfoDelegate OnDownloaded;
+		OnDownloaded.BindUFunction(this, GET_FUNCTION_NAME_CHECKED(URuntimeDataTableSnapshotCommandlet, OnSheetDownloaded));
+
+		URuntimeDataTableObject::DownloadSheetAsCsvInfo(TokenInfo, OperationParams, OnDownloaded, Source.SheetURL, Source.bSheetIsPublic);
+	}
+
+	// Nothing ticks in a commandlet, so HTTP, the scheduler's retries and the parse callbacks have to be pumped here
+	const double GiveUpTime = FPlatformTime::Seconds() + TimeoutSeconds;
+	double LastTime = FPlatformTime::Seconds();
+	while (PendingSnapshots.Num() > 0 && FPlatformTime::Seconds() < GiveUpTime)
+	{
+		const double Now = FPlatformTime::Seconds();
+		const float DeltaTime = Now - LastTime;
+		LastTime = Now;
+
+		FHttpModule::Get().GetHttpManager().Tick(DeltaTime);
+		FTSTicker::GetCoreTicker().Tick(DeltaTime);
+		FTaskGraphInterface::Get().ProcessThreadUntilIdle(ENamedThreads::GameThread);
+
+		FPlatformProcess::Sleep(0.01f);
+	}
+
+	for (const TPair<FName, FString>& Pending : PendingSnapshots)
+	{
+		UE_LOG(LogRuntimeDataTable, Error, TEXT("%hs: %s: timed out after %.0f seconds"), __FUNCTION__, *Pending.Key.ToString(), TimeoutSeconds);
+		NumFailed++;
+	}
+	PendingSnapshots.Reset();
+
+	return NumFailed > 0 ? 1 : 0;
+}
+
+void URuntimeDataTableSnapshotCommandlet::OnSheetDownloaded(FRuntimeDataTableCallbackInfo CallbackInfo, const FEasyCsvInfo& CsvInfo)
+{
+	FString SheetURL;
+	if (!PendingSnapshots.RemoveAndCopyValue(CallbackInfo.OperationName, SheetURL))
+	{
+		return;
+	}
+
+	const FString SnapshotName = CallbackInfo.OperationName.ToString();
+
+	if (!CallbackInfo.bWasSuccessful)
+	{
+		UE_LOG(LogRuntimeDataTable, Error, TEXT("%hs: %s: download failed, response code %i"),
+			__FUNCTION__, *SnapshotName, CallbackInfo.ResponseCode);
+		NumFailed++;
+		return;
+	}
+
+	FRuntimeDataTableSnapshot Snapshot;
+	Snapshot.SheetURL = SheetURL;
+	Snapshot.SnapshotTime = FDateTime::UtcNow();
+	Snapshot.CsvInfo = CsvInfo;
+	Snapshot.ComputeRowHashes();
+
+	const FString SnapshotPath = FRuntimeDataTableSnapshot::GetCookedSnapshotPath(SnapshotName);
+	if (!Snapshot.Save(SnapshotPath))
+	{
+		UE_LOG(LogRuntimeDataTable, Error, TEXT("%hs: %s: could not write %s"), __FUNCTION__, *SnapshotName, *SnapshotPath);
+		NumFailed++;
+		return;
+	}
+
+	UE_LOG(LogRuntimeDataTable, Display, TEXT("%hs: %s: wrote %i rows to %s"),
+		__FUNCTION__, *SnapshotName, CsvInfo.CSV_Keys.Num(), *SnapshotPath);
+}
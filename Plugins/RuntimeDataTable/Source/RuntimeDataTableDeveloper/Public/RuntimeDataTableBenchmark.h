@@ -0,0 +1,64 @@
+// Copyright Jared Therriault 2019, 2022
+
+#pragma once
+
+#include "RuntimeDataTable.h"
+
+#include "RuntimeDataTableBenchmark.generated.h"
+
+/**
+ * Measures download and write throughput against FRuntimeDataTableMockSheetsServer, so that results only depend on
+ * the plugin and the injected faults. Run with the console command:
+ * RuntimeDataTable.Benchmark [Rows=1000] [Columns=10] [Downloads=20] [Writes=5] [LatencyMs=0] [JitterMs=0] [KBps=0]
+ *                            [ErrorRate=0] [Quota=0] [Seed=0] [Port=8765]
+ * Every download and then every write is started at once and left to the scheduler. Identical downloads aren't
+ * coalesced during a run, so each one is a request of its own. Throughput is printed when the
+ * last one is back, followed by the RuntimeDataTable.DumpLatency histograms for the run.
+ */
+UCLASS()
+class RUNTIMEDATATABLEDEVELOPER_API URuntimeDataTableBenchmark : public UObject
+{
+	GENERATED_BODY()
+
+public:
+
+	static void Run(const TArray<FString>& Args);
+
+protected:
+
+	// Do not call
+	UFUNCTION()
+	void OnSheetDownloaded(FRuntimeDataTableCallbackInfo CallbackInfo, const FEasyCsvInfo& CsvInfo);
+
+	// Do not call
+	UFUNCTION()
+	void OnSheetWritten(FRuntimeDataTableCallbackInfo CallbackInfo);
+
+private:
+
+	void StartDownloads();
+	void StartWrites();
+	void Finish();
+
+	// A throwaway service account key, the mock server accepts any
+	static FString GeneratePrivateKey();
+
+	int32 NumRows = 1000;
+	int32 NumColumns = 10;
+	int32 NumDownloads = 20;
+	int32 NumWrites = 5;
+	bool bStartedServer = false;
+	bool bPreviousCoalesceIdenticalDownloads = true;
+
+	FString Csv;
+	FString PrivateKey;
+
+	int32 NumPending = 0;
+	int32 NumFailed = 0;
+	int64 NumBytes = 0;
+	double PhaseStartTime = 0.0;
+
+	double DownloadSeconds = 0.0;
+	int32 NumDownloadsFailed = 0;
+	int64 NumDownloadBytes = 0;
+};
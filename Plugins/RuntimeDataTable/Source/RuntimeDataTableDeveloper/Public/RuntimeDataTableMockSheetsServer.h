@@ -0,0 +1,154 @@
+// Copyright Jared Therriault 2019, 2022
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "Containers/Ticker.h"
+#include "HttpResultCallback.h"
+#include "HttpRouteHandle.h"
+#include "Math/RandomStream.h"
+
+class IHttpRouter;
+struct FHttpServerRequest;
+struct FHttpServerResponse;
+class FJsonObject;
+
+/**
+ * Stands in for Google on localhost, so that downloads and writes can be measured without a network, an account or a quota.
+ * Serves the CSV export, spreadsheet metadata, :batchUpdate, values:batchUpdate and the OAuth token endpoint from sheets
+ * held in memory. Writes are applied to those sheets, so what was written can be downloaded again.
+ * While running, the Google Sheets URL prefixes in the project settings point at it. Set TokenUri in your
+ * FRuntimeDataTableTokenInfo to GetTokenUri(). Any correctly formatted private key is accepted.
+ * Latency, bandwidth, errors and quota can be injected. The same RandomSeed gives the same faults on the same requests.
+ * Game thread only.
+ */
+class RUNTIMEDATATABLEDEVELOPER_API FRuntimeDataTableMockSheetsServer
+{
+public:
+
+	struct FFaultInjection
+	{
+		// Every response is held back at least this long
+		float LatencySeconds = 0.f;
+
+		// And up to this much longer, at random
+		float LatencyJitterSeconds = 0.f;
+
+		// Responses are held back as if their body were sent at this rate. 0 is unlimited.
+		int64 BytesPerSecond = 0;
+
+		// Chance of answering any request with ErrorResponseCode instead
+		float ErrorRate = 0.f;
+		int32 ErrorResponseCode = 503;
+
+		// Requests in any 60 seconds beyond this are answered with a 429 and a Retry-After. 0 is unlimited.
+		int32 QuotaRequestsPerMinute = 0;
+
+		int32 RandomSeed = 0;
+	};
+
+	struct FServerStats
+	{
+		int32 NumRequests = 0;
+		int32 NumInjectedErrors = 0;
+		int32 NumQuotaRejections = 0;
+		int64 NumBytesReceived = 0;
+		int64 NumBytesSent = 0;
+	};
+
+	static FRuntimeDataTableMockSheetsServer& Get();
+
+	static constexpr uint32 DefaultPort = 8765;
+
+	bool Start(const uint32 InPort = DefaultPort);
+
+	// Puts the project settings back the way they were
+	void Stop();
+
+	bool IsRunning() const { return bIsRunning; }
+
+	void SetFaultInjection(const FFaultInjection& InFaultInjection);
+
+	// Adds the tab, or replaces its contents if it's already there
+	void SetSheet(const FString& InSpreadsheetId, const int32 InSheetId, const FString& InTitle, const FString& InCsv);
+
+	// The tab as the export endpoint would send it
+	bool GetSheetAsCsv(const FString& InSpreadsheetId, const int32 InSheetId, FString& OutCsv) const;
+
+	void RemoveAllSheets();
+
+	// An edit link like the ones users paste in, for passing to the download functions
+	FString GetSheetURL(const FString& InSpreadsheetId, const int32 InSheetId) const;
+
+	FString GetTokenUri() const;
+
+	const FServerStats& GetStats() const { return Stats; }
+
+	void ResetStats();
+
+private:
+
+	FRuntimeDataTableMockSheetsServer() {}
+
+	struct FMockSheet
+	{
+		int32 SheetId = 0;
+		FString Title;
+		int32 RowCount = 0;
+		int32 ColumnCount = 0;
+
+		// Ragged, a row only goes as far as its last cell that was written
+		TArray<TArray<FString>> Cells;
+
+		void SetCell(const int32 InRow, const int32 InColumn, const FString& InValue);
+		FString ToCsv() const;
+	};
+
+	FMockSheet* FindSheet(const FString& InSpreadsheetId, const int32 InSheetId);
+	FMockSheet* FindSheetByTitle(const FString& InSpreadsheetId, const FString& InTitle);
+
+	bool HandleExportRequest(const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete);
+	bool HandleApiRequest(const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete);
+	bool HandleTokenRequest(const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete);
+
+	// Counts the request and decides whether it gets an injected failure. Returns false if it was answered with one.
+	bool AdmitRequest(const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete);
+
+	bool IsAuthorized(const FHttpServerRequest& Request) const;
+
+	TUniquePtr<FHttpServerResponse> ApplyBatchUpdate(const FString& InSpreadsheetId, const TSharedPtr<FJsonObject>& InBody);
+	TUniquePtr<FHttpServerResponse> ApplyValuesBatchUpdate(const FString& InSpreadsheetId, const TSharedPtr<FJsonObject>& InBody);
+	TUniquePtr<FHttpServerResponse> MakeMetadataResponse(const FString& InSpreadsheetId);
+
+	// Sends the response once the injected latency and bandwidth say it would have arrived
+	void Respond(const FHttpResultCallback& OnComplete, TUniquePtr<FHttpServerResponse> Response);
+
+	static TUniquePtr<FHttpServerResponse> MakeErrorResponse(const int32 InCode, const FString& InStatus, const FString& InMessage);
+
+	bool bIsRunning = false;
+	uint32 Port = DefaultPort;
+
+	TSharedPtr<IHttpRouter> Router;
+	TArray<FHttpRouteHandle> RouteHandles;
+
+	// Settings overridden while running
+	FString PreviousGoogleSheetsUrlPrefix;
+	FString PreviousGoogleSheetsApiUrlPrefix;
+
+	FFaultInjection FaultInjection;
+	FRandomStream RandomStream;
+	FServerStats Stats;
+
+	// When each request in the last minute arrived, for the quota
+	TArray<double> RecentRequestTimes;
+
+	TSet<FString> IssuedAccessTokens;
+
+	// Responses still being held back, dropped on Stop
+	TMap<uint32, FTSTicker::FDelegateHandle> PendingResponses;
+	uint32 NextPendingResponseId = 0;
+
+	// Spreadsheet id to its tabs
+	TMap<FString, TArray<FMockSheet>> Spreadsheets;
+};
@@ -0,0 +1,40 @@
+// Copyright Jared Therriault 2019, 2022
+
+#pragma once
+
+#include "RuntimeDataTable.h"
+
+#include "Commandlets/Commandlet.h"
+
+#include "RuntimeDataTableSnapshotCommandlet.generated.h"
+
+/**
+ * Downloads every sheet in the project settings' SheetSnapshots and writes each as a snapshot into the project's content,
+ * where LoadSheetSnapshot and FetchSheetSnapshotChanges find it. Run it before cooking so the build ships current data:
+ * UnrealEditor-Cmd <Project>.uproject -run=RuntimeDataTableSnapshot [-Snapshots=NameA+NameB] [-Timeout=120]
+ * Returns non-zero if any snapshot could not be written.
+ */
+UCLASS()
+class RUNTIMEDATATABLEDEVELOPER_API URuntimeDataTableSnapshotCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+
+	URuntimeDataTableSnapshotCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+
+protected:
+
+	// Do not call
+	UFUNCTION()
+	void OnSheetDownloaded(FRuntimeDataTableCallbackInfo CallbackInfo, const FEasyCsvInfo& CsvInfo);
+
+private:
+
+	// Snapshot name to sheet URL, for downloads that haven't come back yet
+	TMap<FName, FString> PendingSnapshots;
+
+	int32 NumFailed = 0;
+};
@@ -0,0 +1,19 @@
+// Copyright Jared Therriault 2019, 2022
+
+using UnrealBuildTool;
+using System.IO;
+
+public class RuntimeDataTableDeveloper : ModuleRules
+{
+    public RuntimeDataTableDeveloper(ReadOnlyTargetRules target) : base(target)
+    {
+        PrivateIncludePaths.AddRange(new string[] { Path.Combine(ModuleDirectory, "Private") });
+        PublicIncludePaths.AddRange(new string[] { Path.Combine(ModuleDirectory, "Public") });
+
+        PublicDependencyModuleNames.AddRange(new string[] { "RuntimeDataTable", "EasyCsv", "HTTPServer" });
+
+        PrivateDependencyModuleNames.AddRange(new string[] { "Engine", "Core", "CoreUObject", "HTTP", "Json", "OpenSSL" });
+
+        PCHUsage = PCHUsageMode.UseExplicitOrSharedPCHs;
+    }
+}